@@ -19,6 +19,21 @@ endif()
 
 
 
+# ---- REDUCED MEMORY MODE ----
+# OFF: MarDyn in the full mode, ON: MarDyn in the reduced memory mode (RMM),
+# BOTH: MarDyn and MarDyn_RMM, the memory mode is then selected at run time
+# with <memorymode>full|reduced</memorymode> in the simulation section of the config file.
+# MarDyn starts MarDyn_RMM (and vice versa) by name, so both binaries have to be installed
+# side by side, i.e. copied to the same directory or both found in the PATH.
+set(REDUCED_MEMORY_MODE_OPTIONS "OFF;ON;BOTH")
+set(REDUCED_MEMORY_MODE "OFF" CACHE STRING "Reduced memory mode (${REDUCED_MEMORY_MODE_OPTIONS}).")
+set_property(CACHE REDUCED_MEMORY_MODE PROPERTY STRINGS ${REDUCED_MEMORY_MODE_OPTIONS})
+if (NOT REDUCED_MEMORY_MODE MATCHES "^(OFF|ON|BOTH)$")
+    message(FATAL_ERROR "wrong reduced memory mode option ")
+endif()
+
+
+
 #set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DQUICKSCHED")
 #set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DTASKTIMINGPROFILE")
 
@@ -53,6 +53,18 @@ if (USE_VECTORIZATION)
         message(WARNING "vectorization not yet supported on this compiler")
         message(STATUS "you can enable vectorization support by editing cmake/modules/vectorization.cmake")
     endif ()
+
+    # additional AVX2 and AVX-512 kernels of the VectorizedCellProcessor, selected at run time by CPUID.
+    # VECTOR_INSTRUCTIONS then sets the minimum the binary runs on, e.g. SSE for a cluster with mixed nodes.
+    option(VCP_DISPATCH "Compile the VectorizedCellProcessor for AVX2 and AVX-512 and select the kernel at run time" OFF)
+    if (VCP_DISPATCH)
+        if (CMAKE_CXX_COMPILER_ID MATCHES "GNU")
+            MESSAGE(STATUS "run time selection of the VectorizedCellProcessor kernel enabled")
+            set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DVCP_DISPATCH")
+        else ()
+            message(WARNING "VCP_DISPATCH is only supported for the GNU compiler, the kernel is fixed at compile time")
+        endif ()
+    endif ()
 elseif ()
     MESSAGE(STATUS "vectorization disabled")
     if (CMAKE_CXX_COMPILER_ID MATCHES "GNU")
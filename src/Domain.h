@@ -302,6 +302,15 @@ public:
 	//! explicitly excludes the kinetic energy associated with
 	//! the directed motion of the respective components.
 	bool thermostatIsUndirected(int thermostat) { return this->_universalUndirectedThermostat[thermostat]; }
+	//! @brief returns whether any thermostat is undirected
+	bool hasUndirectedThermostat() const {
+		for (const auto& thermostat : _universalUndirectedThermostat) {
+			if (thermostat.second) {
+				return true;
+			}
+		}
+		return false;
+	}
 	//! @brief returns the directed velocity associated with a thermostat
 	//! @param th ID of the thermostat
 	//! @param d coordinate 0 (v_x), 1 (v_y), or 2 (v_z).
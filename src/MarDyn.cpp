@@ -5,11 +5,17 @@
 #endif
 
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 
+#include <unistd.h>
+
+#include "rapidxml/rapidxml.hpp"
+
 #include "WrapOpenMP.h"
 
 #include "Simulation.h"
@@ -106,6 +112,88 @@ void program_execution_info(int argc, char **argv, Log::Logger *log) {
 #endif
 }
 
+/**
+ * @brief Read /mardyn/simulation/memorymode from the config file.
+ * @return "full", "reduced" or an empty string if not set or the file cannot be read
+ * @note Called before MPI_Init, therefore rapidxml is used directly instead of XMLfileUnits.
+ */
+std::string get_config_memory_mode(const std::string& configFileName) {
+	std::ifstream configFile(configFileName);
+	if (not configFile) {
+		return std::string();
+	}
+	std::vector<char> buffer((std::istreambuf_iterator<char>(configFile)), std::istreambuf_iterator<char>());
+	buffer.push_back('\0');
+
+	rapidxml::xml_document<> doc;
+	try {
+		doc.parse<rapidxml::parse_trim_whitespace>(buffer.data());
+	} catch (const rapidxml::parse_error&) {
+		// reported later by Simulation::readConfigFile
+		return std::string();
+	}
+	rapidxml::xml_node<>* node = doc.first_node("mardyn");
+	node = node ? node->first_node("simulation") : nullptr;
+	node = node ? node->first_node("memorymode") : nullptr;
+	return node ? std::string(node->value()) : std::string();
+}
+
+/**
+ * @brief Find the config file among the command line arguments without the option parser.
+ * @details Called before MPI_Init, which may still remove arguments of the MPI library, so only the
+ * arguments are scanned: the first argument ending in .xml is taken as the config file.
+ * @return the config file name, or an empty string if there is none or the unit tests are run
+ */
+std::string prescan_config_file_name(int argc, char** argv) {
+	const std::string xmlSuffix(".xml");
+	std::string configFileName;
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg(argv[i]);
+		if (arg == "-t" or arg == "--tests") {
+			return std::string();
+		}
+		if (configFileName.empty() and arg[0] != '-' and arg.size() > xmlSuffix.size()
+				and arg.compare(arg.size() - xmlSuffix.size(), xmlSuffix.size(), xmlSuffix) == 0) {
+			configFileName = arg;
+		}
+	}
+	return configFileName;
+}
+
+/**
+ * @brief Replace the process by the binary of the other memory mode if the config file requests it.
+ * @details A full mode binary invoked as X looks for X_RMM, a reduced memory mode binary invoked
+ * as X_RMM for X, both are built with cmake -DREDUCED_MEMORY_MODE=BOTH. The two binaries therefore
+ * have to be installed side by side: in the same directory if started with a path, otherwise both in
+ * the PATH. If the binary cannot be started, the simulation continues in this process and
+ * Simulation::readXML() reports the mismatch.
+ */
+void exec_memory_mode_binary(int argc, char** argv, const std::string& configFileName) {
+	const std::string suffix("_RMM");
+	std::string binary(argv[0]);
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	if (get_config_memory_mode(configFileName) != "full") {
+		return;
+	}
+	if (binary.size() <= suffix.size() or binary.compare(binary.size() - suffix.size(), suffix.size(), suffix) != 0) {
+		return;
+	}
+	binary.erase(binary.size() - suffix.size());
+#else
+	if (get_config_memory_mode(configFileName) != "reduced") {
+		return;
+	}
+	binary += suffix;
+#endif
+
+	std::vector<char*> binaryArgv(argv, argv + argc);
+	binaryArgv[0] = &binary[0];
+	binaryArgv.push_back(nullptr);
+	// execvp searches PATH if the binary was started without a path
+	execvp(binary.c_str(), binaryArgv.data());
+	std::cerr << "Could not start " << binary << " for the requested memory mode." << std::endl;
+}
+
 /** Run the internal unit tests */
 int run_unit_tests(const Values &options, const vector<string> &args) {
 	string testcases("");
@@ -128,6 +216,12 @@ int run_unit_tests(const Values &options, const vector<string> &args) {
  * all classes.
  */
 int main(int argc, char** argv) {
+	/* select the memory mode, before MPI_Init so that the MPI processes can be replaced */
+	const std::string memoryModeConfigFileName(prescan_config_file_name(argc, argv));
+	if (not memoryModeConfigFileName.empty()) {
+		exec_memory_mode_binary(argc, argv, memoryModeConfigFileName);
+	}
+
 #ifdef ENABLE_MPI
 	MPI_Init(&argc, &argv);
 #endif
@@ -35,6 +35,7 @@
 #include "particleContainer/adapter/LegacyCellProcessor.h"
 #include "particleContainer/adapter/VectorizedCellProcessor.h"
 #include "particleContainer/adapter/VCP1CLJRMM.h"
+#include "particleContainer/adapter/VCPMultiSiteRMM.h"
 #include "integrators/Integrator.h"
 #include "integrators/Leapfrog.h"
 #include "integrators/LeapfrogRMM.h"
@@ -167,11 +168,39 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 		xmlconfig.changecurrentnode("..");
 	}
 
+	/* memory mode */
+	// the binary of the requested mode is started by main(), here it is only checked
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	const string buildMemoryMode("reduced");
+#else
+	const string buildMemoryMode("full");
+#endif
+	string memoryMode;
+	if(xmlconfig.getNodeValue("memorymode", memoryMode)) {
+		if(memoryMode != "full" and memoryMode != "reduced") {
+			global_log->error() << "Unknown memory mode " << memoryMode << ", use full or reduced." << endl;
+			Simulation::exit(1);
+		}
+		if(memoryMode != buildMemoryMode) {
+			global_log->error() << "The config file requests the " << memoryMode << " memory mode, but this binary was built for the "
+					<< buildMemoryMode << " memory mode. Build both with cmake -DREDUCED_MEMORY_MODE=BOTH and start MarDyn." << endl;
+			Simulation::exit(1);
+		}
+		global_log->info() << "Memory mode: " << memoryMode << endl;
+	}
+
 	/* integrator */
 	if(xmlconfig.changecurrentnode("integrator")) {
 		string integratorType;
 		xmlconfig.getNodeValue("@type", integratorType);
 		global_log->info() << "Integrator type: " << integratorType << endl;
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+		if(integratorType == "Leapfrog" and memoryMode == "reduced") {
+			// the same config file can be run in both memory modes
+			global_log->info() << "Using the LeapfrogRMM integrator in the reduced memory mode." << endl;
+			integratorType = "LeapfrogRMM";
+		}
+#endif
 		if(integratorType == "Leapfrog") {
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 			global_log->error() << "The reduced memory mode (RMM) requires the LeapfrogRMM integrator." << endl;
@@ -273,12 +302,85 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 				Simulation::exit(1);
 			}
 			global_log->info() << "dimensionless cutoff radius:\t" << _cutoffRadius << endl;
+
+			// component dependent LJ cutoff radii (not larger than the LJ cutoff radius)
+			XMLfile::Query query = xmlconfig.query("componentRadiusLJ");
+			string oldpath = xmlconfig.getcurrentnodepath();
+			for(XMLfile::Query::const_iterator radiusIter = query.begin(); radiusIter; radiusIter++) {
+				xmlconfig.changecurrentnode(radiusIter);
+				unsigned int cid = 0;
+				double radius = 0.0;
+				xmlconfig.getNodeValue("@cid", cid);
+				xmlconfig.getNodeValueReduced(".", radius);
+				if(cid < 1 or cid > _ensemble->getComponents()->size() or radius <= 0 or radius > _LJCutoffRadius) {
+					global_log->error() << "Invalid LJ cutoff radius " << radius << " for component " << cid
+							<< ", it must lie in (0, " << _LJCutoffRadius << "]." << endl;
+					Simulation::exit(1);
+				}
+				global_log->info() << "dimensionless LJ cutoff radius of component " << cid << ":\t" << radius << endl;
+				_ensemble->getComponents()->at(cid - 1).setLJCutoffRadius(radius);
+			}
+			xmlconfig.changecurrentnode(oldpath);
+
+			// force-shifted or switched LJ potential for all or single pairs of components
+			query = xmlconfig.query("truncationLJ");
+			for(XMLfile::Query::const_iterator truncationIter = query.begin(); truncationIter; truncationIter++) {
+				xmlconfig.changecurrentnode(truncationIter);
+				LJTruncation truncation;
+				string type;
+				xmlconfig.getNodeValue("@type", type);
+				if(type == "ForceShifted") {
+					truncation.type = LJTruncation::FORCE_SHIFTED;
+				} else if(type == "Switched") {
+					truncation.type = LJTruncation::SWITCHED;
+				} else {
+					global_log->error() << "Unknown LJ truncation " << type << ", choose ForceShifted or Switched." << endl;
+					Simulation::exit(1);
+				}
+				unsigned int cid1 = 0, cid2 = 0;
+				xmlconfig.getNodeValue("@cid1", cid1);
+				xmlconfig.getNodeValue("@cid2", cid2);
+				truncation.allPairs = cid1 == 0 and cid2 == 0;
+				if(not truncation.allPairs and (cid1 < 1 or cid2 < 1 or cid1 > _ensemble->getComponents()->size()
+						or cid2 > _ensemble->getComponents()->size())) {
+					global_log->error() << "Invalid components " << cid1 << ", " << cid2 << " of the LJ truncation." << endl;
+					Simulation::exit(1);
+				}
+				truncation.cid1 = cid1 - 1;
+				truncation.cid2 = cid2 - 1;
+				truncation.radiusSwitch = 0.0;
+				if(truncation.type == LJTruncation::SWITCHED) {
+					xmlconfig.getNodeValueReduced("radiusSwitch", truncation.radiusSwitch);
+					if(truncation.radiusSwitch <= 0) {
+						global_log->error() << "The switched LJ potential needs a radiusSwitch > 0." << endl;
+						Simulation::exit(1);
+					}
+				}
+				global_log->info() << "LJ truncation " << type << " for "
+						<< (truncation.allPairs ? string("all components") : "components " + to_string(cid1) + " and " + to_string(cid2))
+						<< (truncation.type == LJTruncation::SWITCHED ? ", switching from r = " + to_string(truncation.radiusSwitch) : string())
+						<< endl;
+				_ljTruncations.push_back(truncation);
+			}
+			xmlconfig.changecurrentnode(oldpath);
 			xmlconfig.changecurrentnode("..");
 		} else {
 			global_log->error() << "Cutoff section missing." << endl;
 			Simulation::exit(1);
 		}
 
+		/* precision of the force calculation */
+		string precision;
+		if(xmlconfig.getNodeValue("precision", precision)) {
+			_forcePrecision = VectorizedCellProcessor::stringToPrecision(precision);
+			if(_forcePrecision < 0) {
+				global_log->error() << "Unknown precision " << precision << ", choose SINGLE, MIXED or DOUBLE." << endl;
+				Simulation::exit(1);
+			}
+			global_log->info() << "Precision of the force calculation: "
+					<< VectorizedCellProcessor::precisionToString(_forcePrecision) << endl;
+		}
+
 		/* electrostatics */
 		/** @todo This may be better go into a physical section for constants? */
 		if(xmlconfig.changecurrentnode("electrostatic[@type='ReactionField']")) {
@@ -680,16 +782,109 @@ void Simulation::prepare_start() {
 	if (!_legacyCellProcessor) {
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 		global_log->info() << "Using vectorized cell processor." << endl;
-		_cellProcessor = new VectorizedCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius);
+		_cellProcessor = new VectorizedCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius,
+				_forcePrecision < 0 ? VCP_PREC : _forcePrecision);
 #else
-		global_log->info() << "Using reduced memory mode (RMM) cell processor." << endl;
-		_cellProcessor = new VCP1CLJRMM( *_domain, _cutoffRadius, _LJCutoffRadius);
+		if (_forcePrecision >= 0) {
+			global_log->warning() << "The precision of the force calculation is fixed by the build in RMM mode." << endl;
+		}
+		const Component& componentZero = _ensemble->getComponents()->front();
+		if (componentZero.numDipoles() > 0 or componentZero.numQuadrupoles() > 0) {
+			global_log->error() << "The reduced memory mode (RMM) supports only LJ centers and charges." << endl;
+			Simulation::exit(1);
+		}
+		if (MoleculeRMM::isMultiSite()) {
+			global_log->info() << "Using reduced memory mode (RMM) cell processor for multi-site molecules." << endl;
+			_cellProcessor = new VCPMultiSiteRMM( *_domain, _cutoffRadius, _LJCutoffRadius);
+		} else {
+			global_log->info() << "Using reduced memory mode (RMM) cell processor." << endl;
+			_cellProcessor = new VCP1CLJRMM( *_domain, _cutoffRadius, _LJCutoffRadius);
+		}
 #endif
 	} else {
 		global_log->info() << "Using legacy cell processor." << endl;
 		_cellProcessor = new LegacyCellProcessor( _cutoffRadius, _LJCutoffRadius, _particlePairsHandler);
 	}
 
+	// Component dependent LJ cutoff radii are only applied by the vectorized cell processor.
+	std::vector<double> componentCutoffRadii;
+	bool mixedLJCutoffs = false;
+	for (const Component& component : *(_ensemble->getComponents())) {
+		const double rcLJ = component.getLJCutoffRadius() > 0. ? component.getLJCutoffRadius() : _LJCutoffRadius;
+		mixedLJCutoffs = mixedLJCutoffs or rcLJ < _LJCutoffRadius;
+		// largest distance, up to which the molecules of the component interact
+		double radius = component.numLJcenters() > 0 ? rcLJ : 0.;
+		if (component.numCharges() + component.numDipoles() + component.numQuadrupoles() > 0) {
+			radius = max(radius, _cutoffRadius);
+		}
+		if (component.ID() >= componentCutoffRadii.size()) {
+			componentCutoffRadii.resize(component.ID() + 1, 0.);
+		}
+		componentCutoffRadii[component.ID()] = radius;
+	}
+	if (mixedLJCutoffs) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+		const bool reducedMemoryMode = true;
+#else
+		const bool reducedMemoryMode = false;
+#endif
+		if (_legacyCellProcessor or reducedMemoryMode or _FMM != nullptr
+				or dynamic_cast<Planar*>(_longRangeCorrection) != nullptr or _ensemble->getType() == muVT) {
+			global_log->error() << "Component dependent LJ cutoff radii require the vectorized cell processor and are "
+					<< "not supported in reduced memory mode, with FMM, the planar long range correction and muVT." << endl;
+			Simulation::exit(1);
+		}
+		LinkedCells* linkedCells = dynamic_cast<LinkedCells*>(_moleculeContainer);
+		if (linkedCells != nullptr) {
+			linkedCells->setComponentCutoffRadii(componentCutoffRadii);
+		}
+	}
+
+	if (not _ljTruncations.empty()) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+		const bool reducedMemoryMode = true;
+#else
+		const bool reducedMemoryMode = false;
+#endif
+		if (_legacyCellProcessor or reducedMemoryMode or _FMM != nullptr or _ensemble->getType() == muVT) {
+			global_log->error() << "Force-shifted and switched LJ potentials require the vectorized cell processor and are "
+					<< "not supported in reduced memory mode, with FMM and muVT." << endl;
+			Simulation::exit(1);
+		}
+		global_log->warning() << "The long range correction treats force-shifted and switched LJ potentials as truncated ones." << endl;
+	}
+
+	if (not _ensemble->getTabulatedPotentials().empty()) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+		const bool reducedMemoryMode = true;
+#else
+		const bool reducedMemoryMode = false;
+#endif
+		if (_legacyCellProcessor or reducedMemoryMode or _FMM != nullptr or _ensemble->getType() == muVT) {
+			global_log->error() << "Tabulated potentials require the vectorized cell processor and are "
+					<< "not supported in reduced memory mode, with FMM and muVT." << endl;
+			Simulation::exit(1);
+		}
+		global_log->warning() << "The long range correction treats tabulated potentials as LJ 12-6 potentials." << endl;
+	}
+
+	// Compact halo copies are only seen by the vectorized cell processor, not by the iterators.
+	LinkedCells* linkedCells = dynamic_cast<LinkedCells*>(_moleculeContainer);
+	if (linkedCells != nullptr and linkedCells->hasCompactHaloCells()) {
+		bool haloPlugins = false;
+		for (auto plugin : _plugins) {
+			if (plugin->requiresHaloMolecules()) {
+				global_log->warning() << "Plugin " << plugin->getPluginName() << " requires the halo molecules." << endl;
+				haloPlugins = true;
+			}
+		}
+		if (_legacyCellProcessor or _FMM != nullptr or haloPlugins) {
+			global_log->warning() << "Compact halo cells require the vectorized cell processor, no FMM and no "
+					<< "plugins using the halo molecules. Storing full halo molecules instead." << endl;
+			linkedCells->setCompactHaloCells(false);
+		}
+	}
+
 	if (_FMM != nullptr) {
 
 		double globalLength[3];
@@ -734,10 +929,17 @@ void Simulation::prepare_start() {
 
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 	// the leapfrog integration requires that we move the velocities by one half-timestep
-	// so we halve vcp1clj_wr_cellProcessor::_dtInvm
-	VCP1CLJRMM * vcp1clj_wr_cellProcessor = static_cast<VCP1CLJRMM * >(_cellProcessor);
-	double dt_inv_m = vcp1clj_wr_cellProcessor->getDtInvm();
-	vcp1clj_wr_cellProcessor->setDtInvm(dt_inv_m * 0.5);
+	// so we halve the _dtInvm of the RMM cell processor
+	VCP1CLJRMM * vcp1clj_wr_cellProcessor = dynamic_cast<VCP1CLJRMM * >(_cellProcessor);
+	VCPMultiSiteRMM * vcpMultiSite_cellProcessor = dynamic_cast<VCPMultiSiteRMM * >(_cellProcessor);
+	double dt_inv_m = 0.0;
+	if (vcp1clj_wr_cellProcessor != nullptr) {
+		dt_inv_m = vcp1clj_wr_cellProcessor->getDtInvm();
+		vcp1clj_wr_cellProcessor->setDtInvm(dt_inv_m * 0.5);
+	} else if (vcpMultiSite_cellProcessor != nullptr) {
+		dt_inv_m = vcpMultiSite_cellProcessor->getDtInvm();
+		vcpMultiSite_cellProcessor->setDtInvm(dt_inv_m * 0.5);
+	}
 #endif /* ENABLE_REDUCED_MEMORY_MODE */
 
 	global_log->info() << "Performing initial force calculation" << endl;
@@ -756,8 +958,12 @@ void Simulation::prepare_start() {
 	}
 
 #ifdef ENABLE_REDUCED_MEMORY_MODE
-	// now set vcp1clj_wr_cellProcessor::_dtInvm back.
-	vcp1clj_wr_cellProcessor->setDtInvm(dt_inv_m);
+	// now set the _dtInvm of the RMM cell processor back.
+	if (vcp1clj_wr_cellProcessor != nullptr) {
+		vcp1clj_wr_cellProcessor->setDtInvm(dt_inv_m);
+	} else if (vcpMultiSite_cellProcessor != nullptr) {
+		vcpMultiSite_cellProcessor->setDtInvm(dt_inv_m);
+	}
 #endif /* ENABLE_REDUCED_MEMORY_MODE */
 
 	_loopCompTime = global_simulation->timers()->getTime("SIMULATION_FORCE_CALCULATION");
@@ -812,6 +1018,57 @@ void Simulation::prepare_start() {
 			true, 1.0);
 	global_log->debug() << "Calculating global values finished." << endl;
 
+	// Fuse the second half step of the leapfrog integrator into the force traversal, if requested and possible.
+	// It is enabled only now, so that the initial force calculation above does not update the velocities.
+	Leapfrog* leapfrog = dynamic_cast<Leapfrog*>(_integrator);
+	if (leapfrog != nullptr and leapfrog->isFusedWithForceCalculation()) {
+		VectorizedCellProcessor* vcp = dynamic_cast<VectorizedCellProcessor*>(_cellProcessor);
+#if defined(ENABLE_MPI) && defined(ENABLE_OVERLAPPING)
+		const bool overlapCommComp = true;
+#else
+		const bool overlapCommComp = false;
+#endif
+		// plugins, which change or read forces and velocities in siteWiseForces() or afterForces()
+		bool forcePlugins = false;
+		for (auto plugin : _plugins) {
+			if (plugin->requiresForcesBeforeIntegration()) {
+				global_log->warning() << "Plugin " << plugin->getPluginName() << " requires the forces before the integration." << endl;
+				forcePlugins = true;
+			}
+		}
+		if (vcp == nullptr or _FMM != nullptr or dynamic_cast<LinkedCells*>(_moleculeContainer) == nullptr
+				or _moleculeContainer->requiresForceExchange() or overlapCommComp
+				or dynamic_cast<Planar*>(_longRangeCorrection) != nullptr
+				or _domain->hasUndirectedThermostat() or _ensemble->getType() == muVT or forcePlugins) {
+			global_log->warning() << "Fusing the integration with the force calculation requires the vectorized cell "
+					<< "processor, LinkedCells without force exchange or overlapping communication, no FMM, no planar "
+					<< "long range correction, no undirected thermostat, no muVT ensemble and no plugins using "
+					<< "siteWiseForces() or afterForces(). Disabling it." << endl;
+			leapfrog->setFuseWithForceCalculation(false);
+		} else {
+			global_log->info() << "Fusing the second half step of the integration with the force calculation." << endl;
+			vcp->setFusedHalfKick(0.5 * _integrator->getTimestepLength());
+		}
+	}
+
+	// Detect the molecules leaving their cells in the position update of the RMM, if requested and possible.
+	LeapfrogRMM* leapfrogRMM = dynamic_cast<LeapfrogRMM*>(_integrator);
+	if (leapfrogRMM != nullptr and leapfrogRMM->isFusedWithLeavingDetection()) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+		const bool isRMM = true;
+#else
+		const bool isRMM = false;
+#endif
+		if (not isRMM or dynamic_cast<LinkedCells*>(_moleculeContainer) == nullptr) {
+			global_log->warning() << "Fusing the detection of leaving molecules with the position update requires "
+					<< "the reduced memory mode and LinkedCells. Disabling it." << endl;
+			leapfrogRMM->setFuseLeavingDetection(false);
+		} else {
+			global_log->info() << "Fusing the detection of leaving molecules with the position update. "
+					<< "Molecules moved by plugins before the force calculation may not be rebinned." << endl;
+		}
+	}
+
 	_ensemble->prepare_start();
 
 	_simstep = _initSimulation = (unsigned long) round(_simulationTime / _integrator->getTimestepLength() );
@@ -948,7 +1205,10 @@ void Simulation::simulate() {
 			}
 
 			// Update forces in molecules so they can be exchanged
-			updateForces();
+			// (already done in the force traversal, if the integration is fused with it)
+			if (not _cellProcessor->requiresPostprocessing()) {
+				updateForces();
+			}
 
 			forceCalculationTimer->stop();
 			perStepTimer.stop();
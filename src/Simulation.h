@@ -8,6 +8,7 @@
 #include "utils/OptionParser.h"
 #include "utils/SysMon.h"
 #include "thermostats/VelocityScalingThermostat.h"
+#include "molecules/Comp2Param.h"
 
 // plugins
 #include "plugins/PluginFactory.h"
@@ -99,7 +100,11 @@ public:
 	     <algorithm>
 	       <cutoffs>
 	          <radiusLJ>DOUBLE</radiusLJ>
+	          <truncationLJ type='ForceShifted|Switched' cid1=INTEGER cid2=INTEGER><!-- all pairs without cid1, cid2 -->
+	            <radiusSwitch>DOUBLE</radiusSwitch><!-- Switched only -->
+	          </truncationLJ>
 	       </cutoffs>
+	       <precision>STRING</precision><!-- SINGLE, MIXED or DOUBLE, default: precision of the build -->
 	       <electrostatic type='ReactionField'>
 	         <epsilon>DOUBLE</epsilon>
 	       </electrostatic>
@@ -240,6 +245,9 @@ public:
 	double getcutoffRadius() const { return _cutoffRadius; }
 	void setcutoffRadius(double cutoffRadius) { _cutoffRadius = cutoffRadius; }
 	double getLJCutoff() const { return _LJCutoffRadius; }
+	//! @brief smooth truncations of the LJ potential, later ones override earlier ones for a pair of components
+	const std::vector<LJTruncation>& getLJTruncations() const { return _ljTruncations; }
+	void setLJTruncations(const std::vector<LJTruncation>& truncations) { _ljTruncations = truncations; }
 	void setLJCutoff(double LJCutoffRadius) { _LJCutoffRadius = LJCutoffRadius; }
 	unsigned long getTotalNumberOfMolecules() const;
 
@@ -469,6 +477,12 @@ private:
 	/** use legacyCellProcessor instead of vectorizedCellProcessor */
 	bool _legacyCellProcessor = false;
 
+	/** precision of the vectorizedCellProcessor (VCP_SPSP, VCP_SPDP or VCP_DPDP), -1 for the one of the build */
+	int _forcePrecision = -1;
+
+	/** smooth truncations of the LJ potential (vectorizedCellProcessor only) */
+	std::vector<LJTruncation> _ljTruncations;
+
 	/** List of plugins to use */
 	std::list<PluginBase*> _plugins;
 
@@ -21,7 +21,8 @@
 class Component;
 class Domain;
 class Comp2Param;
-class CellDataSoA;
+template<typename RealCalc, typename RealAccum> class CellDataSoAT;
+typedef CellDataSoAT<vcp_real_calc, vcp_real_accum> CellDataSoA;
 
 namespace bhfmm {
 /**
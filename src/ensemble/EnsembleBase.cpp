@@ -81,6 +81,23 @@ void Ensemble::readXML(XMLfileUnits& xmlconfig) {
 		dmixcoeff.push_back(eta);
 	}
 	xmlconfig.changecurrentnode(oldpath);
+
+	/* tabulated potentials */
+	query = xmlconfig.query("components/tabulated");
+	global_log->info() << "Found " << query.card() << " tabulated potentials." << endl;
+	_tabulatedPotentials.clear();
+	for(XMLfile::Query::const_iterator tabulatedIter = query.begin(); tabulatedIter; tabulatedIter++) {
+		xmlconfig.changecurrentnode(tabulatedIter);
+		TabulatedPotential potential;
+		potential.readXML(xmlconfig);
+		if(potential.getCid1() >= _components.size() or potential.getCid2() >= _components.size()) {
+			global_log->error() << "Tabulated potential for unknown components " << potential.getCid1() + 1
+					<< " and " << potential.getCid2() + 1 << endl;
+			Simulation::exit(1);
+		}
+		_tabulatedPotentials.push_back(potential);
+	}
+	xmlconfig.changecurrentnode(oldpath);
 	setComponentLookUpIDs();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "molecules/Component.h"
+#include "molecules/TabulatedPotential.h"
 
 #include <string>
 #include <vector>
@@ -87,6 +88,11 @@ public:
 
 	std::vector<Component>* getComponents() { return &_components; }
 
+	//! @brief tabulated pair potentials between the LJ centers of two components
+	const std::vector<TabulatedPotential>& getTabulatedPotentials() const { return _tabulatedPotentials; }
+
+	void addTabulatedPotential(const TabulatedPotential& potential) { _tabulatedPotentials.push_back(potential); }
+
 	void addComponent(Component& component) { _components.push_back(component); }
 
 	//! prepare the _compIDs used by the Vectorized*CellProcessors
@@ -127,6 +133,7 @@ protected:
 	std::vector<Component> _components;
 	std::map<std::string, int> _componentnamesToIds;
 	std::vector<MixingRuleBase*> _mixingrules;
+	std::vector<TabulatedPotential> _tabulatedPotentials;
 	DomainBase* _domain;
 	Type _type = undefined;
 
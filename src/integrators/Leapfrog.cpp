@@ -30,6 +30,12 @@ void Leapfrog::readXML(XMLfileUnits& xmlconfig) {
 	xmlconfig.getNodeValueReduced("timestep", _timestepLength);
 	global_log->info() << "Timestep: " << _timestepLength << endl;
 	mardyn_assert(_timestepLength > 0);
+
+	_fuseWithForceCalculation = false;
+	xmlconfig.getNodeValue("fuseWithForceCalculation", _fuseWithForceCalculation);
+	if (_fuseWithForceCalculation) {
+		global_log->info() << "Second half step of the integration fused with the force calculation (if possible)." << endl;
+	}
 }
 
 void Leapfrog::eventForcesCalculated(ParticleContainer* molCont, Domain* domain) {
@@ -68,6 +74,12 @@ void Leapfrog::transition2to3(ParticleContainer* molCont, Domain* domain) {
 		global_log->error() << "Leapfrog::transition2to3(...): Wrong state for state transition" << endl;
 	}
 
+	if (_fuseWithForceCalculation) {
+		// upd_postF and the thermostat sums were already done during the force calculation
+		this->_state = STATE_POST_FORCE_CALCULATION;
+		return;
+	}
+
 	/* TODO introduce
 	  	class Thermostat {
 		unsigned long N, rotDOF;
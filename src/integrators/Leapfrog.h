@@ -56,6 +56,7 @@ public:
 	 * \code{.xml}
 	   <integrator type="Leapfrog" >
 	     <timestep>DOUBLE</timestep>
+	     <fuseWithForceCalculation>BOOL</fuseWithForceCalculation> <!-- second half step in the force traversal, default: false -->
 	   </integrator>
 	   \endcode
 	 */
@@ -73,11 +74,21 @@ public:
 	//! checks whether the current state of the integrator allows that this method is called
 	void eventNewTimestep(ParticleContainer* molCont, Domain* domain);
 
+	//! @brief true, if the second half step (postF) is done by the cell processor during the force traversal
+	//!
+	//! In this case, transition2to3() only changes the state, since the velocities are already updated
+	//! and the thermostat sums are already stored in the domain (see VectorizedCellProcessor::setFusedHalfKick()).
+	bool isFusedWithForceCalculation() const { return _fuseWithForceCalculation; }
+	void setFuseWithForceCalculation(bool fuse) { _fuseWithForceCalculation = fuse; }
+
 private:
 
 	//! state in which the integrator is
 	int _state;
 
+	//! second half step fused into the force traversal
+	bool _fuseWithForceCalculation = false;
+
 	//! @brief calculate new positions and the first velocity halfstep
 	//!
 	//! This method also checks whether the state is 1. If so, the calculations are done and
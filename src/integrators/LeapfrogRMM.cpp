@@ -8,6 +8,7 @@
 #include "ensemble/EnsembleBase.h"
 #include "molecules/Molecule.h"
 #include "particleContainer/ParticleContainer.h"
+#include "particleContainer/LinkedCells.h"
 #include "particleContainer/ParticleIterator.h"
 
 #include "PositionCellProcessorRMM.h"
@@ -37,6 +38,12 @@ void LeapfrogRMM::readXML(XMLfileUnits & xmlconfig) {
 	global_log->info() << "Timestep: " << _timestepLength << endl;
 	mardyn_assert(_timestepLength > 0);
 
+	_fuseLeavingDetection = false;
+	xmlconfig.getNodeValue("fuseLeavingDetection", _fuseLeavingDetection);
+	if (_fuseLeavingDetection) {
+		global_log->info() << "Detection of leaving molecules fused with the position update (if possible)." << endl;
+	}
+
 	mardyn_assert(_velocityCellProcessor == nullptr);
 	_velocityCellProcessor = new VelocityCellProcessorRMM();
 }
@@ -55,8 +62,12 @@ void LeapfrogRMM::computePositions(ParticleContainer* molCont, Domain* dom) {
 	}
 #else
 	// this is actually called in RMM
-	PositionCellProcessorRMM cellProc(_timestepLength);
-	molCont->traverseCells(cellProc);
+	LinkedCells * linkedCells = _fuseLeavingDetection ? dynamic_cast<LinkedCells *>(molCont) : nullptr;
+	PositionCellProcessorRMM cellProc(_timestepLength, linkedCells != nullptr);
+	molCont->traverseCellsIndependently(cellProc);
+	if (linkedCells != nullptr) {
+		linkedCells->setLeavingMoleculesDetected();
+	}
 #endif
 }
 
@@ -98,12 +109,14 @@ void LeapfrogRMM::computeVelocities(ParticleContainer* molCont, Domain* dom) {
 		dom->setLocalNrotDOF(thermit->first, N[thermit->first], rotDOF[thermit->first]);
 	}
 #else
-	molCont->traverseCells(*_velocityCellProcessor);
+	molCont->traverseCellsIndependently(*_velocityCellProcessor);
 	unsigned long N = _velocityCellProcessor->getN();
 	double summv2 = _velocityCellProcessor->getSummv2();
+	double sumIw2 = _velocityCellProcessor->getSumIw2();
+	unsigned long rotDOF = MoleculeRMM::isMultiSite() ? N * MoleculeRMM::getStaticRMMComponent()->getRotationalDegreesOfFreedom() : 0;
 
 	dom->setLocalSummv2(summv2, 0);
-	dom->setLocalSumIw2(0.0, 0);
-	dom->setLocalNrotDOF(0, N, 0);
+	dom->setLocalSumIw2(sumIw2, 0);
+	dom->setLocalNrotDOF(0, N, rotDOF);
 #endif
 }
@@ -11,6 +11,16 @@ public:
 	LeapfrogRMM (double timestepLength);
 	~LeapfrogRMM();
 
+	/** @brief Read in XML configuration for the leapfrog integrator of the reduced memory mode.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <integrator type="LeapfrogRMM" >
+	     <timestep>DOUBLE</timestep>
+	     <fuseLeavingDetection>BOOL</fuseLeavingDetection> <!-- detect molecules leaving their cells in the position update, default: false -->
+	   </integrator>
+	   \endcode
+	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
 	void init() {}
@@ -23,6 +33,11 @@ public:
 		computePositions(moleculeContainer, domain);
 	}
 
+	//! @brief true, if the position update flags the cells whose molecules left them,
+	//! so that LinkedCells::update() only checks these cells (see LinkedCells::setLeavingMoleculesDetected())
+	bool isFusedWithLeavingDetection() const { return _fuseLeavingDetection; }
+	void setFuseLeavingDetection(bool fuse) { _fuseLeavingDetection = fuse; }
+
 private:
 	
 	void computePositions(ParticleContainer* molCont, Domain* dom);
@@ -31,6 +46,9 @@ private:
 	// unlike the PositionCellProcessor, the VelocityCellProcessor has dynamic data, so keep it.
 	VelocityCellProcessorRMM * _velocityCellProcessor;
 
+	//! detection of leaving molecules fused into the position update
+	bool _fuseLeavingDetection = false;
+
 };
 
 #endif /* SRC_INTEGRATORS_LEAPFROGRMM_H_ */
@@ -10,12 +10,44 @@
 
 #include "particleContainer/ParticleCell.h"
 #include "particleContainer/adapter/CellProcessor.h"
+#include "molecules/Molecule.h"
+#include "molecules/Component.h"
+
+#include <cmath>
+#include <limits>
 
 // explicit Leapfrog position update rule in a vectorized fashion for the RMM
+// for multi-site molecules, the orientations are updated as well
+// optionally, the cells are flagged if molecules left them (see ParticleCellRMM::hasLeavingMolecules())
 
 class PositionCellProcessorRMM : public CellProcessor {
 public:
-	PositionCellProcessorRMM(double timeStep) : CellProcessor(0.0, 0.0), _timeStep(static_cast<vcp_real_calc>(timeStep)) {}
+	PositionCellProcessorRMM(double timeStep, bool detectLeavingMolecules = false) : CellProcessor(0.0, 0.0),
+			_timeStep(static_cast<vcp_real_calc>(timeStep)), _detectLeavingMolecules(detectLeavingMolecules) {
+		_invI[0] = _invI[1] = _invI[2] = 0.0;
+		const Component * component = MoleculeRMM::getStaticRMMComponent();
+		if (MoleculeRMM::isMultiSite()) {
+			const double I[3] = {component->I11(), component->I22(), component->I33()};
+			for (int d = 0; d < 3; ++d) {
+				_invI[d] = I[d] != 0.0 ? static_cast<vcp_real_accum>(1.0 / I[d]) : 0.0;
+			}
+		}
+	}
+
+	/**
+	 * \brief Rotate a vector into the body-fixed frame, see Quaternion::rotateinv().
+	 */
+	static vcp_inline void rotateinv(vcp_real_accum qw, vcp_real_accum qx, vcp_real_accum qy, vcp_real_accum qz,
+			vcp_real_accum dx, vcp_real_accum dy, vcp_real_accum dz,
+			vcp_real_accum& rx, vcp_real_accum& ry, vcp_real_accum& rz) {
+		const vcp_real_accum ww = qw*qw, xx = qx*qx, yy = qy*qy, zz = qz*qz;
+		const vcp_real_accum wx = qw*qx, wy = qw*qy, wz = qw*qz;
+		const vcp_real_accum xy = qx*qy, xz = qx*qz, yz = qy*qz;
+		rx = (ww+xx-yy-zz)*dx + 2*(xy+wz)*dy + 2*(xz-wy)*dz;
+		ry = 2*(xy-wz)*dx + (ww-xx+yy-zz)*dy + 2*(yz+wx)*dz;
+		rz = 2*(xz+wy)*dx + 2*(yz-wx)*dy + (ww-xx-yy+zz)*dz;
+	}
+
 	void initTraversal() {}
 
 	void preprocessCell(ParticleCell& cell) {}
@@ -42,6 +74,14 @@ public:
 
 		const RealCalcVec dt = RealCalcVec::set1(_timeStep);
 
+		// the molecules inside [lower, upper] are in the cell, the bounds are rounded inwards,
+		// so that no molecule is missed which ParticleCellRMM::getLeavingMolecules() would find
+		RealCalcVec lower_x, lower_y, lower_z, upper_x, upper_y, upper_z;
+		getInnerBounds(c, 0, lower_x, upper_x);
+		getInnerBounds(c, 1, lower_y, upper_y);
+		getInnerBounds(c, 2, lower_z, upper_z);
+		MaskCalcVec leaving = MaskCalcVec::zero();
+
 		size_t i = 0;
 		for (; i < end_i; i += VCP_VEC_SIZE) {
 			RealCalcVec r_x = RealCalcVec::aligned_load(soa_r_x + i);
@@ -64,6 +104,9 @@ public:
 			r_y.aligned_store(soa_r_y + i);
 			r_z.aligned_store(soa_r_z + i);
 
+			if (_detectLeavingMolecules) {
+				leaving = leaving or isOutside(r_x, r_y, r_z, lower_x, lower_y, lower_z, upper_x, upper_y, upper_z);
+			}
 		}
 		const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(soa.getMolNum());
 		if (remainderMask.movemask()) {
@@ -88,11 +131,112 @@ public:
 			r_x.aligned_store(soa_r_x + i);
 			r_y.aligned_store(soa_r_y + i);
 			r_z.aligned_store(soa_r_z + i);
+
+			if (_detectLeavingMolecules) {
+				leaving = leaving or (remainderMask and isOutside(r_x, r_y, r_z, lower_x, lower_y, lower_z, upper_x, upper_y, upper_z));
+			}
+		}
+
+		if (_detectLeavingMolecules) {
+			c.setHasLeavingMolecules(leaving.movemask() != 0);
+		}
+
+		if (soa.isRotational()) {
+			updateOrientations(soa);
 		}
 	}
 
 private:
+	/**
+	 * \brief Bounds of the cell in calc precision, such that x < lower or x > upper holds
+	 * for every x outside of [boxMin, boxMax) and possibly for values within one ulp of the borders.
+	 */
+	static void getInnerBounds(const ParticleCellRMM & c, int d, RealCalcVec& lower, RealCalcVec& upper) {
+		const double boxMin = c.getBoxMin(d);
+		const double boxMax = c.getBoxMax(d);
+		vcp_real_calc lo = static_cast<vcp_real_calc>(boxMin);
+		if (static_cast<double>(lo) < boxMin) {
+			lo = std::nextafter(lo, std::numeric_limits<vcp_real_calc>::max());
+		}
+		vcp_real_calc hi = static_cast<vcp_real_calc>(boxMax);
+		if (static_cast<double>(hi) > boxMax) {
+			hi = std::nextafter(hi, std::numeric_limits<vcp_real_calc>::lowest());
+		}
+		// x >= hi  <=>  x > nextafter(hi, -inf)
+		hi = std::nextafter(hi, std::numeric_limits<vcp_real_calc>::lowest());
+		lower = RealCalcVec::set1(lo);
+		upper = RealCalcVec::set1(hi);
+	}
+
+	static vcp_inline MaskCalcVec isOutside(const RealCalcVec& r_x, const RealCalcVec& r_y, const RealCalcVec& r_z,
+			const RealCalcVec& lower_x, const RealCalcVec& lower_y, const RealCalcVec& lower_z,
+			const RealCalcVec& upper_x, const RealCalcVec& upper_y, const RealCalcVec& upper_z) {
+		return (r_x < lower_x) or (upper_x < r_x)
+			or (r_y < lower_y) or (upper_y < r_y)
+			or (r_z < lower_z) or (upper_z < r_z);
+	}
+
+	/**
+	 * \brief Rotate the molecules with their angular momenta.
+	 * \details Same scheme as FullMolecule::upd_preF(), but as the angular momenta
+	 * have already been kicked by a full time step in the force calculation,
+	 * the half-step angular momentum is used for both stages.
+	 */
+	void updateOrientations(CellDataSoARMM & soa) {
+		const size_t molNum = soa.getMolNum();
+
+		vcp_real_accum * const soa_q_w = soa.q_wBegin();
+		vcp_real_accum * const soa_q_x = soa.q_xBegin();
+		vcp_real_accum * const soa_q_y = soa.q_yBegin();
+		vcp_real_accum * const soa_q_z = soa.q_zBegin();
+		const vcp_real_accum * const soa_D_x = soa.D_xBegin();
+		const vcp_real_accum * const soa_D_y = soa.D_yBegin();
+		const vcp_real_accum * const soa_D_z = soa.D_zBegin();
+
+		const vcp_real_accum dt = _timeStep;
+		const vcp_real_accum dt_halve = 0.5 * dt;
+		const vcp_real_accum invI_x = _invI[0], invI_y = _invI[1], invI_z = _invI[2];
+
+		#if defined(_OPENMP)
+		#pragma omp simd
+		#endif
+		for (size_t i = 0; i < molNum; ++i) {
+			const vcp_real_accum qw = soa_q_w[i], qx = soa_q_x[i], qy = soa_q_y[i], qz = soa_q_z[i];
+			const vcp_real_accum Dx = soa_D_x[i], Dy = soa_D_y[i], Dz = soa_D_z[i];
+
+			// angular velocity in the body-fixed frame
+			vcp_real_accum wx, wy, wz;
+			rotateinv(qw, qx, qy, qz, Dx, Dy, Dz, wx, wy, wz);
+			wx *= invI_x; wy *= invI_y; wz *= invI_z;
+
+			// half step, see Quaternion::differentiate()
+			vcp_real_accum hw = qw + dt_halve * 0.5 * (-qx*wx - qy*wy - qz*wz);
+			vcp_real_accum hx = qx + dt_halve * 0.5 * ( qw*wx - qz*wy + qy*wz);
+			vcp_real_accum hy = qy + dt_halve * 0.5 * ( qz*wx + qw*wy - qx*wz);
+			vcp_real_accum hz = qz + dt_halve * 0.5 * (-qy*wx + qx*wy + qw*wz);
+			const vcp_real_accum hcorr = 1.0 / std::sqrt(hw*hw + hx*hx + hy*hy + hz*hz);
+			hw *= hcorr; hx *= hcorr; hy *= hcorr; hz *= hcorr;
+
+			rotateinv(hw, hx, hy, hz, Dx, Dy, Dz, wx, wy, wz);
+			wx *= invI_x; wy *= invI_y; wz *= invI_z;
+
+			// full step
+			const vcp_real_accum nw = qw + dt * 0.5 * (-hx*wx - hy*wy - hz*wz);
+			const vcp_real_accum nx = qx + dt * 0.5 * ( hw*wx - hz*wy + hy*wz);
+			const vcp_real_accum ny = qy + dt * 0.5 * ( hz*wx + hw*wy - hx*wz);
+			const vcp_real_accum nz = qz + dt * 0.5 * (-hy*wx + hx*wy + hw*wz);
+			const vcp_real_accum qcorr = 1.0 / std::sqrt(nw*nw + nx*nx + ny*ny + nz*nz);
+
+			soa_q_w[i] = nw * qcorr;
+			soa_q_x[i] = nx * qcorr;
+			soa_q_y[i] = ny * qcorr;
+			soa_q_z[i] = nz * qcorr;
+		}
+	}
+
 	vcp_real_calc _timeStep;
+	vcp_real_accum _invI[3];
+	bool _detectLeavingMolecules;
 };
 
 #endif /* SRC_INTEGRATORS_POSITIONCELLPROCESSORRMM_H_ */
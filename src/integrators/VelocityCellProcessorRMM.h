@@ -12,13 +12,16 @@
 #include "particleContainer/ParticleCell.h"
 #include "particleContainer/adapter/CellProcessor.h"
 #include "particleContainer/adapter/vectorization/SIMD_VectorizedCellProcessorHelpers.h"
+#include "molecules/Molecule.h"
+#include "molecules/Component.h"
+#include "PositionCellProcessorRMM.h"
 
-// just compute summv2 in a vectorized fashion in RMM
+// just compute summv2 (and sumIw2 for multi-site molecules) in a vectorized fashion in RMM
 
 class VelocityCellProcessorRMM: public CellProcessor {
 public:
 	VelocityCellProcessorRMM() :
-			CellProcessor(0.0, 0.0), _N(0), _summv2(0.0) {
+			CellProcessor(0.0, 0.0), _N(0), _summv2(0.0), _sumIw2(0.0) {
 
 		_threadData.resize(mardyn_get_max_threads());
 
@@ -56,6 +59,17 @@ public:
 		{
 			_N = 0;
 			_summv2 = 0.0;
+			_sumIw2 = 0.0;
+
+			const Component * component = MoleculeRMM::getStaticRMMComponent();
+			_mass = component->m();
+			_invI[0] = _invI[1] = _invI[2] = 0.0;
+			if (MoleculeRMM::isMultiSite()) {
+				const double I[3] = {component->I11(), component->I22(), component->I33()};
+				for (int d = 0; d < 3; ++d) {
+					_invI[d] = I[d] != 0.0 ? static_cast<vcp_real_accum>(1.0 / I[d]) : 0.0;
+				}
+			}
 		} // end pragma omp master
 
 		global_log->debug() << "VelocityCellProcessorRMM::initTraversal()." << std::endl;
@@ -63,10 +77,11 @@ public:
 
 	void endTraversal() {
 		vcp_real_accum glob_summv2 = 0.0;
+		vcp_real_accum glob_sumIw2 = 0.0;
 		unsigned long glob_N = 0;
 
 		#if defined(_OPENMP)
-		#pragma omp parallel reduction(+:glob_summv2, glob_N)
+		#pragma omp parallel reduction(+:glob_summv2, glob_sumIw2, glob_N)
 		#endif
 		{
 			const int tid = mardyn_get_thread_num();
@@ -78,11 +93,14 @@ public:
 
 			// add to global sum
 			glob_summv2 += thread_summv2;
+			glob_sumIw2 += _threadData[tid]->_thread_sumIw2;
 			glob_N += _threadData[tid]->_thread_N;
+			_threadData[tid]->_thread_sumIw2 = 0.0;
 			_threadData[tid]->_thread_N = 0;
 		} // end pragma omp parallel reduction
 
-		_summv2 = glob_summv2;
+		_summv2 = _mass * glob_summv2;
+		_sumIw2 = glob_sumIw2;
 		_N = glob_N;
 	}
 
@@ -125,6 +143,10 @@ public:
 			sum_summv2 = sum_summv2 + v2;
 		}
 		sum_summv2.aligned_load_add_store(&(my_threadData._thread_summv2V[0]));
+
+		if (soa.isRotational()) {
+			my_threadData._thread_sumIw2 += sumIw2(soa);
+		}
 	}
 
 	class ThreadData {
@@ -135,10 +157,12 @@ public:
 			for (size_t j = 0; j < VCP_VEC_SIZE; ++j) {
 				_thread_summv2V[j] = 0.0;
 			}
+			_thread_sumIw2 = 0.0;
 			_thread_N = 0;
 		}
 
 		AlignedArray<vcp_real_accum> _thread_summv2V;
+		vcp_real_accum _thread_sumIw2;
 		unsigned long _thread_N;
 	};
 
@@ -149,9 +173,43 @@ public:
 	double getSummv2() const {
 		return _summv2;
 	}
+
+	double getSumIw2() const {
+		return _sumIw2;
+	}
 private:
+	// rotational kinetic energy (times two) of the molecules of soa
+	vcp_real_accum sumIw2(const CellDataSoARMM & soa) const {
+		const size_t molNum = soa.getMolNum();
+
+		const vcp_real_accum * const soa_q_w = soa.q_wBegin();
+		const vcp_real_accum * const soa_q_x = soa.q_xBegin();
+		const vcp_real_accum * const soa_q_y = soa.q_yBegin();
+		const vcp_real_accum * const soa_q_z = soa.q_zBegin();
+		const vcp_real_accum * const soa_D_x = soa.D_xBegin();
+		const vcp_real_accum * const soa_D_y = soa.D_yBegin();
+		const vcp_real_accum * const soa_D_z = soa.D_zBegin();
+
+		const vcp_real_accum invI_x = _invI[0], invI_y = _invI[1], invI_z = _invI[2];
+
+		vcp_real_accum sum = 0.0;
+		#if defined(_OPENMP)
+		#pragma omp simd reduction(+:sum)
+		#endif
+		for (size_t i = 0; i < molNum; ++i) {
+			vcp_real_accum Dx, Dy, Dz;
+			PositionCellProcessorRMM::rotateinv(soa_q_w[i], soa_q_x[i], soa_q_y[i], soa_q_z[i],
+					soa_D_x[i], soa_D_y[i], soa_D_z[i], Dx, Dy, Dz);
+			sum += Dx * Dx * invI_x + Dy * Dy * invI_y + Dz * Dz * invI_z;
+		}
+		return sum;
+	}
+
 	unsigned long _N;
 	double _summv2;
+	double _sumIw2;
+	double _mass;
+	vcp_real_accum _invI[3];
 	std::vector<ThreadData *> _threadData;
 };
 
@@ -0,0 +1,151 @@
+/**
+ * \file
+ * \brief LeapfrogRMMTest.cpp
+ */
+
+#include "LeapfrogRMMTest.h"
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <sstream>
+
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "molecules/Component.h"
+#include "molecules/Quaternion.h"
+
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+#include "integrators/PositionCellProcessorRMM.h"
+#include "integrators/VelocityCellProcessorRMM.h"
+
+TEST_SUITE_REGISTRATION(LeapfrogRMMTest);
+#else
+#pragma message "Compilation info: LeapfrogRMMTest is not executed in non-RMM mode."
+#endif
+
+LeapfrogRMMTest::LeapfrogRMMTest() {
+}
+
+LeapfrogRMMTest::~LeapfrogRMMTest() {
+}
+
+void LeapfrogRMMTest::testPositionCellProcessorRMM() {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "LeapfrogRMMTest::testPositionCellProcessorRMM()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	// positions are stored in vcp_real_calc, orientations and angular momenta in vcp_real_accum
+	const double ToleranceR = sizeof(vcp_real_calc) == sizeof(float) ? 1e-4 : 1e-12;
+	const double ToleranceQ = sizeof(vcp_real_accum) == sizeof(float) ? 1e-5 : 1e-12;
+	const double dt = 0.5;
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, "VectorizationLennardJones.inp", 35.0);
+	ASSERT_TRUE(MoleculeRMM::isMultiSite());
+	const Component& component = *MoleculeRMM::getStaticRMMComponent();
+	const double invI[3] = {1.0 / component.I11(), 1.0 / component.I22(), component.I33() != 0.0 ? 1.0 / component.I33() : 0.0};
+
+	// expected position and orientation per molecule ID
+	std::map<unsigned long, std::array<double, 7> > expected;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		std::array<double, 7>& e = expected[m->getID()];
+		for (int d = 0; d < 3; ++d) {
+			e[d] = m->r(d) + dt * m->v(d);
+		}
+
+		// FullMolecule::upd_preF() with the angular momentum D of both half steps
+		const Quaternion q = m->q();
+		const std::array<double, 3> D = {{m->D(0), m->D(1), m->D(2)}};
+		std::array<double, 3> w = q.rotateinv(D);
+		for (int d = 0; d < 3; ++d) {
+			w[d] *= invI[d];
+		}
+		Quaternion qhalfstep;
+		q.differentiate(w, qhalfstep);
+		qhalfstep.scale(0.5 * dt);
+		qhalfstep.add(q);
+		qhalfstep.normalize();
+		w = qhalfstep.rotateinv(D);
+		for (int d = 0; d < 3; ++d) {
+			w[d] *= invI[d];
+		}
+		Quaternion qincr;
+		qhalfstep.differentiate(w, qincr);
+		qincr.scale(dt);
+		Quaternion qnew = q;
+		qnew.add(qincr);
+		qnew.normalize();
+		e[3] = qnew.qw();
+		e[4] = qnew.qx();
+		e[5] = qnew.qy();
+		e[6] = qnew.qz();
+
+		// the molecules have to rotate noticeably
+		ASSERT_TRUE(std::abs(qnew.qw() - q.qw()) + std::abs(qnew.qx() - q.qx()) > 1e-6);
+	}
+
+	PositionCellProcessorRMM cellProc(dt);
+	container->traverseCellsIndependently(cellProc);
+
+	size_t numMolecules = 0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m, ++numMolecules) {
+		const std::array<double, 7>& e = expected[m->getID()];
+		const Quaternion& q = m->q();
+		const double actual[7] = {m->r(0), m->r(1), m->r(2), q.qw(), q.qx(), q.qy(), q.qz()};
+		for (int k = 0; k < 7; ++k) {
+			std::stringstream str;
+			str << "Molecule id=" << m->getID() << " r, q index=" << k << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), e[k], actual[k], k < 3 ? ToleranceR * std::abs(e[k]) : ToleranceQ);
+		}
+	}
+	ASSERT_EQUAL(expected.size(), numMolecules);
+
+	delete container;
+#endif /* ENABLE_REDUCED_MEMORY_MODE */
+}
+
+void LeapfrogRMMTest::testVelocityCellProcessorRMM() {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "LeapfrogRMMTest::testVelocityCellProcessorRMM()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	const double Tolerance = sizeof(vcp_real_accum) == sizeof(float) ? 1e-5 : 1e-12;
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, "VectorizationLennardJones.inp", 35.0);
+	ASSERT_TRUE(MoleculeRMM::isMultiSite());
+	const Component& component = *MoleculeRMM::getStaticRMMComponent();
+	const double mass = component.m();
+	const double I[3] = {component.I11(), component.I22(), component.I33()};
+	ASSERT_TRUE(std::abs(mass - 1.0) > 1e-3);
+
+	unsigned long N = 0;
+	double summv2 = 0.0, sumIw2 = 0.0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		++N;
+		const std::array<double, 3> D = {{m->D(0), m->D(1), m->D(2)}};
+		const std::array<double, 3> L = m->q().rotateinv(D);
+		for (int d = 0; d < 3; ++d) {
+			summv2 += mass * m->v(d) * m->v(d);
+			if (I[d] != 0.0) {
+				sumIw2 += L[d] * L[d] / I[d];
+			}
+		}
+	}
+	ASSERT_TRUE(sumIw2 > 0.0);
+
+	VelocityCellProcessorRMM cellProc;
+	container->traverseCellsIndependently(cellProc);
+
+	ASSERT_EQUAL(N, cellProc.getN());
+	ASSERT_DOUBLES_EQUAL(summv2, cellProc.getSummv2(), Tolerance * summv2);
+	ASSERT_DOUBLES_EQUAL(sumIw2, cellProc.getSumIw2(), Tolerance * sumIw2);
+
+	delete container;
+#endif /* ENABLE_REDUCED_MEMORY_MODE */
+}
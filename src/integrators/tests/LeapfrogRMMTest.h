@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \brief LeapfrogRMMTest.h
+ */
+
+#ifndef SRC_INTEGRATORS_TESTS_LEAPFROGRMMTEST_H_
+#define SRC_INTEGRATORS_TESTS_LEAPFROGRMMTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+/**
+ * \brief Tests of the cell processors, which LeapfrogRMM applies to the SoAs of the reduced memory mode.
+ */
+class LeapfrogRMMTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(LeapfrogRMMTest);
+
+	TEST_METHOD(testPositionCellProcessorRMM);
+	TEST_METHOD(testVelocityCellProcessorRMM);
+
+	TEST_SUITE_END();
+
+public:
+	LeapfrogRMMTest();
+
+	virtual ~LeapfrogRMMTest();
+
+	/**
+	 * Moves and rotates the molecules of a 2CLJ input with PositionCellProcessorRMM and compares the
+	 * positions to r + dt * v and the orientations to the rotation of FullMolecule::upd_preF(), computed
+	 * with Quaternion, for angular momenta, which are already kicked by the force calculation.
+	 */
+	void testPositionCellProcessorRMM();
+
+	/**
+	 * Compares N, summv2 and sumIw2 of VelocityCellProcessorRMM for a 2CLJ input of a molecule mass
+	 * other than 1 to the sums over the molecules.
+	 */
+	void testVelocityCellProcessorRMM();
+
+};
+
+#endif /* SRC_INTEGRATORS_TESTS_LEAPFROGRMMTEST_H_ */
@@ -84,6 +84,9 @@ public:
             unsigned long simstep
     ) final;
 
+    bool requiresForcesBeforeIntegration() const override { return true; }
+    bool requiresHaloMolecules() const override { return true; }
+
     /** @brief
      *
      * Output the sampled cavity information from all ensembles to file.
@@ -35,6 +35,8 @@ public:
 			ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
 			unsigned long simstep);
 
+	bool requiresForcesBeforeIntegration() const override { return true; }
+
 	//! @brief will be called in each time step
 	//!
 	//! Most of the times, the output should either be done every time step or at least
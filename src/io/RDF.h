@@ -56,6 +56,9 @@ public:
 
 	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep);
 
+	bool requiresForcesBeforeIntegration() const override { return true; }
+	bool requiresHaloMolecules() const override { return true; }
+
 	void init(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain);
 
 	void finish(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain);
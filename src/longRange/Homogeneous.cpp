@@ -61,6 +61,8 @@ Homogeneous::Homogeneous(double cutoffRadius, double cutoffRadiusLJ, Domain* dom
 			unsigned int numljcentersj=cj.numLJcenters();
 			ParaStrm& params=_comp2params(i,j);
 			params.reset_read();
+			// component dependent LJ cutoff radius of this pair of components
+			const double rcLJ = Comp2Param::pairCutoffLJ(ci, cj, cutoffRadiusLJ);
 			// LJ centers
 			for(unsigned int si=0;si<numljcentersi;++si) {
 				double xi=ci.ljcenter(si).rx();
@@ -72,7 +74,7 @@ Homogeneous::Homogeneous(double cutoffRadius, double cutoffRadiusLJ, Domain* dom
 					double yj=cj.ljcenter(sj).ry();
 					double zj=cj.ljcenter(sj).rz();
 					double tau2=sqrt(xj*xj+yj*yj+zj*zj);
-					if(tau1+tau2>=cutoffRadiusLJ){
+					if(tau1+tau2>=rcLJ){
 						global_log->error() << "Error calculating cutoff corrections, rc too small" << endl;
 						Simulation::exit(1);
 					}
@@ -87,21 +89,21 @@ Homogeneous::Homogeneous(double cutoffRadius, double cutoffRadiusLJ, Domain* dom
 						double fac=double(ci.getNumMolecules())*double(cj.getNumMolecules())*eps24;
 						if(tau1==0. && tau2==0.)
 						{
-							UpotCorrLJ+=fac*(this->_TICCu(-6,cutoffRadiusLJ,sig2)-this->_TICCu(-3,cutoffRadiusLJ,sig2));
-							VirialCorrLJ+=fac*(this->_TICCv(-6,cutoffRadiusLJ,sig2)- this->_TICCv(-3,cutoffRadiusLJ,sig2));
+							UpotCorrLJ+=fac*(this->_TICCu(-6,rcLJ,sig2)-this->_TICCu(-3,rcLJ,sig2));
+							VirialCorrLJ+=fac*(this->_TICCv(-6,rcLJ,sig2)- this->_TICCv(-3,rcLJ,sig2));
 						}
 						else if(tau1!=0. && tau2!=0.)
 						{
-							UpotCorrLJ += fac*( this->_TISSu(-6,cutoffRadiusLJ,sig2,tau1,tau2)
-									- this->_TISSu(-3,cutoffRadiusLJ,sig2,tau1,tau2) );
-							VirialCorrLJ += fac*( this->_TISSv(-6,cutoffRadiusLJ,sig2,tau1,tau2)
-									- this->_TISSv(-3,cutoffRadiusLJ,sig2,tau1,tau2) );
+							UpotCorrLJ += fac*( this->_TISSu(-6,rcLJ,sig2,tau1,tau2)
+									- this->_TISSu(-3,rcLJ,sig2,tau1,tau2) );
+							VirialCorrLJ += fac*( this->_TISSv(-6,rcLJ,sig2,tau1,tau2)
+									- this->_TISSv(-3,rcLJ,sig2,tau1,tau2) );
 						}
 						else {
 							if(tau2==0.) 
 								tau2=tau1;
-							UpotCorrLJ+=fac*(this->_TICSu(-6,cutoffRadiusLJ,sig2,tau2)-this->_TICSu(-3,cutoffRadiusLJ,sig2,tau2));
-							VirialCorrLJ+=fac*(this->_TICSv(-6,cutoffRadiusLJ,sig2,tau2)-this->_TICSv(-3,cutoffRadiusLJ,sig2,tau2));
+							UpotCorrLJ+=fac*(this->_TICSu(-6,rcLJ,sig2,tau2)-this->_TICSu(-3,rcLJ,sig2,tau2));
+							VirialCorrLJ+=fac*(this->_TICSv(-6,rcLJ,sig2,tau2)-this->_TICSv(-3,rcLJ,sig2,tau2));
 						}
 					}
 				}
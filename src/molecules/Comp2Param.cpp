@@ -50,6 +50,7 @@ void Comp2Param::initialize(
 			global_log->info() << "cid+1(compi)=" << compi+1 << " <--> cid+1(compj)=" << compj+1 << ": xi=" << xi << ", eta=" << eta << endl;
 #endif
 			double shift6combined, sigperrc2, sigperrc6;
+			const double rcLJij = pairCutoffLJ(components[compi], components[compj], rcLJ);
 			for (unsigned int centeri = 0; centeri < nci; ++centeri) {
 				const LJcenter& ljcenteri = static_cast<const LJcenter&>(components[compi].ljcenter(centeri));
 				epsi = ljcenteri.eps();
@@ -61,7 +62,7 @@ void Comp2Param::initialize(
 					epsilon24 = 24. * xi * sqrt(epsi * epsj);
 					sigma2 = eta * .5 * (sigi + sigj);
 					sigma2 *= sigma2;
-					sigperrc2 = sigma2 / (rcLJ * rcLJ);
+					sigperrc2 = sigma2 / (rcLJij * rcLJij);
 					sigperrc6 = sigperrc2 * sigperrc2 * sigperrc2;
 					shift6combined = epsilon24 * (sigperrc6 - sigperrc6 * sigperrc6);
 					pstrmij << epsilon24;
@@ -84,7 +85,7 @@ void Comp2Param::initialize(
 					epsilon24 = 24. * xi * sqrt(epsi * epsj);
 					sigma2 = eta * .5 * (sigi + sigj);
 					sigma2 *= sigma2;
-					sigperrc2 = sigma2 / (rcLJ * rcLJ);
+					sigperrc2 = sigma2 / (rcLJij * rcLJij);
 					sigperrc6 = sigperrc2 * sigperrc2 * sigperrc2;
 					shift6combined = epsilon24 * (sigperrc6 - sigperrc6 * sigperrc6);
 					pstrmji << epsilon24;
@@ -8,6 +8,27 @@
 #include "molecules/ParaStrm.h"
 
 
+/** @brief Smooth truncation of the LJ potential between the LJ centers of two components.
+ *
+ * Without one, pairs use the LJ potential truncated at the cutoff radius (and shifted, see LJcenter).
+ * Force-shifted: U(r) - U(rc) - (r - rc) U'(rc), switched: S(r) U(r) with the switching function
+ * S = (rc^2 - r^2)^2 (rc^2 + 2 r^2 - 3 rs^2) / (rc^2 - rs^2)^3 between rs and rc.
+ * Only supported by the vectorized cell processor.
+ */
+struct LJTruncation {
+	enum Type {
+		FORCE_SHIFTED, SWITCHED
+	};
+	Type type;
+	bool allPairs;          /**< applies to all pairs of components */
+	unsigned int cid1, cid2;  /**< component IDs (starting at 0) */
+	double radiusSwitch;    /**< inner radius rs of the switching function */
+
+	bool appliesTo(unsigned int ci, unsigned int cj) const {
+		return allPairs or (ci == cid1 and cj == cid2) or (ci == cid2 and cj == cid1);
+	}
+};
+
 /** Comp2Param provides a flexible hash table interface to interaction parameter streams.
  *
  * @author Martin Bernreuther <bernreuther@hlrs.de> et al. (2010)
@@ -40,6 +61,17 @@ class Comp2Param {
          */
         void initialize(const std::vector<Component>& components, const std::vector<double>& mixcoeff, double epsRF, double rc, double rcLJ);
 
+        /** @brief LJ cutoff radius for the pairs of molecules of the components ci and cj.
+         *
+         *   This is the larger one of the LJ cutoff radii of the two components,
+         *   where a component without its own LJ cutoff radius uses rcLJ.
+         */
+        static double pairCutoffLJ(const Component& ci, const Component& cj, double rcLJ) {
+            const double rci = ci.getLJCutoffRadius() > 0. ? ci.getLJCutoffRadius() : rcLJ;
+            const double rcj = cj.getLJCutoffRadius() > 0. ? cj.getLJCutoffRadius() : rcLJ;
+            return rci > rcj ? rci : rcj;
+        }
+
     private:
         unsigned int m_numcomp;  /**< number of components */
 
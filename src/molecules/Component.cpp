@@ -21,6 +21,7 @@ Component::Component(unsigned int id) {
 	_E_trans=0.;
 	_lookUpID = 0;
 	_E_rot=0.;
+	_ljCutoffRadius = 0.;
 
 	_ljcenters = vector<LJcenter> ();
 	_charges = vector<Charge> ();
@@ -133,6 +133,11 @@ public:
 		_lookUpID = lookUpId;
 	}
 
+	/** set the LJ cutoff radius of the molecules of this component, 0 for the global LJ cutoff radius */
+	void setLJCutoffRadius(double rcLJ) { _ljCutoffRadius = rcLJ; }
+	/** get the LJ cutoff radius of the molecules of this component, 0 for the global LJ cutoff radius */
+	double getLJCutoffRadius() const { return _ljCutoffRadius; }
+
 private:
 
 	void updateMassInertia(Site& site);
@@ -160,6 +165,8 @@ private:
 	double _E_rot; // rotational energy
 	double _T; // temperature
 
+	double _ljCutoffRadius; /**< LJ cutoff radius of this component, 0: the global LJ cutoff radius */
+
 	std::string _name; /**< name of the component/molecule type */
 
 	/**
@@ -721,50 +721,52 @@ void FullMolecule::setupSoACache(CellDataSoABase* const s, unsigned iLJ, unsigne
 
 	normalizeQuaternion();
 
-	unsigned ns = numLJcenters();
-	for (unsigned j = 0; j < ns; ++j) {
-		std::array<double, 3> centerPos = computeLJcenter_d(j);
-		centerPos[0] += _r[0];
-		centerPos[1] += _r[1];
-		centerPos[2] += _r[2];
+	setupSoACacheSites(*_soa, *_component, r_arr(), _q, _soa_index_lj, _soa_index_c, _soa_index_d, _soa_index_q);
+}
 
-		const unsigned ind = _soa_index_lj + j;
+void FullMolecule::setupSoACacheSites(CellDataSoA& soa, const Component& component,
+		const std::array<double, 3>& r, const Quaternion& q, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ) {
+	mardyn_assert(q.isNormalized());
+	const std::array<vcp_real_calc, 3> r_calc = convert_double_to_vcp_real_calc(r);
 
-		_soa->pushBackLJC(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), getComponentLookUpID() + j);
-	}
-	ns = numCharges();
+	unsigned ns = component.numLJcenters();
 	for (unsigned j = 0; j < ns; ++j) {
-		std::array<double, 3> centerPos = computeCharge_d(j);
-		centerPos[0] += _r[0];
-		centerPos[1] += _r[1];
-		centerPos[2] += _r[2];
+		std::array<double, 3> centerPos = q.rotate(component.ljcenter(j).r());
+		centerPos[0] += r[0];
+		centerPos[1] += r[1];
+		centerPos[2] += r[2];
 
-		const unsigned ind = _soa_index_c + j;
+		soa.pushBackLJC(iLJ + j, r_calc, convert_double_to_vcp_real_calc(centerPos), component.getLookUpId() + j);
+	}
+	ns = component.numCharges();
+	for (unsigned j = 0; j < ns; ++j) {
+		std::array<double, 3> centerPos = q.rotate(component.charge(j).r());
+		centerPos[0] += r[0];
+		centerPos[1] += r[1];
+		centerPos[2] += r[2];
 
-		_soa->pushBackCharge(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->charge(j).q());
+		soa.pushBackCharge(iC + j, r_calc, convert_double_to_vcp_real_calc(centerPos), component.charge(j).q());
 	}
-	ns = numDipoles();
+	ns = component.numDipoles();
 	for (unsigned j = 0; j < ns; ++j) {
-		std::array<double, 3> centerPos = computeDipole_d(j);
-		centerPos[0] += _r[0];
-		centerPos[1] += _r[1];
-		centerPos[2] += _r[2];
+		std::array<double, 3> centerPos = q.rotate(component.dipole(j).r());
+		centerPos[0] += r[0];
+		centerPos[1] += r[1];
+		centerPos[2] += r[2];
 
-		std::array<double,3> orientation = computeDipole_e(j);
-		const unsigned ind = _soa_index_d + j;
+		std::array<double,3> orientation = q.rotate(component.dipole(j).e());
 
-		_soa->pushBackDipole(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->dipole(j).absMy(), convert_double_to_vcp_real_calc(orientation));
+		soa.pushBackDipole(iD + j, r_calc, convert_double_to_vcp_real_calc(centerPos), component.dipole(j).absMy(), convert_double_to_vcp_real_calc(orientation));
 	}
-	ns = numQuadrupoles();
+	ns = component.numQuadrupoles();
 	for (unsigned j = 0; j < ns; ++j) {
-		std::array<double, 3> centerPos = computeQuadrupole_d(j);
-		centerPos[0] += _r[0];
-		centerPos[1] += _r[1];
-		centerPos[2] += _r[2];
+		std::array<double, 3> centerPos = q.rotate(component.quadrupole(j).r());
+		centerPos[0] += r[0];
+		centerPos[1] += r[1];
+		centerPos[2] += r[2];
 
-		std::array<double,3> orientation = computeQuadrupole_e(j);
-		const unsigned ind = _soa_index_q + j;
+		std::array<double,3> orientation = q.rotate(component.quadrupole(j).e());
 
-		_soa->pushBackQuadrupole(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->quadrupole(j).absQ(), convert_double_to_vcp_real_calc(orientation));
+		soa.pushBackQuadrupole(iQ + j, r_calc, convert_double_to_vcp_real_calc(centerPos), component.quadrupole(j).absQ(), convert_double_to_vcp_real_calc(orientation));
 	}
 }
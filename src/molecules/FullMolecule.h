@@ -12,7 +12,8 @@
 
 
 class Domain;
-class CellDataSoA;
+template<typename RealCalc, typename RealAccum> class CellDataSoAT;
+typedef CellDataSoAT<vcp_real_calc, vcp_real_accum> CellDataSoA;
 
 //! @brief FullMolecule modeled as LJ sphere with point polarities
 class FullMolecule : public MoleculeInterface {
@@ -123,6 +124,14 @@ public:
 	
 	void setupSoACache(CellDataSoABase * const s, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ);
 
+	/**
+	 * \brief Write the sites of a molecule of the given component with centre of mass r and orientation q
+	 * into soa, starting at the given site indices. q has to be normalized.
+	 * \details Used by setupSoACache() and for halo copies, which are not stored as molecules.
+	 */
+	static void setupSoACacheSites(CellDataSoA& soa, const Component& component,
+			const std::array<double, 3>& r, const Quaternion& q, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ);
+
 	void setSoA(CellDataSoABase * const s);
 	void setStartIndexSoA_LJ(unsigned i) {_soa_index_lj = i;}
 	void setStartIndexSoA_C(unsigned i) {_soa_index_c = i;}
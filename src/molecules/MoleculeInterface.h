@@ -13,7 +13,7 @@
 #include "molecules/Component.h"
 #include "molecules/Quaternion.h"
 #include "particleContainer/adapter/CellDataSoABase.h"
-#include "particleContainer/adapter/vectorization/SIMD_TYPES.h"
+#include "particleContainer/adapter/vectorization/SIMD_PRECISION.h"
 
 class MoleculeInterface {
 public:
@@ -15,7 +15,6 @@
 
 bool 			MoleculeRMM::_initCalled = false;
 Component * 	MoleculeRMM::_component;
-Quaternion 		MoleculeRMM::_quaternion;
 
 void MoleculeRMM::initStaticVars() {
 	if (not _initCalled) {
@@ -35,7 +34,6 @@ void MoleculeRMM::initStaticVars() {
 			// we are in some constructor and are not ready to initialise yet
 			return;
 		}
-		_quaternion = Quaternion(1.0, 0.0, 0.0, 0.0);
 		_initCalled = true;
 	}
 }
@@ -110,11 +108,75 @@ void MoleculeRMM::setF(unsigned short /*d*/, double /*F*/) {
 
 }
 
+const Quaternion& MoleculeRMM::q() const {
+	mardyn_assert(_state == STORAGE_SOA or _state == STORAGE_AOS);
+
+	if (_state == STORAGE_SOA and _soa->isRotational()) {
+		_q = _soa->getMolQ(_soa_index);
+	}
+	return _q;
+}
+
+void MoleculeRMM::setq(Quaternion q) {
+	mardyn_assert(_state == STORAGE_SOA or _state == STORAGE_AOS);
+
+	if (_state == STORAGE_AOS) {
+		_q = q;
+	} else if (_soa->isRotational()) {
+		_soa->setMolQ(_soa_index, q);
+	}
+}
+
+double MoleculeRMM::D(unsigned short d) const {
+	mardyn_assert(_state == STORAGE_SOA or _state == STORAGE_AOS);
+
+	if (_state == STORAGE_AOS) {
+		return _D[d];
+	} else {
+		return _soa->isRotational() ? _soa->getMolD(d, _soa_index) : 0.0;
+	}
+}
+
+void MoleculeRMM::setD(unsigned short d, double D) {
+	mardyn_assert(_state == STORAGE_SOA or _state == STORAGE_AOS);
+
+	if (_state == STORAGE_AOS) {
+		_D[d] = D;
+	} else if (_soa->isRotational()) {
+		_soa->setMolD(d, _soa_index, D);
+	}
+}
+
+double MoleculeRMM::U_rot_2() {
+	if (not isMultiSite()) {
+		return 0.0;
+	}
+	std::array<double, 3> w = q().rotateinv(D_arr());
+	double Iw2 = 0.;
+	for (unsigned short d = 0; d < 3; ++d) {
+		const double I = getI(d);
+		if (I != 0.) {
+			Iw2 += w[d] * w[d] / I;
+		}
+	}
+	return Iw2;
+}
+
 std::string MoleculeRMM::getWriteFormat(){
-	return std::string("IRV");
+	return isMultiSite() ? std::string("ICRVQD") : std::string("IRV");
 }
 
 void MoleculeRMM::write(std::ostream& ostrm) const {
+	if (isMultiSite()) {
+		const Quaternion& quat = q();
+		ostrm << getID() << "\t" << (_component->ID() + 1) << "\t"
+			  << r(0) << " " << r(1) << " " << r(2) << "\t"
+			  << v(0) << " " << v(1) << " " << v(2) << "\t"
+			  << quat.qw() << " " << quat.qx() << " " << quat.qy() << " " << quat.qz() << "\t"
+			  << D(0) << " " << D(1) << " " << D(2) << "\t"
+			  << endl;
+		return;
+	}
 	ostrm << getID() << "\t"
 		  << r(0) << " " << r(1) << " " << r(2) << "\t"
 		  << v(0) << " " << v(1) << " " << v(2) << "\t"
@@ -21,9 +21,9 @@ public:
 	MoleculeRMM(unsigned long id = 0, Component *component = nullptr,
         double rx = 0., double ry = 0., double rz = 0.,
         double vx = 0., double vy = 0., double vz = 0.,
-        double = 0., double = 0., double = 0., double = 0., /*q0, q1, q2, q3*/
-        double = 0., double = 0., double = 0. /*Dx, Dy, Dz*/
-	) {
+        double q0 = 1., double q1 = 0., double q2 = 0., double q3 = 0.,
+        double Dx = 0., double Dy = 0., double Dz = 0.
+	) : _q(q0, q1, q2, q3) {
 		_state = STORAGE_AOS;
 		_r[0] = rx;
 		_r[1] = ry;
@@ -31,13 +31,15 @@ public:
 		_v[0] = vx;
 		_v[1] = vy;
 		_v[2] = vz;
+		_D[0] = Dx;
+		_D[1] = Dy;
+		_D[2] = Dz;
 		_id = id;
 		_soa = nullptr;
 		_soa_index = 0;
 
 		if(component != nullptr) {
 			_component = component;
-			_quaternion = Quaternion(1.0, 0.0, 0.0, 0.0);
 			_initCalled = true;
 		} else if(not _initCalled) {
 			initStaticVars();
@@ -50,14 +52,17 @@ public:
 		for (int d = 0; d < 3; ++d) {
 			setr(d, other.r(d));
 			setv(d, other.v(d));
+			setD(d, other.D(d));
 		}
+		_q = other.q();
 		_id = other.getID();
 		_soa = nullptr;
 		_soa_index = 0;
 	}
 
-	MoleculeRMM(CellDataSoARMM * soa, size_t index) {
+	MoleculeRMM(CellDataSoARMM * soa, size_t index) : _q(1.0, 0.0, 0.0, 0.0) {
 		_state = STORAGE_SOA;
+		_D[0] = _D[1] = _D[2] = 0.0;
 		_soa = soa;
 		_soa_index = index;
 
@@ -95,17 +100,11 @@ public:
 	double F(unsigned short d) const { return v(d);}
 #endif
 
-	const Quaternion& q() const {
-		return _quaternion;
-	}
+	const Quaternion& q() const;
 
-	void setq(Quaternion q) {
-		_quaternion = q;
-	}
+	void setq(Quaternion q);
 
-	double D(unsigned short /*d*/) const {
-		return 0.0;
-	}
+	double D(unsigned short d) const;
 	double M(unsigned short /*d*/) const {
 		return 0.0;
 	}
@@ -113,28 +112,25 @@ public:
 		return 0.0;
 	}
 
-	void setD(unsigned short /*d*/, double /*D*/) {}
+	void setD(unsigned short d, double D);
 
 	inline void move(int d, double dr) {
 		setr(d, r(d) + dr);
 	}
 
-	double getI(unsigned short /*d*/) const {
-		mardyn_assert(false);
-		// TODO: check values for single-centered molecules
-		return 0.0;
+	double getI(unsigned short d) const {
+		mardyn_assert(d < 3);
+		return d == 0 ? _component->I11() : (d == 1 ? _component->I22() : _component->I33());
 	}
 
 	void updateMassInertia() {}
 
 
 	double U_rot() {
-		return 0.;
+		return 0.5 * U_rot_2();
 	}
 
-	double U_rot_2() override {
-		return 0.;
-	}
+	double U_rot_2() override;
 
 	void setupSoACache(CellDataSoABase * const s, unsigned iLJ, unsigned /*iC*/, unsigned /*iD*/, unsigned /*iQ*/) {
 		mardyn_assert(false);
@@ -159,16 +155,16 @@ public:
 	}
 
 	unsigned int numSites() const {
-		return 1;
+		return numLJcenters() + numCharges();
 	}
 	unsigned int numOrientedSites() const {
 		return 0;
 	}
 	unsigned int numLJcenters() const {
-		return 1;
+		return _component->numLJcenters();
 	}
 	unsigned int numCharges() const {
-		return 0;
+		return _component->numCharges();
 	}
 	unsigned int numDipoles() const {
 		return 0;
@@ -177,19 +173,18 @@ public:
 		return 0;
 	}
 
-	std::array<double, 3> site_d(unsigned int /*i*/) const { return emptyArray3(); }
+	std::array<double, 3> site_d(unsigned int i) const {
+		return i < numLJcenters() ? ljcenter_d(i) : charge_d(i - numLJcenters());
+	}
 
-	std::array<double, 3> ljcenter_d(unsigned int i) const { return emptyArray3(); }
-	std::array<double, 3> charge_d(unsigned int /*i*/) const { return emptyArray3(); }
+	std::array<double, 3> ljcenter_d(unsigned int i) const { return q().rotate(_component->ljcenter(i).r()); }
+	std::array<double, 3> charge_d(unsigned int i) const { return q().rotate(_component->charge(i).r()); }
 	std::array<double, 3> dipole_d(unsigned int /*i*/) const { return emptyArray3(); }
 	std::array<double, 3> quadrupole_d(unsigned int /*i*/) const { return emptyArray3(); }
 
-	std::array<double, 3> site_d_abs(unsigned int i) const { return ljcenter_d_abs(i); }
-	std::array<double, 3> ljcenter_d_abs(unsigned int i) const {
-		mardyn_assert(i == 0);
-		return r_arr();
-	}
-	std::array<double, 3> charge_d_abs(unsigned int /*i*/) const { return emptyArray3(); }
+	std::array<double, 3> site_d_abs(unsigned int i) const { return addArrays(r_arr(), site_d(i)); }
+	std::array<double, 3> ljcenter_d_abs(unsigned int i) const { return addArrays(r_arr(), ljcenter_d(i)); }
+	std::array<double, 3> charge_d_abs(unsigned int i) const { return addArrays(r_arr(), charge_d(i)); }
 	std::array<double, 3> dipole_d_abs(unsigned int /*i*/) const { return emptyArray3(); }
 	std::array<double, 3> quadrupole_d_abs(unsigned int /*i*/) const { return emptyArray3(); }
 
@@ -202,9 +197,13 @@ public:
 	std::array<double, 3> dipole_F(unsigned int /*i*/) const { return emptyArray3(); }
 	std::array<double, 3> quadrupole_F(unsigned int /*i*/) const { return emptyArray3(); }
 
-	void normalizeQuaternion() {}
-	std::array<double, 3> computeLJcenter_d(unsigned int /*i*/) const { return emptyArray3(); }
-	std::array<double, 3> computeCharge_d(unsigned int /*i*/) const { return emptyArray3(); }
+	void normalizeQuaternion() {
+		Quaternion qn = q();
+		qn.normalize();
+		setq(qn);
+	}
+	std::array<double, 3> computeLJcenter_d(unsigned int i) const { return ljcenter_d(i); }
+	std::array<double, 3> computeCharge_d(unsigned int i) const { return charge_d(i); }
 	std::array<double, 3> computeDipole_d(unsigned int /*i*/) const { return emptyArray3(); }
 	std::array<double, 3> computeQuadrupole_d(unsigned int /*i*/) const { return emptyArray3(); }
 	std::array<double, 3> computeDipole_e(unsigned int /*i*/) const { return emptyArray3(); }
@@ -232,21 +231,32 @@ public:
 #ifndef DEBUG_FUNCTIONALITY_HACKS
 	void Fljcenteradd(unsigned int /*i*/, double /*a*/[]) {}
 	void Fljcentersub(unsigned int /*i*/, double /*a*/[]) {}
+	void Fchargeadd(unsigned int /*i*/, double /*a*/[]) {}
+	void Fchargesub(unsigned int /*i*/, double /*a*/[]) {}
 #else
+	// site forces are summed up into the velocity
 	void Fljcenteradd(unsigned int i, double a[]) {
-		mardyn_assert(i == 0);
+		mardyn_assert(i < numLJcenters());
 		for(int d = 0; d < 3; ++d)
 			setv(d, v(d) + a[d]);
 	}
 	void Fljcentersub(unsigned int i, double a[]) {
-		mardyn_assert(i == 0);
+		mardyn_assert(i < numLJcenters());
+		for(int d = 0; d < 3; ++d)
+			setv(d, v(d) - a[d]);
+	}
+	void Fchargeadd(unsigned int i, double a[]) {
+		mardyn_assert(i < numCharges());
+		for(int d = 0; d < 3; ++d)
+			setv(d, v(d) + a[d]);
+	}
+	void Fchargesub(unsigned int i, double a[]) {
+		mardyn_assert(i < numCharges());
 		for(int d = 0; d < 3; ++d)
 			setv(d, v(d) - a[d]);
 	}
 #endif
 
-	void Fchargeadd(unsigned int /*i*/, double /*a*/[]) {}
-	void Fchargesub(unsigned int /*i*/, double /*a*/[]) {}
 	void Fdipoleadd(unsigned int /*i*/, double /*a*/[]) {}
 	void Fdipolesub(unsigned int /*i*/, double /*a*/[]) {}
 	void Fquadrupoleadd(unsigned int /*i*/, double /*a*/[]) {}
@@ -257,14 +267,16 @@ public:
 	void upd_postF(double /*dt_halve*/, double& /*summv2*/, double& /*sumIw2*/) {
 		mardyn_assert(false);
 	}
-	void calculate_mv2_Iw2(double& summv2, double& /*sumIw2*/) {
+	void calculate_mv2_Iw2(double& summv2, double& sumIw2) {
 		summv2 += _component->m() * v2();
+		sumIw2 += U_rot_2();
 	}
-	void calculate_mv2_Iw2(double& summv2, double& /*sumIw2*/, double offx, double offy, double offz) {
-		double vcx = _v[0] - offx;
-		double vcy = _v[1] - offy;
-		double vcz = _v[2] - offz;
+	void calculate_mv2_Iw2(double& summv2, double& sumIw2, double offx, double offy, double offz) {
+		double vcx = v(0) - offx;
+		double vcy = v(1) - offy;
+		double vcz = v(2) - offz;
 		summv2 += _component->m() * (vcx*vcx + vcy*vcy + vcz*vcz);
+		sumIw2 += U_rot_2();
 	}
 	static std::string getWriteFormat();
 	void write(std::ostream& /*ostrm*/) const;
@@ -277,6 +289,17 @@ public:
 		return _component;
 	}
 
+	/**
+	 * \brief Whether the RMM component is a rigid body of several LJ centers and charges.
+	 * Only then the quaternion and the angular momentum are stored and integrated.
+	 */
+	static bool isMultiSite() {
+		if (not _initCalled) {
+			initStaticVars();
+		}
+		return _component != nullptr and _component->numSites() > 1;
+	}
+
 	void setStorageState(StorageState s) {
 		_state = s;
 	}
@@ -294,6 +317,12 @@ public:
 	}
 
 private:
+	static std::array<double, 3> addArrays(const std::array<double, 3>& a, const std::array<double, 3>& b) {
+		std::array<double, 3> ret;
+		ret[0] = a[0] + b[0]; ret[1] = a[1] + b[1]; ret[2] = a[2] + b[2];
+		return ret;
+	}
+
 	static std::array<double, 3> emptyArray3() {
 		//mardyn_assert(false);
 		std::array<double, 3> ret;
@@ -304,7 +333,6 @@ private:
 	static void initStaticVars();
 
     static Component *_component;  /**< IDentification number of its component type */
-    static Quaternion _quaternion;
     static bool _initCalled;
 
     StorageState _state;
@@ -313,6 +341,8 @@ private:
     vcp_real_calc _r[3];  /**< position coordinates */
     vcp_real_accum _v[3];  /**< velocity */
     unsigned long _id;
+    mutable Quaternion _q;  /**< orientation, only used for multi-site components */
+    vcp_real_accum _D[3];  /**< angular momentum, only used for multi-site components */
 
 	// if the state is SOA, the values are read from the SoA:
 	CellDataSoARMM * _soa;
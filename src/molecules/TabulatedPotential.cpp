@@ -0,0 +1,243 @@
+#include "molecules/TabulatedPotential.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "Simulation.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include "utils/xmlfileUnits.h"
+
+using namespace std;
+using Log::global_log;
+
+TabulatedPotential::TabulatedPotential() :
+		_type(MIE), _cid1(0), _cid2(0), _rmin(0.), _nodes(1000), _shifted(true),
+		_epsilonC(0.), _sigma(0.), _n(0.), _m(0.), _A(0.), _B(0.), _C(0.) {
+}
+
+void TabulatedPotential::readXML(XMLfileUnits& xmlconfig) {
+	string type;
+	xmlconfig.getNodeValue("@type", type);
+	unsigned cid1 = 0, cid2 = 0;
+	xmlconfig.getNodeValue("@cid1", cid1);
+	xmlconfig.getNodeValue("@cid2", cid2);
+	if (cid1 < 1 or cid2 < 1) {
+		global_log->error() << "Tabulated potential: invalid component ids " << cid1 << ", " << cid2 << endl;
+		Simulation::exit(1);
+	}
+	_cid1 = cid1 - 1;
+	_cid2 = cid2 - 1;
+
+	if (type == "Mie") {
+		double epsilon = 0., sigma = 0., n = 12., m = 6.;
+		xmlconfig.getNodeValueReduced("epsilon", epsilon);
+		xmlconfig.getNodeValueReduced("sigma", sigma);
+		xmlconfig.getNodeValue("n", n);
+		xmlconfig.getNodeValue("m", m);
+		if (sigma <= 0. or m <= 0. or n <= m) {
+			global_log->error() << "Tabulated potential: Mie potential needs sigma > 0 and n > m > 0." << endl;
+			Simulation::exit(1);
+		}
+		setMie(_cid1, _cid2, epsilon, sigma, n, m);
+	} else if (type == "Buckingham") {
+		_type = BUCKINGHAM;
+		xmlconfig.getNodeValue("A", _A);
+		xmlconfig.getNodeValue("B", _B);
+		xmlconfig.getNodeValue("C", _C);
+		_rmin = 0.5;
+	} else if (type == "File") {
+		_type = FILE;
+		string filename;
+		xmlconfig.getNodeValue("filename", filename);
+		ifstream file(filename.c_str());
+		string line;
+		while (getline(file, line)) {
+			istringstream values(line);
+			double r, u;
+			if (line.empty() or line[0] == '#' or not (values >> r >> u)) {
+				continue;
+			}
+			if (not _fileR2.empty() and r * r <= _fileR2.back()) {
+				global_log->error() << "Tabulated potential: distances in " << filename << " must be ascending." << endl;
+				Simulation::exit(1);
+			}
+			_fileR2.push_back(r * r);
+			_fileU.push_back(u);
+		}
+		if (_fileR2.size() < 2) {
+			global_log->error() << "Tabulated potential: could not read at least two points from " << filename << endl;
+			Simulation::exit(1);
+		}
+		_rmin = sqrt(_fileR2.front());
+
+		// second derivatives of the natural cubic spline
+		const size_t num = _fileR2.size();
+		_fileU2.assign(num, 0.);
+		vector<double> tmp(num, 0.);
+		for (size_t i = 1; i < num - 1; ++i) {
+			const double sig = (_fileR2[i] - _fileR2[i - 1]) / (_fileR2[i + 1] - _fileR2[i - 1]);
+			const double p = sig * _fileU2[i - 1] + 2.;
+			_fileU2[i] = (sig - 1.) / p;
+			tmp[i] = (_fileU[i + 1] - _fileU[i]) / (_fileR2[i + 1] - _fileR2[i])
+					- (_fileU[i] - _fileU[i - 1]) / (_fileR2[i] - _fileR2[i - 1]);
+			tmp[i] = (6. * tmp[i] / (_fileR2[i + 1] - _fileR2[i - 1]) - sig * tmp[i - 1]) / p;
+		}
+		for (size_t k = num - 1; k-- > 0;) {
+			_fileU2[k] = _fileU2[k] * _fileU2[k + 1] + tmp[k];
+		}
+	} else {
+		global_log->error() << "Unknown tabulated potential " << type << ", choose Mie, Buckingham or File." << endl;
+		Simulation::exit(1);
+	}
+
+	xmlconfig.getNodeValueReduced("rmin", _rmin);
+	xmlconfig.getNodeValue("nodes", _nodes);
+	xmlconfig.getNodeValue("shifted", _shifted);
+	if (_rmin <= 0. or _nodes < 1) {
+		global_log->error() << "Tabulated potential: rmin and the number of nodes must be positive." << endl;
+		Simulation::exit(1);
+	}
+	global_log->info() << "Tabulated potential between components " << cid1 << " and " << cid2 << ": "
+			<< getDescription() << endl;
+}
+
+void TabulatedPotential::setMie(unsigned cid1, unsigned cid2, double epsilon, double sigma, double n, double m) {
+	_type = MIE;
+	_cid1 = cid1;
+	_cid2 = cid2;
+	_epsilonC = n / (n - m) * pow(n / m, m / (n - m)) * epsilon;
+	_sigma = sigma;
+	_n = n;
+	_m = m;
+	_rmin = 0.5 * sigma;
+}
+
+double TabulatedPotential::U(double r2) const {
+	switch (_type) {
+	case MIE: {
+		const double sr2 = _sigma * _sigma / r2;
+		return _epsilonC * (pow(sr2, 0.5 * _n) - pow(sr2, 0.5 * _m));
+	}
+	case BUCKINGHAM:
+		return _A * exp(-_B * sqrt(r2)) - _C / (r2 * r2 * r2);
+	case FILE: {
+		// natural cubic spline, continued linearly outside of the points
+		const size_t num = _fileR2.size();
+		if (r2 <= _fileR2.front()) {
+			return _fileU.front() + (r2 - _fileR2.front()) * dUdr2(_fileR2.front());
+		} else if (r2 >= _fileR2.back()) {
+			return _fileU.back() + (r2 - _fileR2.back()) * dUdr2(_fileR2.back());
+		}
+		size_t lo = 0, hi = num - 1;
+		while (hi - lo > 1) {
+			const size_t k = (hi + lo) / 2;
+			(_fileR2[k] > r2 ? hi : lo) = k;
+		}
+		const double h = _fileR2[hi] - _fileR2[lo];
+		const double a = (_fileR2[hi] - r2) / h;
+		const double b = (r2 - _fileR2[lo]) / h;
+		return a * _fileU[lo] + b * _fileU[hi] + ((a * a * a - a) * _fileU2[lo] + (b * b * b - b) * _fileU2[hi]) * h * h / 6.;
+	}
+	}
+	return 0.;
+}
+
+double TabulatedPotential::dUdr2(double r2) const {
+	switch (_type) {
+	case MIE: {
+		const double sr2 = _sigma * _sigma / r2;
+		return _epsilonC / r2 * (-0.5 * _n * pow(sr2, 0.5 * _n) + 0.5 * _m * pow(sr2, 0.5 * _m));
+	}
+	case BUCKINGHAM: {
+		const double r = sqrt(r2);
+		const double dUdr = -_A * _B * exp(-_B * r) + 6. * _C / (r2 * r2 * r2 * r);
+		return dUdr / (2. * r);
+	}
+	case FILE: {
+		const size_t num = _fileR2.size();
+		size_t lo = 0, hi = num - 1;
+		if (r2 <= _fileR2.front()) {
+			hi = 1;
+			r2 = _fileR2.front();
+		} else if (r2 >= _fileR2.back()) {
+			lo = num - 2;
+			r2 = _fileR2.back();
+		} else {
+			while (hi - lo > 1) {
+				const size_t k = (hi + lo) / 2;
+				(_fileR2[k] > r2 ? hi : lo) = k;
+			}
+		}
+		const double h = _fileR2[hi] - _fileR2[lo];
+		const double a = (_fileR2[hi] - r2) / h;
+		const double b = (r2 - _fileR2[lo]) / h;
+		return (_fileU[hi] - _fileU[lo]) / h
+				- (3. * a * a - 1.) / 6. * h * _fileU2[lo] + (3. * b * b - 1.) / 6. * h * _fileU2[hi];
+	}
+	}
+	return 0.;
+}
+
+void TabulatedPotential::tabulate(double rc, double rmax, vector<double>& coefficients, double& r2min, double& invDr2,
+		unsigned& intervals) const {
+	mardyn_assert(rmax >= rc);
+	r2min = _rmin * _rmin;
+	intervals = _nodes;
+	const double dr2 = (rmax * rmax - r2min) / intervals;
+	invDr2 = 1. / dr2;
+	const double shift = _shifted ? U(rc * rc) : 0.;
+
+	// cubic Hermite interpolation between the nodes, derivatives with respect to t
+	double u0 = U(r2min) - shift;
+	double d0 = dUdr2(r2min) * dr2;
+	for (unsigned k = 0; k < intervals; ++k) {
+		const double r2 = r2min + (k + 1) * dr2;
+		const double u1 = U(r2) - shift;
+		const double d1 = dUdr2(r2) * dr2;
+		coefficients.push_back(u0);
+		coefficients.push_back(d0);
+		coefficients.push_back(3. * (u1 - u0) - 2. * d0 - d1);
+		coefficients.push_back(2. * (u0 - u1) + d0 + d1);
+		u0 = u1;
+		d0 = d1;
+	}
+}
+
+void TabulatedPotential::evaluate(const double* coefficients, double r2min, double invDr2, unsigned intervals,
+		double r2, double& u, double& scale) {
+	const double x = (r2 - r2min) * invDr2;
+	if (x >= intervals) {
+		u = 0.;
+		scale = 0.;
+		return;
+	}
+	const unsigned k = x < 0. ? 0 : static_cast<unsigned>(x);
+	const double* c = coefficients + 4 * k;
+	const double t = x - k;
+	if (x < 0.) {
+		u = c[0] + t * c[1];
+		scale = -2. * c[1] * invDr2;
+	} else {
+		u = c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+		scale = -2. * (c[1] + t * (2. * c[2] + 3. * t * c[3])) * invDr2;
+	}
+}
+
+string TabulatedPotential::getDescription() const {
+	ostringstream description;
+	switch (_type) {
+	case MIE:
+		description << "Mie " << _n << "-" << _m << " (epsilon C = " << _epsilonC << ", sigma = " << _sigma << ")";
+		break;
+	case BUCKINGHAM:
+		description << "Buckingham (A = " << _A << ", B = " << _B << ", C = " << _C << ")";
+		break;
+	case FILE:
+		description << "from file (" << _fileR2.size() << " points)";
+		break;
+	}
+	description << ", " << _nodes << " intervals from r = " << _rmin << (_shifted ? ", shifted" : "");
+	return description.str();
+}
@@ -0,0 +1,90 @@
+#ifndef TABULATEDPOTENTIAL_H_
+#define TABULATEDPOTENTIAL_H_
+
+#include <string>
+#include <vector>
+
+class XMLfileUnits;
+
+/**
+ * @brief Pair potential between the LJ centers of two components, which replaces their LJ 12-6 potential.
+ * @details The potential is given analytically (Mie n-m or Buckingham exp-6) or by a file and tabulated
+ * as cubic Hermite spline on a uniform grid in r^2, which the vectorized cell processor evaluates.
+ * Below rmin, the spline continues linearly in r^2, beyond the cutoff radius the potential is zero.
+ *
+ * \code{.xml}
+   <tabulated type="Mie|Buckingham|File" cid1="INTEGER" cid2="INTEGER">
+     <!-- Mie n-m: U(r) = C eps ((sigma/r)^n - (sigma/r)^m), C = n/(n-m) (n/m)^(m/(n-m)) -->
+     <epsilon>DOUBLE</epsilon> <sigma>DOUBLE</sigma> <n>DOUBLE</n> <m>DOUBLE</m>
+     <!-- Buckingham: U(r) = A exp(-B r) - C / r^6 -->
+     <A>DOUBLE</A> <B>DOUBLE</B> <C>DOUBLE</C>
+     <!-- File: two columns r U(r), ascending in r -->
+     <filename>STRING</filename>
+     <rmin>DOUBLE</rmin>           <!-- smallest tabulated distance, default: 0.5 sigma, 0.5 or the first r of the file -->
+     <nodes>INTEGER</nodes>        <!-- number of intervals of the spline, default: 1000 -->
+     <shifted>BOOL</shifted>       <!-- shift the potential to zero at the cutoff radius, default: true -->
+   </tabulated>
+   \endcode
+ */
+class TabulatedPotential {
+public:
+	enum Type {
+		MIE, BUCKINGHAM, FILE
+	};
+
+	TabulatedPotential();
+
+	void readXML(XMLfileUnits& xmlconfig);
+
+	//! @brief set up a Mie n-m potential (without reading XML)
+	void setMie(unsigned cid1, unsigned cid2, double epsilon, double sigma, double n, double m);
+
+	//! @brief shift the potential to zero at the cutoff radius (default: true)
+	void setShifted(bool shifted) { _shifted = shifted; }
+
+	//! @brief number of intervals of the spline (default: 1000)
+	void setNodes(unsigned nodes) { _nodes = nodes; }
+
+	//! @brief component IDs (starting at 0) of the interacting components
+	unsigned getCid1() const { return _cid1; }
+	unsigned getCid2() const { return _cid2; }
+
+	//! @brief potential U(r^2) of the given function (not the tabulated one, not shifted)
+	double U(double r2) const;
+
+	//! @brief derivative dU/d(r^2) of the given function
+	double dUdr2(double r2) const;
+
+	/**
+	 * @brief Tabulate the potential, shifted at the cutoff radius rc, up to the radius rmax >= rc.
+	 * @details Appends four coefficients (a, b, c, d) per interval to coefficients, so that
+	 * U = a + t (b + t (c + t d)) with t = (r^2 - r2min) / dr2 - interval. Returns the grid of the table.
+	 * The cutoff applies to the centers of mass, so the LJ centers of multi-site molecules within rc
+	 * interact up to rc plus their distances from the centers of mass, which rmax has to cover.
+	 */
+	void tabulate(double rc, double rmax, std::vector<double>& coefficients, double& r2min, double& invDr2,
+			unsigned& intervals) const;
+
+	//! @brief Evaluate a table of tabulate() like the vectorized cell processor: potential and -2 dU/d(r^2).
+	static void evaluate(const double* coefficients, double r2min, double invDr2, unsigned intervals,
+			double r2, double& u, double& scale);
+
+	std::string getDescription() const;
+
+private:
+	Type _type;
+	unsigned _cid1, _cid2;
+
+	double _rmin;
+	unsigned _nodes;
+	bool _shifted;
+
+	// Mie
+	double _epsilonC, _sigma, _n, _m;
+	// Buckingham
+	double _A, _B, _C;
+	// File: natural cubic spline through the points (r^2, U)
+	std::vector<double> _fileR2, _fileU, _fileU2;
+};
+
+#endif /* TABULATEDPOTENTIAL_H_ */
@@ -0,0 +1,49 @@
+/*
+ * TabulatedPotentialTest.cpp
+ */
+
+#include "TabulatedPotentialTest.h"
+#include "molecules/TabulatedPotential.h"
+
+#include <cmath>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(TabulatedPotentialTest);
+
+TabulatedPotentialTest::TabulatedPotentialTest() {
+}
+
+TabulatedPotentialTest::~TabulatedPotentialTest() {
+}
+
+void TabulatedPotentialTest::testMieLennardJones() {
+	const double epsilon = 1.5, sigma = 1.2, rc = 3.0;
+	TabulatedPotential potential;
+	potential.setMie(0, 0, epsilon, sigma, 12., 6.);
+
+	std::vector<double> coefficients;
+	double r2min, invDr2;
+	unsigned intervals;
+	potential.tabulate(rc, rc, coefficients, r2min, invDr2, intervals);
+	ASSERT_EQUAL(static_cast<size_t>(4 * intervals), coefficients.size());
+
+	const double sr2c = sigma * sigma / (rc * rc);
+	const double shift = 4. * epsilon * (sr2c * sr2c * sr2c * sr2c * sr2c * sr2c - sr2c * sr2c * sr2c);
+	for (double r = 0.95 * sigma; r < rc; r += 0.01) {
+		const double sr2 = sigma * sigma / (r * r);
+		const double sr6 = sr2 * sr2 * sr2;
+		const double ljU = 4. * epsilon * (sr6 * sr6 - sr6) - shift;
+		const double ljScale = 24. * epsilon / (r * r) * (2. * sr6 * sr6 - sr6);
+
+		double u, scale;
+		TabulatedPotential::evaluate(&coefficients[0], r2min, invDr2, intervals, r * r, u, scale);
+		ASSERT_DOUBLES_EQUAL(ljU, u, 1e-5 * (1. + std::fabs(ljU)));
+		ASSERT_DOUBLES_EQUAL(ljScale, scale, 1e-3 * (1. + std::fabs(ljScale)));
+	}
+
+	// no interaction beyond the cutoff radius
+	double u, scale;
+	TabulatedPotential::evaluate(&coefficients[0], r2min, invDr2, intervals, 1.01 * rc * rc, u, scale);
+	ASSERT_DOUBLES_EQUAL(0., u, 1e-15);
+	ASSERT_DOUBLES_EQUAL(0., scale, 1e-15);
+}
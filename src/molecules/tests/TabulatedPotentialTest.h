@@ -0,0 +1,29 @@
+/*
+ * TabulatedPotentialTest.h
+ */
+
+#ifndef TABULATEDPOTENTIALTEST_H_
+#define TABULATEDPOTENTIALTEST_H_
+
+#include "utils/Testing.h"
+
+class TabulatedPotentialTest : public utils::Test {
+
+	TEST_SUITE(TabulatedPotentialTest);
+	TEST_METHOD(testMieLennardJones);
+	TEST_SUITE_END();
+
+public:
+
+	TabulatedPotentialTest();
+
+	virtual ~TabulatedPotentialTest();
+
+	/**
+	 * Tabulate a Mie 12-6 potential and compare the evaluated table with the shifted LJ 12-6 potential.
+	 */
+	void testMieLennardJones();
+
+};
+
+#endif /* TABULATEDPOTENTIALTEST_H_ */
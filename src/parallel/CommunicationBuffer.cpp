@@ -9,29 +9,47 @@
 #include "molecules/Molecule.h"
 #include "Simulation.h"
 #include "ensemble/EnsembleBase.h"
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+#include "particleContainer/adapter/CellDataSoARMM.h"
+#endif
 
 #include <climits> /* UINT64_MAX */
 
 #ifdef ENABLE_REDUCED_MEMORY_MODE
-// position, velocity, id
-size_t CommunicationBuffer::_numBytesLeaving = 6 * sizeof(vcp_real_calc) + sizeof(unsigned long);
-// position, id (for now)
-size_t CommunicationBuffer::_numBytesHalo = 3 * sizeof(vcp_real_calc)
+// multi-site molecules additionally carry their orientation (leaving and halo) and angular momentum (leaving)
+size_t CommunicationBuffer::numBytesLeaving() {
+	// position, velocity, id
+	const size_t numBytes = 6 * sizeof(vcp_real_calc) + sizeof(unsigned long);
+	return MoleculeRMM::isMultiSite() ? numBytes + 7 * sizeof(vcp_real_accum) : numBytes;
+}
+size_t CommunicationBuffer::numBytesHalo() {
+	// position, id (for now)
+	const size_t numBytes = 3 * sizeof(vcp_real_calc)
 	#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
 			+ sizeof(unsigned long)
 	#endif
 		;
-size_t CommunicationBuffer::_numBytesForces = sizeof(unsigned long) + 3 * sizeof(vcp_real_calc) + 3 * sizeof(vcp_real_accum);
+	return MoleculeRMM::isMultiSite() ? numBytes + 4 * sizeof(vcp_real_accum) : numBytes;
+}
+size_t CommunicationBuffer::numBytesForces() {
+	return sizeof(unsigned long) + 3 * sizeof(vcp_real_calc) + 3 * sizeof(vcp_real_accum);
+}
 #else
 // position, velocity, orientation, angular momentum, id, cid
-size_t CommunicationBuffer::_numBytesLeaving = 13 * sizeof(double) + sizeof(unsigned long) + sizeof(int);
+size_t CommunicationBuffer::numBytesLeaving() {
+	return 13 * sizeof(double) + sizeof(unsigned long) + sizeof(int);
+}
 // position, orientation, id, cid
-size_t CommunicationBuffer::_numBytesHalo = 7 * sizeof(double) + sizeof(int)
+size_t CommunicationBuffer::numBytesHalo() {
+	return 7 * sizeof(double) + sizeof(int)
 	#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
 			+ sizeof(unsigned long)
 	#endif
 		;
-size_t CommunicationBuffer::_numBytesForces = sizeof(unsigned long) + 12 * sizeof(double);
+}
+size_t CommunicationBuffer::numBytesForces() {
+	return sizeof(unsigned long) + 12 * sizeof(double);
+}
 #endif
 
 
@@ -72,7 +90,7 @@ void CommunicationBuffer::resizeForReceivingMolecules(unsigned long& numForces)
 	// read _numForces
 	size_t i_runningByte = 0;
 	//i_runningByte = readValue(i_runningByte, _numForces);
-	_numForces = _buffer.size() / _numBytesForces;
+	_numForces = _buffer.size() / numBytesForces();
 	numForces = _numForces;
 }
 
@@ -80,8 +98,8 @@ void CommunicationBuffer::resizeForAppendingLeavingMolecules(unsigned long numLe
 	_numLeaving += numLeaving;
 	mardyn_assert(_numHalo == 0ul); // assumption: add leaving, add leaving, then add halo, halo, halo, ... but not intertwined.
 	size_t numBytes = sizeof(_numHalo) + sizeof(_numLeaving) +
-				_numLeaving * _numBytesLeaving +
-				_numHalo * _numBytesHalo;
+				_numLeaving * numBytesLeaving() +
+				_numHalo * numBytesHalo();
 	resizeForRawBytes(numBytes);
 
 	// store _numLeaving
@@ -93,8 +111,8 @@ void CommunicationBuffer::resizeForAppendingHaloMolecules(unsigned long numHalo)
 	// _numLeaving stays
 	_numHalo += numHalo;
 	size_t numBytes = sizeof(_numHalo) + sizeof(_numLeaving) +
-				_numLeaving * _numBytesLeaving +
-				_numHalo * _numBytesHalo;
+				_numLeaving * numBytesLeaving() +
+				_numHalo * numBytesHalo();
 	resizeForRawBytes(numBytes);
 
 	// store _numHalo
@@ -105,7 +123,7 @@ void CommunicationBuffer::resizeForAppendingHaloMolecules(unsigned long numHalo)
 void CommunicationBuffer::resizeForAppendingForceMolecules(unsigned long numForces) {
 	_numForces += numForces;
 	// maybe some assert
-	size_t numBytes = sizeof(_numForces) + _numForces * _numBytesForces;
+	size_t numBytes = sizeof(_numForces) + _numForces * numBytesForces();
 	resizeForRawBytes(numBytes);
 	
 	size_t i_runningByte = 0;
@@ -116,7 +134,7 @@ void CommunicationBuffer::addLeavingMolecule(size_t indexOfMolecule, const Molec
 	mardyn_assert(indexOfMolecule < _numLeaving);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::LEAVING, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesLeaving <= _buffer.capacity());
+	mardyn_assert(i_firstByte + numBytesLeaving() <= _buffer.capacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -128,6 +146,15 @@ void CommunicationBuffer::addLeavingMolecule(size_t indexOfMolecule, const Molec
 	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(m.v(0)));
 	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(m.v(1)));
 	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(m.v(2)));
+	if (MoleculeRMM::isMultiSite()) {
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.q().qw()));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.q().qx()));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.q().qy()));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.q().qz()));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.D(0)));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.D(1)));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.D(2)));
+	}
 #else
 	i_runningByte = emplaceValue(i_runningByte, m.getID());
 	i_runningByte = emplaceValue(i_runningByte, m.componentid());
@@ -146,14 +173,14 @@ void CommunicationBuffer::addLeavingMolecule(size_t indexOfMolecule, const Molec
 	i_runningByte = emplaceValue(i_runningByte, m.D(2));
 #endif
 
-	mardyn_assert(i_runningByte - i_firstByte == _numBytesLeaving);
+	mardyn_assert(i_runningByte - i_firstByte == numBytesLeaving());
 }
 
 void CommunicationBuffer::addHaloMolecule(size_t indexOfMolecule, const Molecule& m) {
 	mardyn_assert(indexOfMolecule < _numHalo);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesHalo <= _buffer.capacity());
+	mardyn_assert(i_firstByte + numBytesHalo() <= _buffer.capacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -163,6 +190,12 @@ void CommunicationBuffer::addHaloMolecule(size_t indexOfMolecule, const Molecule
 	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(m.r(0)));
 	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(m.r(1)));
 	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(m.r(2)));
+	if (MoleculeRMM::isMultiSite()) {
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.q().qw()));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.q().qx()));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.q().qy()));
+		i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_accum>(m.q().qz()));
+	}
 #else
 	#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
 		i_runningByte = emplaceValue(i_runningByte, m.getID());
@@ -177,7 +210,7 @@ void CommunicationBuffer::addHaloMolecule(size_t indexOfMolecule, const Molecule
 	i_runningByte = emplaceValue(i_runningByte, m.q().qz());
 #endif
 
-	mardyn_assert(i_runningByte - i_firstByte == _numBytesHalo);
+	mardyn_assert(i_runningByte - i_firstByte == numBytesHalo());
 }
 
 void CommunicationBuffer::addForceMolecule(size_t indexOfMolecule, const Molecule& m) {
@@ -217,7 +250,7 @@ void CommunicationBuffer::readLeavingMolecule(size_t indexOfMolecule, Molecule&
 	mardyn_assert(indexOfMolecule < _numLeaving);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::LEAVING, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesLeaving <= _buffer.capacity());
+	mardyn_assert(i_firstByte + numBytesLeaving() <= _buffer.capacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -235,6 +268,20 @@ void CommunicationBuffer::readLeavingMolecule(size_t indexOfMolecule, Molecule&
 		m.setr(d, rbuf[d]);
 		m.setv(d, vbuf[d]);
 	}
+	if (MoleculeRMM::isMultiSite()) {
+		vcp_real_accum qbuf[4], Dbuf[3];
+		i_runningByte = readValue(i_runningByte, qbuf[0]);
+		i_runningByte = readValue(i_runningByte, qbuf[1]);
+		i_runningByte = readValue(i_runningByte, qbuf[2]);
+		i_runningByte = readValue(i_runningByte, qbuf[3]);
+		i_runningByte = readValue(i_runningByte, Dbuf[0]);
+		i_runningByte = readValue(i_runningByte, Dbuf[1]);
+		i_runningByte = readValue(i_runningByte, Dbuf[2]);
+		m.setq(Quaternion(qbuf[0], qbuf[1], qbuf[2], qbuf[3]));
+		for (int d = 0; d < 3; ++d) {
+			m.setD(d, Dbuf[d]);
+		}
+	}
 #else
 	unsigned long idbuf;
 	unsigned int cidbuf;
@@ -265,32 +312,30 @@ void CommunicationBuffer::readLeavingMolecule(size_t indexOfMolecule, Molecule&
 	);
 #endif
 
-	mardyn_assert(i_runningByte - i_firstByte == _numBytesLeaving);
+	mardyn_assert(i_runningByte - i_firstByte == numBytesLeaving());
 }
 
 void CommunicationBuffer::readHaloMolecule(size_t indexOfMolecule, Molecule& m) const {
 	mardyn_assert(indexOfMolecule < _numHalo);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesHalo <= _buffer.capacity());
+	mardyn_assert(i_firstByte + numBytesHalo() <= _buffer.capacity());
 
 	// add id, r, v
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 	unsigned long idbuf;
-	vcp_real_calc rbuf[3];
-	#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
-		i_runningByte = readValue(i_runningByte, idbuf);
-	#else
-		idbuf = UINT64_MAX;
-	#endif /*LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES*/
-	i_runningByte = readValue(i_runningByte, rbuf[0]);
-	i_runningByte = readValue(i_runningByte, rbuf[1]);
-	i_runningByte = readValue(i_runningByte, rbuf[2]);
+	double rbuf[3];
+	Quaternion qbuf(1.0, 0.0, 0.0, 0.0);
+	readHaloMolecule(indexOfMolecule, rbuf, idbuf, qbuf);
+	i_runningByte += numBytesHalo();
 	m.setid(idbuf);
 	for (int d = 0; d < 3; ++d) {
 		m.setr(d, rbuf[d]);
 	}
+	if (MoleculeRMM::isMultiSite()) {
+		m.setq(qbuf);
+	}
 #else
 	unsigned long idbuf;
 	unsigned int cidbuf;
@@ -317,8 +362,64 @@ void CommunicationBuffer::readHaloMolecule(size_t indexOfMolecule, Molecule& m)
 	);
 #endif
 
-	mardyn_assert(i_runningByte - i_firstByte == _numBytesHalo);
+	mardyn_assert(i_runningByte - i_firstByte == numBytesHalo());
+}
+
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+void CommunicationBuffer::addHaloMolecule(size_t indexOfMolecule, const CellDataSoARMM& soa, size_t soaIndex, const double r[3]) {
+	mardyn_assert(indexOfMolecule < _numHalo);
+
+	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
+	mardyn_assert(i_firstByte + numBytesHalo() <= _buffer.capacity());
+
+	size_t i_runningByte = i_firstByte;
+	#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+		i_runningByte = emplaceValue(i_runningByte, static_cast<unsigned long>(soa.getMolUid(soaIndex)));
+	#endif /*LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES*/
+	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(r[0]));
+	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(r[1]));
+	i_runningByte = emplaceValue(i_runningByte, static_cast<vcp_real_calc>(r[2]));
+	if (MoleculeRMM::isMultiSite()) {
+		i_runningByte = emplaceValue(i_runningByte, soa.q_wBegin()[soaIndex]);
+		i_runningByte = emplaceValue(i_runningByte, soa.q_xBegin()[soaIndex]);
+		i_runningByte = emplaceValue(i_runningByte, soa.q_yBegin()[soaIndex]);
+		i_runningByte = emplaceValue(i_runningByte, soa.q_zBegin()[soaIndex]);
+	}
+
+	mardyn_assert(i_runningByte - i_firstByte == numBytesHalo());
+}
+
+void CommunicationBuffer::readHaloMolecule(size_t indexOfMolecule, double r[3], unsigned long& id, Quaternion& q) const {
+	mardyn_assert(indexOfMolecule < _numHalo);
+
+	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
+	mardyn_assert(i_firstByte + numBytesHalo() <= _buffer.capacity());
+
+	size_t i_runningByte = i_firstByte;
+	vcp_real_calc rbuf[3];
+	#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+		i_runningByte = readValue(i_runningByte, id);
+	#else
+		id = UINT64_MAX;
+	#endif /*LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES*/
+	i_runningByte = readValue(i_runningByte, rbuf[0]);
+	i_runningByte = readValue(i_runningByte, rbuf[1]);
+	i_runningByte = readValue(i_runningByte, rbuf[2]);
+	for (int d = 0; d < 3; ++d) {
+		r[d] = rbuf[d];
+	}
+	if (MoleculeRMM::isMultiSite()) {
+		vcp_real_accum qbuf[4];
+		i_runningByte = readValue(i_runningByte, qbuf[0]);
+		i_runningByte = readValue(i_runningByte, qbuf[1]);
+		i_runningByte = readValue(i_runningByte, qbuf[2]);
+		i_runningByte = readValue(i_runningByte, qbuf[3]);
+		q = Quaternion(qbuf[0], qbuf[1], qbuf[2], qbuf[3]);
+	}
+
+	mardyn_assert(i_runningByte - i_firstByte == numBytesHalo());
 }
+#endif
 
 void CommunicationBuffer::readForceMolecule(size_t indexOfMolecule, Molecule& m) const {
 	// some mardyn assert
@@ -382,12 +483,12 @@ size_t CommunicationBuffer::getStartPosition(ParticleType_t type, size_t indexOf
 	ret += sizeof(_numLeaving) + sizeof(_numHalo);
 
 	if(type == ParticleType_t::LEAVING) {
-		ret += indexOfMolecule * _numBytesLeaving;
+		ret += indexOfMolecule * numBytesLeaving();
 	} else if(type == ParticleType_t::HALO) {
-		ret += _numLeaving * _numBytesLeaving + indexOfMolecule * _numBytesHalo;
+		ret += _numLeaving * numBytesLeaving() + indexOfMolecule * numBytesHalo();
 	} else if(type == ParticleType_t::FORCE) {
 		// ??? - does the force exchange happen on its own or with the other bytes?
-		ret = indexOfMolecule * _numBytesForces; // assumed on its own.
+		ret = indexOfMolecule * numBytesForces(); // assumed on its own.
 		//additionally no leaving or halo molecules are transmitted, thus _numLeaving, _numHalo are zero!
 	}
 
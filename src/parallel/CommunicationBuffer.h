@@ -15,6 +15,9 @@
 #include <stddef.h>
 #include <mpi.h>
 
+class CellDataSoARMM;
+class Quaternion;
+
 // do not uncomment the if, it will break halo copies of the kddecomposition!
 //#if (not defined(NDEBUG))
 #define LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
@@ -64,6 +67,15 @@ public:
 	void readHaloMolecule(size_t indexOfMolecule, Molecule& m) const;
 	void readForceMolecule(size_t indexOfMolecule, Molecule& m) const;
 
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	/**
+	 * Bulk path of the RMM, with the same layout as above: write a halo copy directly from the SoA of a cell,
+	 * with the (shifted) position r, resp. read the values of a halo copy without building a Molecule.
+	 */
+	void addHaloMolecule(size_t indexOfMolecule, const CellDataSoARMM& soa, size_t soaIndex, const double r[3]);
+	void readHaloMolecule(size_t indexOfMolecule, double r[3], unsigned long& id, Quaternion& q) const;
+#endif
+
 	void resizeForReceivingMolecules(unsigned long& numLeaving, unsigned long& numHalo); 
 	void resizeForReceivingMolecules(unsigned long& numForces);
 
@@ -84,9 +96,10 @@ public:
 	}
 
 private:
-	static size_t _numBytesHalo;
-	static size_t _numBytesLeaving;
-        static size_t _numBytesForces; // where is this set?
+	//! number of bytes per halo, leaving and force molecule
+	static size_t numBytesHalo();
+	static size_t numBytesLeaving();
+	static size_t numBytesForces();
 
 	enum class ParticleType_t {HALO=0, LEAVING=1, FORCE=3};
 	size_t getStartPosition(ParticleType_t type, size_t indexOfMolecule) const;
@@ -15,6 +15,13 @@
 #include "ParticleData.h"
 #include "parallel/DomainDecompBase.h"
 #include "Domain.h"
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+#include "particleContainer/LinkedCells.h"
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <utility>
 
 CommunicationPartner::CommunicationPartner(const int r, const double hLo[3], const double hHi[3], const double bLo[3], 
 		const double bHi[3], const double sh[3], const int offset[3], const bool enlarged[3][2]) {
@@ -297,7 +304,14 @@ bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool r
 				
 				
 				global_simulation->timers()->start("COMMUNICATION_PARTNER_TEST_RECV");
-				unsigned long totalNumMols = numLeaving + numHalo;
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+				// without duplicate checks, the halo copies are unpacked directly into the cells
+				LinkedCells* linkedCells = dynamic_cast<LinkedCells*>(moleculeContainer);
+				const bool unpackHaloCopiesToSoA = linkedCells != nullptr and not removeRecvDuplicates;
+#else
+				const bool unpackHaloCopiesToSoA = false;
+#endif
+				unsigned long totalNumMols = numLeaving + (unpackHaloCopiesToSoA ? 0 : numHalo);
 				mols.resize(totalNumMols);
 
 				/*#if defined(_OPENMP) and not defined (ADVANCED_OVERLAPPING)
@@ -315,7 +329,20 @@ bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool r
 					mols[i] = m;
 				}
 
-				moleculeContainer->addParticles(mols, removeRecvDuplicates);
+				if (numHalo > 0 and not unpackHaloCopiesToSoA and moleculeContainer->hasCompactHaloCells()) {
+					// halo copies are added separately, as the container stores them in compact form
+					std::vector<Molecule> haloMols(mols.begin() + numLeaving, mols.end());
+					mols.resize(numLeaving);
+					moleculeContainer->addParticles(mols, removeRecvDuplicates);
+					moleculeContainer->addHaloParticles(haloMols, removeRecvDuplicates);
+				} else {
+					moleculeContainer->addParticles(mols, removeRecvDuplicates);
+				}
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+				if (unpackHaloCopiesToSoA) {
+					addHaloCopiesRMM(linkedCells, numHalo);
+				}
+#endif
 				mols.clear();
 
 			} else { // Buffer is force data
@@ -424,6 +451,13 @@ void CommunicationPartner::add(CommunicationPartner partner) {
 void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeContainer, const double lowCorner[3],
 		const double highCorner[3], const double shift[3], const bool removeFromContainer, HaloOrLeavingCorrection haloLeaveCorr) {
 	using std::vector;
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	LinkedCells* linkedCells = dynamic_cast<LinkedCells*>(moleculeContainer);
+	if (haloLeaveCorr == HALO and linkedCells != nullptr) {
+		collectHaloCopiesInRegionRMM(linkedCells, lowCorner, highCorner, shift);
+		return;
+	}
+#endif
 	global_simulation->timers()->start("COMMUNICATION_PARTNER_INIT_SEND");
 	vector<vector<Molecule>> threadData;
 	vector<int> prefixArray;
@@ -452,6 +486,10 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 		{
 			threadData.resize(numThreads);
 			prefixArray.resize(numThreads + 1);
+			if (haloLeaveCorr == HALO) {
+				// halo copies in compact form are not visited by the region iterator, the master thread collects them
+				moleculeContainer->getCompactHaloCopiesInRegion(lowCorner, highCorner, threadData[0]);
+			}
 		}
 
 		#if defined (_OPENMP)
@@ -511,43 +549,11 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 			mCopy.move(0, shift[0]);
 			mCopy.move(1, shift[1]);
 			mCopy.move(2, shift[2]);
+			double r[3] = {mCopy.r(0), mCopy.r(1), mCopy.r(2)};
+			correctShiftedPosition(r, shift, haloLeaveCorr, domain);
 			for (int dim = 0; dim < 3; dim++) {
-				if (haloLeaveCorr == HALO) {
-					// checks if the molecule has been shifted to inside the domain due to rounding errors.
-					if (shift[dim] < 0.) { // if the shift was negative, it is now in the lower part of the domain -> min
-						if (mCopy.r(dim) >= 0.) {  // in the lower part it was wrongly shifted
-							//std::cout << std::endl << "shifting: molecule" << m.id << std::endl;
-							vcp_real_calc r = 0;
-							mCopy.setr(dim, std::nexttoward(r, r - 1.f)); // ensures that r is smaller than the boundingboxmin
-						}
-					} else if (shift[dim] > 0.) {  // shift > 0
-						if (mCopy.r(dim) < domain->getGlobalLength(dim)) { // in the higher part it was wrongly shifted
-							// std::nextafter: returns the next bigger value of _boundingBoxMax
-							//std::cout << std::endl << "shifting: molecule" << m.id << std::endl;
-							vcp_real_calc r = domain->getGlobalLength(dim);
-							mCopy.setr(dim, std::nexttoward(r, r + 1.f));  // ensures that r is bigger than the boundingboxmax
-						}
-					}
-				} else if (haloLeaveCorr == LEAVING || haloLeaveCorr == FORCES) {
-					// some additional shifting to ensure that rounding errors do not hinder the correct placement
-					if (shift[dim] < 0) {  // if the shift was negative, it is now in the lower part of the domain -> min
-						if (mCopy.r(dim) < 0.) { // in the lower part it was wrongly shifted if
-							mCopy.setr(dim, 0.); // ensures that r is at least the boundingboxmin
-							//std::cout << std::endl << "shifting: molecule" << m.id << std::endl;
-						}
-					} else  if (shift[dim] > 0.) {  // shift > 0
-						if (mCopy.r(dim) >= domain->getGlobalLength(dim)) { // in the lower part it was wrongly shifted if
-						// std::nexttoward: returns the next bigger value of _boundingBoxMax
-							vcp_real_calc r = domain->getGlobalLength(dim);
-							mCopy.setr(dim, std::nexttoward(r, r - 1.f)); // ensures that r is smaller than the boundingboxmax
-							//std::cout << std::endl << "shifting: molecule" << m.id << std::endl;
-						}
-					}
-				} 
-				/* else if(haloLeaveCorr == FORCES) { // using Leaving correction for now.
-					// THIS IS STILL MISSING!
-				} */
-			} /* for-loop dim */
+				mCopy.setr(dim, r[dim]);
+			}
 			if (haloLeaveCorr == LEAVING) {
 				_sendBuf.addLeavingMolecule(numMolsAlreadyIn + prefixArray[threadNum] + i, mCopy);
 			} else if (haloLeaveCorr == HALO) {
@@ -560,6 +566,175 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 	global_simulation->timers()->stop("COMMUNICATION_PARTNER_INIT_SEND");
 }
 
+void CommunicationPartner::correctShiftedPosition(double r[3], const double shift[3], HaloOrLeavingCorrection haloLeaveCorr,
+		Domain* domain) {
+	for (int dim = 0; dim < 3; dim++) {
+		if (haloLeaveCorr == HALO) {
+			// checks if the molecule has been shifted to inside the domain due to rounding errors.
+			if (shift[dim] < 0.) { // if the shift was negative, it is now in the lower part of the domain -> min
+				if (r[dim] >= 0.) {  // in the lower part it was wrongly shifted
+					//std::cout << std::endl << "shifting: molecule" << m.id << std::endl;
+					vcp_real_calc bound = 0;
+					r[dim] = std::nexttoward(bound, bound - 1.f); // ensures that r is smaller than the boundingboxmin
+				}
+			} else if (shift[dim] > 0.) {  // shift > 0
+				if (r[dim] < domain->getGlobalLength(dim)) { // in the higher part it was wrongly shifted
+					// std::nextafter: returns the next bigger value of _boundingBoxMax
+					//std::cout << std::endl << "shifting: molecule" << m.id << std::endl;
+					vcp_real_calc bound = domain->getGlobalLength(dim);
+					r[dim] = std::nexttoward(bound, bound + 1.f);  // ensures that r is bigger than the boundingboxmax
+				}
+			}
+		} else if (haloLeaveCorr == LEAVING || haloLeaveCorr == FORCES) {
+			// some additional shifting to ensure that rounding errors do not hinder the correct placement
+			if (shift[dim] < 0) {  // if the shift was negative, it is now in the lower part of the domain -> min
+				if (r[dim] < 0.) { // in the lower part it was wrongly shifted if
+					r[dim] = 0.; // ensures that r is at least the boundingboxmin
+					//std::cout << std::endl << "shifting: molecule" << m.id << std::endl;
+				}
+			} else  if (shift[dim] > 0.) {  // shift > 0
+				if (r[dim] >= domain->getGlobalLength(dim)) { // in the lower part it was wrongly shifted if
+				// std::nexttoward: returns the next bigger value of _boundingBoxMax
+					vcp_real_calc bound = domain->getGlobalLength(dim);
+					r[dim] = std::nexttoward(bound, bound - 1.f); // ensures that r is smaller than the boundingboxmax
+					//std::cout << std::endl << "shifting: molecule" << m.id << std::endl;
+				}
+			}
+		} 
+		/* else if(haloLeaveCorr == FORCES) { // using Leaving correction for now.
+			// THIS IS STILL MISSING!
+		} */
+	} /* for-loop dim */
+}
+
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+namespace {
+//! same test as Molecule::inBox()
+inline bool inRegion(const CellDataSoARMM& soa, size_t i, const double lowCorner[3], const double highCorner[3]) {
+	bool in = true;
+	for (unsigned short d = 0; d < 3; ++d) {
+		const double r = soa.getMolR(d, i);
+		in &= (r >= lowCorner[d] and r < highCorner[d]);
+	}
+	return in;
+}
+}
+
+void CommunicationPartner::collectHaloCopiesInRegionRMM(LinkedCells* linkedCells, const double lowCorner[3],
+		const double highCorner[3], const double shift[3]) {
+	global_simulation->timers()->start("COMMUNICATION_PARTNER_INIT_SEND");
+	std::vector<unsigned long> cellIndices;
+	linkedCells->getCellIndicesInRegion(lowCorner, highCorner, cellIndices);
+	const long numCells = static_cast<long>(cellIndices.size());
+
+	// count the molecules in the region per cell, to know where each cell starts in the send buffer
+	std::vector<unsigned long> prefixArray(numCells + 1, 0);
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+	#endif
+	for (long c = 0; c < numCells; ++c) {
+		const CellDataSoARMM& soa = linkedCells->getCellReference(cellIndices[c]).getCellDataSoA();
+		unsigned long numInRegion = 0;
+		for (size_t i = 0; i < soa.getMolNum(); ++i) {
+			numInRegion += inRegion(soa, i, lowCorner, highCorner) ? 1 : 0;
+		}
+		prefixArray[c + 1] = numInRegion;
+	}
+	for (long c = 0; c < numCells; ++c) {
+		prefixArray[c + 1] += prefixArray[c];
+	}
+
+	const unsigned long numMolsAlreadyIn = _sendBuf.getNumHalo();
+	_sendBuf.resizeForAppendingHaloMolecules(prefixArray[numCells]);
+
+	Domain* domain = global_simulation->getDomain();
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+	#endif
+	for (long c = 0; c < numCells; ++c) {
+		const CellDataSoARMM& soa = linkedCells->getCellReference(cellIndices[c]).getCellDataSoA();
+		unsigned long indexInBuffer = numMolsAlreadyIn + prefixArray[c];
+		for (size_t i = 0; i < soa.getMolNum(); ++i) {
+			if (not inRegion(soa, i, lowCorner, highCorner)) {
+				continue;
+			}
+			// round like Molecule::move(), so that the correction is not undone by the conversion
+			double r[3];
+			for (unsigned short d = 0; d < 3; ++d) {
+				r[d] = static_cast<vcp_real_calc>(soa.getMolR(d, i) + shift[d]);
+			}
+			correctShiftedPosition(r, shift, HALO, domain);
+			_sendBuf.addHaloMolecule(indexInBuffer, soa, i, r);
+			++indexInBuffer;
+		}
+		mardyn_assert(indexInBuffer == numMolsAlreadyIn + prefixArray[c + 1]);
+	}
+	global_simulation->timers()->stop("COMMUNICATION_PARTNER_INIT_SEND");
+}
+
+void CommunicationPartner::addHaloCopiesRMM(LinkedCells* linkedCells, unsigned long numHalo) {
+	// copies outside of the halo box are dropped, as LinkedCells::addHaloParticle() does
+	double haloBoxMin[3], haloBoxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		haloBoxMin[d] = linkedCells->getBoundingBoxMin(d) - linkedCells->get_halo_L(d);
+		haloBoxMax[d] = linkedCells->getBoundingBoxMax(d) + linkedCells->get_halo_L(d);
+	}
+	const unsigned long outside = std::numeric_limits<unsigned long>::max();
+
+	// sort the halo copies by their cells, so that each cell is filled by one thread with one allocation
+	std::vector<std::pair<unsigned long, unsigned long>> cellAndIndex(numHalo);
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (long i = 0; i < static_cast<long>(numHalo); ++i) {
+		double r[3];
+		unsigned long id;
+		Quaternion q(1.0, 0.0, 0.0, 0.0);
+		_recvBuf.readHaloMolecule(i, r, id, q);
+		bool inBox = true;
+		for (int d = 0; d < 3; ++d) {
+			inBox &= (r[d] >= haloBoxMin[d] and r[d] < haloBoxMax[d]);
+		}
+		const unsigned long cellIndex = inBox ? linkedCells->getCellIndexOfPoint(r) : outside;
+		cellAndIndex[i] = std::make_pair(cellIndex, static_cast<unsigned long>(i));
+	}
+	std::sort(cellAndIndex.begin(), cellAndIndex.end());
+	while (numHalo > 0 and cellAndIndex[numHalo - 1].first == outside) {
+		--numHalo;
+	}
+
+	std::vector<unsigned long> cellStarts;
+	for (unsigned long i = 0; i < numHalo; ++i) {
+		if (i == 0 or cellAndIndex[i].first != cellAndIndex[i - 1].first) {
+			cellStarts.push_back(i);
+		}
+	}
+	cellStarts.push_back(numHalo);
+	const long numCells = static_cast<long>(cellStarts.size()) - 1;
+
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+	#endif
+	for (long c = 0; c < numCells; ++c) {
+		ParticleCell& cell = linkedCells->getCellReference(cellAndIndex[cellStarts[c]].first);
+		cell.increaseMoleculeStorage(cellStarts[c + 1] - cellStarts[c]);
+		for (unsigned long j = cellStarts[c]; j < cellStarts[c + 1]; ++j) {
+			double r[3];
+			unsigned long id;
+			Quaternion q(1.0, 0.0, 0.0, 0.0);
+			_recvBuf.readHaloMolecule(cellAndIndex[j].second, r, id, q);
+			mardyn_assert(cell.testPointInCell(r));
+			const std::array<vcp_real_calc, 3> rc = {
+				static_cast<vcp_real_calc>(r[0]),
+				static_cast<vcp_real_calc>(r[1]),
+				static_cast<vcp_real_calc>(r[2])
+			};
+			cell.addHaloCopy(rc, id, q);
+		}
+	}
+}
+#endif
+
 size_t CommunicationPartner::getDynamicSize() {
 	return _sendBuf.getDynamicSize() + _recvBuf.getDynamicSize() + _haloInfo.capacity() * sizeof(PositionInfo);
 }
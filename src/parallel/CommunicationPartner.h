@@ -21,6 +21,8 @@ typedef enum {
 } MessageType;
 
 class ParticleContainer;
+class LinkedCells;
+class Domain;
 
 struct PositionInfo {
 	double _bothLow[3], _bothHigh[3];
@@ -126,6 +128,18 @@ private:
 			const double highCorner[3], const double shift[3], const bool removeFromContainer,
 			HaloOrLeavingCorrection haloLeaveCorr);
 
+	//! correct rounding errors of the periodic shift, such that halo copies end up outside and leaving molecules inside of the domain
+	static void correctShiftedPosition(double r[3], const double shift[3], HaloOrLeavingCorrection haloLeaveCorr, Domain* domain);
+
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	//! pack the halo copies in the region directly from the SoA of the cells into the send buffer
+	void collectHaloCopiesInRegionRMM(LinkedCells* linkedCells, const double lowCorner[3],
+			const double highCorner[3], const double shift[3]);
+
+	//! unpack the received halo copies directly into the SoA of the halo cells
+	void addHaloCopiesRMM(LinkedCells* linkedCells, unsigned long numHalo);
+#endif
+
 	int _rank;
 	int _countTested;
 	std::vector<PositionInfo> _haloInfo;
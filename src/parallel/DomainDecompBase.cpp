@@ -256,6 +256,29 @@ void DomainDecompBase::populateHaloLayerWithCopies(unsigned dim, ParticleContain
 		}
 
 
+		auto shiftAndAddHaloCopy = [&](Molecule& m) {
+			m.setr(dim, m.r(dim) + shift);
+			// checks if the molecule has been shifted to inside the domain due to rounding errors.
+			if (shift < 0) {  // if the shift was negative, it is now in the lower part of the domain -> min
+				if (m.r(dim) >= moleculeContainer->getBoundingBoxMin(dim)) { // in the lower part it was wrongly shifted if
+					vcp_real_calc r = moleculeContainer->getBoundingBoxMin(dim);
+					m.setr(dim, std::nexttoward(r, r - 1.f));  // ensures that r is smaller than the boundingboxmin
+				}
+			} else {  // shift > 0
+				if (m.r(dim) < moleculeContainer->getBoundingBoxMax(dim)) { // in the lower part it was wrongly shifted if
+					// std::nextafter: returns the next bigger value of _boundingBoxMax
+					vcp_real_calc r = moleculeContainer->getBoundingBoxMax(dim);
+					m.setr(dim, std::nexttoward(r, r + 1.f));  // ensures that r is bigger than the boundingboxmax
+				}
+			}
+			moleculeContainer->addHaloParticle(m);
+		};
+
+		// halo copies of the previous dimensions, which the container stores in compact form
+		// and the iterators do not visit; they are needed for the edges and corners of the halo
+		std::vector<Molecule> compactHaloCopies;
+		moleculeContainer->getCompactHaloCopiesInRegion(startRegion, endRegion, compactHaloCopies);
+
 		#if defined (_OPENMP)
 		#pragma omp parallel shared(startRegion, endRegion)
 		#endif
@@ -265,23 +288,13 @@ void DomainDecompBase::populateHaloLayerWithCopies(unsigned dim, ParticleContain
 			//traverse and gather all boundary particles in the cells
 			for(auto i = begin; i.isValid(); ++i){
 				Molecule m = *i;
-				m.setr(dim, m.r(dim) + shift);
-				// checks if the molecule has been shifted to inside the domain due to rounding errors.
-				if (shift < 0) {  // if the shift was negative, it is now in the lower part of the domain -> min
-					if (m.r(dim) >= moleculeContainer->getBoundingBoxMin(dim)) { // in the lower part it was wrongly shifted if
-						vcp_real_calc r = moleculeContainer->getBoundingBoxMin(dim);
-						m.setr(dim, std::nexttoward(r, r - 1.f));  // ensures that r is smaller than the boundingboxmin
-					}
-				} else {  // shift > 0
-					if (m.r(dim) < moleculeContainer->getBoundingBoxMax(dim)) { // in the lower part it was wrongly shifted if
-						// std::nextafter: returns the next bigger value of _boundingBoxMax
-						vcp_real_calc r = moleculeContainer->getBoundingBoxMax(dim);
-						m.setr(dim, std::nexttoward(r, r + 1.f));  // ensures that r is bigger than the boundingboxmax
-					}
-				}
-				moleculeContainer->addHaloParticle(m);
+				shiftAndAddHaloCopy(m);
 			}
 		}
+
+		for (Molecule& m : compactHaloCopies) {
+			shiftAndAddHaloCopy(m);
+		}
 	}
 }
 
@@ -10,7 +10,7 @@
 
 
 void ParticleDataRMM::getMPIType(MPI_Datatype &sendPartType) {
-	int blocklengths[] = { 1, 6 }; // 1 unsLong value (id), 6 double values (3r, 3v)
+	int blocklengths[] = { 1, 13 }; // 1 unsLong value (id), 13 double values (3r, 3v, 4q, 3D)
 
 
 	MPI_Datatype types[2];
@@ -32,8 +32,10 @@ void ParticleDataRMM::getMPIType(MPI_Datatype &sendPartType) {
 		Simulation::exit(4852);
 	}
 
-	//if the following statement is not true, then the 6 double values do not follow one after the other.
+	//if the following statement is not true, then the 13 double values do not follow one after the other.
 	mardyn_assert(&(pdata_dummy.r[0]) + 3 == &(pdata_dummy.v[0]));
+	mardyn_assert(&(pdata_dummy.r[0]) + 6 == &(pdata_dummy.q[0]));
+	mardyn_assert(&(pdata_dummy.r[0]) + 10 == &(pdata_dummy.D[0]));
 
 	MPI_Aint displacements[3];
 #if MPI_VERSION >= 2 && MPI_SUBVERSION >= 0
@@ -64,6 +66,13 @@ void ParticleDataRMM::MoleculeToParticleData(ParticleDataRMM &particleStruct, Mo
 	particleStruct.v[0] = molecule.v(0);
 	particleStruct.v[1] = molecule.v(1);
 	particleStruct.v[2] = molecule.v(2);
+	particleStruct.q[0] = molecule.q().qw();
+	particleStruct.q[1] = molecule.q().qx();
+	particleStruct.q[2] = molecule.q().qy();
+	particleStruct.q[3] = molecule.q().qz();
+	particleStruct.D[0] = molecule.D(0);
+	particleStruct.D[1] = molecule.D(1);
+	particleStruct.D[2] = molecule.D(2);
 }
 
 void ParticleDataRMM::ParticleDataToMolecule(const ParticleDataRMM &particleStruct, Molecule &molecule) {
@@ -71,7 +80,7 @@ void ParticleDataRMM::ParticleDataToMolecule(const ParticleDataRMM &particleStru
 	molecule = Molecule(particleStruct.id, component,
 						particleStruct.r[0], particleStruct.r[1], particleStruct.r[2],
 						particleStruct.v[0], particleStruct.v[1], particleStruct.v[2],
-						1., 0., 0., 0.,
-						0., 0., 0.
+						particleStruct.q[0], particleStruct.q[1], particleStruct.q[2], particleStruct.q[3],
+						particleStruct.D[0], particleStruct.D[1], particleStruct.D[2]
 	);
 }
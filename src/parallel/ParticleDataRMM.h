@@ -31,6 +31,8 @@ public:
 	unsigned long id;
 	vcp_real_calc r[3];
 	vcp_real_calc v[3];
+	vcp_real_calc q[4];
+	vcp_real_calc D[3];
 };
 
 #endif /* ParticleDataRMM_H_ */
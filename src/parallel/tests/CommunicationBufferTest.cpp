@@ -14,7 +14,11 @@
 #include "Simulation.h"
 #include "ensemble/EnsembleBase.h"
 #include "ensemble/CanonicalEnsemble.h"
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+#include "particleContainer/adapter/CellDataSoARMM.h"
+#endif
 
+#include <cstring>
 #include <iostream>
 using namespace std;
 
@@ -302,3 +306,85 @@ void CommunicationBufferTest::testPackSendRecvUnpack() {
 
 	//MPI_Barrier(MPI_COMM_WORLD);
 }
+
+// free function
+void CommunicationBufferTest__testHaloSoARMM(bool rotational) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	Component component(0);
+	component.addLJcenter(0, 0, -0.5, 1, 1, 1, 0, false);
+	if (rotational) {
+		component.addLJcenter(0, 0, 0.5, 1, 1, 1, 0, false);
+	}
+	global_simulation->getEnsemble()->addComponent(component);
+	Component* c = global_simulation->getEnsemble()->getComponent(0);
+
+	const int numMols = 3;
+	Molecule m[numMols];
+	m[0] = Molecule(7, c, 1., 2., 3., -1., -2., -3., 0.5, 0.5, 0.5, 0.5, 0.1, 0.2, 0.3);
+	m[1] = Molecule(8, c, 11.25, 12.5, 13.75, -11., -12., -13., 0.6, 0.0, 0.8, 0.0, -0.1, 0.0, 0.1);
+	m[2] = Molecule(123456789012, c, 0.125, 21., 22., 1., 2., 3., 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+	// the copy is the periodic image of the molecule
+	const double shift[3] = { 30., -10., 0. };
+	ASSERT_EQUAL(rotational, MoleculeRMM::isMultiSite());
+
+	CellDataSoARMM soa(0);
+	for (int i = 0; i < numMols; ++i) {
+		soa.appendMolecule(m[i]);
+	}
+	ASSERT_EQUAL(rotational, soa.isRotational());
+
+	CommunicationBuffer bufMolecule, bufSoA;
+	bufMolecule.resizeForAppendingLeavingMolecules(0);
+	bufMolecule.resizeForAppendingHaloMolecules(numMols);
+	bufSoA.resizeForAppendingLeavingMolecules(0);
+	bufSoA.resizeForAppendingHaloMolecules(numMols);
+	for (int i = 0; i < numMols; ++i) {
+		double r[3];
+		Molecule shifted(m[i]);
+		for (int d = 0; d < 3; ++d) {
+			r[d] = m[i].r(d) + shift[d];
+			shifted.setr(d, r[d]);
+		}
+		bufMolecule.addHaloMolecule(i, shifted);
+		bufSoA.addHaloMolecule(i, soa, i, r);
+	}
+
+	ASSERT_EQUAL(bufMolecule.getNumElementsForSending(), bufSoA.getNumElementsForSending());
+	ASSERT_EQUAL(0, std::memcmp(bufMolecule.getDataForSending(), bufSoA.getDataForSending(),
+			bufSoA.getNumElementsForSending()));
+
+	for (int i = 0; i < numMols; ++i) {
+		double r[3];
+		unsigned long id;
+		Quaternion q(1.0, 0.0, 0.0, 0.0);
+		bufSoA.readHaloMolecule(i, r, id, q);
+		Molecule mread;
+		bufSoA.readHaloMolecule(i, mread);
+
+		ASSERT_EQUAL(m[i].getID(), id);
+		ASSERT_EQUAL(m[i].getID(), mread.getID());
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(m[i].r(d) + shift[d], r[d], 1e-16);
+			ASSERT_DOUBLES_EQUAL(m[i].r(d) + shift[d], mread.r(d), 1e-16);
+		}
+		if (rotational) {
+			ASSERT_DOUBLES_EQUAL(m[i].q().qw(), q.qw(), 1e-7);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qx(), q.qx(), 1e-7);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qy(), q.qy(), 1e-7);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qz(), q.qz(), 1e-7);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qw(), mread.q().qw(), 1e-7);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qx(), mread.q().qx(), 1e-7);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qy(), mread.q().qy(), 1e-7);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qz(), mread.q().qz(), 1e-7);
+		}
+	}
+#endif /* ENABLE_REDUCED_MEMORY_MODE */
+}
+
+void CommunicationBufferTest::testHaloSoARMM() {
+	CommunicationBufferTest__testHaloSoARMM(false);
+}
+
+void CommunicationBufferTest::testHaloSoARMMRotational() {
+	CommunicationBufferTest__testHaloSoARMM(true);
+}
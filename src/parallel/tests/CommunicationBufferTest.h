@@ -17,6 +17,8 @@ class CommunicationBufferTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testLeaving);
 	TEST_METHOD(testLeavingAndHalo);
 	TEST_METHOD(testPackSendRecvUnpack);
+	TEST_METHOD(testHaloSoARMM);
+	TEST_METHOD(testHaloSoARMMRotational);
 	TEST_SUITE_END();
 
 public:
@@ -33,6 +35,17 @@ public:
 	void testLeavingAndHalo();
 
 	void testPackSendRecvUnpack();
+
+	/**
+	 * Halo copies packed directly from the SoA of an RMM cell have to be byte-identical to the ones
+	 * packed from Molecules, and have to be read back by both read paths (single-site component).
+	 */
+	void testHaloSoARMM();
+
+	/**
+	 * As testHaloSoARMM(), for a multi-site component, i.e. including the quaternions.
+	 */
+	void testHaloSoARMMRotational();
 };
 
 #endif /* SRC_PARALLEL_TESTS_COMMUNICATIONBUFFERTEST_H_ */
@@ -28,11 +28,12 @@ public:
 	virtual void setBoxMax(const double b[3]) = 0;
 
 	unsigned long getCellIndex() const { return _cellIndex; }
-	void setCellIndex(unsigned long cellIndex) { _cellIndex = cellIndex; }
+	void setCellIndex(unsigned long cellIndex) { _cellIndex = static_cast<unsigned int>(cellIndex); }
 
 protected:
 	//! the index of a cell. On one process every index must be unique.
-	unsigned long _cellIndex;
+	//! 32 bits, so that derived cells can place small members behind it (see ParticleCellRMMTest::testSizeOfIs64()).
+	unsigned int _cellIndex;
 };
 
 #endif /* CELL_H_ */
@@ -28,10 +28,11 @@ public:
 	void init(int cellsPerDim[3],
 			double haloBoxMin[3], double haloBoxMax[3],
 			double boxMin[3], double boxMax[3],
-			double cellLength[3]) {
+			double cellLength[3], int haloWidthInNumCells[3]) {
 		int totalNumCells = 1;
 		for (int d = 0; d < 3; ++d) {
 			_cellsPerDimension[d] = cellsPerDim[d];
+			_haloWidthInNumCells[d] = haloWidthInNumCells[d];
 			_haloBoundingBoxMin[d] = haloBoxMin[d];
 			_haloBoundingBoxMax[d] = haloBoxMax[d];
 			_boundingBoxMin[d] = boxMin[d];
@@ -42,17 +43,18 @@ public:
 		}
 
 		_haloCellFlags.resize(totalNumCells);
+		_initCalled = true;
 
 		int runningIndex = 0;
 
 		for (unsigned z = 0; z < _cellsPerDimension[2]; ++z) {
-			bool isHaloZ = (z == 0 or z == _cellsPerDimension[2]-1);
+			bool isHaloZ = isCell1D(IsCell_t::HALO, z, 2);
 
 			for (unsigned y = 0; y < _cellsPerDimension[1]; ++y) {
-				bool isHaloY = (y == 0 or y == _cellsPerDimension[1]-1);
+				bool isHaloY = isCell1D(IsCell_t::HALO, y, 1);
 
 				for (unsigned x = 0; x < _cellsPerDimension[0]; ++x) {
-					bool isHaloX = (x == 0 or x == _cellsPerDimension[0]-1);
+					bool isHaloX = isCell1D(IsCell_t::HALO, x, 0);
 
 					if (isHaloZ or isHaloY or isHaloX) {
 						_haloCellFlags.at(runningIndex) = true;
@@ -63,7 +65,6 @@ public:
 				}
 			}
 		}
-		_initCalled = true;
 	}
 
 	// NOTE: optimised isHaloCell for runtime. Uses 1 bit per cell.
@@ -110,21 +111,25 @@ private:
 		}
 		return ret;
 	}
+	// the halo, boundary and inner layers are haloWidth cells wide each
 	bool isCell1D(IsCell_t type, Global1DIndex_t index, int dimension) const {
 		mardyn_assert(_initCalled);
+		const long i = static_cast<long>(index);
+		const long n = static_cast<long>(_cellsPerDimension[dimension]);
+		const long h = _haloWidthInNumCells[dimension];
 		bool ret;
 		switch(type) {
 		case IsCell_t::HALO:
-			ret = (index == 0) or (index == _cellsPerDimension[dimension]-1);
+			ret = (i < h) or (i >= n - h);
 			break;
 		case IsCell_t::BOUNDARY:
-			ret = (index == 1) or (index == _cellsPerDimension[dimension]-2);
+			ret = (i >= h and i < 2 * h) or (i >= n - 2 * h and i < n - h);
 			break;
 		case IsCell_t::INNER:
-			ret = (index >= 2) and (index <= _cellsPerDimension[dimension]-3);
+			ret = (i >= 2 * h) and (i < n - 2 * h);
 			break;
 		case IsCell_t::INNERMOST:
-			ret = (index >= 3) and (index <= _cellsPerDimension[dimension]-4);
+			ret = (i >= 3 * h) and (i < n - 3 * h);
 			break;
 		}
 		return ret;
@@ -135,16 +140,16 @@ private:
 
 		double ret;
 		// why oh why don't we have switch statements on variables
+		const Global1DIndex_t h = static_cast<Global1DIndex_t>(_haloWidthInNumCells[dimension]);
 		if (index == 0) {
 			ret = _haloBoundingBoxMin[dimension];
-		} else if (index == 1) {
+		} else if (index == h) {
 			ret = _boundingBoxMin[dimension];
-		} else if (index == _cellsPerDimension[dimension] - 1) {
+		} else if (index == _cellsPerDimension[dimension] - h) {
 			ret = _boundingBoxMax[dimension];
 		} else if (index == _cellsPerDimension[dimension]) {
 			ret = _haloBoundingBoxMax[dimension];
 		} else {
-			mardyn_assert(index > 1 and index < _cellsPerDimension[dimension] - 1);
 			ret = index * _cellLength[dimension] + _haloBoundingBoxMin[dimension];
 		}
 		return ret;
@@ -157,6 +162,7 @@ private:
 	//member fields
 	bool _initCalled;
 	Global3DIndex_t _cellsPerDimension;
+	std::array<int, 3> _haloWidthInNumCells;
 	std::array<double, 3> _boundingBoxMin, _boundingBoxMax;
 	std::array<double, 3> _haloBoundingBoxMin, _haloBoundingBoxMax;
 	std::array<double, 3> _cellLength;
@@ -0,0 +1,53 @@
+/*
+ * CompactHaloMolecule.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef SRC_PARTICLECONTAINER_COMPACTHALOMOLECULE_H_
+#define SRC_PARTICLECONTAINER_COMPACTHALOMOLECULE_H_
+
+#include <array>
+
+#include "molecules/Molecule.h"
+#include "molecules/Quaternion.h"
+
+class Component;
+
+/**
+ * \brief Halo copy of a molecule, reduced to the data needed to set up the CellDataSoA of the force calculation.
+ * \details Halo cells of LinkedCells store these instead of full molecules, if compact halo cells are enabled.
+ * Velocity, angular momentum, forces and the site caches of a halo copy are never read during the force
+ * calculation, so only the ID (for duplicate checks and Verlet lists), the position, the orientation and the
+ * component are kept. This is the same data the halo copies carry in the communication buffers.
+ */
+class CompactHaloMolecule {
+public:
+	explicit CompactHaloMolecule(const Molecule& m) :
+			_id(m.getID()), _r(m.r_arr()), _q(m.q()), _component(m.component()) {
+		_q.normalize();
+	}
+
+	unsigned long getID() const { return _id; }
+	double r(unsigned short d) const { return _r[d]; }
+	const std::array<double, 3>& r_arr() const { return _r; }
+	const Quaternion& q() const { return _q; }
+	Component* component() const { return _component; }
+
+	bool inBox(const double l[3], const double u[3]) const {
+		return _r[0] >= l[0] and _r[0] < u[0] and _r[1] >= l[1] and _r[1] < u[1] and _r[2] >= l[2] and _r[2] < u[2];
+	}
+
+	//! @brief Materialize the halo copy as molecule at rest, e.g. to forward it to the next neighbour.
+	Molecule toMolecule() const {
+		return Molecule(_id, _component, _r[0], _r[1], _r[2], 0., 0., 0., _q.qw(), _q.qx(), _q.qy(), _q.qz());
+	}
+
+private:
+	unsigned long _id;
+	std::array<double, 3> _r;
+	Quaternion _q;
+	Component* _component;
+};
+
+#endif /* SRC_PARTICLECONTAINER_COMPACTHALOMOLECULE_H_ */
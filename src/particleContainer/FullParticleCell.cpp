@@ -9,9 +9,12 @@
 #include "particleContainer/FullParticleCell.h"
 #include "molecules/Molecule.h"
 #include "utils/UnorderedVector.h"
+#include "utils/threeDimensionalMapping.h"
 #include "Simulation.h"
 
 #include "utils/mardyn_assert.h"
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 using namespace std;
@@ -28,6 +31,7 @@ FullParticleCell::~FullParticleCell() {
 
 void FullParticleCell::deallocateAllParticles() {
 	_molecules.clear();
+	_compactHaloMolecules.clear();
 }
 
 bool FullParticleCell::findMoleculeByID(size_t& index, unsigned long molid) const {
@@ -70,6 +74,24 @@ bool FullParticleCell::addParticle(Molecule& particle, bool checkWhetherDuplicat
 	return wasInserted;
 }
 
+bool FullParticleCell::addCompactHaloParticle(const Molecule& particle, bool checkWhetherDuplicate) {
+#ifndef NDEBUG
+	bool isIn = testInBox(particle);
+	mardyn_assert(isIn);
+#endif
+
+	if (checkWhetherDuplicate) {
+		// perform a check whether this molecule exists (has been received) already
+		for (const CompactHaloMolecule& m : _compactHaloMolecules) {
+			if (m.getID() == particle.getID()) {
+				return false;
+			}
+		}
+	}
+	_compactHaloMolecules.emplace_back(particle);
+	return true;
+}
+
 bool FullParticleCell::isEmpty() const {
 	return _molecules.empty();
 }
@@ -140,24 +162,83 @@ void FullParticleCell::getRegion(double lowCorner[3], double highCorner[3], std:
 	}
 }
 
+void FullParticleCell::sortMoleculesByMortonIndex(unsigned subdivisions) {
+	const size_t numMolecules = _molecules.size();
+	if (numMolecules < 2) {
+		return;
+	}
+	// keep the order, which the Verlet lists refer to, until the molecules of the cell change
+	if (_verletLists.isEnabled() and _verletLists.hasReferenceOrder(_molecules)) {
+		return;
+	}
+
+	double boxMin[3], scale[3];
+	for (int d = 0; d < 3; ++d) {
+		boxMin[d] = getBoxMin(d);
+		scale[d] = subdivisions / (getBoxMax(d) - boxMin[d]);
+	}
+
+	// (Morton index, old position): sorting the pairs keeps the order of molecules in the same sub-cell
+	vector<pair<uint64_t, size_t>> keys(numMolecules);
+	for (size_t i = 0; i < numMolecules; ++i) {
+		uint64_t subCell[3];
+		for (int d = 0; d < 3; ++d) {
+			// halo molecules may lie slightly outside of the cell
+			const double s = (_molecules[i].r(d) - boxMin[d]) * scale[d];
+			subCell[d] = static_cast<uint64_t>(min(max(s, 0.0), subdivisions - 1.0));
+		}
+		keys[i] = make_pair(threeDimensionalMapping::threeToMorton(subCell[0], subCell[1], subCell[2]), i);
+	}
+
+	if (is_sorted(keys.begin(), keys.end())) {
+		return;
+	}
+	sort(keys.begin(), keys.end());
+
+	vector<Molecule> sortedMolecules;
+	sortedMolecules.reserve(_molecules.capacity());
+	for (size_t i = 0; i < numMolecules; ++i) {
+		sortedMolecules.push_back(std::move(_molecules[keys[i].second]));
+	}
+	_molecules.swap(sortedMolecules);
+}
+
+void FullParticleCell::updateInteractionRadius(const std::vector<double>& componentCutoffRadii) {
+	double radius = 0.0;
+	for (const Molecule& m : _molecules) {
+		radius = std::max(radius, componentCutoffRadii[m.componentid()]);
+	}
+	for (const CompactHaloMolecule& m : _compactHaloMolecules) {
+		radius = std::max(radius, componentCutoffRadii[m.component()->ID()]);
+	}
+	setInteractionRadius(radius);
+}
+
 void FullParticleCell::buildSoACaches() {
 
 	// Determine the total number of centers.
-	size_t numMolecules = _molecules.size();
+	size_t numMolecules = _molecules.size() + _compactHaloMolecules.size();
 	size_t nLJCenters = 0;
 	size_t nCharges = 0;
 	size_t nDipoles = 0;
 	size_t nQuadrupoles = 0;
 
-	for (size_t m = 0;  m < numMolecules; ++m) {
+	for (size_t m = 0;  m < _molecules.size(); ++m) {
 		nLJCenters += _molecules[m].numLJcenters();
 		nCharges += _molecules[m].numCharges();
 		nDipoles += _molecules[m].numDipoles();
 		nQuadrupoles += _molecules[m].numQuadrupoles();
 	}
+	for (const CompactHaloMolecule& m : _compactHaloMolecules) {
+		nLJCenters += m.component()->numLJcenters();
+		nCharges += m.component()->numCharges();
+		nDipoles += m.component()->numDipoles();
+		nQuadrupoles += m.component()->numQuadrupoles();
+	}
 
 	// Construct the SoA.
 	_cellDataSoA.resize(numMolecules,nLJCenters,nCharges,nDipoles,nQuadrupoles);
+	_cellDataSoA._cellBoxMin = getBoxMinArray();
 
 	size_t iLJCenters = 0;
 	size_t iCharges = 0;
@@ -190,6 +271,37 @@ void FullParticleCell::buildSoACaches() {
 
 		M.clearFM();
 	}
+
+	// compact halo copies follow the molecules, they only provide the sites
+	for (size_t i = _molecules.size(); i < numMolecules; ++i) {
+		const CompactHaloMolecule & M = _compactHaloMolecules[i - _molecules.size()];
+		const Component & component = *M.component();
+
+		_cellDataSoA._mol_ljc_num[i] = component.numLJcenters();
+		_cellDataSoA._mol_charges_num[i] = component.numCharges();
+		_cellDataSoA._mol_dipoles_num[i] = component.numDipoles();
+		_cellDataSoA._mol_quadrupoles_num[i] = component.numQuadrupoles();
+
+		_cellDataSoA._mol_pos.x(i) = M.r(0);
+		_cellDataSoA._mol_pos.y(i) = M.r(1);
+		_cellDataSoA._mol_pos.z(i) = M.r(2);
+
+		FullMolecule::setupSoACacheSites(_cellDataSoA, component, M.r_arr(), M.q(), iLJCenters, iCharges, iDipoles, iQuadrupoles);
+
+		iLJCenters += component.numLJcenters();
+		iCharges += component.numCharges();
+		iDipoles += component.numDipoles();
+		iQuadrupoles += component.numQuadrupoles();
+	}
+
+	if (_verletLists.isEnabled()) {
+		if (_compactHaloMolecules.empty()) {
+			_verletLists.updateReference(_molecules);
+		} else {
+			mardyn_assert(_molecules.empty());
+			_verletLists.updateReference(_compactHaloMolecules);
+		}
+	}
 }
 
 void FullParticleCell::increaseMoleculeStorage(size_t numExtraMols) {
@@ -8,11 +8,14 @@
 #ifndef SRC_PARTICLECONTAINER_FULLPARTICLECELL_H_
 #define SRC_PARTICLECONTAINER_FULLPARTICLECELL_H_
 
+#include <limits>
 #include <vector>
 
 #include "Cell.h"
+#include "particleContainer/CompactHaloMolecule.h"
 #include "particleContainer/ParticleCellBase.h"
 #include "particleContainer/adapter/CellDataSoA.h"
+#include "particleContainer/adapter/CellVerletLists.h"
 #include "SingleCellIterator.h"
 
 //! @brief FullParticleCell data structure. Renamed from ParticleCell.
@@ -71,6 +74,22 @@ public:
 	//! insert a single molecule into this cell
 	bool addParticle(Molecule& particle, bool checkWhetherDuplicate = false) override;
 
+	/**
+	 * \brief Insert a halo copy, which is only stored with the data needed for the SoA (see CompactHaloMolecule).
+	 * \details Compact halo copies are not visible to the iterators of the cell, they only show up in the
+	 * CellDataSoA after buildSoACaches(). deallocateAllParticles() removes them.
+	 */
+	bool addCompactHaloParticle(const Molecule& particle, bool checkWhetherDuplicate = false);
+
+	//! return the number of compact halo copies contained in this cell
+	size_t getCompactHaloMoleculeCount() const {
+		return _compactHaloMolecules.size();
+	}
+
+	const std::vector<CompactHaloMolecule>& getCompactHaloMolecules() const {
+		return _compactHaloMolecules;
+	}
+
 	bool isEmpty() const override;
 
 	bool deleteMoleculeByIndex(size_t index) override;
@@ -86,6 +105,13 @@ public:
 		return _cellDataSoA;
 	}
 
+	/**
+	 * \brief Get the Verlet list data for VectorizedCellProcessor.
+	 */
+	CellVerletLists& getVerletLists() {
+		return _verletLists;
+	}
+
 	void preUpdateLeavingMolecules() override;
 
 	void updateLeavingMoleculesBase(ParticleCellBase& otherCell) override;
@@ -97,10 +123,36 @@ public:
 
 	void buildSoACaches() override;
 
+	/**
+	 * \brief Sort the molecules along the Morton curve through a grid of subdivisions^3 sub-cells.
+	 * Molecules within the same sub-cell keep their relative order. Invalidates the SoA caches.
+	 */
+	void sortMoleculesByMortonIndex(unsigned subdivisions);
+
+	/**
+	 * \brief Set the interaction radius to the largest cutoff radius of the components of the molecules
+	 * (including the compact halo copies) in the cell.
+	 * \param componentCutoffRadii cutoff radius of each component, indexed by component ID
+	 */
+	void updateInteractionRadius(const std::vector<double>& componentCutoffRadii);
+
+	/** @brief Largest cutoff radius of the molecules in the cell.
+	 * Traversals skip pairs of cells, which are farther apart than the interaction radii of both cells.
+	 * Unbounded, unless the container sets it for component dependent cutoff radii.
+	 */
+	double getInteractionRadius() const {
+		return _interactionRadius;
+	}
+
+	void setInteractionRadius(double interactionRadius) {
+		_interactionRadius = interactionRadius;
+	}
+
 	void increaseMoleculeStorage(size_t numExtraMols) override;
 
 	virtual size_t getMoleculeVectorDynamicSize() const override {
-		return _molecules.capacity() * sizeof(Molecule) + _leavingMolecules.capacity() * sizeof(Molecule);
+		return _molecules.capacity() * sizeof(Molecule) + _leavingMolecules.capacity() * sizeof(Molecule)
+				+ _compactHaloMolecules.capacity() * sizeof(CompactHaloMolecule);
 	}
 
 //protected: do not use!
@@ -128,11 +180,23 @@ private:
 	 */
 	std::vector<Molecule> _leavingMolecules;
 
+	/**
+	 * \brief Halo copies without full Molecule objects, see addCompactHaloParticle().
+	 */
+	std::vector<CompactHaloMolecule> _compactHaloMolecules;
+
 	/**
 	 * \brief Structure of arrays for VectorizedCellProcessor.
 	 * \author Johannes Heckl
 	 */
 	CellDataSoA _cellDataSoA;
+
+	/**
+	 * \brief Reference configuration and cell pair lists for the Verlet list mode of VectorizedCellProcessor.
+	 */
+	CellVerletLists _verletLists;
+
+	double _interactionRadius = std::numeric_limits<double>::max();
 };
 
 #endif /* SRC_PARTICLECONTAINER_FULLPARTICLECELL_H_ */
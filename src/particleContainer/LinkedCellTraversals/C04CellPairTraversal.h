@@ -12,7 +12,9 @@
 #include "utils/threeDimensionalMapping.h"
 #include "utils/mardyn_assert.h"
 
-struct C04CellPairTraversalData : CellPairTraversalData {
+#include <limits>
+
+struct C04CellPairTraversalData : C08BasedTraversalData {
 };
 
 template <class CellTemplate>
@@ -37,6 +39,8 @@ public:
 	void traverseCellPairsOuter(CellProcessor& cellProcessor) {}
 	void traverseCellPairsInner(CellProcessor& cellProcessor, unsigned stage, unsigned stageCount) {}
 
+	unsigned maxCellsInCutoff() const override {return std::numeric_limits<unsigned>::max();}
+
 private:
 	void traverseCellPairsBackend(CellProcessor& cellProcessor,
 			const std::array<long, 3>& start,
@@ -65,10 +69,13 @@ private:
 template<class CellTemplate>
 inline void C04CellPairTraversal<CellTemplate>::traverseCellPairs(
 		CellProcessor& cellProcessor) {
+	// the colouring works on blocks of k^3 base cells, which behave like single base cells for k = 1
+	const long k = static_cast<long>(this->_cellsInCutoff);
 	std::array<long, 3> start, end;
 	for (int d = 0; d < 3; ++d) {
 		start[d] = 0l;
-		end[d] = static_cast<long>(this->_dims[d]) - 1;
+		// ceil((dims - k) / k) blocks cover all base cells
+		end[d] = (static_cast<long>(this->_dims[d]) - 1) / k;
 	}
 	traverseCellPairsBackend(cellProcessor, start, end);
 }
@@ -133,11 +140,20 @@ void C04CellPairTraversal<CellTemplate>::processBasePack32(
 			isIn = isIn and (index[d] >= start[d]) and (index[d] < end[d]);
 		}
 
-		if (isIn) {
+		if (not isIn) {
+			continue;
+		}
+
+		if (this->_cellsInCutoff == 1) {
 			unsigned long ulIndex = static_cast<unsigned long>(threeToOneD(index, signedDims));
 			C08BasedTraversals<CellTemplate>::processBaseCell(cellProcessor, ulIndex);
 		} else {
-			continue;
+			std::array<unsigned long, 3> blockStart, cellEnd;
+			for (int d = 0; d < 3; ++d) {
+				blockStart[d] = static_cast<unsigned long>(index[d]) * this->_cellsInCutoff;
+				cellEnd[d] = this->_dims[d] - this->_cellsInCutoff;
+			}
+			this->processBaseBlock(cellProcessor, blockStart, cellEnd);
 		}
 	}
 }
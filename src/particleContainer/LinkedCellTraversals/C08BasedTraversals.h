@@ -13,13 +13,36 @@
 #include "utils/threeDimensionalMapping.h"
 #include "WrapOpenMP.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief Geometry of the cell grid, from which the C08 based traversals derive their neighbour stencil.
+ */
+struct C08BasedTraversalData : CellPairTraversalData {
+	unsigned cellsInCutoff = 1; //!< cells have a width of at least cutoff / cellsInCutoff
+	std::array<double, 3> cellLength = {{0.0, 0.0, 0.0}};
+	double cutoff = 0.0; //!< cell pairs farther apart are skipped (0: keep all pairs of the stencil)
+};
+
+/**
+ * \brief Base class of traversals, which process the cell pairs block-wise around a base cell.
+ * \details For cellsInCutoff = k, the base cell b handles all pairs of cells c1, c2 within
+ * b + [0,k]^3, which have b as their component-wise minimum. Cell pairs, whose minimal distance
+ * exceeds the cutoff radius, are removed from the stencil. The traversals colour blocks of
+ * k^3 base cells instead of single base cells, so for k = 1 they reduce to the classic scheme.
+ * Cell pairs, whose minimal distance exceeds the interaction radii of both cells
+ * (see FullParticleCell::getInteractionRadius()), are skipped during the traversal.
+ */
 template <class CellTemplate>
 class C08BasedTraversals : public CellPairTraversals<CellTemplate> {
 public:
 	C08BasedTraversals(
 			std::vector<CellTemplate>& cells,
 			const std::array<unsigned long, 3>& dims) :
-			CellPairTraversals<CellTemplate>(cells, dims) {
+			CellPairTraversals<CellTemplate>(cells, dims), _cellsInCutoff(1), _cellLength({{0.0, 0.0, 0.0}}), _cutoff(0.0) {
 		computeOffsets();
 	}
 	virtual ~C08BasedTraversals() {
@@ -29,6 +52,11 @@ public:
 						 const std::array<unsigned long, 3> &dims,
 						 CellPairTraversalData *data) {
 		CellPairTraversals<CellTemplate>::rebuild(cells, dims, data);
+		if (C08BasedTraversalData* c08Data = dynamic_cast<C08BasedTraversalData*>(data)) {
+			_cellsInCutoff = c08Data->cellsInCutoff;
+			_cellLength = c08Data->cellLength;
+			_cutoff = c08Data->cutoff;
+		}
 		computeOffsets();
 	};
 
@@ -36,11 +64,20 @@ protected:
 	template <bool eighthShell=false>
 	void processBaseCell(CellProcessor& cellProcessor, unsigned long cellIndex) const;
 
+	//! @brief Process the base cells in [start, start + cellsInCutoff)^3, which lie below end.
+	void processBaseBlock(CellProcessor& cellProcessor, const std::array<unsigned long, 3>& start,
+			const std::array<unsigned long, 3>& end) const;
+
+	unsigned _cellsInCutoff;
+
 private:
 	void computeOffsets();
 
-	std::array<std::pair<unsigned long, unsigned long>, 14> _cellPairOffsets8Pack;
-	std::array<unsigned long, 8> _cellOffsets8Pack;
+	std::array<double, 3> _cellLength;
+	double _cutoff;
+
+	std::vector<std::pair<unsigned long, unsigned long> > _cellPairOffsets8Pack;
+	std::vector<double> _cellPairDistancesSquare8Pack; //!< minimal squared distance of the cells of each pair
 };
 
 template<class CellTemplate>
@@ -59,11 +96,11 @@ void C08BasedTraversals<CellTemplate>::processBaseCell(CellProcessor& cellProces
 	// map to 3D index and check that we're not on the "right" boundary
 	std::array<unsigned long, 3> threeDIndex = threeDimensionalMapping::oneToThreeD(baseIndex, this->_dims);
 	for (int d = 0; d < 3; ++d) {
-		mardyn_assert(threeDIndex[d] != this->_dims[d]-1);
+		mardyn_assert(threeDIndex[d] + _cellsInCutoff < this->_dims[d]);
 	}
 #endif
 
-	const int num_pairs = _cellPairOffsets8Pack.size();
+	const int num_pairs = static_cast<int>(_cellPairOffsets8Pack.size());
 	for(int j = 0; j < num_pairs; ++j) {
 		pair<long, long> current_pair = _cellPairOffsets8Pack[j];
 
@@ -80,6 +117,15 @@ void C08BasedTraversals<CellTemplate>::processBaseCell(CellProcessor& cellProces
 			continue;
 		}
 
+		// component dependent cutoff radii: the molecules of the cells are out of range
+		const double distanceSquare = _cellPairDistancesSquare8Pack[j];
+		if (distanceSquare > 0.0) {
+			const double radius = std::max(cell1.getInteractionRadius(), cell2.getInteractionRadius());
+			if (distanceSquare > radius * radius) {
+				continue;
+			}
+		}
+
 		if(cellIndex1 == cellIndex2) {
 			cellProcessor.processCell(cell1);
 		}
@@ -98,6 +144,23 @@ void C08BasedTraversals<CellTemplate>::processBaseCell(CellProcessor& cellProces
 	}
 }
 
+template<class CellTemplate>
+void C08BasedTraversals<CellTemplate>::processBaseBlock(CellProcessor& cellProcessor,
+		const std::array<unsigned long, 3>& start, const std::array<unsigned long, 3>& end) const {
+	const unsigned long end_x = std::min(start[0] + _cellsInCutoff, end[0]);
+	const unsigned long end_y = std::min(start[1] + _cellsInCutoff, end[1]);
+	const unsigned long end_z = std::min(start[2] + _cellsInCutoff, end[2]);
+
+	for (unsigned long z = start[2]; z < end_z; ++z) {
+		for (unsigned long y = start[1]; y < end_y; ++y) {
+			for (unsigned long x = start[0]; x < end_x; ++x) {
+				unsigned long baseIndex = threeDimensionalMapping::threeToOneD(x, y, z, this->_dims);
+				processBaseCell(cellProcessor, baseIndex);
+			}
+		}
+	}
+}
+
 template<class CellTemplate>
 void C08BasedTraversals<CellTemplate>::computeOffsets() {
 	using threeDimensionalMapping::threeToOneD;
@@ -108,44 +171,65 @@ void C08BasedTraversals<CellTemplate>::computeOffsets() {
 		dims[d] = static_cast<long>(this->_dims[d]);
 	}
 
-	long int o   = threeToOneD(0l, 0l, 0l, dims); // origin
-	long int x   = threeToOneD(1l, 0l, 0l, dims); // displacement to the right
-	long int y   = threeToOneD(0l, 1l, 0l, dims); // displacement ...
-	long int z   = threeToOneD(0l, 0l, 1l, dims);
-	long int xy  = threeToOneD(1l, 1l, 0l, dims);
-	long int yz  = threeToOneD(0l, 1l, 1l, dims);
-	long int xz  = threeToOneD(1l, 0l, 1l, dims);
-	long int xyz = threeToOneD(1l, 1l, 1l, dims);
-
-	int i = 0;
-	// if incrementing along X, the following order will be more cache-efficient:
-	_cellPairOffsets8Pack[i++] = make_pair(o, o  );
-	_cellPairOffsets8Pack[i++] = make_pair(o, y  );
-	_cellPairOffsets8Pack[i++] = make_pair(y, z  );
-	_cellPairOffsets8Pack[i++] = make_pair(o, z  );
-	_cellPairOffsets8Pack[i++] = make_pair(o, yz );
-
-	_cellPairOffsets8Pack[i++] = make_pair(x, yz );
-	_cellPairOffsets8Pack[i++] = make_pair(x, y  );
-	_cellPairOffsets8Pack[i++] = make_pair(x, z  );
-	_cellPairOffsets8Pack[i++] = make_pair(o, x  );
-	_cellPairOffsets8Pack[i++] = make_pair(o, xy );
-	_cellPairOffsets8Pack[i++] = make_pair(xy, z );
-	_cellPairOffsets8Pack[i++] = make_pair(y, xz );
-	_cellPairOffsets8Pack[i++] = make_pair(o, xz );
-	_cellPairOffsets8Pack[i++] = make_pair(o, xyz);
-
-	i = 0;
-	_cellOffsets8Pack[i++] =   o;
-	_cellOffsets8Pack[i++] =   y;
-	_cellOffsets8Pack[i++] =   z;
-	_cellOffsets8Pack[i++] =  yz;
-
-	_cellOffsets8Pack[i++] =   x;
-	_cellOffsets8Pack[i++] =  xy;
-	_cellOffsets8Pack[i++] =  xz;
-	_cellOffsets8Pack[i++] = xyz;
+	_cellPairOffsets8Pack.clear();
+	_cellPairDistancesSquare8Pack.clear();
+
+	if (_cellsInCutoff == 1) {
+		long int o   = threeToOneD(0l, 0l, 0l, dims); // origin
+		long int x   = threeToOneD(1l, 0l, 0l, dims); // displacement to the right
+		long int y   = threeToOneD(0l, 1l, 0l, dims); // displacement ...
+		long int z   = threeToOneD(0l, 0l, 1l, dims);
+		long int xy  = threeToOneD(1l, 1l, 0l, dims);
+		long int yz  = threeToOneD(0l, 1l, 1l, dims);
+		long int xz  = threeToOneD(1l, 0l, 1l, dims);
+		long int xyz = threeToOneD(1l, 1l, 1l, dims);
+
+		// if incrementing along X, the following order will be more cache-efficient:
+		_cellPairOffsets8Pack.push_back(make_pair(o, o  ));
+		_cellPairOffsets8Pack.push_back(make_pair(o, y  ));
+		_cellPairOffsets8Pack.push_back(make_pair(y, z  ));
+		_cellPairOffsets8Pack.push_back(make_pair(o, z  ));
+		_cellPairOffsets8Pack.push_back(make_pair(o, yz ));
+
+		_cellPairOffsets8Pack.push_back(make_pair(x, yz ));
+		_cellPairOffsets8Pack.push_back(make_pair(x, y  ));
+		_cellPairOffsets8Pack.push_back(make_pair(x, z  ));
+		_cellPairOffsets8Pack.push_back(make_pair(o, x  ));
+		_cellPairOffsets8Pack.push_back(make_pair(o, xy ));
+		_cellPairOffsets8Pack.push_back(make_pair(xy, z ));
+		_cellPairOffsets8Pack.push_back(make_pair(y, xz ));
+		_cellPairOffsets8Pack.push_back(make_pair(o, xz ));
+		_cellPairOffsets8Pack.push_back(make_pair(o, xyz));
+		// all cells of the stencil touch each other
+		_cellPairDistancesSquare8Pack.assign(_cellPairOffsets8Pack.size(), 0.0);
+		return;
+	}
+
+	// general stencil: all pairs of cells in [0,k]^3, which have the origin as component-wise minimum
+	const long k = static_cast<long>(_cellsInCutoff);
+	const long n = (k + 1) * (k + 1) * (k + 1);
+	const double cutoffSquare = _cutoff * _cutoff;
+	for (long i1 = 0; i1 < n; ++i1) {
+		const std::array<long, 3> c1 = {{i1 % (k + 1), (i1 / (k + 1)) % (k + 1), i1 / ((k + 1) * (k + 1))}};
+		for (long i2 = i1; i2 < n; ++i2) {
+			const std::array<long, 3> c2 = {{i2 % (k + 1), (i2 / (k + 1)) % (k + 1), i2 / ((k + 1) * (k + 1))}};
+
+			bool isBasePair = true;
+			double distanceSquare = 0.0;
+			for (int d = 0; d < 3; ++d) {
+				isBasePair = isBasePair and std::min(c1[d], c2[d]) == 0;
+				// minimal distance of the cells: number of cells in between times the cell width
+				const long cellsInBetween = std::max(std::abs(c1[d] - c2[d]) - 1l, 0l);
+				distanceSquare += (cellsInBetween * _cellLength[d]) * (cellsInBetween * _cellLength[d]);
+			}
+			if (not isBasePair or (_cutoff > 0.0 and distanceSquare > cutoffSquare)) {
+				continue;
+			}
 
+			_cellPairOffsets8Pack.push_back(make_pair(threeToOneD(c1, dims), threeToOneD(c2, dims)));
+			_cellPairDistancesSquare8Pack.push_back(distanceSquare);
+		}
+	}
 }
 
 
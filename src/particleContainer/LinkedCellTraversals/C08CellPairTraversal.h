@@ -13,7 +13,9 @@
 #include "utils/mardyn_assert.h"
 #include "C08BasedTraversals.h"
 
-struct C08CellPairTraversalData : CellPairTraversalData {
+#include <limits>
+
+struct C08CellPairTraversalData : C08BasedTraversalData {
 };
 
 template <class CellTemplate, bool eighthShell = false>
@@ -35,11 +37,18 @@ public:
 
 	bool requiresForceExchange() const override {return eighthShell;}
 
+	unsigned maxCellsInCutoff() const override {return eighthShell ? 1 : std::numeric_limits<unsigned>::max();}
+
 private:
 	void traverseCellPairsBackend(CellProcessor& cellProcessor,
 			const std::array<unsigned long, 3> & start,
 			const std::array<unsigned long, 3> & end,
 			const std::array<unsigned long, 3> & stride) const;
+
+	void traverseBlocksBackend(CellProcessor& cellProcessor,
+			const std::array<unsigned long, 3> & start,
+			const std::array<unsigned long, 3> & end,
+			const std::array<unsigned long, 3> & stride) const;
 };
 
 
@@ -48,10 +57,13 @@ void C08CellPairTraversal<CellTemplate, eighthShell>::traverseCellPairs(
 		CellProcessor& cellProcessor) {
 
 	using std::array;
-	const array<unsigned long, 3> strides = { 2, 2, 2 };
+	// blocks of k^3 base cells touch 2k cells per dimension, so blocks which are 2k apart are independent
+	const unsigned long k = this->_cellsInCutoff;
+	const array<unsigned long, 3> colours = { 2, 2, 2 };
+	const array<unsigned long, 3> strides = { 2 * k, 2 * k, 2 * k };
 	array<unsigned long, 3> end;
 	for (int d = 0; d < 3; ++d) {
-		end[d] = this->_dims[d] - 1;
+		end[d] = this->_dims[d] - k;
 	}
 
 	#if defined(_OPENMP)
@@ -59,14 +71,17 @@ void C08CellPairTraversal<CellTemplate, eighthShell>::traverseCellPairs(
 	#endif
 	{
 		for (unsigned long col = 0; col < 8; ++col) {
-			std::array<unsigned long, 3> begin = threeDimensionalMapping::oneToThreeD(col, strides);
+			std::array<unsigned long, 3> begin = threeDimensionalMapping::oneToThreeD(col, colours);
+			for (int d = 0; d < 3; ++d) {
+				begin[d] *= k;
+			}
 			if (eighthShell) {
 				// if we are using eighth shell, we start at 1,1,1 instead of 0,0,0
 				for (unsigned short i = 0; i < 3; ++i) {
 					begin[i] += 1;
 				}
 			}
-			traverseCellPairsBackend(cellProcessor, begin, end, strides);
+			traverseBlocksBackend(cellProcessor, begin, end, strides);
 			#if defined(_OPENMP)
 			#pragma omp barrier
 			#endif
@@ -87,7 +102,8 @@ void C08CellPairTraversal<CellTemplate, eighthShell>::traverseCellPairsOuter(
 	{
 		unsigned long minsize = min(this->_dims[0], min(this->_dims[1], this->_dims[2]));
 
-		if (minsize <= 5) {
+		// the splitting into inner and outer region is only implemented for cells of cutoff width
+		if (minsize <= 5 or this->_cellsInCutoff > 1) {
 			// iterating in the inner region didn't do anything. Iterate normally.
 			traverseCellPairs(cellProcessor);
 			return;
@@ -154,7 +170,7 @@ void C08CellPairTraversal<CellTemplate, eighthShell>::traverseCellPairsInner(
 
 	mardyn_assert(minsize >= 4);  // there should be at least 4 cells in each dimension, otherwise we did something stupid!
 
-	if (minsize <= 5) {
+	if (minsize <= 5 or this->_cellsInCutoff > 1) {
 		return;  // we can not iterate over any inner cells, that do not depend on boundary or halo cells
 	}
 
@@ -220,4 +236,32 @@ void C08CellPairTraversal<CellTemplate, eighthShell>::traverseCellPairsBackend(C
 }
 
 
+template<class CellTemplate, bool eighthShell>
+void C08CellPairTraversal<CellTemplate, eighthShell>::traverseBlocksBackend(CellProcessor& cellProcessor,
+		const std::array<unsigned long, 3>& start, const std::array<unsigned long, 3>& end,
+		const std::array<unsigned long, 3>& stride) const {
+
+	if (this->_cellsInCutoff == 1) {
+		traverseCellPairsBackend(cellProcessor, start, end, stride);
+		return;
+	}
+
+	// note parallel region is open outside
+	const unsigned long start_x = start[0], start_y = start[1], start_z = start[2];
+	const unsigned long end_x = end[0], end_y = end[1], end_z = end[2];
+	const unsigned long stride_x = stride[0], stride_y = stride[1], stride_z = stride[2];
+
+	#if defined(_OPENMP)
+	#pragma omp for schedule(dynamic, 1) collapse(3) nowait
+	#endif
+	for (unsigned long z = start_z; z < end_z; z += stride_z) {
+		for (unsigned long y = start_y; y < end_y; y += stride_y) {
+			for (unsigned long x = start_x; x < end_x; x += stride_x) {
+				const std::array<unsigned long, 3> blockStart = {{x, y, z}};
+				this->processBaseBlock(cellProcessor, blockStart, end);
+			}
+		}
+	}
+}
+
 #endif /* SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08CELLPAIRTRAVERSAL_H_ */
@@ -0,0 +1,239 @@
+/*
+ * C08WorkStealingTraversal.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08WORKSTEALINGTRAVERSAL_H_
+#define SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08WORKSTEALINGTRAVERSAL_H_
+
+#include "particleContainer/LinkedCellTraversals/C08BasedTraversals.h"
+#include "utils/threeDimensionalMapping.h"
+#include "WrapOpenMP.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+struct C08WorkStealingTraversalData : C08BasedTraversalData {
+};
+
+/**
+ * \brief C08 traversal with load balancing by work stealing, which needs neither OpenMP tasks nor an external library.
+ * \details The blocks of base cells are coloured like in the C08 traversal, so blocks of the same colour are
+ * independent. For every colour, the blocks are split into one contiguous range per thread, such that all ranges
+ * hold the same number of molecules. A thread processes its own range from the front. When it runs out of work,
+ * it steals single blocks from the back of the ranges of the other threads. Both ends of a range are kept in one
+ * atomic word, so taking a block is a single compare-and-swap.
+ */
+template <class CellTemplate>
+class C08WorkStealingTraversal : public C08BasedTraversals<CellTemplate> {
+public:
+	C08WorkStealingTraversal(
+			std::vector<CellTemplate>& cells,
+			const std::array<unsigned long, 3>& dims) :
+			C08BasedTraversals<CellTemplate>(cells, dims), _numRanges(0) {
+		computeColours();
+	}
+	~C08WorkStealingTraversal() {
+	}
+
+	void rebuild(std::vector<CellTemplate> &cells,
+				 const std::array<unsigned long, 3> &dims,
+				 CellPairTraversalData *data) override {
+		C08BasedTraversals<CellTemplate>::rebuild(cells, dims, data);
+		computeColours();
+	}
+
+	void traverseCellPairs(CellProcessor& cellProcessor);
+
+	//! the splitting into inner and outer region is not supported, the outer part processes everything
+	void traverseCellPairsOuter(CellProcessor& cellProcessor) {
+		traverseCellPairs(cellProcessor);
+	}
+	void traverseCellPairsInner(CellProcessor& /*cellProcessor*/, unsigned /*stage*/, unsigned /*stageCount*/) {
+	}
+
+	unsigned maxCellsInCutoff() const override {return std::numeric_limits<unsigned>::max();}
+
+private:
+	//! front (lower 32 bit) and back (upper 32 bit) of the blocks of one thread, padded to a cache line
+	struct Range {
+		std::atomic<uint64_t> bounds;
+		char padding[64 - sizeof(std::atomic<uint64_t>)];
+	};
+
+	static uint64_t packRange(uint32_t front, uint32_t back) {
+		return (static_cast<uint64_t>(back) << 32) | front;
+	}
+
+	//! @brief Take the next block from the front of the range. Returns false, if the range is empty.
+	static bool popFront(Range& range, uint32_t& block);
+
+	//! @brief Take the last block from the back of the range. Returns false, if the range is empty.
+	static bool stealBack(Range& range, uint32_t& block);
+
+	void computeColours();
+
+	//! @brief Split the blocks of a colour into equally loaded ranges, one per thread.
+	void distributeColour(unsigned colour, int numThreads);
+
+	void processBlock(CellProcessor& cellProcessor, unsigned long blockIndex) const;
+
+	unsigned long blockLoad(unsigned long blockIndex) const;
+
+	std::array<std::vector<unsigned long>, 8> _colourBlocks; //!< base cell index of every block, per colour
+	std::vector<unsigned long> _prefixLoad; //!< prefix sum of the block loads of the current colour
+	std::unique_ptr<Range[]> _ranges;
+	int _numRanges;
+};
+
+template<class CellTemplate>
+bool C08WorkStealingTraversal<CellTemplate>::popFront(Range& range, uint32_t& block) {
+	uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+	for (;;) {
+		const uint32_t front = static_cast<uint32_t>(bounds);
+		const uint32_t back = static_cast<uint32_t>(bounds >> 32);
+		if (front >= back) {
+			return false;
+		}
+		if (range.bounds.compare_exchange_weak(bounds, packRange(front + 1, back))) {
+			block = front;
+			return true;
+		}
+	}
+}
+
+template<class CellTemplate>
+bool C08WorkStealingTraversal<CellTemplate>::stealBack(Range& range, uint32_t& block) {
+	uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+	for (;;) {
+		const uint32_t front = static_cast<uint32_t>(bounds);
+		const uint32_t back = static_cast<uint32_t>(bounds >> 32);
+		if (front >= back) {
+			return false;
+		}
+		if (range.bounds.compare_exchange_weak(bounds, packRange(front, back - 1))) {
+			block = back - 1;
+			return true;
+		}
+	}
+}
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::computeColours() {
+	// same blocks and colours as C08CellPairTraversal::traverseCellPairs()
+	const unsigned long k = this->_cellsInCutoff;
+	for (unsigned long colour = 0; colour < 8; ++colour) {
+		std::vector<unsigned long>& blocks = _colourBlocks[colour];
+		blocks.clear();
+		const std::array<unsigned long, 3> begin = threeDimensionalMapping::oneToThreeD(colour, {{2ul, 2ul, 2ul}});
+		for (unsigned long z = begin[2] * k; z + k < this->_dims[2]; z += 2 * k) {
+			for (unsigned long y = begin[1] * k; y + k < this->_dims[1]; y += 2 * k) {
+				for (unsigned long x = begin[0] * k; x + k < this->_dims[0]; x += 2 * k) {
+					blocks.push_back(threeDimensionalMapping::threeToOneD(x, y, z, this->_dims));
+				}
+			}
+		}
+	}
+}
+
+template<class CellTemplate>
+unsigned long C08WorkStealingTraversal<CellTemplate>::blockLoad(unsigned long blockIndex) const {
+	// the molecules of the base cells estimate the work, +1 accounts for the overhead of empty cells
+	const unsigned long k = this->_cellsInCutoff;
+	const std::array<unsigned long, 3> start = threeDimensionalMapping::oneToThreeD(blockIndex, this->_dims);
+	unsigned long load = 0;
+	for (unsigned long z = start[2]; z < std::min(start[2] + k, this->_dims[2] - k); ++z) {
+		for (unsigned long y = start[1]; y < std::min(start[1] + k, this->_dims[1] - k); ++y) {
+			for (unsigned long x = start[0]; x < std::min(start[0] + k, this->_dims[0] - k); ++x) {
+				load += this->_cells->at(threeDimensionalMapping::threeToOneD(x, y, z, this->_dims)).getMoleculeCount() + 1;
+			}
+		}
+	}
+	return load;
+}
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::distributeColour(unsigned colour, int numThreads) {
+	const std::vector<unsigned long>& blocks = _colourBlocks[colour];
+	const size_t numBlocks = blocks.size();
+
+	_prefixLoad.resize(numBlocks + 1);
+	_prefixLoad[0] = 0;
+	for (size_t b = 0; b < numBlocks; ++b) {
+		_prefixLoad[b + 1] = _prefixLoad[b] + blockLoad(blocks[b]);
+	}
+
+	const unsigned long totalLoad = _prefixLoad[numBlocks];
+	uint32_t front = 0;
+	for (int t = 0; t < numThreads; ++t) {
+		const unsigned long targetLoad = totalLoad * (t + 1) / numThreads;
+		uint32_t back = static_cast<uint32_t>(
+				std::lower_bound(_prefixLoad.begin(), _prefixLoad.end(), targetLoad) - _prefixLoad.begin());
+		if (t == numThreads - 1) {
+			back = static_cast<uint32_t>(numBlocks);
+		}
+		_ranges[t].bounds.store(packRange(front, back), std::memory_order_relaxed);
+		front = back;
+	}
+}
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::processBlock(CellProcessor& cellProcessor, unsigned long blockIndex) const {
+	if (this->_cellsInCutoff == 1) {
+		this->processBaseCell(cellProcessor, blockIndex);
+		return;
+	}
+	const unsigned long k = this->_cellsInCutoff;
+	const std::array<unsigned long, 3> end = {{this->_dims[0] - k, this->_dims[1] - k, this->_dims[2] - k}};
+	this->processBaseBlock(cellProcessor, threeDimensionalMapping::oneToThreeD(blockIndex, this->_dims), end);
+}
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::traverseCellPairs(CellProcessor& cellProcessor) {
+	const int maxThreads = mardyn_get_max_threads();
+	if (_numRanges < maxThreads) {
+		_ranges.reset(new Range[maxThreads]);
+		_numRanges = maxThreads;
+	}
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		const int myID = mardyn_get_thread_num();
+		const int numThreads = mardyn_get_num_threads();
+
+		for (unsigned colour = 0; colour < 8; ++colour) {
+			const std::vector<unsigned long>& blocks = _colourBlocks[colour];
+
+			#if defined(_OPENMP)
+			#pragma omp single
+			#endif
+			distributeColour(colour, numThreads);
+			// implicit barrier of single: all ranges are set up
+
+			uint32_t block;
+			while (popFront(_ranges[myID], block)) {
+				processBlock(cellProcessor, blocks[block]);
+			}
+
+			// own range exhausted: steal from the others, until all ranges are empty
+			for (int i = 1; i < numThreads; ++i) {
+				Range& victim = _ranges[(myID + i) % numThreads];
+				while (stealBack(victim, block)) {
+					processBlock(cellProcessor, blocks[block]);
+				}
+			}
+
+			#if defined(_OPENMP)
+			#pragma omp barrier
+			#endif
+		}
+	} // end pragma omp parallel
+}
+
+#endif /* SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08WORKSTEALINGTRAVERSAL_H_ */
@@ -192,7 +192,8 @@ inline void OriginalCellPairTraversal<CellTemplate>::processBaseCell(CellProcess
 		}
 	} else
 	// loop over all boundary cells and calculate forces to forward and backward neighbours
-	if (currentCell.isBoundaryCell()) {
+	// (isBoundaryCell() is also true for halo cells, which lie next to the boundary in one dimension)
+	if (currentCell.isBoundaryCell() and not currentCell.isHaloCell()) {
 		cellProcessor.processCell(currentCell);
 		// loop over all forward neighbours
 		for (auto& neighbourOffset : this->_forwardNeighbourOffsets) {
@@ -12,16 +12,27 @@
 #include "utils/ThreeElementPermutations.h"
 #include "WrapOpenMP.h"
 
-struct SlicedCellPairTraversalData : CellPairTraversalData {
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+struct SlicedCellPairTraversalData : C08BasedTraversalData {
+	//! choose the slice boundaries from the particle counts of the cells instead of equal thickness
+	bool weighted = false;
+	//! weighted only: recompute the slice boundaries after this many traversals
+	unsigned rebalanceInterval = 10;
 };
 
 template<class CellTemplate>
 class SlicedCellPairTraversal: public C08BasedTraversals<CellTemplate> {
+	friend class LinkedCellsTest;
+
 public:
 	SlicedCellPairTraversal(
 		std::vector<CellTemplate> &cells, const std::array<unsigned long, 3> &dims) :
 		C08BasedTraversals<CellTemplate>(cells, dims)
 		, _locks(mardyn_get_max_threads() - 1, nullptr)
+		, _weighted(false), _rebalanceInterval(10), _traversalsSinceRebalance(0)
 	{
 		#if defined(_OPENMP)
 		#pragma omp parallel
@@ -34,7 +45,16 @@ public:
 		}
 	}
 
-	using C08BasedTraversals<CellTemplate>::rebuild;
+	void rebuild(std::vector<CellTemplate> &cells,
+				 const std::array<unsigned long, 3> &dims,
+				 CellPairTraversalData *data) override {
+		C08BasedTraversals<CellTemplate>::rebuild(cells, dims, data);
+		if (SlicedCellPairTraversalData* slicedData = dynamic_cast<SlicedCellPairTraversalData*>(data)) {
+			_weighted = slicedData->weighted;
+			_rebalanceInterval = std::max(slicedData->rebalanceInterval, 1u);
+		}
+		_sliceBounds.clear();
+	}
 
 	virtual ~SlicedCellPairTraversal() {
 		#if defined(_OPENMP)
@@ -52,18 +72,35 @@ public:
 	void traverseCellPairsOuter(CellProcessor& cellProcessor);
 	void traverseCellPairsInner(CellProcessor& cellProcessor, unsigned stage, unsigned stageCount);
 
-	static bool isApplicable(const std::array<unsigned long, 3>& dims);
+	unsigned maxCellsInCutoff() const override {return std::numeric_limits<unsigned>::max();}
+
+	static bool isApplicable(const std::array<unsigned long, 3>& dims, unsigned cellsInCutoff = 1);
 
 	static bool isApplicable(
 		const std::array<unsigned long, 3>& start,
-		const std::array<unsigned long, 3>& end);
+		const std::array<unsigned long, 3>& end,
+		unsigned cellsInCutoff = 1);
 
 protected:
+	/**
+	 * @param sliceBounds if not empty: the first slice of every thread, followed by the number of slices.
+	 * A slice is a layer of base cells perpendicular to the longest dimension of [start, end).
+	 */
 	void traverseCellPairsBackend(CellProcessor& cellProcessor,
 		const std::array<unsigned long, 3>& start,
-		const std::array<unsigned long, 3>& end
+		const std::array<unsigned long, 3>& end,
+		const std::vector<unsigned long>& sliceBounds = std::vector<unsigned long>()
 		);
 
+	/**
+	 * @brief Split the slices of [start, end) among numThreads threads, such that all threads get
+	 * about the same estimated work, but at least 2 * cellsInCutoff slices each.
+	 * The work of a base cell is estimated as N^2 + 1 for N molecules in the cell, since the number
+	 * of pairs grows with the square of the density.
+	 */
+	void computeSliceBounds(const std::array<unsigned long, 3>& start, const std::array<unsigned long, 3>& end,
+			int numThreads);
+
 private:
 	enum LockType {
 		MY_LOCK,
@@ -76,6 +113,11 @@ private:
 	void destroyLocks();
 
 	std::vector<mardyn_lock_t *> _locks;
+
+	bool _weighted;
+	unsigned _rebalanceInterval;
+	unsigned _traversalsSinceRebalance;
+	std::vector<unsigned long> _sliceBounds;
 };
 
 template<class CellTemplate>
@@ -85,10 +127,69 @@ inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairs(
 	const array<unsigned long, 3> start = { 0, 0, 0 };
 	array<unsigned long, 3> end;
 	for (int d = 0; d < 3; ++d) {
-		end[d] = this->_dims[d] - 1;
+		end[d] = this->_dims[d] - this->_cellsInCutoff;
 	}
 
-	traverseCellPairsBackend(cellProcessor, start, end);
+	if (not _weighted) {
+		traverseCellPairsBackend(cellProcessor, start, end);
+		return;
+	}
+
+	const int numThreads = mardyn_get_max_threads();
+	if (_sliceBounds.size() != static_cast<size_t>(numThreads) + 1 or _traversalsSinceRebalance >= _rebalanceInterval) {
+		computeSliceBounds(start, end, numThreads);
+		_traversalsSinceRebalance = 0;
+	}
+	++_traversalsSinceRebalance;
+	traverseCellPairsBackend(cellProcessor, start, end, _sliceBounds);
+}
+
+template<class CellTemplate>
+inline void SlicedCellPairTraversal<CellTemplate>::computeSliceBounds(
+		const std::array<unsigned long, 3>& start, const std::array<unsigned long, 3>& end, int numThreads) {
+
+	using namespace Permute3Elements;
+	using std::array;
+
+	const array<unsigned long, 3> diff = {end[0] - start[0], end[1] - start[1], end[2] - start[2]};
+	const Permutation perm = getPermutationForIncreasingSorting(diff);
+	const array<unsigned long, 3> diff_permuted = permuteForward(perm, diff);
+	const array<unsigned long, 3> start_permuted = permuteForward(perm, start);
+	const unsigned long numSlices = diff_permuted[2];
+	const unsigned long minSlices = 2 * this->_cellsInCutoff;
+
+	// prefix sum of the estimated work over the slices
+	std::vector<unsigned long> prefixWork(numSlices + 1, 0);
+	for (unsigned long s = 0; s < numSlices; ++s) {
+		unsigned long work = 0;
+		array<unsigned long, 3> ind_permuted;
+		ind_permuted[2] = start_permuted[2] + s;
+		for (unsigned long j = 0; j < diff_permuted[1]; ++j) {
+			ind_permuted[1] = start_permuted[1] + j;
+			for (unsigned long i = 0; i < diff_permuted[0]; ++i) {
+				ind_permuted[0] = start_permuted[0] + i;
+				const unsigned long cellIndex = threeDimensionalMapping::threeToOneD(permuteBackward(perm, ind_permuted), this->_dims);
+				const unsigned long N = this->_cells->at(cellIndex).getMoleculeCount();
+				work += N * N + 1;
+			}
+		}
+		prefixWork[s + 1] = prefixWork[s] + work;
+	}
+
+	_sliceBounds.assign(numThreads + 1, 0);
+	_sliceBounds[numThreads] = numSlices;
+	if (numSlices < minSlices * numThreads) {
+		// not applicable anyway, the backend will complain
+		return;
+	}
+	for (int t = 1; t < numThreads; ++t) {
+		const unsigned long target = prefixWork[numSlices] * t / numThreads;
+		unsigned long bound = std::lower_bound(prefixWork.begin(), prefixWork.end(), target) - prefixWork.begin();
+		// every thread needs 2k slices for the locking scheme, also the remaining threads
+		bound = std::max(bound, _sliceBounds[t - 1] + minSlices);
+		bound = std::min(bound, numSlices - minSlices * (numThreads - t));
+		_sliceBounds[t] = bound;
+	}
 }
 
 template<class CellTemplate>
@@ -99,7 +200,8 @@ inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairsOuter(
 	{
 		unsigned long minsize = std::min(this->_dims[0], std::min(this->_dims[1], this->_dims[2]));
 
-		if (minsize <= 5) {
+		// the splitting into inner and outer region is only implemented for cells of cutoff width
+		if (minsize <= 5 or this->_cellsInCutoff > 1) {
 			// iterating in the inner region didn't do anything. Iterate normally.
 			traverseCellPairs(cellProcessor);
 			return;
@@ -162,7 +264,7 @@ inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairsInner(
 
 	mardyn_assert(minsize >= 4);  // there should be at least 4 cells in each dimension, otherwise we did something stupid!
 
-	if (minsize <= 5) {
+	if (minsize <= 5 or this->_cellsInCutoff > 1) {
 		return;  // we can not iterate over any inner cells, that do not depend on boundary or halo cells
 	}
 
@@ -182,14 +284,15 @@ template<class CellTemplate>
 inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairsBackend(
 		CellProcessor& cellProcessor,
 		const std::array<unsigned long, 3>& start,
-		const std::array<unsigned long, 3>& end
+		const std::array<unsigned long, 3>& end,
+		const std::vector<unsigned long>& sliceBounds
 		) {
 
 	using namespace Permute3Elements;
 	using std::array;
 
 	// Note: in the following we quasi-reimplement an OpenMP for-loop parallelisation with static scheduling
-	if (not isApplicable(start, end) ) {
+	if (not isApplicable(start, end, this->_cellsInCutoff) ) {
 		Log::global_log->error() << "The SlicedCellPairTraversal is not applicable. Aborting." << std::endl;
 		mardyn_exit(1);
 	}
@@ -217,10 +320,16 @@ inline void SlicedCellPairTraversal<CellTemplate>::traverseCellPairsBackend(
 		int my_id = mardyn_get_thread_num();
 		int num_threads = mardyn_get_num_threads();
 
-		const unsigned long my_start = num_cells * my_id / num_threads;
-		const unsigned long my_end = num_cells * (my_id + 1) / num_threads;
+		unsigned long my_start = num_cells * my_id / num_threads;
+		unsigned long my_end = num_cells * (my_id + 1) / num_threads;
+		if (sliceBounds.size() == static_cast<size_t>(num_threads) + 1) {
+			const unsigned long cells_per_slice = diff_permuted[0] * diff_permuted[1];
+			my_start = sliceBounds[my_id] * cells_per_slice;
+			my_end = sliceBounds[my_id + 1] * cells_per_slice;
+		}
 		const unsigned long my_num_cells = my_end - my_start; // a rough measure should be enough?
-		const unsigned long slice_size = diff_permuted[0] * diff_permuted[1];
+		// a base cell touches the k following slices, so the first and last k slices of neighbouring threads conflict
+		const unsigned long slice_size = diff_permuted[0] * diff_permuted[1] * this->_cellsInCutoff;
 		unsigned long my_progress_counter = 0;
 
 		acquireLock(MY_LOCK);
@@ -318,21 +427,22 @@ inline void SlicedCellPairTraversal<CellTemplate>::initLocks() {
 
 template<class CellTemplate>
 inline bool SlicedCellPairTraversal<CellTemplate>::isApplicable(
-		const std::array<unsigned long, 3>& dims) {
+		const std::array<unsigned long, 3>& dims, unsigned cellsInCutoff) {
 	using std::array;
 	const array<unsigned long, 3> start = { 0, 0, 0 };
 	array<unsigned long, 3> end;
 	for (int d = 0; d < 3; ++d) {
-		end[d] = dims[d] - 1;
+		end[d] = dims[d] - cellsInCutoff;
 	}
 
-	return isApplicable(start, end);
+	return isApplicable(start, end, cellsInCutoff);
 }
 
 template<class CellTemplate>
 inline bool SlicedCellPairTraversal<CellTemplate>::isApplicable(
 		const std::array<unsigned long, 3>& start,
-		const std::array<unsigned long, 3>& end) {
+		const std::array<unsigned long, 3>& end,
+		unsigned cellsInCutoff) {
 
 	using namespace Permute3Elements;
 	using std::array;
@@ -349,7 +459,7 @@ inline bool SlicedCellPairTraversal<CellTemplate>::isApplicable(
 	}
 
 	const size_t my_num_cells = num_cells / num_threads; // a rough measure should be enough? // lower bound ?
-	const size_t slice_size = dimsPermuted[0] * dimsPermuted[1];
+	const size_t slice_size = dimsPermuted[0] * dimsPermuted[1] * cellsInCutoff;
 
 	const bool ret = my_num_cells >= 2 * slice_size or num_threads == 1;
 
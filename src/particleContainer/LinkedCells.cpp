@@ -8,13 +8,16 @@
 #include "particleContainer/handlerInterfaces/ParticlePairsHandler.h"
 #include "particleContainer/adapter/CellProcessor.h"
 #include "particleContainer/adapter/LegacyCellProcessor.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
 #include "ParticleCell.h"
 #include "molecules/Molecule.h"
 #include "utils/Logger.h"
 #include "utils/mardyn_assert.h"
 #include "utils/Random.h"
+#include "utils/threeDimensionalMapping.h"
 #include <array>
 #include <algorithm>
+#include <utility>
 
 #include "particleContainer/TraversalTuner.h"
 
@@ -35,12 +38,14 @@ using Log::global_log;
 //############ PUBLIC METHODS ####################
 //################################################
 
-LinkedCells::LinkedCells() : ParticleContainer(), _traversalTuner(new TraversalTuner<ParticleCell>()), _resortCellProcessorSliced(nullptr) {
+LinkedCells::LinkedCells() : ParticleContainer(), _traversalTuner(new TraversalTuner<ParticleCell>()), _resortCellProcessorSliced(nullptr),
+		_leavingMoleculesDetected(false) {
 }
 
 LinkedCells::LinkedCells(double bBoxMin[3], double bBoxMax[3],
 		double cutoffRadius) :
-		ParticleContainer(bBoxMin, bBoxMax), _traversalTuner(new TraversalTuner<ParticleCell>()) {
+		ParticleContainer(bBoxMin, bBoxMax), _traversalTuner(new TraversalTuner<ParticleCell>()), _resortCellProcessorSliced(nullptr),
+		_leavingMoleculesDetected(false) {
 	int numberOfCells = 1;
 	_cutoffRadius = cutoffRadius;
 
@@ -105,6 +110,7 @@ LinkedCells::LinkedCells(double bBoxMin[3], double bBoxMax[3],
 
 	_cellsValid = false;
 	_resortCellProcessorSliced = nullptr;
+	_leavingMoleculesDetected = false;
 }
 
 LinkedCells::~LinkedCells() {
@@ -118,18 +124,81 @@ LinkedCells::~LinkedCells() {
 
 void LinkedCells::initializeTraversal() {
 	std::array<long unsigned, 3> dims;
+	std::array<double, 3> cellLength;
 	for (int d = 0; d < 3; ++d) {
 		dims[d] = _cellsPerDimension[d];
+		cellLength[d] = _cellLength[d];
 	}
-	_traversalTuner->rebuild(_cells, dims);
+	_traversalTuner->rebuild(_cells, dims, _cellsInCutoff, cellLength, _cutoffRadius);
 }
 
 void LinkedCells::readXML(XMLfileUnits& xmlconfig) {
 	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // new
 	mardyn_assert(_cellsInCutoff>=1); // new
 
+	_verletSkin = xmlconfig.getNodeValue_double("verletSkin", 0.0);
+	if (_verletSkin < 0.0) {
+		global_log->error() << "LinkedCells: verletSkin must not be negative, but is " << _verletSkin << endl;
+		Simulation::exit(1);
+	}
+	if (_verletSkin > 0.0) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+		global_log->info() << "LinkedCells: using cell pair Verlet lists with skin " << _verletSkin << endl;
+#else
+		global_log->warning() << "LinkedCells: Verlet lists are not supported in reduced memory mode, ignoring verletSkin." << endl;
+		_verletSkin = 0.0;
+#endif
+	}
+
+	xmlconfig.getNodeValue("sortMolecules", _sortMolecules);
+	if (_sortMolecules) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+		global_log->info() << "LinkedCells: sorting molecules along a Morton curve before rebuilding the SoA caches" << endl;
+#else
+		global_log->warning() << "LinkedCells: sorting molecules is not supported in reduced memory mode, ignoring sortMolecules." << endl;
+		_sortMolecules = false;
+#endif
+	}
+
+	bool compactIDs = false;
+	xmlconfig.getNodeValue("compactIDs", compactIDs);
+	if (compactIDs) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+		global_log->info() << "LinkedCells: storing the molecule IDs as 32-bit offsets to a per-cell base" << endl;
+		CellDataSoARMM::setCompactUIDs(true);
+#else
+		global_log->warning() << "LinkedCells: compact IDs are only supported in reduced memory mode, ignoring compactIDs." << endl;
+#endif
+	}
+
 	_traversalTuner = std::unique_ptr<TraversalTuner<ParticleCell>>(new TraversalTuner<ParticleCell>()); // new way to assign _traversalTuner
 	_traversalTuner->readXML(xmlconfig);
+
+	bool compactHaloCells = false;
+	xmlconfig.getNodeValue("compactHaloCells", compactHaloCells);
+	setCompactHaloCells(compactHaloCells);
+}
+
+void LinkedCells::setCompactHaloCells(bool compact) {
+	_compactHaloCells = false;
+	if (not compact) {
+		return;
+	}
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	// the force exchange needs the forces on the halo molecules, autotuning never selects such traversals
+	using traversalNames = TraversalTuner<ParticleCell>::traversalNames;
+	const traversalNames selected = _traversalTuner->getSelectedTraversal();
+	if (not _traversalTuner->isAutotuning() and (selected == traversalNames::HS or selected == traversalNames::MP
+			or selected == traversalNames::C08ES)) {
+		global_log->warning() << "LinkedCells: compact halo cells are not supported with traversals that require "
+				<< "a force exchange, ignoring compactHaloCells." << endl;
+		return;
+	}
+	global_log->info() << "LinkedCells: storing halo copies in compact form" << endl;
+	_compactHaloCells = true;
+#else
+	global_log->warning() << "LinkedCells: compact halo cells are not supported in reduced memory mode, ignoring compactHaloCells." << endl;
+#endif
 }
 
 bool LinkedCells::rebuild(double bBoxMin[3], double bBoxMax[3]) {
@@ -189,6 +258,7 @@ bool LinkedCells::rebuild(double bBoxMin[3], double bBoxMax[3]) {
 	}
 
 	initializeCells();
+	setVerletSkin(_verletSkin);
 
 	// TODO: We loose particles here as they are not communicated to the new owner
 	// delete all Particles which are outside of the halo region
@@ -246,7 +316,7 @@ void LinkedCells::update() {
 
 	// TODO: replace via a cellProcessor and a traverseCells call ?
 #ifndef ENABLE_REDUCED_MEMORY_MODE
-	update_via_copies();
+	update_via_thread_buffers();
 #else
 //	update_via_coloring();
 	std::array<long unsigned, 3> dims = {
@@ -258,10 +328,13 @@ void LinkedCells::update() {
 		if (_resortCellProcessorSliced == nullptr) {
 			_resortCellProcessorSliced = new ResortCellProcessorSliced(this);
 		}
+		_resortCellProcessorSliced->setOnlyCellsWithLeavingMolecules(_leavingMoleculesDetected);
 		_traversalTuner->traverseCellPairs(TraversalTuner<ParticleCell>::traversalNames::SLICED, *_resortCellProcessorSliced);
+		_resortCellProcessorSliced->setOnlyCellsWithLeavingMolecules(false);
 	} else {
 		update_via_traversal();
 	}
+	_leavingMoleculesDetected = false;
 #endif
 
 	_cellsValid = true;
@@ -351,6 +424,88 @@ void LinkedCells::update_via_copies() {
 		}
 	} // end pragma omp parallel
 }
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+void LinkedCells::update_via_thread_buffers() {
+	typedef std::vector<std::pair<unsigned long, Molecule>> LeavingBuffer;
+
+	const unsigned long numCells = _cells.size();
+	const int maxThreads = mardyn_get_max_threads();
+	if (_leavingMoleculeBuffers.size() < static_cast<size_t>(maxThreads)) {
+		_leavingMoleculeBuffers.resize(maxThreads);
+	}
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		const int threadID = mardyn_get_thread_num();
+		const int numThreads = mardyn_get_num_threads();
+		LeavingBuffer& myBuffer = _leavingMoleculeBuffers[threadID];
+		myBuffer.clear();
+
+		// 1. every thread removes the leaving molecules of its cells and tags them with their new cell
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (unsigned long cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+			for (auto it = _cells[cellIndex].iterator(); it.isValid(); ++it) {
+				it->setSoA(nullptr);
+				if (not _cells[cellIndex].testInBox(*it)) {
+					myBuffer.emplace_back(getTargetCellIndex(*it, cellIndex), std::move(*it));
+					it.deleteCurrentParticle();
+				}
+			}
+		}
+
+		// the buffer of each thread is sorted by target cell, keeping the order within a cell
+		std::stable_sort(myBuffer.begin(), myBuffer.end(),
+				[](const LeavingBuffer::value_type& a, const LeavingBuffer::value_type& b) { return a.first < b.first; });
+
+		#if defined(_OPENMP)
+		#pragma omp barrier
+		#endif
+
+		// 2. every thread inserts the molecules for its own range of target cells,
+		// which it locates in the sorted buffers of all threads via binary search
+		const unsigned long myCellsBegin = threadID * numCells / numThreads;
+		const unsigned long myCellsEnd = (threadID + 1) * numCells / numThreads;
+		for (int t = 0; t < numThreads; ++t) {
+			LeavingBuffer& buffer = _leavingMoleculeBuffers[t];
+			auto it = std::lower_bound(buffer.begin(), buffer.end(), myCellsBegin,
+					[](const LeavingBuffer::value_type& a, unsigned long index) { return a.first < index; });
+			for (; it != buffer.end() and it->first < myCellsEnd; ++it) {
+				_cells[it->first].addParticle(it->second);
+			}
+		}
+	} // end pragma omp parallel
+}
+
+unsigned long LinkedCells::getTargetCellIndex(Molecule& molecule, unsigned long currentCellIndex) const {
+	if (not molecule.inBox(_haloBoundingBoxMin, _haloBoundingBoxMax)) {
+		return currentCellIndex;
+	}
+	const unsigned long cellIndex = getCellIndexOfMolecule(&molecule);
+	if (_cells[cellIndex].testInBox(molecule)) {
+		return cellIndex;
+	}
+
+	// rounding may differ between getCellIndexOfMolecule() and testInBox(): the latter decides
+	int cell3D[3];
+	threeDIndexOfCellIndex(cellIndex, cell3D, _cellsPerDimension);
+	for (int z = std::max(cell3D[2] - 1, 0); z <= std::min(cell3D[2] + 1, _cellsPerDimension[2] - 1); ++z) {
+		for (int y = std::max(cell3D[1] - 1, 0); y <= std::min(cell3D[1] + 1, _cellsPerDimension[1] - 1); ++y) {
+			for (int x = std::max(cell3D[0] - 1, 0); x <= std::min(cell3D[0] + 1, _cellsPerDimension[0] - 1); ++x) {
+				const unsigned long neighbourIndex = cellIndexOf3DIndex(x, y, z);
+				if (_cells[neighbourIndex].testInBox(molecule)) {
+					return neighbourIndex;
+				}
+			}
+		}
+	}
+	return cellIndex;
+}
+#endif
+
 void LinkedCells::update_via_coloring() {
 	std::array<std::pair<unsigned long, unsigned long>, 14> cellPairOffsets = calculateCellPairOffsets();
 
@@ -416,11 +571,17 @@ void LinkedCells::update_via_sliced_traversal() {
 void LinkedCells::update_via_traversal() {
 	class ResortCellProcessor : public CellProcessor {
 	public:
-		ResortCellProcessor() : CellProcessor(0.0, 0.0) {}
+		ResortCellProcessor(bool onlyCellsWithLeavingMolecules) : CellProcessor(0.0, 0.0),
+				_onlyCellsWithLeavingMolecules(onlyCellsWithLeavingMolecules) {}
 		void initTraversal() {}
 		void preprocessCell(ParticleCell& ) {}
 
 		void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false) { // does this need a bool?
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+				if (_onlyCellsWithLeavingMolecules and not cell1.hasLeavingMolecules() and not cell2.hasLeavingMolecules()) {
+					return;
+				}
+#endif
 				cell1.updateLeavingMoleculesBase(cell2);
 		}
 
@@ -429,7 +590,9 @@ void LinkedCells::update_via_traversal() {
 		void postprocessCell(ParticleCell& ) {}
 		void endTraversal() {}
 
-	} resortCellProcessor;
+	private:
+		const bool _onlyCellsWithLeavingMolecules;
+	} resortCellProcessor(_leavingMoleculesDetected);
 	_traversalTuner->traverseCellPairs(resortCellProcessor);
 }
 
@@ -441,6 +604,7 @@ bool LinkedCells::addParticle(Molecule& particle, bool inBoxCheckedAlready, bool
 		wasInserted = _cells[cellIndex].addParticle(particle, checkWhetherDuplicate);
 		if (rebuildCaches) {
 			_cells[cellIndex].buildSoACaches();
+			updateCellInteractionRadius(_cells[cellIndex]);
 		}
 	}
 	return wasInserted;
@@ -535,6 +699,56 @@ void LinkedCells::addParticles(vector<Molecule>& particles, bool checkWhetherDup
 	return;
 }
 
+bool LinkedCells::addHaloParticle(Molecule& particle, bool inBoxCheckedAlready, bool checkWhetherDuplicate, const bool& rebuildCaches) {
+	if (not _compactHaloCells) {
+		return ParticleContainer::addHaloParticle(particle, inBoxCheckedAlready, checkWhetherDuplicate, rebuildCaches);
+	}
+
+	bool wasInserted = false;
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	mardyn_assert(not particle.inBox(_boundingBoxMin, _boundingBoxMax));
+	const bool inBox = inBoxCheckedAlready or particle.inBox(_haloBoundingBoxMin, _haloBoundingBoxMax);
+	if (inBox) {
+		int cellIndex = getCellIndexOfMolecule(&particle);
+		wasInserted = _cells[cellIndex].addCompactHaloParticle(particle, checkWhetherDuplicate);
+		if (rebuildCaches) {
+			_cells[cellIndex].buildSoACaches();
+			updateCellInteractionRadius(_cells[cellIndex]);
+		}
+	}
+#endif
+	return wasInserted;
+}
+
+void LinkedCells::addHaloParticles(vector<Molecule>& particles, bool checkWhetherDuplicate) {
+	if (not _compactHaloCells) {
+		addParticles(particles, checkWhetherDuplicate);
+		return;
+	}
+
+	// compact halo copies are cheap to insert, a serial loop suffices
+	for (Molecule& particle : particles) {
+		mardyn_assert(particle.inBox(_haloBoundingBoxMin, _haloBoundingBoxMax));
+		addHaloParticle(particle, true, checkWhetherDuplicate);
+	}
+}
+
+void LinkedCells::getCompactHaloCopiesInRegion(const double lowCorner[3], const double highCorner[3],
+		std::vector<Molecule>& molecules) {
+	if (not _compactHaloCells) {
+		return;
+	}
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	for (unsigned long cellIndex : _haloCellIndices) {
+		for (const CompactHaloMolecule& m : _cells[cellIndex].getCompactHaloMolecules()) {
+			if (m.inBox(lowCorner, highCorner)) {
+				molecules.push_back(m.toMolecule());
+			}
+		}
+	}
+#endif
+}
+
 void LinkedCells::traverseNonInnermostCells(CellProcessor& cellProcessor) {
 	if (_cellsValid == false) {
 		global_log->error() << "Cell structure in LinkedCells (traverseNonInnermostCells) invalid, call update first" << endl;
@@ -563,6 +777,38 @@ void LinkedCells::traverseCells(CellProcessor& cellProcessor) {
 
 	cellProcessor.initTraversal();
 	_traversalTuner->traverseCellPairs(cellProcessor);
+	if (cellProcessor.requiresPostprocessing()) {
+		// all forces are final now
+		const long numCells = static_cast<long>(_cells.size());
+		#if defined(_OPENMP)
+		#pragma omp parallel for schedule(dynamic, 64)
+		#endif
+		for (long cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+			cellProcessor.postprocessCell(_cells[cellIndex]);
+		}
+	}
+	cellProcessor.endTraversal();
+}
+
+void LinkedCells::traverseCellsIndependently(CellProcessor& cellProcessor) {
+	if (_cellsValid == false) {
+		global_log->error()
+				<< "Cell structure in LinkedCells (traverseCellsIndependently) invalid, call update first"
+				<< endl;
+		Simulation::exit(1);
+	}
+
+	cellProcessor.initTraversal();
+	const long numCells = static_cast<long>(_cells.size());
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic, 64)
+	#endif
+	for (long cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+		ParticleCell& cell = _cells[cellIndex];
+		if (not cell.isHaloCell()) {
+			cellProcessor.processCell(cell);
+		}
+	}
 	cellProcessor.endTraversal();
 }
 
@@ -647,7 +893,7 @@ void LinkedCells::initializeCells() {
 	ParticleCell::_cellBorderAndFlagManager.init(_cellsPerDimension,
 			_haloBoundingBoxMin, _haloBoundingBoxMax,
 			_boundingBoxMin, _boundingBoxMax,
-			_cellLength);
+			_cellLength, _haloWidthInNumCells);
 
 	for (int iz = 0; iz < _cellsPerDimension[2]; ++iz) {
 		for (int iy = 0; iy < _cellsPerDimension[1]; ++iy) {
@@ -669,6 +915,33 @@ void LinkedCells::initializeCells() {
 			}
 		}
 	}
+
+	const std::array<unsigned long, 3> dims = {{
+		static_cast<unsigned long>(_cellsPerDimension[0]),
+		static_cast<unsigned long>(_cellsPerDimension[1]),
+		static_cast<unsigned long>(_cellsPerDimension[2])
+	}};
+	std::vector<std::pair<uint64_t, unsigned long>> mortonIndices(_cells.size());
+	for (unsigned long i = 0; i < _cells.size(); ++i) {
+		const std::array<unsigned long, 3> pos = threeDimensionalMapping::oneToThreeD(i, dims);
+		mortonIndices[i] = std::make_pair(threeDimensionalMapping::threeToMorton(pos[0], pos[1], pos[2]), i);
+	}
+	std::sort(mortonIndices.begin(), mortonIndices.end());
+	_mortonCellOrder.resize(_cells.size());
+	for (unsigned long i = 0; i < _cells.size(); ++i) {
+		_mortonCellOrder[i] = mortonIndices[i].second;
+	}
+}
+
+void LinkedCells::setVerletSkin(double skin) {
+	_verletSkin = skin;
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	for (unsigned long cellIndex = 0; cellIndex < _cells.size(); ++cellIndex) {
+		int position[3];
+		threeDIndexOfCellIndex(cellIndex, position, _cellsPerDimension);
+		_cells[cellIndex].getVerletLists().setSkin(_verletSkin, position, _haloWidthInNumCells);
+	}
+#endif
 }
 
 void LinkedCells::calculateNeighbourIndices(std::vector<long>& forwardNeighbourOffsets, std::vector<long>& backwardNeighbourOffsets) const {
@@ -884,6 +1157,25 @@ void LinkedCells::getCellIndicesOfRegion(const double startRegion[3], const doub
 	endIndex = getCellIndexOfPoint(endRegion);
 }
 
+void LinkedCells::getCellIndicesInRegion(const double startRegion[3], const double endRegion[3], std::vector<unsigned long>& cellIndices) {
+	unsigned int startRegionCellIndex;
+	unsigned int endRegionCellIndex;
+	getCellIndicesOfRegion(startRegion, endRegion, startRegionCellIndex, endRegionCellIndex);
+
+	int start3DIndices[3], end3DIndices[3];
+	threeDIndexOfCellIndex(startRegionCellIndex, start3DIndices, _cellsPerDimension);
+	threeDIndexOfCellIndex(endRegionCellIndex, end3DIndices, _cellsPerDimension);
+
+	cellIndices.clear();
+	for (int iz = start3DIndices[2]; iz <= end3DIndices[2]; ++iz) {
+		for (int iy = start3DIndices[1]; iy <= end3DIndices[1]; ++iy) {
+			for (int ix = start3DIndices[0]; ix <= end3DIndices[0]; ++ix) {
+				cellIndices.push_back(cellIndexOf3DIndex(ix, iy, iz));
+			}
+		}
+	}
+}
+
 unsigned long LinkedCells::initCubicGrid(std::array<unsigned long, 3> numMoleculesPerDimension, std::array<double, 3> simBoxLength) {
 	const unsigned long numCells = _cells.size();
 
@@ -985,18 +1277,11 @@ void LinkedCells::deleteMolecule(Molecule &molecule, const bool& rebuildCaches)
 	}
 	else if (rebuildCaches) {
 		_cells[cellid].buildSoACaches();
+		updateCellInteractionRadius(_cells[cellid]);
 	}
 }
 
 double LinkedCells::getEnergy(ParticlePairsHandler* particlePairsHandler, Molecule* m1, CellProcessor& cellProcessorI) {
-	CellProcessor* cellProcessor;
-	if (dynamic_cast<LegacyCellProcessor*>(&cellProcessorI)) {
-		cellProcessor = &cellProcessorI;
-	} else {
-		cellProcessor = new LegacyCellProcessor(cellProcessorI.getCutoffRadius(), cellProcessorI.getLJCutoffRadius(),
-				particlePairsHandler);
-	}
-
 	double u = 0.0;
 
 	unsigned long cellIndex = getCellIndexOfMolecule(m1);
@@ -1005,37 +1290,52 @@ double LinkedCells::getEnergy(ParticlePairsHandler* particlePairsHandler, Molecu
 
 	mardyn_assert(not currentCell.isHaloCell());
 
-	Molecule molWithSoA = *m1;
-	molWithSoA.buildOwnSoA();
-
-	cellProcessor->initTraversal();
-
-	u += cellProcessor->processSingleMolecule(&molWithSoA, currentCell);
-
 	vector<long> forwardNeighbourOffsets; // now vector
 	vector<long> backwardNeighbourOffsets; // now vector
 	calculateNeighbourIndices(forwardNeighbourOffsets, backwardNeighbourOffsets);
 
-	// forward neighbours
-	for (auto neighbourOffsetsIter = forwardNeighbourOffsets.begin();
-			neighbourOffsetsIter != forwardNeighbourOffsets.end();
-			neighbourOffsetsIter++) {
-		ParticleCell& neighbourCell = _cells[cellIndex + *neighbourOffsetsIter];
-		u += cellProcessor->processSingleMolecule(&molWithSoA, neighbourCell);
+	// the cell of m1 first, then the forward and backward neighbours
+	vector<ParticleCell*> cells;
+	cells.reserve(1 + forwardNeighbourOffsets.size() + backwardNeighbourOffsets.size());
+	cells.push_back(&currentCell);
+	for (long offset : forwardNeighbourOffsets) {
+		cells.push_back(&_cells[cellIndex + offset]);
 	}
-	// backward neighbours
-	for (auto neighbourOffsetsIter = backwardNeighbourOffsets.begin();
-			neighbourOffsetsIter != backwardNeighbourOffsets.end();
-			neighbourOffsetsIter++) {
-		ParticleCell& neighbourCell = _cells[cellIndex - *neighbourOffsetsIter];
-		u += cellProcessor->processSingleMolecule(&molWithSoA, neighbourCell);
+	for (long offset : backwardNeighbourOffsets) {
+		cells.push_back(&_cells[cellIndex - offset]);
+	}
+
+	// the VectorizedCellProcessor evaluates test molecules outside of traversals,
+	// whose end would overwrite the macroscopic values of the force calculation in the Domain
+	VectorizedCellProcessor* vectorizedCellProcessor = dynamic_cast<VectorizedCellProcessor*>(&cellProcessorI);
+	if (vectorizedCellProcessor != nullptr) {
+		u = vectorizedCellProcessor->processSingleMolecule(m1, cells);
+		mardyn_assert(not std::isnan(u)); // catches NaN
+		return u;
+	}
+
+	CellProcessor* cellProcessor;
+	if (dynamic_cast<LegacyCellProcessor*>(&cellProcessorI)) {
+		cellProcessor = &cellProcessorI;
+	} else {
+		cellProcessor = new LegacyCellProcessor(cellProcessorI.getCutoffRadius(), cellProcessorI.getLJCutoffRadius(),
+				particlePairsHandler);
+	}
+
+	Molecule molWithSoA = *m1;
+	molWithSoA.buildOwnSoA();
+
+	cellProcessor->initTraversal();
+
+	for (ParticleCell* cell : cells) {
+		u += cellProcessor->processSingleMolecule(&molWithSoA, *cell);
 	}
 
 	cellProcessor->endTraversal();
 
 	molWithSoA.releaseOwnSoA();
 
-	if (!dynamic_cast<LegacyCellProcessor*>(&cellProcessorI)) {
+	if (cellProcessor != &cellProcessorI) {
 		delete cellProcessor;
 	}
 
@@ -1048,9 +1348,10 @@ void LinkedCells::updateInnerMoleculeCaches() {
 	#if defined(_OPENMP)
 	#pragma omp parallel for schedule(static)
 	#endif
-	for (long int cellIndex = 0; cellIndex < (long int) _cells.size(); cellIndex++) {
-		if(_cells[cellIndex].isInnerCell()){
-			_cells[cellIndex].buildSoACaches();
+	for (long int i = 0; i < (long int) _cells.size(); i++) {
+		ParticleCell& cell = _cells[cacheRebuildCellIndex(i)];
+		if(cell.isInnerCell()){
+			rebuildCellCache(cell);
 		}
 	}
 }
@@ -1059,9 +1360,10 @@ void LinkedCells::updateBoundaryAndHaloMoleculeCaches() {
 	#if defined(_OPENMP)
 	#pragma omp parallel for schedule(static)
 	#endif
-	for (long int cellIndex = 0; cellIndex < (long int) _cells.size(); cellIndex++) {
-		if (_cells[cellIndex].isHaloCell() or _cells[cellIndex].isBoundaryCell()) {
-			_cells[cellIndex].buildSoACaches();
+	for (long int i = 0; i < (long int) _cells.size(); i++) {
+		ParticleCell& cell = _cells[cacheRebuildCellIndex(i)];
+		if (cell.isHaloCell() or cell.isBoundaryCell()) {
+			rebuildCellCache(cell);
 		}
 	}
 }
@@ -1070,9 +1372,44 @@ void LinkedCells::updateMoleculeCaches() {
 	#if defined(_OPENMP)
 	#pragma omp parallel for schedule(static)
 	#endif
-	for (long int cellIndex = 0; cellIndex < (long int) _cells.size(); cellIndex++) {
-		_cells[cellIndex].buildSoACaches();
+	for (long int i = 0; i < (long int) _cells.size(); i++) {
+		rebuildCellCache(_cells[cacheRebuildCellIndex(i)]);
+	}
+}
+
+void LinkedCells::rebuildCellCache(ParticleCell& cell) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	if (_sortMolecules) {
+		// 4^3 sub-cells: a SIMD block of molecules covers a compact part of the cell
+		cell.sortMoleculesByMortonIndex(4);
+	}
+#endif
+	cell.buildSoACaches();
+	updateCellInteractionRadius(cell);
+}
+
+void LinkedCells::updateCellInteractionRadius(ParticleCell& cell) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	if (not _componentCutoffRadii.empty()) {
+		cell.updateInteractionRadius(_componentCutoffRadii);
 	}
+#endif
+}
+
+void LinkedCells::setComponentCutoffRadii(const std::vector<double>& componentCutoffRadii) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	_componentCutoffRadii = componentCutoffRadii;
+	if (_componentCutoffRadii.empty()) {
+		for (auto& cell : _cells) {
+			cell.setInteractionRadius(std::numeric_limits<double>::max());
+		}
+	} else if (_cellsInCutoff == 1) {
+		global_log->info() << "LinkedCells: use more than one cell in the cutoff radius to skip the cell pairs "
+				<< "beyond the component dependent cutoff radii." << endl;
+	}
+#else
+	global_log->warning() << "LinkedCells: component dependent cutoff radii are not supported in reduced memory mode." << endl;
+#endif
 }
 
 size_t LinkedCells::getTotalSize() {
@@ -5,6 +5,7 @@
 #include <vector>
 #include <array>
 #include <memory>
+#include <utility>
 
 #include "particleContainer/ParticleContainer.h"
 #include "particleContainer/ParticleIterator.h"
@@ -104,6 +105,9 @@ public:
 	 * \code{.xml}
 	   <datastructure type="LinkedCells">
 	     <cellsInCutoffRadius>INTEGER</cellsInCutoffRadius>
+	     <verletSkin>DOUBLE</verletSkin>
+	     <sortMolecules>BOOL</sortMolecules>
+	     <compactHaloCells>BOOL</compactHaloCells>
 	   </datastructure>
 	   \endcode
 	 */
@@ -126,6 +130,15 @@ public:
 	void update();
 
 	void update_via_copies();
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	/**
+	 * \brief Single pass rebinning without locks or atomics.
+	 * Every thread moves the leaving molecules of its cells into a thread-local buffer, tagged with
+	 * their target cell and sorted by it. Then every thread inserts the buffered molecules of all
+	 * threads into its own contiguous range of target cells.
+	 */
+	void update_via_thread_buffers();
+#endif
 	void update_via_coloring();
 	void update_via_traversal();
 	void update_via_sliced_traversal();
@@ -134,6 +147,37 @@ public:
 
 	void addParticles(std::vector<Molecule>& particles, bool checkWhetherDuplicate=false);
 
+	bool addHaloParticle(Molecule& particle, bool inBoxCheckedAlready = false, bool checkWhetherDuplicate = false,
+			const bool& rebuildCaches = false) override;
+
+	void addHaloParticles(std::vector<Molecule>& particles, bool checkWhetherDuplicate=false) override;
+
+	void getCompactHaloCopiesInRegion(const double lowCorner[3], const double highCorner[3],
+			std::vector<Molecule>& molecules) override;
+
+	/**
+	 * \brief Store halo copies only with the data needed for the SoA of the VectorizedCellProcessor.
+	 * \details Halo copies are then kept as CompactHaloMolecule instead of full molecules, which saves memory
+	 * and the time to insert, set up and delete them. They are not visited by the iterators, so only the
+	 * VectorizedCellProcessor sees them. Not available in reduced memory mode and with traversals that
+	 * require a force exchange.
+	 */
+	void setCompactHaloCells(bool compact);
+
+	bool hasCompactHaloCells() const override {
+		return _compactHaloCells;
+	}
+
+	/**
+	 * \brief Enable the pruning of cell pairs for component dependent cutoff radii.
+	 * \details Each cell then keeps the largest cutoff radius of its molecules, and the C08 based traversals
+	 * skip pairs of cells, which are farther apart. This pays off with more than one cell in the cutoff radius,
+	 * so that the pairs of the small molecules are processed on a finer grid than the large cutoff radius.
+	 * \param componentCutoffRadii largest cutoff radius of the interactions of each component, indexed by
+	 * component ID (an empty vector disables the pruning)
+	 */
+	void setComponentCutoffRadii(const std::vector<double>& componentCutoffRadii);
+
 	//! @brief calculate the forces between the molecules.
 	//!
 	//! Only molecules with a distance not larger than the cutoff radius are to be used. \n
@@ -154,6 +198,16 @@ public:
 
 	void traversePartialInnermostCells(CellProcessor& cellProcessor, unsigned int stage, int stageCount);
 
+	//! @brief processCell() for all non-halo cells in parallel, without the synchronisation of the pair traversals
+	void traverseCellsIndependently(CellProcessor& cellProcessor) override;
+
+	//! @brief The molecules were moved by a sweep that flagged the cells whose molecules may have left them
+	//! (ParticleCellRMM::setHasLeavingMolecules()), so the next update() only checks these cells.
+	//! Only supported in the reduced memory mode, the flag is reset by update().
+	void setLeavingMoleculesDetected() {
+		_leavingMoleculesDetected = true;
+	}
+
 	//! @return the number of particles stored in the Linked Cells
 	unsigned long getNumberOfParticles();
 
@@ -171,6 +225,9 @@ public:
 	double getCutoff() { return _cutoffRadius; }
 	void setCutoff(double rc) override { _cutoffRadius = rc; }
 
+	//! @brief set the skin of the cell pair Verlet lists of the VectorizedCellProcessor (0 disables them)
+	void setVerletSkin(double skin);
+
 	void deleteMolecule(Molecule &molecule, const bool& rebuildCaches) override;
 	/* TODO: The particle container should not contain any physics, search a new place for this. */
 	double getEnergy(ParticlePairsHandler* particlePairsHandler, Molecule* m1, CellProcessor& cellProcessor);
@@ -228,6 +285,9 @@ public:
 	}
 	RegionParticleIterator regionIterator (const double startRegion[3], const double endRegion[3], ParticleIterator::Type t = ParticleIterator::ALL_CELLS);
 
+	//! @brief get the indices of all cells which regionIterator() visits for the region
+	void getCellIndicesInRegion(const double startRegion[3], const double endRegion[3], std::vector<unsigned long>& cellIndices);
+
 	size_t getTotalSize() override;
 	void printSubInfo(int offset) override;
 	std::string getName() override;
@@ -254,6 +314,25 @@ private:
 
 	void initializeTraversal();
 
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	/**
+	 * @brief Index of the cell, which the molecule belongs to according to ParticleCell::testInBox().
+	 * Molecules outside of the halo bounding box stay in their current cell, as with the old neighbour based update.
+	 */
+	unsigned long getTargetCellIndex(Molecule& molecule, unsigned long currentCellIndex) const;
+#endif
+
+	//! @brief Index of the i-th cell, whose SoA cache is rebuilt (Morton order if molecules are sorted, else lexicographic).
+	unsigned long cacheRebuildCellIndex(unsigned long i) const {
+		return _sortMolecules ? _mortonCellOrder[i] : i;
+	}
+
+	//! @brief Sort the molecules of the cell, if enabled, and rebuild its SoA cache.
+	void rebuildCellCache(ParticleCell& cell);
+
+	//! @brief Update the interaction radius of the cell, if component dependent cutoff radii are used.
+	void updateCellInteractionRadius(ParticleCell& cell);
+
 	//! @brief Calculate neighbour indices.
 	//!
 	//! This method is executed once for the molecule container and not for
@@ -326,6 +405,14 @@ private:
 	double _cellLengthReciprocal[3]; //!< 1.0 / _cellLength, to speed-up particle sorting
 	double _cutoffRadius; //!< RDF/electrostatics cutoff radius
 	unsigned _cellsInCutoff = 1; //!< Cells in cutoff radius -> cells with size cutoff / cellsInCutoff
+	double _verletSkin = 0.0; //!< Skin of the cell pair Verlet lists of the VectorizedCellProcessor (0: disabled)
+	bool _sortMolecules = false; //!< Sort the molecules inside the cells along a Morton curve before rebuilding the SoA caches
+	bool _compactHaloCells = false; //!< Store halo copies as CompactHaloMolecule, see setCompactHaloCells()
+	std::vector<double> _componentCutoffRadii; //!< Cutoff radius of each component for pruning cell pairs, see setComponentCutoffRadii()
+	std::vector<unsigned long> _mortonCellOrder; //!< Indices of all cells, ordered along the Morton curve through the cell grid
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	std::vector<std::vector<std::pair<unsigned long, Molecule>>> _leavingMoleculeBuffers; //!< Per thread: leaving molecules and their target cells, see update_via_thread_buffers()
+#endif
 
 	//! @brief True if all Particles are in the right cell
 	//!
@@ -342,6 +429,9 @@ private:
 	bool _cellsValid;
 
 	ResortCellProcessorSliced * _resortCellProcessorSliced;
+
+	//! see setLeavingMoleculesDetected()
+	bool _leavingMoleculesDetected;
 };
 
 #endif  // MARDYN_AUTOPAS
@@ -1,7 +1,7 @@
 #include "particleContainer/ParticleCellRMM.h"
 #include "particleContainer/ParticleCell.h"
 
-ParticleCellRMM::ParticleCellRMM() : _cellDataSoARMM(0) {
+ParticleCellRMM::ParticleCellRMM() : _hasLeavingMolecules(true), _cellDataSoARMM(0) {
 	// TODO Auto-generated constructor stub
 
 }
@@ -49,6 +49,7 @@ bool ParticleCellRMM::addParticle(Molecule& particle, bool checkWhetherDuplicate
 
 	if (not found) {
 		_cellDataSoARMM.appendMolecule(particle);
+		_hasLeavingMolecules = true;
 		wasInserted = true;
 	} else {
 		wasInserted = false;
@@ -5,12 +5,14 @@
 #include "SingleCellIterator.h"
 #include "particleContainer/adapter/CellDataSoARMM.h"
 
+#include <limits>
+
 class ParticleCellRMM: public ParticleCellBase {
 public:
 	ParticleCellRMM();
 
 	ParticleCellRMM(const ParticleCellRMM& other) :
-			ParticleCellBase(other), _cellDataSoARMM(other._cellDataSoARMM) {
+			ParticleCellBase(other), _hasLeavingMolecules(other._hasLeavingMolecules), _cellDataSoARMM(other._cellDataSoARMM) {
 	}
 
 	~ParticleCellRMM();
@@ -23,6 +25,16 @@ public:
 
 	bool addParticle(Molecule& particle, bool checkWhetherDuplicate = false) override;
 
+	/**
+	 * \brief Append a halo copy at rest given by its position, ID and orientation, without building a Molecule.
+	 * \details Duplicates are not checked.
+	 */
+	void addHaloCopy(const std::array<vcp_real_calc, 3>& r, uint64_t uid, const Quaternion& q) {
+		const std::array<vcp_real_accum, 3> zero = {0., 0., 0.};
+		_cellDataSoARMM.appendMolecule(r, zero, uid, q, zero);
+		_hasLeavingMolecules = true;
+	}
+
 	bool isEmpty() const override;
 
 	bool deleteMoleculeByIndex(size_t index) override;
@@ -55,6 +67,23 @@ public:
 
 	void getLeavingMolecules(std::vector<Molecule> & appendBuffer);
 
+	/**
+	 * \brief Whether molecules may lie outside of the cell bounds.
+	 * \details Set by sweeps which move the molecules and compare them with the cell bounds
+	 * (PositionCellProcessorRMM), reset to true whenever a molecule is added.
+	 * Only used by LinkedCells::update() after LinkedCells::setLeavingMoleculesDetected().
+	 */
+	bool hasLeavingMolecules() const {return _hasLeavingMolecules;}
+
+	void setHasLeavingMolecules(bool hasLeavingMolecules) {_hasLeavingMolecules = hasLeavingMolecules;}
+
+	/** @brief Unbounded, component dependent cutoff radii are not supported in the reduced memory mode.
+	 * \details Not stored, to keep the cell at 64 bytes.
+	 */
+	double getInteractionRadius() const {
+		return std::numeric_limits<double>::max();
+	}
+
 	bool findMoleculeByID(size_t& index, unsigned long molid) const;
 
 //protected: do not use!
@@ -64,6 +93,9 @@ public:
 private:
 	Molecule buildAoSMolecule(size_t i) const;
 
+	//! declared first, so that it fills the padding behind Cell::_cellIndex
+	bool _hasLeavingMolecules;
+
 	/**
 	 * \brief Structure of arrays for VectorizedCellProcessor.
 	 * \author Johannes Heckl
@@ -130,6 +130,24 @@ public:
 	//! @param particles reference to a vector of pointers to particles
 	virtual void addParticles(std::vector<Molecule>& particles, bool checkWhetherDuplicate=false) = 0;
 
+	//! @brief adds a whole vector of particles, which all lie in the halo
+	//! @param particles reference to a vector of halo copies
+	virtual void addHaloParticles(std::vector<Molecule>& particles, bool checkWhetherDuplicate=false) {
+		addParticles(particles, checkWhetherDuplicate);
+	}
+
+	//! @brief whether halo copies are stored in a compact form, which addHaloParticles() has to be used for
+	virtual bool hasCompactHaloCells() const {
+		return false;
+	}
+
+	//! @brief append the halo copies within the region, which are not visited by the iterators
+	//!
+	//! Containers may store halo copies in a compact form without full molecules (see LinkedCells).
+	//! Such halo copies are appended as molecules at rest, e.g. to forward them to the next neighbour.
+	virtual void getCompactHaloCopiesInRegion(const double /*lowCorner*/[3], const double /*highCorner*/[3],
+			std::vector<Molecule>& /*molecules*/) {}
+
 	//! @brief traverse pairs which are close to each other
 	//!
 	//! Only interactions between particles which have a distance which is not
@@ -154,6 +172,12 @@ public:
 
 	virtual void traversePartialInnermostCells(CellProcessor& cellProcessor, unsigned int stage, int stageCount) = 0;
 
+	//! @brief Call processCell() for all non-halo cells, for cell processors which do not access neighbour cells.
+	//! Containers without cells run traverseCells() instead.
+	virtual void traverseCellsIndependently(CellProcessor& cellProcessor) {
+		traverseCells(cellProcessor);
+	}
+
 	virtual ParticleIterator iterator (ParticleIterator::Type t = ParticleIterator::ALL_CELLS) = 0;
 	virtual RegionParticleIterator regionIterator (const double startCorner[3], const double endCorner[3], ParticleIterator::Type t = ParticleIterator::ALL_CELLS) = 0;
 
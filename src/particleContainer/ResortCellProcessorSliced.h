@@ -17,7 +17,7 @@
 class ResortCellProcessorSliced: public CellProcessor {
 public:
 	ResortCellProcessorSliced(LinkedCells * container) :
-			CellProcessor(0.0, 0.0), _container(container) {
+			CellProcessor(0.0, 0.0), _container(container), _onlyCellsWithLeavingMolecules(false) {
 		// allocate threadData
 		_threadData.resize(mardyn_get_max_threads());
 		#if defined(_OPENMP)
@@ -44,6 +44,12 @@ public:
 	void preprocessCell(ParticleCell& ) {}
 	void processCellPair(ParticleCell&, ParticleCell&, bool) {}
 	void processCell(ParticleCell& cell) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+		if (_onlyCellsWithLeavingMolecules and not cell.hasLeavingMolecules()) {
+			return;
+		}
+#endif
+
 		// get leaving molecules
 		std::vector<Molecule>& b = _threadData[mardyn_get_thread_num()]->_buffer;
 
@@ -58,6 +64,11 @@ public:
 	double processSingleMolecule(Molecule*, ParticleCell& ) { return 0.0;}
 	void postprocessCell(ParticleCell& ) {}
 	void endTraversal() {}
+
+	// see LinkedCells::setLeavingMoleculesDetected()
+	void setOnlyCellsWithLeavingMolecules(bool onlyCellsWithLeavingMolecules) {
+		_onlyCellsWithLeavingMolecules = onlyCellsWithLeavingMolecules;
+	}
 private:
 	class ThreadData {
 	public:
@@ -71,6 +82,7 @@ private:
 
 	LinkedCells * _container;
 
+	bool _onlyCellsWithLeavingMolecules;
 };
 
 #endif /* SRC_PARTICLECONTAINER_RESORTCELLPROCESSORSLICED_H_ */
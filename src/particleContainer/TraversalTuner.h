@@ -2,14 +2,19 @@
 #define TRAVERSALTUNER_H_
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
 #include <utils/Logger.h>
+#include <utils/Timer.h>
 #include <Simulation.h>
 #include "LinkedCellTraversals/CellPairTraversals.h"
 #include "LinkedCellTraversals/QuickschedTraversal.h"
 #include "LinkedCellTraversals/C08CellPairTraversal.h"
+#include "LinkedCellTraversals/C08WorkStealingTraversal.h"
 #include "LinkedCellTraversals/C04CellPairTraversal.h"
 #include "LinkedCellTraversals/OriginalCellPairTraversal.h"
 #include "LinkedCellTraversals/HalfShellTraversal.h"
@@ -32,7 +37,8 @@ public:
 		HS       = 4,
 		MP       = 5,
 		C08ES    = 6,
-		QSCHED   = 7,
+		C08WS    = 7,
+		QSCHED   = 8,
 	};
 
 	TraversalTuner();
@@ -43,8 +49,16 @@ public:
 
 	void readXML(XMLfileUnits &xmlconfig);
 
+	/**
+	 * @brief Set up all traversals for a new cell grid.
+	 * @param cellsInCutoff cells have a width of at least cutoff / cellsInCutoff
+	 * @param cellLength width of the cells, used with the cutoff to prune the neighbour stencils
+	 */
 	void rebuild(std::vector<CellTemplate> &cells,
-				 const std::array<unsigned long, 3> &dims);
+				 const std::array<unsigned long, 3> &dims,
+				 unsigned cellsInCutoff,
+				 const std::array<double, 3> &cellLength,
+				 double cutoff);
 
 	void traverseCellPairs(CellProcessor &cellProcessor);
 
@@ -54,6 +68,10 @@ public:
 
 	void traverseCellPairsInner(CellProcessor &cellProcessor, unsigned stage, unsigned stageCount);
 
+	//! @brief Is the traversal chosen at runtime by timing all applicable candidates?
+	bool isAutotuning() const {
+		return _autotune;
+	}
 
 	bool isTraversalApplicable(traversalNames name, const std::array<unsigned long, 3> &dims) const; // new
 
@@ -63,6 +81,9 @@ public:
 	}
         
     CellPairTraversals<ParticleCell>* getCurrentOptimalTraversal() {
+            // reset whenever the selection or the autotuning candidate changes
+            if (_optimalTraversal == nullptr)
+                findOptimalTraversal();
             return _optimalTraversal;
     }
         
@@ -77,6 +98,40 @@ private:
 	CellPairTraversals<CellTemplate> *_optimalTraversal;
 
 	unsigned _cellsInCutoff = 1;
+
+	//! @brief Start a new sampling phase over all traversals applicable to the current cell grid.
+	void startTuning();
+
+	//! @brief Record the time of one sampled traversal and advance to the next candidate if necessary.
+	void addTuningSample(double time);
+
+	//! @brief Select the fastest candidate after all candidates have been sampled.
+	void finishTuning();
+
+	//! @brief Check whether the particle count, the thread count or the tuning interval require a new sampling phase.
+	bool needsRetuning() const;
+
+	unsigned long countParticles() const;
+
+	static const char* traversalNameToString(traversalNames name);
+
+	// autotuning settings
+	bool _autotune = false;
+	unsigned _tuningSamples = 3;  //!< timed traversals per candidate
+	unsigned _tuningInterval = 0;  //!< force a new sampling phase after this many traversals (0: never)
+	double _retuneParticleChange = 0.2;  //!< relative change of the particle count which triggers a new sampling phase
+
+	// autotuning state
+	bool _tuningActive = false;
+	bool _tuningRequested = true;
+	std::vector<traversalNames> _tuningCandidates;
+	std::vector<double> _tuningTimes;  //!< fastest sample per candidate
+	size_t _currentCandidate = 0;
+	unsigned _currentSample = 0;
+	const std::type_info* _tuningProcessorType = nullptr;  //!< only traversals with this cell processor are timed
+	unsigned long _tunedParticleCount = 0;
+	int _tunedThreadCount = 0;
+	unsigned long _traversalsSinceTuning = 0;
 };
 
 template<class CellTemplate>
@@ -92,6 +147,7 @@ TraversalTuner<CellTemplate>::TraversalTuner() : _cells(nullptr), _dims(), _opti
     struct HalfShellTraversalData    	 *hsData   	 = new HalfShellTraversalData;
     struct MidpointTraversalData    	 *mpData   	 = new MidpointTraversalData;
 	struct C08CellPairTraversalData    	 *c08esData  = new C08CellPairTraversalData;
+	struct C08WorkStealingTraversalData  *c08wsData  = new C08WorkStealingTraversalData;
 
 
 	_traversals = {
@@ -101,7 +157,8 @@ TraversalTuner<CellTemplate>::TraversalTuner() : _cells(nullptr), _dims(), _opti
 			make_pair(nullptr, slicedData),
             make_pair(nullptr, hsData),
             make_pair(nullptr, mpData),
-			make_pair(nullptr, c08esData)
+			make_pair(nullptr, c08esData),
+			make_pair(nullptr, c08wsData)
 	};
 #ifdef QUICKSCHED
 	struct QuickschedTraversalData *quiData = new QuickschedTraversalData;
@@ -124,7 +181,11 @@ TraversalTuner<CellTemplate>::~TraversalTuner() {
 
 template<class CellTemplate>
 void TraversalTuner<CellTemplate>::findOptimalTraversal() {
-	// TODO implement autotuning here! At the moment the traversal is chosen via readXML!
+	if (_tuningActive) {
+		// sampling phase: use the current candidate, the best one is chosen in finishTuning()
+		_optimalTraversal = _traversals[_tuningCandidates[_currentCandidate]].first;
+		return;
+	}
 
 	_optimalTraversal = _traversals[selectedTraversal].first;
 
@@ -137,6 +198,8 @@ void TraversalTuner<CellTemplate>::findOptimalTraversal() {
         global_log->info() << "Using C08CellPairTraversal without eighthShell." << endl;
     else if (dynamic_cast<C08CellPairTraversal<CellTemplate, true> *>(_optimalTraversal))
 	    global_log->info() << "Using C08CellPairTraversal with eighthShell." << endl;
+    else if (dynamic_cast<C08WorkStealingTraversal<CellTemplate> *>(_optimalTraversal))
+    	global_log->info() << "Using C08WorkStealingTraversal." << endl;
     else if (dynamic_cast<C04CellPairTraversal<CellTemplate> *>(_optimalTraversal))
     	global_log->info() << "Using C04CellPairTraversal." << endl;
     else if (dynamic_cast<MidpointTraversal<CellTemplate> *>(_optimalTraversal))
@@ -153,7 +216,11 @@ void TraversalTuner<CellTemplate>::findOptimalTraversal() {
 		global_log->warning() << "Using unknown traversal." << endl;
 
 
-	mardyn_assert(_optimalTraversal->maxCellsInCutoff() >= _cellsInCutoff);
+	if (_optimalTraversal->maxCellsInCutoff() < _cellsInCutoff) {
+		global_log->error() << "The selected traversal supports at most " << _optimalTraversal->maxCellsInCutoff()
+				<< " cells in cutoff, but " << _cellsInCutoff << " are used." << endl;
+		Simulation::exit(1);
+	}
 
 }
 
@@ -169,7 +236,28 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 			  traversalType.begin(),
 			  ::tolower);
 
-	if (traversalType.find("c08es") != string::npos)
+	if (traversalType.find("auto") != string::npos) {
+		// the initial selection from the constructor is used until the first sampling phase has finished
+		_autotune = true;
+		const int tuningSamples = xmlconfig.getNodeValue_int("tuningSamples", 3);
+		const int tuningInterval = xmlconfig.getNodeValue_int("tuningInterval", 0);
+		xmlconfig.getNodeValue("retuneParticleChange", _retuneParticleChange);
+		if (tuningSamples < 1) {
+			global_log->error() << "tuningSamples must be at least 1." << endl;
+			Simulation::exit(1);
+		}
+		if (tuningInterval < 0) {
+			global_log->error() << "tuningInterval must not be negative." << endl;
+			Simulation::exit(1);
+		}
+		_tuningSamples = static_cast<unsigned>(tuningSamples);
+		_tuningInterval = static_cast<unsigned>(tuningInterval);
+		global_log->info() << "Traversal autotuning enabled: " << _tuningSamples << " samples per traversal, retuning interval "
+				<< _tuningInterval << ", retuning on relative particle count change of " << _retuneParticleChange << endl;
+	}
+	else if (traversalType.find("c08ws") != string::npos)
+		selectedTraversal = C08WS;
+	else if (traversalType.find("c08es") != string::npos)
 		selectedTraversal = C08ES;
 	else if (traversalType.find("c08") != string::npos)
 		selectedTraversal = C08;
@@ -198,7 +286,7 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 		}
 	}
 
-	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // This is currently only used for an assert
+	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // overwritten by rebuild()
 
 	// workaround for stupid iterator:
 	// since
@@ -220,6 +308,17 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 				  ::tolower);
 		if (traversalType == "c08") {
 			// nothing to do
+		} else if (traversalType.find("slice") != string::npos) {
+			SlicedCellPairTraversalData *slicedData = dynamic_cast<SlicedCellPairTraversalData *>(_traversals[SLICED].second);
+			xmlconfig.getNodeValue("weighted", slicedData->weighted);
+			xmlconfig.getNodeValue("rebalanceInterval", slicedData->rebalanceInterval);
+			if (slicedData->rebalanceInterval < 1) {
+				global_log->error() << "rebalanceInterval of the sliced traversal must be at least 1." << endl;
+				Simulation::exit(1);
+			}
+			global_log->info() << "Sliced traversal: " << (slicedData->weighted ? "weighted" : "equal") << " slices"
+					<< (slicedData->weighted ? ", rebalanced every " + to_string(slicedData->rebalanceInterval) + " traversals" : "")
+					<< endl;
 		} else if (traversalType.find("qui") != string::npos) {
 #ifdef QUICKSCHED
 			if (not is_base_of<ParticleCellBase, CellTemplate>::value) {
@@ -263,10 +362,12 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 
 template<class CellTemplate>
 void TraversalTuner<CellTemplate>::rebuild(std::vector<CellTemplate> &cells, 
-        const std::array<unsigned long, 3> &dims) {
+        const std::array<unsigned long, 3> &dims, unsigned cellsInCutoff,
+        const std::array<double, 3> &cellLength, double cutoff) {
     
 	_cells = &cells; // new - what for?
 	_dims = dims; // new - what for?
+	_cellsInCutoff = cellsInCutoff;
 
 	for (size_t i = 0ul; i < _traversals.size(); ++i) {
 		auto& tPair = _traversals[i];
@@ -294,6 +395,9 @@ void TraversalTuner<CellTemplate>::rebuild(std::vector<CellTemplate> &cells,
 				case traversalNames::C08ES:
 					tPair.first = new C08CellPairTraversal<CellTemplate, true>(cells, dims);
 					break;
+				case traversalNames::C08WS:
+					tPair.first = new C08WorkStealingTraversal<CellTemplate>(cells, dims);
+					break;
 				case traversalNames::QSCHED: {
 					mardyn_assert((is_base_of<ParticleCellBase, CellTemplate>::value));
 					QuickschedTraversalData *quiData = dynamic_cast<QuickschedTraversalData *>(tPair.second);
@@ -304,25 +408,177 @@ void TraversalTuner<CellTemplate>::rebuild(std::vector<CellTemplate> &cells,
 					Simulation::exit(1);
 			}
 		}
+		if (C08BasedTraversalData* c08Data = dynamic_cast<C08BasedTraversalData*>(tPair.second)) {
+			c08Data->cellsInCutoff = cellsInCutoff;
+			c08Data->cellLength = cellLength;
+			c08Data->cutoff = cutoff;
+		}
 		tPair.first->rebuild(cells, dims, tPair.second);
 	}
 	_optimalTraversal = nullptr;
+	// the cell grid changed, so the previous measurements are meaningless
+	_tuningRequested = true;
 }
 
 template<class CellTemplate>
 void TraversalTuner<CellTemplate>::traverseCellPairs(CellProcessor &cellProcessor) {
+	if (_autotune and not _tuningActive and needsRetuning())
+		startTuning();
 	if (_optimalTraversal == nullptr)
 		findOptimalTraversal();
-        _optimalTraversal->traverseCellPairs(cellProcessor);
+
+	if (not _tuningActive) {
+		_optimalTraversal->traverseCellPairs(cellProcessor);
+		++_traversalsSinceTuning;
+		return;
+	}
+
+	// time only traversals of the cell processor that was seen first in this sampling phase (i.e. the force
+	// calculation), other processors (RDF, resorting, ...) are too cheap and would falsify the measurements.
+	if (_tuningProcessorType == nullptr)
+		_tuningProcessorType = &typeid(cellProcessor);
+	if (*_tuningProcessorType != typeid(cellProcessor)) {
+		_optimalTraversal->traverseCellPairs(cellProcessor);
+		return;
+	}
+
+	Timer timer;
+	timer.start();
+	_optimalTraversal->traverseCellPairs(cellProcessor);
+	timer.stop();
+	addTuningSample(timer.get_etime());
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::startTuning() {
+	_tuningCandidates.clear();
+	// Traversals which require a force exchange (HS, MP, C08ES) change the communication pattern of the domain
+	// decomposition and are therefore never chosen automatically.
+	std::vector<traversalNames> names = {C08, C04, SLICED, C08WS, QSCHED};
+	if (mardyn_get_max_threads() == 1) {
+		// the original traversal is not parallelised
+		names.push_back(ORIGINAL);
+	}
+	for (traversalNames name : names) {
+		if (static_cast<size_t>(name) >= _traversals.size() or _traversals[name].first == nullptr)
+			continue;
+		if (not isTraversalApplicable(name, _dims))
+			continue;
+		if (_traversals[name].first->maxCellsInCutoff() < _cellsInCutoff)
+			continue;
+		_tuningCandidates.push_back(name);
+	}
+
+	_tunedParticleCount = countParticles();
+	_tunedThreadCount = mardyn_get_max_threads();
+	_traversalsSinceTuning = 0;
+	_tuningRequested = false;
+
+	if (_tuningCandidates.size() < 2) {
+		// nothing to choose from, keep the current selection
+		if (_tuningCandidates.size() == 1)
+			selectedTraversal = _tuningCandidates[0];
+		_optimalTraversal = nullptr;
+		return;
+	}
+
+	global_log->info() << "Starting traversal autotuning with " << _tuningCandidates.size() << " candidates for "
+			<< _tunedParticleCount << " particles and " << _tunedThreadCount << " threads." << endl;
+
+	_tuningTimes.assign(_tuningCandidates.size(), std::numeric_limits<double>::max());
+	_currentCandidate = 0;
+	_currentSample = 0;
+	_tuningProcessorType = nullptr;
+	_tuningActive = true;
+	_optimalTraversal = nullptr;
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::addTuningSample(double time) {
+	// use the fastest sample, the first traversal of a candidate often suffers from cold caches
+	_tuningTimes[_currentCandidate] = std::min(_tuningTimes[_currentCandidate], time);
+
+	++_currentSample;
+	if (_currentSample < _tuningSamples)
+		return;
+
+	_currentSample = 0;
+	++_currentCandidate;
+	_optimalTraversal = nullptr;
+	if (_currentCandidate == _tuningCandidates.size())
+		finishTuning();
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::finishTuning() {
+	size_t best = 0;
+	for (size_t i = 0; i < _tuningCandidates.size(); ++i) {
+		global_log->info() << "Traversal autotuning: " << traversalNameToString(_tuningCandidates[i]) << " took "
+				<< _tuningTimes[i] << " s" << endl;
+		if (_tuningTimes[i] < _tuningTimes[best])
+			best = i;
+	}
+	selectedTraversal = _tuningCandidates[best];
+	global_log->info() << "Traversal autotuning selected " << traversalNameToString(selectedTraversal) << "." << endl;
+
+	_tuningActive = false;
+	_tuningProcessorType = nullptr;
+	_traversalsSinceTuning = 0;
+	_optimalTraversal = nullptr;
+}
+
+template<class CellTemplate>
+bool TraversalTuner<CellTemplate>::needsRetuning() const {
+	if (_tuningRequested)
+		return true;
+	if (_tunedThreadCount != mardyn_get_max_threads())
+		return true;
+	if (_tuningInterval > 0 and _traversalsSinceTuning >= _tuningInterval)
+		return true;
+
+	const double oldCount = static_cast<double>(std::max(_tunedParticleCount, 1ul));
+	const double newCount = static_cast<double>(countParticles());
+	return std::abs(newCount - oldCount) > _retuneParticleChange * oldCount;
+}
+
+template<class CellTemplate>
+unsigned long TraversalTuner<CellTemplate>::countParticles() const {
+	unsigned long N = 0;
+	if (_cells == nullptr)
+		return N;
+	for (const auto& cell : *_cells) {
+		N += cell.getMoleculeCount();
+	}
+	return N;
+}
+
+template<class CellTemplate>
+const char* TraversalTuner<CellTemplate>::traversalNameToString(traversalNames name) {
+	switch (name) {
+		case ORIGINAL: return "OriginalCellPairTraversal";
+		case C08:      return "C08CellPairTraversal";
+		case C04:      return "C04CellPairTraversal";
+		case SLICED:   return "SlicedCellPairTraversal";
+		case HS:       return "HalfShellTraversal";
+		case MP:       return "MidpointTraversal";
+		case C08ES:    return "C08CellPairTraversal with eighthShell";
+		case C08WS:    return "C08WorkStealingTraversal";
+		case QSCHED:   return "QuickschedTraversal";
+	}
+	return "unknown traversal";
 }
 
 template<class CellTemplate>
 inline void TraversalTuner<CellTemplate>::traverseCellPairs(traversalNames name,
 		CellProcessor& cellProcessor) {
-	if (name == getSelectedTraversal()) {
-		traverseCellPairs(cellProcessor);
+	if (name == getSelectedTraversal() and not _tuningActive) {
+		// bypass the tuner, this is not a force traversal
+		if (_optimalTraversal == nullptr)
+			findOptimalTraversal();
+		_optimalTraversal->traverseCellPairs(cellProcessor);
 	} else {
 		SlicedCellPairTraversal<CellTemplate> slicedTraversal(*_cells, _dims);
+		slicedTraversal.rebuild(*_cells, _dims, _traversals[SLICED].second);
 		switch(name) {
 		case SLICED:
 			slicedTraversal.traverseCellPairs(cellProcessor);
@@ -356,7 +612,7 @@ inline bool TraversalTuner<CellTemplate>::isTraversalApplicable(
 	bool ret = true;
 	switch(name) {
 	case SLICED:
-		ret = SlicedCellPairTraversal<CellTemplate>::isApplicable(dims);
+		ret = SlicedCellPairTraversal<CellTemplate>::isApplicable(dims, _cellsInCutoff);
 		break;
 	case QSCHED:
 #ifdef QUICKSCHED
@@ -371,6 +627,9 @@ inline bool TraversalTuner<CellTemplate>::isTraversalApplicable(
 	case C04:
 		ret = true;
 		break;
+	case C08WS:
+		ret = true;
+		break;
 	case ORIGINAL:
 		ret = true;
 		break;
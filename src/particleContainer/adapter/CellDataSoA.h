@@ -11,23 +11,102 @@
 #include "CellDataSoABase.h"
 #include "utils/AlignedArrayTriplet.h"
 #include "utils/ConcatenatedSites.h"
-#include "vectorization/SIMD_TYPES.h"
+#include "vectorization/SIMD_PRECISION.h"
 #include <cstdint>
+#include <algorithm>
 #include <array>
+#include <memory>
+#include <type_traits>
+
+/**
+ * \brief Copy of a CellDataSoA in another precision, for force kernels whose precision is chosen at run time.
+ * \details The copy is owned by the CellDataSoA it was made of and is made at most once per traversal
+ * (see VectorizedCellProcessor::Kernel). Copying the CellDataSoA does not copy it, it is just made again.
+ */
+class CellDataSoAConversion {
+public:
+	CellDataSoAConversion() : _soa(nullptr, nullptr), _traversal(0), _pending(false) {}
+	CellDataSoAConversion(const CellDataSoAConversion&) : CellDataSoAConversion() {}
+	CellDataSoAConversion& operator=(const CellDataSoAConversion&) {
+		_soa.reset();
+		_traversal = 0;
+		_pending = false;
+		return *this;
+	}
+
+	/**
+	 * \brief Get the copy of type SoA, allocate it if necessary.
+	 * \param traversal the current traversal
+	 * \param outdated set to true, if the copy was not yet made in this traversal. It is then marked as made
+	 * and as pending, i.e. its forces have to be added to the original CellDataSoA.
+	 */
+	template<class SoA>
+	SoA& get(unsigned long traversal, bool& outdated) {
+		if (_soa.get_deleter() != &deleteSoA<SoA>) {
+			_soa = std::unique_ptr<CellDataSoABase, void (*)(CellDataSoABase*)>(new SoA(0, 0, 0, 0, 0), &deleteSoA<SoA>);
+			_traversal = 0;
+		}
+		outdated = _traversal != traversal;
+		if (outdated) {
+			_traversal = traversal;
+			_pending = true;
+		}
+		return *static_cast<SoA*>(_soa.get());
+	}
+
+	/**
+	 * \brief Get the copy of type SoA, if its forces have not yet been added to the original CellDataSoA.
+	 * The copy is not pending anymore afterwards.
+	 */
+	template<class SoA>
+	SoA* takePending() {
+		if (not _pending or _soa.get_deleter() != &deleteSoA<SoA>) {
+			return nullptr;
+		}
+		_pending = false;
+		return static_cast<SoA*>(_soa.get());
+	}
+
+private:
+	template<class SoA>
+	static void deleteSoA(CellDataSoABase* soa) {
+		delete static_cast<SoA*>(soa);
+	}
+
+	std::unique_ptr<CellDataSoABase, void (*)(CellDataSoABase*)> _soa;
+	unsigned long _traversal;
+	bool _pending;
+};
 
 /**
  * \brief Structure of Arrays for vectorized force calculation.
+ * \details The precision of the build is CellDataSoA, force kernels of other precisions
+ * use copies (see CellDataSoAConversion).<br>
+ * The CellDataSoA of a cell keeps absolute positions in the precision of the build, since the molecules,
+ * the FlopCounter, the FMM P2P kernels and the VectorizedMoleculeUpdate read it. Reduced precision storage
+ * of the site coordinates is the copy of a MIXED or SINGLE kernel in a DOUBLE build: its positions are
+ * float and relative to the cell (see _origin), its forces and virials are double for MIXED. The kernel
+ * only streams through the copy, which takes half the bytes per coordinate, but the copy is allocated in
+ * addition to the CellDataSoA, i.e. it reduces the working set of the force calculation, not the memory.
+ * \tparam RealCalc floating point type of positions and parameters (vcp_real_calc)
+ * \tparam RealAccum floating point type of forces, torques and virials (vcp_real_accum)
  * \author Johannes Heckl, Wolfgang Eckhardt, Uwe Ehmann
  */
-class CellDataSoA : public CellDataSoABase {
+template<typename RealCalc, typename RealAccum>
+class CellDataSoAT : public CellDataSoABase {
+public:
+	typedef RealCalc vcp_real_calc;
+	typedef RealAccum vcp_real_accum;
+	typedef typename std::conditional<std::is_same<RealCalc, float>::value, uint32_t, uint64_t>::type vcp_ljc_id_t;
 
+private:
 	//for better readability:
 	typedef ConcSites::SiteType 			SiteType;
 	typedef ConcSites::CoordinateType	CoordinateType;
 
 
 public:
-	CellDataSoA(size_t mol_arg, size_t ljc_arg, size_t charges_arg, size_t dipoles_arg, size_t quadrupoles_arg) {
+	CellDataSoAT(size_t mol_arg, size_t ljc_arg, size_t charges_arg, size_t dipoles_arg, size_t quadrupoles_arg) {
 		resize(mol_arg, ljc_arg, charges_arg, dipoles_arg, quadrupoles_arg);
 	}
 
@@ -73,6 +152,20 @@ public:
 	AlignedArrayTriplet<vcp_real_calc> _quadrupoles_e; // orientation vector of quadrupole moment
 	AlignedArrayTriplet<vcp_real_accum> _quadrupoles_M; // torque vector
 
+	// copy in the precision of the force kernel, if it differs from this one
+	CellDataSoAConversion _conversion;
+
+	// lower corner of the cell (see FullParticleCell::buildSoACaches())
+	std::array<double, 3> _cellBoxMin {{0., 0., 0.}};
+
+	/*
+	 * The positions are relative to this point. It is zero, except for copies with positions in
+	 * lower precision than the original SoA (see copyCalcFrom()), whose positions are relative to the
+	 * lower corner of the cell: the differences within a cell and to the neighbouring cells then
+	 * do not lose precision to the distance from the origin of the domain.
+	 */
+	std::array<double, 3> _origin {{0., 0., 0.}};
+
 
 	/**
 	 * \brief	Get Pointer to the beginning of the specified data
@@ -176,12 +269,18 @@ public:
 		_quadrupoles_e.z(index) = orientation[2];
 	}
 
+	/**
+	 * \brief Set up the dist lookups of all center types for this cell as second cell of the force calculation.
+	 * \tparam IndicesPerLookup number of centers covered by one entry of the lookup (VCP_INDICES_PER_LOOKUP_SINGLE)
+	 * \tparam Lookup entry type of the lookup (vcp_lookupOrMask_single), both depend on the instruction set of the kernel
+	 */
+	template<size_t IndicesPerLookup, typename Lookup>
 	void vcp_inline initDistLookupPointers(
-			AlignedArray<vcp_lookupOrMask_single>& centers_dist_lookup,
-			vcp_lookupOrMask_single*& ljc_dist_lookup,
-			vcp_lookupOrMask_single*& charges_dist_lookup,
-			vcp_lookupOrMask_single*& dipoles_dist_lookup,
-			vcp_lookupOrMask_single*& quadrupoles_dist_lookup) const {
+			AlignedArray<Lookup>& centers_dist_lookup,
+			Lookup*& ljc_dist_lookup,
+			Lookup*& charges_dist_lookup,
+			Lookup*& dipoles_dist_lookup,
+			Lookup*& quadrupoles_dist_lookup) const {
 
 		size_t ljc_size 	= AlignedArray<vcp_real_calc>::_round_up(_ljc_num);
 		size_t charges_size = AlignedArray<vcp_real_calc>::_round_up(_charges_num);
@@ -193,14 +292,15 @@ public:
 		setPaddingToZero(centers_dist_lookup);
 
 		ljc_dist_lookup = centers_dist_lookup;
-		charges_dist_lookup = ljc_dist_lookup + (ljc_size + VCP_INDICES_PER_LOOKUP_SINGLE_M1)/VCP_INDICES_PER_LOOKUP_SINGLE;
-		dipoles_dist_lookup = charges_dist_lookup + (charges_size + VCP_INDICES_PER_LOOKUP_SINGLE_M1)/VCP_INDICES_PER_LOOKUP_SINGLE;
-		quadrupoles_dist_lookup = dipoles_dist_lookup + (dipoles_size + VCP_INDICES_PER_LOOKUP_SINGLE_M1)/VCP_INDICES_PER_LOOKUP_SINGLE;
+		charges_dist_lookup = ljc_dist_lookup + (ljc_size + IndicesPerLookup - 1)/IndicesPerLookup;
+		dipoles_dist_lookup = charges_dist_lookup + (charges_size + IndicesPerLookup - 1)/IndicesPerLookup;
+		quadrupoles_dist_lookup = dipoles_dist_lookup + (dipoles_size + IndicesPerLookup - 1)/IndicesPerLookup;
 	}
 
+	template<typename Lookup>
 	void vcp_inline initDistLookupPointersSingle(
-			AlignedArray<vcp_lookupOrMask_single>& centers_dist_lookup,
-			vcp_lookupOrMask_single*& sites_dist_lookup,
+			AlignedArray<Lookup>& centers_dist_lookup,
+			Lookup*& sites_dist_lookup,
 			size_t sites_num) const {
 
 		centers_dist_lookup.resize_zero_shrink(sites_num, true, false);
@@ -246,6 +346,99 @@ public:
 
 	}
 
+	/**
+	 * \brief Make this SoA a copy of soa for the force calculation: positions and parameters are converted,
+	 * forces, torques and virials are set to zero.
+	 * \details Positions in lower precision than those of soa are stored relative to the lower corner
+	 * of the cell (see _origin).
+	 */
+	template<class SoA>
+	void copyCalcFrom(const SoA& soa) {
+		typedef typename SoA::vcp_real_calc SourceCalc;
+		resize(soa.getMolNum(), soa._ljc_num, soa._charges_num, soa._dipoles_num, soa._quadrupoles_num);
+
+		_cellBoxMin = soa._cellBoxMin;
+		_origin = sizeof(vcp_real_calc) < sizeof(SourceCalc) ? soa._cellBoxMin : soa._origin;
+		const double shift[3] = { soa._origin[0] - _origin[0], soa._origin[1] - _origin[1], soa._origin[2] - _origin[2] };
+
+		for (size_t i = 0; i < getMolNum(); ++i) {
+			_mol_pos.x(i) = static_cast<vcp_real_calc>(soa._mol_pos.x(i) + shift[0]);
+			_mol_pos.y(i) = static_cast<vcp_real_calc>(soa._mol_pos.y(i) + shift[1]);
+			_mol_pos.z(i) = static_cast<vcp_real_calc>(soa._mol_pos.z(i) + shift[2]);
+			_mol_ljc_num[i] = soa._mol_ljc_num[i];
+			_mol_charges_num[i] = soa._mol_charges_num[i];
+			_mol_dipoles_num[i] = soa._mol_dipoles_num[i];
+			_mol_quadrupoles_num[i] = soa._mol_quadrupoles_num[i];
+		}
+
+		const SiteType siteTypes[] = {SiteType::LJC, SiteType::CHARGE, SiteType::DIPOLE, SiteType::QUADRUPOLE};
+		const size_t sitesNum[] = {_ljc_num, _charges_num, _dipoles_num, _quadrupoles_num};
+		const CoordinateType coordinates[] = {CoordinateType::X, CoordinateType::Y, CoordinateType::Z};
+		for (int t = 0; t < 4; ++t) {
+			for (CoordinateType c : coordinates) {
+				const double shift_c = shift[static_cast<int>(c)];
+				copyConvertedShifted(soa.getBeginCalc(SoA::QuantityType::MOL_POSITION, siteTypes[t], c), getBeginCalc(QuantityType::MOL_POSITION, siteTypes[t], c), sitesNum[t], shift_c);
+				copyConvertedShifted(soa.getBeginCalc(SoA::QuantityType::CENTER_POSITION, siteTypes[t], c), getBeginCalc(QuantityType::CENTER_POSITION, siteTypes[t], c), sitesNum[t], shift_c);
+				std::fill(getBeginAccum(QuantityType::FORCE, siteTypes[t], c), getBeginAccum(QuantityType::FORCE, siteTypes[t], c) + sitesNum[t], 0.);
+				std::fill(getBeginAccum(QuantityType::VIRIAL, siteTypes[t], c), getBeginAccum(QuantityType::VIRIAL, siteTypes[t], c) + sitesNum[t], 0.);
+			}
+		}
+
+		copyConverted<typename SoA::vcp_ljc_id_t, vcp_ljc_id_t>(soa._ljc_id, _ljc_id, _ljc_num);
+		copyConverted<SourceCalc, vcp_real_calc>(soa._charges_q, _charges_q, _charges_num);
+		copyConverted<SourceCalc, vcp_real_calc>(soa._dipoles_p, _dipoles_p, _dipoles_num);
+		copyConverted<SourceCalc, vcp_real_calc>(soa._quadrupoles_m, _quadrupoles_m, _quadrupoles_num);
+		for (CoordinateType c : coordinates) {
+			const auto coord = static_cast<typename AlignedArrayTriplet<vcp_real_calc>::Coordinate>(c);
+			const auto sourceCoord = static_cast<typename AlignedArrayTriplet<SourceCalc>::Coordinate>(c);
+			copyConverted(soa._dipoles_e.begin(sourceCoord), _dipoles_e.begin(coord), _dipoles_num);
+			copyConverted(soa._quadrupoles_e.begin(sourceCoord), _quadrupoles_e.begin(coord), _quadrupoles_num);
+
+			const auto accumCoord = static_cast<typename AlignedArrayTriplet<vcp_real_accum>::Coordinate>(c);
+			std::fill(_dipoles_M.begin(accumCoord), _dipoles_M.begin(accumCoord) + _dipoles_num, 0.);
+			std::fill(_quadrupoles_M.begin(accumCoord), _quadrupoles_M.begin(accumCoord) + _quadrupoles_num, 0.);
+		}
+	}
+
+	/**
+	 * \brief Add the forces, torques and virials of this SoA to those of soa, of which it is a copy (see copyCalcFrom()).
+	 */
+	template<class SoA>
+	void addAccumTo(SoA& soa) const {
+		const SiteType siteTypes[] = {SiteType::LJC, SiteType::CHARGE, SiteType::DIPOLE, SiteType::QUADRUPOLE};
+		const size_t sitesNum[] = {_ljc_num, _charges_num, _dipoles_num, _quadrupoles_num};
+		const CoordinateType coordinates[] = {CoordinateType::X, CoordinateType::Y, CoordinateType::Z};
+		for (int t = 0; t < 4; ++t) {
+			for (CoordinateType c : coordinates) {
+				addConverted(getBeginAccum(QuantityType::FORCE, siteTypes[t], c), soa.getBeginAccum(SoA::QuantityType::FORCE, siteTypes[t], c), sitesNum[t]);
+				addConverted(getBeginAccum(QuantityType::VIRIAL, siteTypes[t], c), soa.getBeginAccum(SoA::QuantityType::VIRIAL, siteTypes[t], c), sitesNum[t]);
+			}
+		}
+		for (CoordinateType c : coordinates) {
+			const auto coord = static_cast<typename AlignedArrayTriplet<vcp_real_accum>::Coordinate>(c);
+			const auto targetCoord = static_cast<typename AlignedArrayTriplet<typename SoA::vcp_real_accum>::Coordinate>(c);
+			addConverted(_dipoles_M.begin(coord), soa._dipoles_M.begin(targetCoord), _dipoles_num);
+			addConverted(_quadrupoles_M.begin(coord), soa._quadrupoles_M.begin(targetCoord), _quadrupoles_num);
+		}
+	}
+
+	/**
+	 * \brief Exchange forces, torques and virials with those of accum, which are resized to the centers
+	 * of this SoA first, but not set to zero.
+	 * \details Swapping back and forth lets a kernel run on this SoA without changing its forces
+	 * (see VectorizedCellProcessor::Kernel::calculateEnergy()).
+	 */
+	void swapAccum(CellDataSoAT& accum) {
+		accum._centers_f.resize(_ljc_num, _charges_num, _dipoles_num, _quadrupoles_num);
+		accum._centers_V.resize(_ljc_num, _charges_num, _dipoles_num, _quadrupoles_num);
+		accum._dipoles_M.resize_zero_shrink(_dipoles_num);
+		accum._quadrupoles_M.resize_zero_shrink(_quadrupoles_num);
+		_centers_f.swap(accum._centers_f);
+		_centers_V.swap(accum._centers_V);
+		_dipoles_M.swap(accum._dipoles_M);
+		_quadrupoles_M.swap(accum._quadrupoles_M);
+	}
+
 	size_t getDynamicSize() const {
 		size_t total = 0;
 
@@ -273,7 +466,29 @@ public:
 
 private:
 
-	vcp_inline void setPaddingToZero(AlignedArray<vcp_lookupOrMask_single>& t) const {
+	template<typename From, typename To>
+	static void copyConverted(const From* from, To* to, size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			to[i] = static_cast<To>(from[i]);
+		}
+	}
+
+	template<typename From, typename To>
+	static void copyConvertedShifted(const From* from, To* to, size_t n, double shift) {
+		for (size_t i = 0; i < n; ++i) {
+			to[i] = static_cast<To>(from[i] + shift);
+		}
+	}
+
+	template<typename From, typename To>
+	static void addConverted(const From* from, To* to, size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			to[i] += static_cast<To>(from[i]);
+		}
+	}
+
+	template<typename Lookup>
+	vcp_inline void setPaddingToZero(AlignedArray<Lookup>& t) const {
 		size_t ljc_size 	= AlignedArray<vcp_real_calc>::_round_up(_ljc_num);
 		size_t charges_size = AlignedArray<vcp_real_calc>::_round_up(_charges_num);
 		size_t dipoles_size = AlignedArray<vcp_real_calc>::_round_up(_dipoles_num);
@@ -365,4 +580,7 @@ private:
 
 };
 
+//! \brief CellDataSoA in the precision of the build (see SIMD_PRECISION.h).
+typedef CellDataSoAT<vcp_real_calc, vcp_real_accum> CellDataSoA;
+
 #endif /* CELLDATASOA_H_ */
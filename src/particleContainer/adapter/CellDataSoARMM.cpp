@@ -0,0 +1,35 @@
+#include "CellDataSoARMM.h"
+
+#include "Simulation.h"
+#include "utils/Logger.h"
+
+#include <algorithm>
+
+using Log::global_log;
+
+bool CellDataSoARMM::_compactUIDs = false;
+
+void CellDataSoARMM::rebaseCompactUIDs(uint64_t uid) {
+	mardyn_assert(_data.isCompactUID());
+
+	uint64_t minUid = uid;
+	uint64_t maxUid = uid;
+	for (size_t i = 0; i < getMolNum(); ++i) {
+		const uint64_t molUid = getMolUid(i);
+		minUid = std::min(minUid, molUid);
+		maxUid = std::max(maxUid, molUid);
+	}
+
+	if (maxUid - minUid > std::numeric_limits<compact_uid_t>::max()) {
+		global_log->error() << "CellDataSoARMM: the IDs " << minUid << " and " << maxUid
+				<< " in one cell do not fit into 32-bit offsets, disable compactIDs." << std::endl;
+		Simulation::exit(1);
+	}
+
+	uint64_t& uidBase = _data.compact_uid_base();
+	compact_uid_t * const compactUids = _data.begin_compact_uid();
+	for (size_t i = 0; i < getMolNum(); ++i) {
+		compactUids[i] = static_cast<compact_uid_t>(uidBase + compactUids[i] - minUid);
+	}
+	uidBase = minUid;
+}
@@ -7,10 +7,18 @@
 #include "molecules/MoleculeRMM.h"
 #include "CellDataSoABase.h"
 #include <cstdint>
+#include <limits>
 
 /**
  * \brief Structure of Arrays for single-center lennard-Jones molecules for
  * the RMM run.
+ *
+ * If the RMM component is a rigid multi-site molecule (MoleculeRMM::isMultiSite()),
+ * the quaternion and angular momentum are stored as well.
+ *
+ * With compact UIDs (setCompactUIDs()), the IDs are stored as 32-bit offsets to a
+ * per-cell base and reconstructed in getMolUid(). The base is stored behind the arrays
+ * (ConcatenatedAlignedArrayRMM::compact_uid_base()), not in the cell.
  * \author Nikola Tchipev
  */
 class CellDataSoARMM : public CellDataSoABase {
@@ -20,6 +28,15 @@ public:
 		resize(mol_arg);
 	}
 
+	//! Store the IDs of the molecules of all cells allocated from now on as 32-bit offsets.
+	static void setCompactUIDs(bool compactUIDs) {
+		_compactUIDs = compactUIDs;
+	}
+
+	static bool getCompactUIDs() {
+		return _compactUIDs;
+	}
+
 	vcp_inline vcp_real_calc* r_xBegin() { return _data.begin_calc(Quantity_t::RX);}
 	vcp_inline vcp_real_calc* r_yBegin() { return _data.begin_calc(Quantity_t::RY);}
 	vcp_inline vcp_real_calc* r_zBegin() { return _data.begin_calc(Quantity_t::RZ);}
@@ -34,12 +51,35 @@ public:
 	const vcp_inline vcp_real_accum* v_yBegin() const { return _data.begin_accum(Quantity_t::VY);}
 	const vcp_inline vcp_real_accum* v_zBegin() const { return _data.begin_accum(Quantity_t::VZ);}
 
+	vcp_inline vcp_real_accum* q_wBegin() { return _data.begin_accum(Quantity_t::Q0);}
+	vcp_inline vcp_real_accum* q_xBegin() { return _data.begin_accum(Quantity_t::Q1);}
+	vcp_inline vcp_real_accum* q_yBegin() { return _data.begin_accum(Quantity_t::Q2);}
+	vcp_inline vcp_real_accum* q_zBegin() { return _data.begin_accum(Quantity_t::Q3);}
+	vcp_inline vcp_real_accum* D_xBegin() { return _data.begin_accum(Quantity_t::DX);}
+	vcp_inline vcp_real_accum* D_yBegin() { return _data.begin_accum(Quantity_t::DY);}
+	vcp_inline vcp_real_accum* D_zBegin() { return _data.begin_accum(Quantity_t::DZ);}
+
+	const vcp_inline vcp_real_accum* q_wBegin() const { return _data.begin_accum(Quantity_t::Q0);}
+	const vcp_inline vcp_real_accum* q_xBegin() const { return _data.begin_accum(Quantity_t::Q1);}
+	const vcp_inline vcp_real_accum* q_yBegin() const { return _data.begin_accum(Quantity_t::Q2);}
+	const vcp_inline vcp_real_accum* q_zBegin() const { return _data.begin_accum(Quantity_t::Q3);}
+	const vcp_inline vcp_real_accum* D_xBegin() const { return _data.begin_accum(Quantity_t::DX);}
+	const vcp_inline vcp_real_accum* D_yBegin() const { return _data.begin_accum(Quantity_t::DY);}
+	const vcp_inline vcp_real_accum* D_zBegin() const { return _data.begin_accum(Quantity_t::DZ);}
+
+	//! whether the quaternion and the angular momentum are stored
+	bool isRotational() const { return _data.isRotational(); }
+
 	void resize(size_t molecules_arg) {
 		const bool allow_shrink = false; // TODO shrink at some point in the future
 
 		setMolNum(molecules_arg);
 
 		// entries per molecule
+		// (the component may already be deleted when the cells are cleared at the end of the simulation)
+		if (molecules_arg > 0) {
+			prepareStorage();
+		}
 		_data.resize(getMolNum());
 	}
 
@@ -59,20 +99,60 @@ public:
 			static_cast<vcp_real_accum>(m_RMM.v(1)),
 			static_cast<vcp_real_accum>(m_RMM.v(2))
 		};
+		std::array<vcp_real_accum, 3> D = {
+			static_cast<vcp_real_accum>(m_RMM.D(0)),
+			static_cast<vcp_real_accum>(m_RMM.D(1)),
+			static_cast<vcp_real_accum>(m_RMM.D(2))
+		};
+		appendMolecule(calcs, accums, m_RMM.getID(), m_RMM.q(), D);
+	}
 
-		_data.appendValues(calcs, accums, m_RMM.getID(), getMolNum());
+	/**
+	 * \brief Append a molecule given by its values, without building a Molecule.
+	 * \details q and D are only stored for rotational storage.
+	 */
+	void appendMolecule(const std::array<vcp_real_calc, 3>& r, const std::array<vcp_real_accum, 3>& v, uint64_t uid,
+			const Quaternion& q, const std::array<vcp_real_accum, 3>& D) {
+		prepareStorage();
+		if (_data.isCompactUID()) {
+			if (getMolNum() == 0) {
+				// the base lives in the allocated storage
+				_data.increaseStorage(0, 1);
+				_data.compact_uid_base() = uid;
+			} else if (not fitsCompactUID(uid)) {
+				rebaseCompactUIDs(uid);
+			}
+			uid -= _data.compact_uid_base();
+		}
+		_data.appendValues(r, v, uid, getMolNum());
+		if (isRotational()) {
+			setMolQ(getMolNum(), q);
+			for (unsigned short d = 0; d < 3; ++d) {
+				setMolD(d, getMolNum(), D[d]);
+			}
+		}
 		incrementMolNum();
 	}
 
 	void increaseStorage(size_t additionalMolecules) {
+		prepareStorage();
 		_data.increaseStorage(getMolNum(), additionalMolecules);
 	}
 
 	Molecule buildAoSMolecule(size_t index) const {
+		if (not isRotational()) {
+			return Molecule (
+				getMolUid(index), nullptr,
+				getMolR(0,index), getMolR(1,index), getMolR(2,index),
+				getMolV(0,index), getMolV(1,index), getMolV(2,index));
+		}
+		const Quaternion q = getMolQ(index);
 		return Molecule (
 			getMolUid(index), nullptr,
 			getMolR(0,index), getMolR(1,index), getMolR(2,index),
-			getMolV(0,index), getMolV(1,index), getMolV(2,index));
+			getMolV(0,index), getMolV(1,index), getMolV(2,index),
+			q.qw(), q.qx(), q.qy(), q.qz(),
+			getMolD(0,index), getMolD(1,index), getMolD(2,index));
 	}
 
 	void readImmutableMolecule(size_t index, MoleculeInterface& m) const {
@@ -87,6 +167,12 @@ public:
 		m_RMM.setv(1, getMolV(1,index));
 		m_RMM.setv(2, getMolV(2,index));
 		m_RMM.setid(getMolUid(index));
+		if (isRotational()) {
+			m_RMM.setq(getMolQ(index));
+			m_RMM.setD(0, getMolD(0,index));
+			m_RMM.setD(1, getMolD(1,index));
+			m_RMM.setD(2, getMolD(2,index));
+		}
 	}
 
 	void readMutableMolecule(size_t index, MoleculeInterface& m) {
@@ -106,6 +192,12 @@ public:
 		setMolV(1, i, static_cast<vcp_real_calc>(m.v(1)));
 		setMolV(2, i, static_cast<vcp_real_calc>(m.v(2)));
 		setMolUid(i, m.getID());
+		if (isRotational()) {
+			setMolQ(i, m.q());
+			setMolD(0, i, static_cast<vcp_real_accum>(m.D(0)));
+			setMolD(1, i, static_cast<vcp_real_accum>(m.D(1)));
+			setMolD(2, i, static_cast<vcp_real_accum>(m.D(2)));
+		}
 	}
 
 	void deleteMolecule(size_t index) {
@@ -118,6 +210,12 @@ public:
 			setMolV(1, index, getMolV(1,getMolNum()-1));
 			setMolV(2, index, getMolV(2,getMolNum()-1));
 			setMolUid(index, getMolUid(getMolNum()-1));
+			if (isRotational()) {
+				setMolQ(index, getMolQ(getMolNum()-1));
+				setMolD(0, index, getMolD(0,getMolNum()-1));
+				setMolD(1, index, getMolD(1,getMolNum()-1));
+				setMolD(2, index, getMolD(2,getMolNum()-1));
+			}
 		}
 		decrementMolNum();
 	}
@@ -151,18 +249,71 @@ public:
 	}
 
 	uint64_t getMolUid(size_t index) const {
+		if (_data.isCompactUID()) {
+			return _data.compact_uid_base() + _data.get_compact_uid(index);
+		}
 		Quantity_t q = Quantity_t::UID;
 		return _data.get_uid(q, index);
 	}
 
 	void setMolUid(size_t index, unsigned long molUid) {
+		if (_data.isCompactUID()) {
+			if (not fitsCompactUID(molUid)) {
+				rebaseCompactUIDs(molUid);
+			}
+			_data.get_compact_uid(index) = static_cast<compact_uid_t>(molUid - _data.compact_uid_base());
+			return;
+		}
 		Quantity_t q = Quantity_t::UID;
 		_data.get_uid(q, index) = molUid;
 	}
 
+	Quaternion getMolQ(size_t index) const {
+		return Quaternion(
+			_data.get_accum(Quantity_t::Q0, index), _data.get_accum(Quantity_t::Q1, index),
+			_data.get_accum(Quantity_t::Q2, index), _data.get_accum(Quantity_t::Q3, index));
+	}
+
+	void setMolQ(size_t index, const Quaternion& q) {
+		_data.get_accum(Quantity_t::Q0, index) = static_cast<vcp_real_accum>(q.qw());
+		_data.get_accum(Quantity_t::Q1, index) = static_cast<vcp_real_accum>(q.qx());
+		_data.get_accum(Quantity_t::Q2, index) = static_cast<vcp_real_accum>(q.qy());
+		_data.get_accum(Quantity_t::Q3, index) = static_cast<vcp_real_accum>(q.qz());
+	}
+
+	vcp_real_accum getMolD(unsigned short d, size_t index) const {
+		mardyn_assert(d < 3);
+		Quantity_t q = static_cast<Quantity_t>(d + 11); // +11 to convert to DX, DY, DZ
+		return _data.get_accum(q,index);
+	}
+
+	void setMolD(unsigned short d, size_t index, vcp_real_accum molD) {
+		mardyn_assert(d < 3);
+		Quantity_t q = static_cast<Quantity_t>(d + 11); // +11 to convert to DX, DY, DZ
+		_data.get_accum(q,index) = molD;
+	}
+
 private:
+	typedef ConcatenatedAlignedArrayRMM<vcp_real_calc, vcp_real_accum, uint64_t>::compact_uid_t compact_uid_t;
+
+	//! the rotational arrays and the compact UIDs can only be switched on while nothing is allocated
+	void prepareStorage() {
+		_data.setRotational(MoleculeRMM::isMultiSite());
+		_data.setCompactUID(_compactUIDs);
+	}
+
+	bool fitsCompactUID(uint64_t uid) const {
+		const uint64_t uidBase = _data.compact_uid_base();
+		return uid >= uidBase and uid - uidBase <= std::numeric_limits<compact_uid_t>::max();
+	}
+
+	//! lower _uidBase to the smallest ID of the cell and uid, exit if the IDs do not fit into 32 bits anymore
+	void rebaseCompactUIDs(uint64_t uid);
+
 	// entries per molecule
 	ConcatenatedAlignedArrayRMM<vcp_real_calc, vcp_real_accum, uint64_t> _data;
+
+	static bool _compactUIDs;
 };
 
 #endif /* CELLDATASOARMM_H_ */
@@ -86,6 +86,11 @@ public:
 	 * Called after the cell has been considered for the last time during the traversal.
 	 */
 	virtual void postprocessCell(ParticleCell& cell) = 0;
+	/**
+	 * The traversals of LinkedCells call postprocessCell() for every cell after all cell pairs
+	 * have been processed, only if this returns true.
+	 */
+	virtual bool requiresPostprocessing() const { return false; }
 
 	/**
 	 * Called after the traversal finished.
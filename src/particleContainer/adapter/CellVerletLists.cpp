@@ -0,0 +1,105 @@
+/*
+ * CellVerletLists.cpp
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#include "CellVerletLists.h"
+#include "molecules/Molecule.h"
+#include "particleContainer/CompactHaloMolecule.h"
+
+#include <algorithm>
+#include <cmath>
+
+void CellVerletLists::PairList::init(unsigned long version1, unsigned long version2, double margin,
+		size_t numMolecules1, const std::array<size_t, 4>& numSites2, size_t sitesPerBlock) {
+	_rebuild = (version1 != _version1 or version2 != _version2);
+	if (not _rebuild) {
+		return;
+	}
+
+	_version1 = version1;
+	_version2 = version2;
+	_margin = margin;
+	for (size_t t = 0; t < 4; ++t) {
+		const size_t numBlocks = (numSites2[t] + sitesPerBlock - 1) / sitesPerBlock;
+		_wordsPerMolecule[t] = (numBlocks + 63) / 64;
+		_blocks[t].assign(numMolecules1 * _wordsPerMolecule[t], 0);
+	}
+}
+
+void CellVerletLists::setSkin(double skin, const int position[3], const int stencilRadius[3]) {
+	_skin = skin;
+	_listMargin = 0.5 * skin;
+	_referenceIDs.clear();
+	_referencePositions.clear();
+	++_version;
+
+	size_t numPairLists = 1;
+	for (int d = 0; d < 3; ++d) {
+		_position[d] = position[d];
+		_stencilRadius[d] = stencilRadius[d];
+		numPairLists *= 2 * stencilRadius[d] + 1;
+	}
+	_pairLists.clear();
+	if (isEnabled()) {
+		_pairLists.resize(numPairLists);
+	}
+}
+
+template <class MoleculeType>
+void CellVerletLists::updateReference(const std::vector<MoleculeType>& molecules) {
+	const size_t numMolecules = molecules.size();
+	const double halfSkin = 0.5 * _skin;
+
+	bool reset = (numMolecules != _referenceIDs.size());
+	double maxDisplacementSquare = 0.0;
+
+	for (size_t i = 0; i < numMolecules and not reset; ++i) {
+		const MoleculeType& m = molecules[i];
+		if (m.getID() != _referenceIDs[i]) {
+			reset = true;
+			break;
+		}
+		double displacementSquare = 0.0;
+		for (int d = 0; d < 3; ++d) {
+			const double dr = m.r(d) - _referencePositions[3 * i + d];
+			displacementSquare += dr * dr;
+		}
+		maxDisplacementSquare = std::max(maxDisplacementSquare, displacementSquare);
+	}
+
+	if (maxDisplacementSquare > halfSkin * halfSkin) {
+		reset = true;
+	}
+
+	if (reset) {
+		_referenceIDs.resize(numMolecules);
+		_referencePositions.resize(3 * numMolecules);
+		for (size_t i = 0; i < numMolecules; ++i) {
+			_referenceIDs[i] = molecules[i].getID();
+			for (int d = 0; d < 3; ++d) {
+				_referencePositions[3 * i + d] = molecules[i].r(d);
+			}
+		}
+		maxDisplacementSquare = 0.0;
+		++_version;
+	}
+
+	_listMargin = halfSkin + std::sqrt(maxDisplacementSquare);
+}
+
+bool CellVerletLists::hasReferenceOrder(const std::vector<Molecule>& molecules) const {
+	if (molecules.size() != _referenceIDs.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < molecules.size(); ++i) {
+		if (molecules[i].getID() != _referenceIDs[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template void CellVerletLists::updateReference(const std::vector<Molecule>& molecules);
+template void CellVerletLists::updateReference(const std::vector<CompactHaloMolecule>& molecules);
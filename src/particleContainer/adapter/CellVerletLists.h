@@ -0,0 +1,141 @@
+/*
+ * CellVerletLists.h
+ *
+ *  Created on: 18 Oct 2026
+ */
+
+#ifndef SRC_PARTICLECONTAINER_ADAPTER_CELLVERLETLISTS_H_
+#define SRC_PARTICLECONTAINER_ADAPTER_CELLVERLETLISTS_H_
+
+#include "molecules/MoleculeForwardDeclaration.h"
+#include "utils/ConcatenatedSites.h"
+#include "utils/mardyn_assert.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief Per-cell bookkeeping for the Verlet list mode of the VectorizedCellProcessor.
+ * \details Every cell keeps the molecule IDs and positions of a reference configuration.
+ * As long as the cell contains the same molecules in the same order and none of them moved
+ * more than half the skin away from its reference position, the version of the cell stays
+ * unchanged. A cell pair list, which was built while both cells had their current version,
+ * then still contains every pair within the cutoff radius.
+ *
+ * The lists are stored in the SoA layout of the VectorizedCellProcessor: for every molecule of
+ * the first cell and every site type, one bit per SIMD block (one vector of sites of the force
+ * kernel) of the second cell, which is set if the block holds at least one site within the list radius.
+ * The pair lists of a cell are stored in a flat vector, indexed by the offset of the second cell
+ * in the stencil of neighbour cells.
+ */
+class CellVerletLists {
+	typedef ConcSites::SiteType SiteType;
+
+public:
+	/**
+	 * \brief Candidate blocks of the second cell for all molecules of the first cell.
+	 */
+	class PairList {
+	public:
+		/**
+		 * \brief Prepare the list for the current traversal.
+		 * Marks the list for a rebuild if one of the versions changed.
+		 * \param sitesPerBlock vector length of the force kernel, which uses the list
+		 */
+		void init(unsigned long version1, unsigned long version2, double margin, size_t numMolecules1,
+				const std::array<size_t, 4>& numSites2, size_t sitesPerBlock);
+
+		bool needsRebuild() const {
+			return _rebuild;
+		}
+
+		//! sum of the list margins of both cells, i.e. list radius minus cutoff radius
+		double getMargin() const {
+			return _margin;
+		}
+
+		uint64_t* getBlocks(SiteType type, size_t molecule) {
+			const size_t t = static_cast<size_t>(type);
+			return _blocks[t].data() + molecule * _wordsPerMolecule[t];
+		}
+
+	private:
+		unsigned long _version1 = 0;
+		unsigned long _version2 = 0;
+		bool _rebuild = true;
+		double _margin = 0.0;
+		std::array<size_t, 4> _wordsPerMolecule = {{0, 0, 0, 0}};
+		std::array<std::vector<uint64_t>, 4> _blocks;
+	};
+
+	CellVerletLists() : _skin(0.0), _version(0), _listMargin(0.0), _position{{0, 0, 0}}, _stencilRadius{{0, 0, 0}} {}
+
+	/**
+	 * \brief Verlet lists are used, if the skin is positive.
+	 * \param position 3D index of the cell in the cell grid
+	 * \param stencilRadius maximum distance (in cells) of the second cell of a pair in each dimension
+	 */
+	void setSkin(double skin, const int position[3], const int stencilRadius[3]);
+
+	bool isEnabled() const {
+		return _skin > 0.0;
+	}
+
+	unsigned long getVersion() const {
+		return _version;
+	}
+
+	/**
+	 * \brief Distance by which the list radius has to exceed the cutoff radius on behalf of this cell.
+	 * Half the skin plus the current displacement from the reference configuration.
+	 */
+	double getListMargin() const {
+		return _listMargin;
+	}
+
+	/**
+	 * \brief Compare the molecules of the cell to the reference configuration.
+	 * Increments the version and takes the molecules as new reference, if a molecule was
+	 * added, removed, reordered or moved more than half the skin.
+	 * Instantiated for Molecule and CompactHaloMolecule.
+	 */
+	template <class MoleculeType>
+	void updateReference(const std::vector<MoleculeType>& molecules);
+
+	/**
+	 * \brief Whether the molecules are the ones of the reference configuration in the same order.
+	 * Sorting the molecules of such a cell would invalidate its lists without need.
+	 */
+	bool hasReferenceOrder(const std::vector<Molecule>& molecules) const;
+
+	/**
+	 * \brief List for the interaction of this cell (first) with the cell owning other (second).
+	 */
+	PairList& getPairList(const CellVerletLists& other) {
+		size_t index = 0;
+		for (int d = 2; d >= 0; --d) {
+			const int offset = other._position[d] - _position[d] + _stencilRadius[d];
+			mardyn_assert(offset >= 0 and offset <= 2 * _stencilRadius[d]);
+			index = index * (2 * _stencilRadius[d] + 1) + offset;
+		}
+		return _pairLists[index];
+	}
+
+private:
+	double _skin;
+	unsigned long _version;
+	double _listMargin;
+
+	std::vector<unsigned long> _referenceIDs;
+	std::vector<double> _referencePositions;
+
+	std::array<int, 3> _position;
+	std::array<int, 3> _stencilRadius;
+
+	//! one list per neighbour cell, index ((dz * (2 ry + 1)) + dy) * (2 rx + 1) + dx with offsets shifted by the radius r
+	std::vector<PairList> _pairLists;
+};
+
+#endif /* SRC_PARTICLECONTAINER_ADAPTER_CELLVERLETLISTS_H_ */
@@ -48,8 +48,10 @@
 #include <sstream>
 
 #include "molecules/MoleculeForwardDeclaration.h"
+#include "vectorization/SIMD_PRECISION.h"
 
-class CellDataSoA;
+template<typename RealCalc, typename RealAccum> class CellDataSoAT;
+typedef CellDataSoAT<vcp_real_calc, vcp_real_accum> CellDataSoA;
 class CellDataSoARMM;
 
 /**
@@ -0,0 +1,561 @@
+#include "VCPMultiSiteRMM.h"
+
+#include "particleContainer/adapter/CellDataSoARMM.h"
+#include "molecules/Molecule.h"
+#include "particleContainer/ParticleCell.h"
+#include "Domain.h"
+#include "utils/Logger.h"
+#include "ensemble/EnsembleBase.h"
+#include "integrators/Integrator.h"
+#include "Simulation.h"
+#include "particleContainer/adapter/vectorization/MaskGatherChooser.h"
+
+#include <algorithm>
+#include <cstring>
+
+VCPMultiSiteRMM::VCPMultiSiteRMM(Domain& domain, double cutoffRadius, double LJcutoffRadius) :
+	CellProcessor(cutoffRadius, LJcutoffRadius), _domain(domain), _numLJcenters(0), _numCharges(0),
+	_dtInvm(0.0), _mass(0.0), _upot6lj(0.0), _upotXpoles(0.0), _virial(0.0) {
+#if VCP_VEC_TYPE==VCP_NOVEC
+	global_log->info() << "VCPMultiSiteRMM: using no intrinsics." << std::endl;
+#elif VCP_VEC_TYPE==VCP_VEC_SSE3
+	global_log->info() << "VCPMultiSiteRMM: using SSE3 intrinsics." << std::endl;
+#elif VCP_VEC_TYPE==VCP_VEC_AVX
+	global_log->info() << "VCPMultiSiteRMM: using AVX intrinsics." << std::endl;
+#elif VCP_VEC_TYPE==VCP_VEC_AVX2
+	global_log->info() << "VCPMultiSiteRMM: using AVX2 intrinsics." << std::endl;
+#elif (VCP_VEC_TYPE==VCP_VEC_KNL) || (VCP_VEC_TYPE==VCP_VEC_KNL_GATHER)
+	global_log->info() << "VCPMultiSiteRMM: using KNL intrinsics." << std::endl;
+#elif (VCP_VEC_TYPE==VCP_VEC_AVX512F) || (VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER)
+	global_log->info() << "VCPMultiSiteRMM: using SKX intrinsics." << std::endl;
+#endif
+
+	const Component& componentZero = _simulation.getEnsemble()->getComponents()->front();
+	const unsigned int componentZeroID = componentZero.ID();
+	_numLJcenters = componentZero.numLJcenters();
+	_numCharges = componentZero.numCharges();
+	_mass = static_cast<vcp_real_accum>(componentZero.m());
+
+	// LJ parameters of all pairs of LJ centers
+	ParaStrm & p = _domain.getComp2Params()(componentZeroID, componentZeroID);
+	p.reset_read();
+	for (unsigned a = 0; a < _numLJcenters; ++a) {
+		for (unsigned b = 0; b < _numLJcenters; ++b) {
+			double e, sig, shi;
+			p >> e; p >> sig; p >> shi;
+			_eps24.push_back(static_cast<vcp_real_calc>(e));
+			_sig2.push_back(static_cast<vcp_real_calc>(sig));
+			_shift6.push_back(static_cast<vcp_real_calc>(shi));
+		}
+	}
+
+	for (unsigned a = 0; a < _numCharges; ++a) {
+		for (unsigned b = 0; b < _numCharges; ++b) {
+			_qq.push_back(static_cast<vcp_real_calc>(componentZero.charge(a).q() * componentZero.charge(b).q()));
+		}
+	}
+
+	for (unsigned a = 0; a < _numLJcenters; ++a) {
+		const std::array<double, 3> r = componentZero.ljcenter(a).r();
+		_siteBodyX.push_back(static_cast<vcp_real_accum>(r[0]));
+		_siteBodyY.push_back(static_cast<vcp_real_accum>(r[1]));
+		_siteBodyZ.push_back(static_cast<vcp_real_accum>(r[2]));
+	}
+	for (unsigned a = 0; a < _numCharges; ++a) {
+		const std::array<double, 3> r = componentZero.charge(a).r();
+		_siteBodyX.push_back(static_cast<vcp_real_accum>(r[0]));
+		_siteBodyY.push_back(static_cast<vcp_real_accum>(r[1]));
+		_siteBodyZ.push_back(static_cast<vcp_real_accum>(r[2]));
+	}
+
+	global_log->info() << "VCPMultiSiteRMM: " << _numLJcenters << " LJ centers and "
+			<< _numCharges << " charges per molecule." << std::endl;
+
+	if (global_simulation != nullptr and global_simulation->getIntegrator() != nullptr) {
+		double dt = global_simulation->getIntegrator()->getTimestepLength();
+		_dtInvm = dt / componentZero.m();
+	} else {
+		global_log->info() << "VCPMultiSiteRMM: initialize dtInvm via setter method necessary." << endl;
+	}
+
+	// initialize thread data
+	_numThreads = mardyn_get_max_threads();
+	global_log->info() << "VCPMultiSiteRMM: allocate data for "
+			<< _numThreads << " threads." << std::endl;
+	_threadData.resize(_numThreads);
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		VCPMultiSiteRMMThreadData * myown = new VCPMultiSiteRMMThreadData();
+		const int myid = mardyn_get_thread_num();
+		_threadData[myid] = myown;
+	} // end pragma omp parallel
+}
+
+VCPMultiSiteRMM::~VCPMultiSiteRMM() {
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		const int myid = mardyn_get_thread_num();
+		delete _threadData[myid];
+	}
+}
+
+void VCPMultiSiteRMM::initTraversal() {
+	mardyn_assert(_dtInvm != static_cast<vcp_real_accum>(0.0));
+
+	#if defined(_OPENMP)
+	#pragma omp master
+	#endif
+	{
+		_upot6lj = 0.0;
+		_upotXpoles = 0.0;
+		_virial = 0.0;
+	} // end pragma omp master
+
+	global_log->debug() << "VCPMultiSiteRMM::initTraversal()." << std::endl;
+}
+
+void VCPMultiSiteRMM::processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll) {
+	mardyn_assert(&cell1 != &cell2);
+	ParticleCellRMM & cellRMM1 = downcastCellReferenceRMM(cell1);
+	ParticleCellRMM & cellRMM2 = downcastCellReferenceRMM(cell2);
+
+	CellDataSoARMM& soa1 = cellRMM1.getCellDataSoA();
+	CellDataSoARMM& soa2 = cellRMM2.getCellDataSoA();
+	const bool c1Halo = cellRMM1.isHaloCell();
+	const bool c2Halo = cellRMM2.isHaloCell();
+
+	// this variable determines whether
+	// _calcPairs(soa1, soa2) or _calcPairs(soa2, soa1)
+	// is more efficient
+	const bool calc_soa1_soa2 = (soa1.getMolNum() <= soa2.getMolNum());
+
+	// if one cell is empty, or both cells are Halo, skip
+	if (soa1.getMolNum() == 0 or soa2.getMolNum() == 0 or (c1Halo and c2Halo)) {
+		return;
+	}
+
+	// Macroscopic conditions as in VCP1CLJRMM::processCellPair()
+	const bool ApplyCutoff = true;
+
+	if (sumAll or (not c1Halo and not c2Halo) or (cellRMM1.getCellIndex() < cellRMM2.getCellIndex())) {
+		const bool CalculateMacroscopic = true;
+
+		if (calc_soa1_soa2) {
+			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+		} else {
+			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+		}
+	} else {
+		mardyn_assert(c1Halo != c2Halo);
+		mardyn_assert(not (cellRMM1.getCellIndex() < cellRMM2.getCellIndex()));
+
+		const bool CalculateMacroscopic = false;
+
+		if (calc_soa1_soa2) {
+			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+		} else {
+			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+		}
+	}
+}
+
+void VCPMultiSiteRMM::processCell(ParticleCell& cell) {
+	ParticleCellRMM & cellRMM = downcastCellReferenceRMM(cell);
+
+	CellDataSoARMM& soa = cellRMM.getCellDataSoA();
+	if (cellRMM.isHaloCell() or soa.getMolNum() < 2) {
+		return;
+	}
+	const bool CalculateMacroscopic = true;
+	const bool ApplyCutoff = true;
+	_calculatePairs<SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa, soa);
+}
+
+void VCPMultiSiteRMM::endTraversal() {
+	vcp_real_accum glob_upot6lj = 0.0;
+	vcp_real_accum glob_upotXpoles = 0.0;
+	vcp_real_accum glob_virial = 0.0;
+
+	#if defined(_OPENMP)
+	#pragma omp parallel reduction(+:glob_upot6lj, glob_upotXpoles, glob_virial)
+	#endif
+	{
+		const int tid = mardyn_get_thread_num();
+
+		// reduce vectors and clear local variable
+		vcp_real_accum thread_upot = 0.0, thread_upotXpoles = 0.0, thread_virial = 0.0;
+
+		load_hSum_Store_Clear(&thread_upot, _threadData[tid]->_upot6ljV);
+		load_hSum_Store_Clear(&thread_upotXpoles, _threadData[tid]->_upotXpolesV);
+		load_hSum_Store_Clear(&thread_virial, _threadData[tid]->_virialV);
+
+		// add to global sum
+		glob_upot6lj += thread_upot;
+		glob_upotXpoles += thread_upotXpoles;
+		glob_virial += thread_virial;
+	} // end pragma omp parallel reduction
+
+	_upot6lj = glob_upot6lj;
+	_upotXpoles = glob_upotXpoles;
+	_virial = glob_virial;
+	_domain.setLocalVirial(_virial);
+	_domain.setLocalUpot(_upot6lj / 6.0 + _upotXpoles);
+}
+
+void VCPMultiSiteRMM::fillSites(SiteBuffer& sites, const CellDataSoARMM& soa) const {
+	const size_t numMols = soa.getMolNum();
+	const size_t numSites = _numLJcenters + _numCharges;
+	sites._stride = vcp_ceil_to_vec_size(numMols);
+
+	const size_t size = numSites * sites._stride;
+	sites._x.resize_zero_shrink(size);
+	sites._y.resize_zero_shrink(size);
+	sites._z.resize_zero_shrink(size);
+	sites._fx.resize_zero_shrink(size);
+	sites._fy.resize_zero_shrink(size);
+	sites._fz.resize_zero_shrink(size);
+	std::memset(&sites._fx[0], 0, size * sizeof(vcp_real_accum));
+	std::memset(&sites._fy[0], 0, size * sizeof(vcp_real_accum));
+	std::memset(&sites._fz[0], 0, size * sizeof(vcp_real_accum));
+
+	const vcp_real_calc * const r_x = soa.r_xBegin();
+	const vcp_real_calc * const r_y = soa.r_yBegin();
+	const vcp_real_calc * const r_z = soa.r_zBegin();
+	const vcp_real_accum * const q_w = soa.q_wBegin();
+	const vcp_real_accum * const q_x = soa.q_xBegin();
+	const vcp_real_accum * const q_y = soa.q_yBegin();
+	const vcp_real_accum * const q_z = soa.q_zBegin();
+
+	for (size_t s = 0; s < numSites; ++s) {
+		const vcp_real_accum bx = _siteBodyX[s];
+		const vcp_real_accum by = _siteBodyY[s];
+		const vcp_real_accum bz = _siteBodyZ[s];
+		vcp_real_calc * const x = sites.x(s);
+		vcp_real_calc * const y = sites.y(s);
+		vcp_real_calc * const z = sites.z(s);
+
+		// rotate the body-fixed site position, see Quaternion::rotate()
+		#if defined(_OPENMP)
+		#pragma omp simd
+		#endif
+		for (size_t j = 0; j < numMols; ++j) {
+			const vcp_real_accum ww = q_w[j] * q_w[j], xx = q_x[j] * q_x[j], yy = q_y[j] * q_y[j], zz = q_z[j] * q_z[j];
+			const vcp_real_accum wx = q_w[j] * q_x[j], wy = q_w[j] * q_y[j], wz = q_w[j] * q_z[j];
+			const vcp_real_accum xy = q_x[j] * q_y[j], xz = q_x[j] * q_z[j], yz = q_y[j] * q_z[j];
+
+			const vcp_real_accum dx = (ww + xx - yy - zz) * bx + 2 * (xy - wz) * by + 2 * (wy + xz) * bz;
+			const vcp_real_accum dy = 2 * (wz + xy) * bx + (ww - xx + yy - zz) * by + 2 * (yz - wx) * bz;
+			const vcp_real_accum dz = 2 * (xz - wy) * bx + 2 * (wx + yz) * by + (ww - xx - yy + zz) * bz;
+
+			x[j] = static_cast<vcp_real_calc>(r_x[j] + dx);
+			y[j] = static_cast<vcp_real_calc>(r_y[j] + dy);
+			z[j] = static_cast<vcp_real_calc>(r_z[j] + dz);
+		}
+		for (size_t j = numMols; j < sites._stride; ++j) {
+			x[j] = y[j] = z[j] = 0.0;
+		}
+	}
+}
+
+void VCPMultiSiteRMM::kickMolecules(SiteBuffer& sites, CellDataSoARMM& soa) const {
+	const size_t numMols = soa.getMolNum();
+	const size_t numSites = _numLJcenters + _numCharges;
+
+	const vcp_real_calc * const r_x = soa.r_xBegin();
+	const vcp_real_calc * const r_y = soa.r_yBegin();
+	const vcp_real_calc * const r_z = soa.r_zBegin();
+	vcp_real_accum * const v_x = soa.v_xBegin();
+	vcp_real_accum * const v_y = soa.v_yBegin();
+	vcp_real_accum * const v_z = soa.v_zBegin();
+	vcp_real_accum * const D_x = soa.D_xBegin();
+	vcp_real_accum * const D_y = soa.D_yBegin();
+	vcp_real_accum * const D_z = soa.D_zBegin();
+
+	// the angular momentum is kicked with dt = _dtInvm * m
+	const vcp_real_accum dtInvm = _dtInvm;
+	const vcp_real_accum dt = _dtInvm * _mass;
+
+	for (size_t s = 0; s < numSites; ++s) {
+		const vcp_real_calc * const x = sites.x(s);
+		const vcp_real_calc * const y = sites.y(s);
+		const vcp_real_calc * const z = sites.z(s);
+		const vcp_real_accum * const fx = sites.fx(s);
+		const vcp_real_accum * const fy = sites.fy(s);
+		const vcp_real_accum * const fz = sites.fz(s);
+
+		#if defined(_OPENMP)
+		#pragma omp simd
+		#endif
+		for (size_t j = 0; j < numMols; ++j) {
+			const vcp_real_accum dx = static_cast<vcp_real_accum>(x[j]) - static_cast<vcp_real_accum>(r_x[j]);
+			const vcp_real_accum dy = static_cast<vcp_real_accum>(y[j]) - static_cast<vcp_real_accum>(r_y[j]);
+			const vcp_real_accum dz = static_cast<vcp_real_accum>(z[j]) - static_cast<vcp_real_accum>(r_z[j]);
+
+			v_x[j] += dtInvm * fx[j];
+			v_y[j] += dtInvm * fy[j];
+			v_z[j] += dtInvm * fz[j];
+
+			D_x[j] += dt * (dy * fz[j] - dz * fy[j]);
+			D_y[j] += dt * (dz * fx[j] - dx * fz[j]);
+			D_z[j] += dt * (dx * fy[j] - dy * fx[j]);
+		}
+	}
+}
+
+template<bool calculateMacroscopic>
+vcp_inline void VCPMultiSiteRMM::_loopBodyLJ(
+	const RealCalcVec& m_dx, const RealCalcVec& m_dy, const RealCalcVec& m_dz,
+	const RealCalcVec& c_dx, const RealCalcVec& c_dy, const RealCalcVec& c_dz, const RealCalcVec& c_r2,
+	RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+	RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+	const MaskCalcVec& forceMask,
+	const RealCalcVec& eps_24, const RealCalcVec& sig2,
+	const RealCalcVec& shift6)
+{
+	const RealCalcVec r2_inv = RealCalcVec::fastReciprocal_mask(c_r2, forceMask);
+
+	const RealCalcVec lj2 = sig2 * r2_inv;//1FP (scale)
+	const RealCalcVec lj4 = lj2 * lj2;//1FP (scale)
+	const RealCalcVec lj6 = lj4 * lj2;//1FP (scale)
+	const RealCalcVec lj12 = lj6 * lj6;//1FP (scale)
+	const RealCalcVec lj12m6 = lj12 - lj6;//1FP (scale)
+
+	const RealCalcVec eps24r2inv = eps_24 * r2_inv;//1FP (scale)
+	const RealCalcVec lj12lj12m6 = lj12 + lj12m6;//1FP (scale)
+	const RealCalcVec scale = eps24r2inv * lj12lj12m6;//1FP (scale)
+
+	f_x = c_dx * scale;//1FP (apply scale)
+	f_y = c_dy * scale;//1FP (apply scale)
+	f_z = c_dz * scale;//1FP (apply scale)
+
+	// Check if we have to add the macroscopic values up
+	if (calculateMacroscopic) {
+
+		const RealCalcVec upot_sh = RealCalcVec::fmadd(eps_24, lj12m6, shift6); //2 FP upot				//shift6 is not masked -> we have to mask upot_shifted
+		const RealCalcVec upot_masked = RealCalcVec::apply_mask(upot_sh, forceMask); //mask it
+		const RealAccumVec upot_masked_accum = RealAccumVec::convertCalcToAccum(upot_masked);
+
+		sum_upot6lj = sum_upot6lj + upot_masked_accum;//1FP (sum macro)
+
+		// the virial uses the distance of the centers of mass
+		const RealAccumVec virial = RealAccumVec::convertCalcToAccum(m_dx * f_x + m_dy * f_y + m_dz * f_z);
+		sum_virial = sum_virial + virial;//1 FP (sum macro) + 5 FP (virial)
+	}
+}
+
+template<bool calculateMacroscopic>
+vcp_inline void VCPMultiSiteRMM::_loopBodyCharge(
+	const RealCalcVec& m_dx, const RealCalcVec& m_dy, const RealCalcVec& m_dz,
+	const RealCalcVec& c_dx, const RealCalcVec& c_dy, const RealCalcVec& c_dz, const RealCalcVec& c_r2,
+	RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+	RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+	const MaskCalcVec& forceMask,
+	const RealCalcVec& qq)
+{
+	const RealCalcVec c_dr2_inv = RealCalcVec::fastReciprocal_mask(c_r2, forceMask);//masked
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	const RealCalcVec c_dr_inv = RealCalcVec::fastReciprocSqrt_mask(c_r2, forceMask);//masked
+#else
+	const RealCalcVec c_dr_inv = RealCalcVec::sqrt(c_dr2_inv);//masked
+#endif
+
+	const RealCalcVec upot = qq * c_dr_inv;//masked
+	const RealCalcVec fac = upot * c_dr2_inv;//masked
+
+	f_x = c_dx * fac;
+	f_y = c_dy * fac;
+	f_z = c_dz * fac;
+
+	// Check if we have to add the macroscopic values up
+	if (calculateMacroscopic) {
+		sum_upotXpoles = sum_upotXpoles + RealAccumVec::convertCalcToAccum(upot);
+
+		const RealAccumVec virial = RealAccumVec::convertCalcToAccum(m_dx * f_x + m_dy * f_y + m_dz * f_z);
+		sum_virial = sum_virial + virial;
+	}
+}
+
+template<bool CalculateMacroscopic, class MaskGatherChooser, bool isLJ>
+vcp_inline void VCPMultiSiteRMM::_loopOverSitesJ(size_t a, size_t j,
+		const RealCalcVec& m_dx, const RealCalcVec& m_dy, const RealCalcVec& m_dz,
+		const RealCalcVec& c1_r_x, const RealCalcVec& c1_r_y, const RealCalcVec& c1_r_z,
+		SiteBuffer& sites2, const MaskCalcVec& forceMask,
+		RealAccumVec& sum_fx1, RealAccumVec& sum_fy1, RealAccumVec& sum_fz1,
+		RealAccumVec& sum_upot, RealAccumVec& sum_virial) {
+
+	const unsigned numSitesOfType = isLJ ? _numLJcenters : _numCharges;
+	const size_t siteOffset = isLJ ? 0 : _numLJcenters;
+
+	for (unsigned b = 0; b < numSitesOfType; ++b) {
+		const size_t siteJ = siteOffset + b;
+
+		// the site buffers are padded with zeros, so we can always load whole vectors
+		const RealCalcVec c2_r_x = RealCalcVec::aligned_load(sites2.x(siteJ) + j);
+		const RealCalcVec c2_r_y = RealCalcVec::aligned_load(sites2.y(siteJ) + j);
+		const RealCalcVec c2_r_z = RealCalcVec::aligned_load(sites2.z(siteJ) + j);
+
+		const RealCalcVec c_dx = c1_r_x - c2_r_x;
+		const RealCalcVec c_dy = c1_r_y - c2_r_y;
+		const RealCalcVec c_dz = c1_r_z - c2_r_z;
+
+		const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		RealCalcVec fx, fy, fz;
+		const size_t pairIndex = a * numSitesOfType + b;
+		if (isLJ) {
+			const RealCalcVec eps24 = RealCalcVec::set1(_eps24[pairIndex]);
+			const RealCalcVec sig2 = RealCalcVec::set1(_sig2[pairIndex]);
+			const RealCalcVec shift6 = RealCalcVec::set1(_shift6[pairIndex]);
+			_loopBodyLJ<CalculateMacroscopic>(m_dx, m_dy, m_dz, c_dx, c_dy, c_dz, c_r2, fx, fy, fz,
+					sum_upot, sum_virial, forceMask, eps24, sig2, shift6);
+		} else {
+			const RealCalcVec qq = RealCalcVec::set1(_qq[pairIndex]);
+			_loopBodyCharge<CalculateMacroscopic>(m_dx, m_dy, m_dz, c_dx, c_dy, c_dz, c_r2, fx, fy, fz,
+					sum_upot, sum_virial, forceMask, qq);
+		}
+
+		const RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
+		const RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
+		const RealAccumVec a_fz = RealAccumVec::convertCalcToAccum(fz);
+
+		vcp_simd_load_sub_store<MaskGatherChooser>(sites2.fx(siteJ), j, a_fx, forceMask);
+		vcp_simd_load_sub_store<MaskGatherChooser>(sites2.fy(siteJ), j, a_fy, forceMask);
+		vcp_simd_load_sub_store<MaskGatherChooser>(sites2.fz(siteJ), j, a_fz, forceMask);
+
+		sum_fx1 = sum_fx1 + a_fx;
+		sum_fy1 = sum_fy1 + a_fy;
+		sum_fz1 = sum_fz1 + a_fz;
+	}
+}
+
+template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser, bool isLJ>
+vcp_inline void VCPMultiSiteRMM::_calculateSite(size_t i, size_t siteI, SiteBuffer& sites1,
+		const CellDataSoARMM & soa1, const CellDataSoARMM & soa2, SiteBuffer& sites2,
+		const RealCalcVec& rc2, RealAccumVec& sum_upot, RealAccumVec& sum_virial) {
+
+	const size_t a = (isLJ ? 0 : _numLJcenters) + siteI;
+
+	const vcp_real_calc * const soa2_mol_pos_x = soa2.r_xBegin();
+	const vcp_real_calc * const soa2_mol_pos_y = soa2.r_yBegin();
+	const vcp_real_calc * const soa2_mol_pos_z = soa2.r_zBegin();
+
+	const RealCalcVec m1_r_x = RealCalcVec::broadcast(soa1.r_xBegin() + i);
+	const RealCalcVec m1_r_y = RealCalcVec::broadcast(soa1.r_yBegin() + i);
+	const RealCalcVec m1_r_z = RealCalcVec::broadcast(soa1.r_zBegin() + i);
+
+	const RealCalcVec c1_r_x = RealCalcVec::broadcast(sites1.x(a) + i);
+	const RealCalcVec c1_r_y = RealCalcVec::broadcast(sites1.y(a) + i);
+	const RealCalcVec c1_r_z = RealCalcVec::broadcast(sites1.z(a) + i);
+
+	RealAccumVec sum_fx1 = RealAccumVec::zero();
+	RealAccumVec sum_fy1 = RealAccumVec::zero();
+	RealAccumVec sum_fz1 = RealAccumVec::zero();
+
+	const size_t end_j = vcp_floor_to_vec_size(soa2.getMolNum());
+
+	size_t j = ForcePolicy :: InitJ(i);
+	MaskCalcVec initJ_mask = ForcePolicy :: InitJ_Mask(i);
+
+	for (; j < end_j; j += VCP_VEC_SIZE) {
+		const RealCalcVec m2_r_x = RealCalcVec::aligned_load(soa2_mol_pos_x + j);
+		const RealCalcVec m2_r_y = RealCalcVec::aligned_load(soa2_mol_pos_y + j);
+		const RealCalcVec m2_r_z = RealCalcVec::aligned_load(soa2_mol_pos_z + j);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		const RealCalcVec m_r2 = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz);
+
+		const MaskCalcVec forceMask = ForcePolicy::GetForceMask(m_r2, rc2, initJ_mask);
+
+		if (MaskGatherChooser::computeLoop(forceMask)) {
+			_loopOverSitesJ<CalculateMacroscopic, MaskGatherChooser, isLJ>(siteI, j, m_dx, m_dy, m_dz,
+					c1_r_x, c1_r_y, c1_r_z, sites2, forceMask, sum_fx1, sum_fy1, sum_fz1, sum_upot, sum_virial);
+		}
+	}
+	const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(soa2.getMolNum());
+	if (remainderMask.movemask())
+	{
+		const RealCalcVec m2_r_x = RealCalcVec::aligned_load_mask(soa2_mol_pos_x + j, remainderMask);
+		const RealCalcVec m2_r_y = RealCalcVec::aligned_load_mask(soa2_mol_pos_y + j, remainderMask);
+		const RealCalcVec m2_r_z = RealCalcVec::aligned_load_mask(soa2_mol_pos_z + j, remainderMask);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		const RealCalcVec m_r2 = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz);
+
+		const MaskCalcVec forceMask = remainderMask and ForcePolicy::GetForceMask(m_r2, rc2, initJ_mask);//AND remainderMask -> set unimportant ones to zero.
+
+		if (MaskGatherChooser::computeLoop(forceMask)) {
+			_loopOverSitesJ<CalculateMacroscopic, MaskGatherChooser, isLJ>(siteI, j, m_dx, m_dy, m_dz,
+					c1_r_x, c1_r_y, c1_r_z, sites2, forceMask, sum_fx1, sum_fy1, sum_fz1, sum_upot, sum_virial);
+		}
+	}
+
+	hSum_Add_Store(sites1.fx(a) + i, sum_fx1);
+	hSum_Add_Store(sites1.fy(a) + i, sum_fy1);
+	hSum_Add_Store(sites1.fz(a) + i, sum_fz1);
+}
+
+template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
+void VCPMultiSiteRMM::_calculatePairs(CellDataSoARMM& soa1, CellDataSoARMM& soa2) {
+	mardyn_assert(soa1.isRotational() and soa2.isRotational());
+
+	const int tid = mardyn_get_thread_num();
+	VCPMultiSiteRMMThreadData &my_threadData = *_threadData[tid];
+
+	// for a single cell, both buffers are the same
+	const bool singleCell = (&soa1 == &soa2);
+	SiteBuffer& sites1 = my_threadData._sites[0];
+	SiteBuffer& sites2 = singleCell ? my_threadData._sites[0] : my_threadData._sites[1];
+	fillSites(sites1, soa1);
+	if (not singleCell) {
+		fillSites(sites2, soa2);
+	}
+
+	RealAccumVec sum_upot6lj = RealAccumVec::zero();
+	RealAccumVec sum_upotXpoles = RealAccumVec::zero();
+	RealAccumVec sum_virial = RealAccumVec::zero();
+
+	const RealCalcVec rcLJ2 = RealCalcVec::set1(_LJCutoffRadiusSquare);
+	const RealCalcVec rc2 = RealCalcVec::set1(_cutoffRadiusSquare);
+
+#if not (VCP_VEC_TYPE == VCP_VEC_KNL_GATHER) and not (VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER)
+
+	const size_t soa1_mol_num = soa1.getMolNum();
+	for (size_t i = 0; i < soa1_mol_num; ++i) {
+		for (unsigned a = 0; a < _numLJcenters; ++a) {
+			_calculateSite<ForcePolicy, CalculateMacroscopic, MaskGatherChooser, true>(i, a, sites1, soa1, soa2, sites2,
+					rcLJ2, sum_upot6lj, sum_virial);
+		}
+		for (unsigned a = 0; a < _numCharges; ++a) {
+			_calculateSite<ForcePolicy, CalculateMacroscopic, MaskGatherChooser, false>(i, a, sites1, soa1, soa2, sites2,
+					rc2, sum_upotXpoles, sum_virial);
+		}
+	}
+
+	sum_upot6lj.aligned_load_add_store(&my_threadData._upot6ljV[0]);
+	sum_upotXpoles.aligned_load_add_store(&my_threadData._upotXpolesV[0]);
+	sum_virial.aligned_load_add_store(&my_threadData._virialV[0]);
+
+	kickMolecules(sites1, soa1);
+	if (not singleCell) {
+		kickMolecules(sites2, soa2);
+	}
+
+#else
+#pragma message "TODO: RMM Mode is not implemented yet for KNL_G_S and SKX_G_S."
+#endif
+}
@@ -0,0 +1,194 @@
+#ifndef SRC_PARTICLECONTAINER_ADAPTER_VCPMULTISITERMM_H_
+#define SRC_PARTICLECONTAINER_ADAPTER_VCPMULTISITERMM_H_
+
+#include "CellProcessor.h"
+
+#include "particleContainer/adapter/vectorization/SIMD_TYPES.h"
+#include "particleContainer/adapter/vectorization/SIMD_VectorizedCellProcessorHelpers.h"
+#include "WrapOpenMP.h"
+
+#include "molecules/MoleculeForwardDeclaration.h"
+
+#include <vector>
+
+class Component;
+class Domain;
+class CellDataSoARMM;
+
+/**
+ * \brief Vectorized cell processor of the RMM mode for a rigid component of
+ * several LJ centers and charges.
+ * \details Like VCP1CLJRMM, the forces are not stored, but directly kicked
+ * into the velocities (and the torques into the angular momenta).
+ * The site positions are not stored either: for every cell (pair), they are
+ * computed from the positions and the quaternions into per-thread buffers,
+ * which also collect the site forces before they are reduced to the molecules.
+ * As in the full mode, the cutoff is applied to the distance of the centers of mass.
+ */
+class VCPMultiSiteRMM: public CellProcessor {
+public:
+	VCPMultiSiteRMM(Domain & domain, double cutoffRadius, double LJcutoffRadius);
+	~VCPMultiSiteRMM();
+
+	/**
+	 * \brief Reset macroscopic values to 0.0.
+	 */
+	void initTraversal();
+
+	void preprocessCell(ParticleCell& /*cell*/) {}
+
+	void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false /* related to ZonalMethod */);
+
+	double processSingleMolecule(Molecule* /*m1*/, ParticleCell& /*cell2*/) {
+		return 0.0;
+	}
+
+	/**
+	 * \brief Calculate forces between pairs of Molecules in cell.
+	 */
+	void processCell(ParticleCell& cell);
+
+	void postprocessCell(ParticleCell& /*cell*/) {}
+
+	/**
+	 * \brief Store macroscopic values in the Domain.
+	 */
+	void endTraversal();
+
+	void setDtInvm(double dtInvm) {
+		_dtInvm = static_cast<vcp_real_accum>(dtInvm);
+	}
+
+	double getDtInvm() const {
+		return _dtInvm;
+	}
+
+private:
+	/**
+	 * \brief The Domain where macroscopic values will be stored.
+	 */
+	Domain & _domain;
+
+	unsigned _numLJcenters, _numCharges;
+
+	//! LJ parameters of the pairs of LJ centers, index: a * _numLJcenters + b
+	std::vector<vcp_real_calc> _eps24, _sig2, _shift6;
+
+	//! products of the charges, index: a * _numCharges + b
+	std::vector<vcp_real_calc> _qq;
+
+	//! body-fixed site positions, first the LJ centers, then the charges
+	std::vector<vcp_real_accum> _siteBodyX, _siteBodyY, _siteBodyZ;
+
+	vcp_real_accum _dtInvm, _mass;
+
+	/**
+	 * \brief Sum of all LJ potentials.
+	 * \details Multiplied by 6.0 for performance reasons.
+	 */
+	double _upot6lj;
+
+	//! Sum of all charge potentials.
+	double _upotXpoles;
+
+	/**
+	 * \brief The virial.
+	 */
+	double _virial;
+
+	/**
+	 * \brief Site positions and forces of the molecules of one cell.
+	 * \details Site-major layout: the entries of site s start at s * _stride.
+	 */
+	struct SiteBuffer {
+		SiteBuffer() : _stride(0) {}
+
+		vcp_real_calc * x(size_t s) { return &_x[s * _stride]; }
+		vcp_real_calc * y(size_t s) { return &_y[s * _stride]; }
+		vcp_real_calc * z(size_t s) { return &_z[s * _stride]; }
+		vcp_real_accum * fx(size_t s) { return &_fx[s * _stride]; }
+		vcp_real_accum * fy(size_t s) { return &_fy[s * _stride]; }
+		vcp_real_accum * fz(size_t s) { return &_fz[s * _stride]; }
+
+		AlignedArray<vcp_real_calc> _x, _y, _z;
+		AlignedArray<vcp_real_accum> _fx, _fy, _fz;
+		size_t _stride;
+	};
+
+	struct VCPMultiSiteRMMThreadData {
+	public:
+		VCPMultiSiteRMMThreadData() {
+			_upot6ljV.resize(_numVectorElements);
+			_upotXpolesV.resize(_numVectorElements);
+			_virialV.resize(_numVectorElements);
+
+			for (size_t j = 0; j < _numVectorElements; ++j) {
+				_upot6ljV[j] = 0.0;
+				_upotXpolesV[j] = 0.0;
+				_virialV[j] = 0.0;
+			}
+		}
+
+		//! buffers for the two cells of a pair, only the first one is used for a single cell
+		SiteBuffer _sites[2];
+
+		AlignedArray<vcp_real_accum> _upot6ljV, _upotXpolesV, _virialV;
+	};
+
+	std::vector<VCPMultiSiteRMMThreadData *> _threadData;
+
+	static const size_t _numVectorElements = VCP_VEC_SIZE;
+	size_t _numThreads;
+
+	//! compute the absolute site positions of all molecules of soa and clear the site forces
+	void fillSites(SiteBuffer& sites, const CellDataSoARMM& soa) const;
+
+	//! reduce the site forces to forces and torques and kick the velocities and angular momenta
+	void kickMolecules(SiteBuffer& sites, CellDataSoARMM& soa) const;
+
+	template<bool calculateMacroscopic>
+	vcp_inline
+	void _loopBodyLJ(
+		const RealCalcVec& m_dx, const RealCalcVec& m_dy, const RealCalcVec& m_dz,
+		const RealCalcVec& c_dx, const RealCalcVec& c_dy, const RealCalcVec& c_dz, const RealCalcVec& c_r2,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask,
+		const RealCalcVec& eps_24, const RealCalcVec& sig2,
+		const RealCalcVec& shift6);
+
+	template<bool calculateMacroscopic>
+	vcp_inline
+	void _loopBodyCharge(
+		const RealCalcVec& m_dx, const RealCalcVec& m_dy, const RealCalcVec& m_dz,
+		const RealCalcVec& c_dx, const RealCalcVec& c_dy, const RealCalcVec& c_dz, const RealCalcVec& c_r2,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask,
+		const RealCalcVec& qq);
+
+	//! interactions of site a of molecule i with the sites of the same type of the molecules j .. j+VCP_VEC_SIZE-1
+	template<bool CalculateMacroscopic, class MaskGatherChooser, bool isLJ>
+	vcp_inline void _loopOverSitesJ(size_t a, size_t j,
+			const RealCalcVec& m_dx, const RealCalcVec& m_dy, const RealCalcVec& m_dz,
+			const RealCalcVec& c1_r_x, const RealCalcVec& c1_r_y, const RealCalcVec& c1_r_z,
+			SiteBuffer& sites2, const MaskCalcVec& forceMask,
+			RealAccumVec& sum_fx1, RealAccumVec& sum_fy1, RealAccumVec& sum_fz1,
+			RealAccumVec& sum_upot, RealAccumVec& sum_virial);
+
+	/**
+	 * \brief Site-site interactions of one site of molecule i with one site type of all molecules of soa2.
+	 * \details The policy classes and MaskGatherChooser are used as in VCP1CLJRMM::_calculatePairs().
+	 * The cutoff rc2 is applied to the distance of the centers of mass.
+	 */
+	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser, bool isLJ>
+	vcp_inline void _calculateSite(size_t i, size_t siteI, SiteBuffer& sites1,
+			const CellDataSoARMM & soa1, const CellDataSoARMM & soa2, SiteBuffer& sites2,
+			const RealCalcVec& rc2, RealAccumVec& sum_upot, RealAccumVec& sum_virial);
+
+	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
+	vcp_inline void _calculatePairs(CellDataSoARMM & soa1, CellDataSoARMM & soa2);
+
+};
+
+#endif /* SRC_PARTICLECONTAINER_ADAPTER_VCPMULTISITERMM_H_ */
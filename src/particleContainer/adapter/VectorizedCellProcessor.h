@@ -8,19 +8,40 @@
 #define VECTORIZEDCELLPROCESSOR_H_
 
 #include "CellProcessor.h"
+#include "CellVerletLists.h"
 #include "utils/AlignedArray.h"
 #include <iostream>
+#include <map>
+#include <memory>
+#include <string>
 #include <vector>
 #include <cmath>
-#include "vectorization/SIMD_TYPES.h"
-#include "vectorization/SIMD_VectorizedCellProcessorHelpers.h"
+#include "vectorization/SIMD_PRECISION.h"
 #include "WrapOpenMP.h"
 
+/*
+ * Force kernels for further instruction sets, which are selected at run time (VCP_DISPATCH, see vectorization.cmake).
+ * They are compiled with #pragma GCC target, so only the GNU compiler is supported. Instruction sets,
+ * which are enabled for the whole build anyway, do not need a second kernel.
+ */
+#if defined(VCP_DISPATCH) and defined(__GNUC__) and not defined(__clang__) and not defined(__INTEL_COMPILER) and \
+	(defined(__x86_64__) or defined(__i386__)) and not defined(NOVEC) and not defined(ENABLE_REDUCED_MEMORY_MODE)
+	#if not defined(__AVX2__)
+		#define VCP_DISPATCH_AVX2
+	#endif
+	#if not defined(__AVX512F__)
+		#define VCP_DISPATCH_AVX512F
+	#endif
+#endif
+
 #include "molecules/MoleculeForwardDeclaration.h"
 class Component;
 class Domain;
 class Comp2Param;
-class CellDataSoA;
+template<typename RealCalc, typename RealAccum> class CellDataSoAT;
+typedef CellDataSoAT<vcp_real_calc, vcp_real_accum> CellDataSoA;
+class FullParticleCell;
+class VectorizedMoleculeUpdate;
 
 /**
  * \brief Vectorized calculation of the force.
@@ -28,6 +49,7 @@ class CellDataSoA;
  */
 class VectorizedCellProcessor : public CellProcessor {
 	friend class VCP1CLJRMMTest;
+	friend class VCPMultiSiteRMMTest;
 public:
 	typedef std::vector<Component> ComponentList;
 
@@ -36,11 +58,19 @@ public:
 	/**
 	 * \brief Construct and set up the internal parameter table.
 	 * \details Components and parameters should be finalized before this call.
+	 * \param precision precision of the force calculation (VCP_SPSP, VCP_SPDP or VCP_DPDP, see SIMD_PRECISION.h),
+	 * the precision of the build by default
 	 */
-	VectorizedCellProcessor(Domain & domain, double cutoffRadius, double LJcutoffRadius);
+	VectorizedCellProcessor(Domain & domain, double cutoffRadius, double LJcutoffRadius, int precision = VCP_PREC);
 
 	~VectorizedCellProcessor();
 
+	//! \brief Name of a precision as in the PRECISION option of the build: SINGLE (VCP_SPSP), MIXED (VCP_SPDP) or DOUBLE (VCP_DPDP).
+	static std::string precisionToString(int precision);
+
+	//! \brief Precision of a name as returned by precisionToString(), case insensitive. -1, if the name is unknown.
+	static int stringToPrecision(std::string name);
+
 	/**
 	 * \brief Reset macroscopic values to 0.0.
 	 */
@@ -50,9 +80,20 @@ public:
 	 */
 	void preprocessCell(ParticleCell& /*cell*/) {}
 
-	double processSingleMolecule(Molecule* /*m1*/, ParticleCell& /*cell2*/) {
-		return 0.0;
-	}
+	/**
+	 * \brief Potential energy of the test molecule m1 with the molecules of cell2 (see ChemicalPotential).
+	 * \details The sites of m1 are written into a CellDataSoA of the thread, whose interactions with the
+	 * CellDataSoA of cell2 are evaluated by the force kernel, vectorized over the centers of cell2.
+	 * A molecule of cell2 at the position of m1, i.e. m1 itself in case of a test deletion, is skipped.
+	 */
+	double processSingleMolecule(Molecule* m1, ParticleCell& cell2);
+
+	/**
+	 * \brief Potential energy of the test molecule m1 with the molecules of all given cells.
+	 * \details As processSingleMolecule(), but the sites of m1 are set up once for all cells,
+	 * e.g. the cell of m1, which comes first, and its neighbours in LinkedCells::getEnergy().
+	 */
+	double processSingleMolecule(Molecule* m1, const std::vector<ParticleCell*>& cells);
 
 	/**
 	 * \brief Calculate forces between pairs of Molecules in cell.
@@ -62,14 +103,168 @@ public:
         void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false);
         
 	/**
-	 * \brief Free the LennardJonesSoA for cell.
+	 * \brief Second half step of the leapfrog integrator for the molecules of a non-halo cell,
+	 * if it is fused into the traversal (see setFusedHalfKick()).
 	 */
-	void postprocessCell(ParticleCell& /*cell*/) {}
+	void postprocessCell(ParticleCell& cell);
 	/**
 	 * \brief Store macroscopic values in the Domain.
 	 */
 	void endTraversal();
 
+	/**
+	 * \brief Fuse the second half step of the leapfrog integrator into the force traversal.
+	 * \details For dtHalf > 0, postprocessCell() computes force and torque of the molecules of every
+	 * non-halo cell (Molecule::calcFM()), applies the velocity half-kick (Molecule::upd_postF()), both
+	 * vectorized on the CellDataSoA of the cell (see VectorizedMoleculeUpdate), and
+	 * accumulates the thermostat sums, which endTraversal() stores in the Domain. This saves the
+	 * separate sweeps over all molecules of Simulation::updateForces() and Leapfrog::eventForcesCalculated().
+	 * 0 disables the fused integration.
+	 */
+	void setFusedHalfKick(double dtHalf) {
+		_fusedDtHalf = dtHalf;
+	}
+
+	bool requiresPostprocessing() const override {
+		return _fusedDtHalf > 0.0;
+	}
+
+	//! \brief Grid of a tabulated potential, whose coefficients start at offset in _tabCoeffs (see TabulatedPotential::tabulate()).
+	struct TabulatedTable {
+		size_t offset;
+		double r2min;
+		double invDr2;
+		unsigned intervals;
+	};
+
+	/**
+	 * \brief Vectorized force calculation for one instruction set and precision.
+	 * \details The kernel holds the per thread data of the force calculation and the parameter tables
+	 * in its precision. The implementation (VectorizedCellProcessorKernel.h) is compiled for the
+	 * instruction set of the build and, if VCP_DISPATCH is enabled, for AVX2 and AVX-512 in addition.
+	 * The constructor of the VectorizedCellProcessor picks the widest kernel, which the CPU supports.<br>
+	 * The kernels for the precisions, which differ from the one of the build, are compiled for the same
+	 * instruction sets. They calculate the forces on copies of the CellDataSoAs in their precision
+	 * (see CellDataSoAConversion), which are made once per traversal, and add them to the CellDataSoAs
+	 * in endTraversal() or finishCell().
+	 */
+	class Kernel {
+	public:
+		explicit Kernel(const VectorizedCellProcessor& vcp) :
+				_vcp(vcp), _epsRFInvrc3(vcp._epsRFInvrc3), _singleSiteLJ(vcp._singleSiteLJ),
+				_ljcTab(vcp._ljcTab), _tabTables(vcp._tabTables), _tabCoeffs(vcp._tabCoeffs), _traversal(0) {
+		}
+
+		virtual ~Kernel() {
+		}
+
+		//! \brief Instruction set of the kernel, for the log.
+		virtual const char* getInstructionSet() const = 0;
+
+		//! \brief Precision of the kernel (VCP_SPSP, VCP_SPDP or VCP_DPDP).
+		virtual int getPrecision() const = 0;
+
+		//! \brief Number of sites processed per vector, i.e. the block size of the Verlet lists.
+		virtual size_t getVectorLength() const = 0;
+
+		//! \brief Whether the kernel uses Verlet lists, the single-site LJ path is faster without them.
+		virtual bool usesVerletLists() const = 0;
+
+		/**
+		 * \brief Calculate the forces between the molecules of soa1 and the centers of soa2.
+		 * \param singleCell whether soa1 and soa2 are the same cell, i.e. every pair is calculated once
+		 * \param calculateMacroscopic whether potential energy and virial are summed up
+		 * \param verletList see VectorizedCellProcessor::getVerletPairList()
+		 */
+		virtual void calculatePairs(CellDataSoA& soa1, CellDataSoA& soa2, CellVerletLists::PairList* verletList,
+				bool singleCell, bool calculateMacroscopic) = 0;
+
+		/**
+		 * \brief Potential energy of the molecules of soa1 with the molecules of all soa2s, except those at the same
+		 * position, as in FluidPot(). The forces of the soa2s and the macroscopic values of the traversal are left unchanged.
+		 */
+		virtual double calculateEnergy(CellDataSoA& soa1, const std::vector<CellDataSoA*>& soa2s) = 0;
+
+		//! \brief Add the macroscopic values summed up by the calling thread and reset them.
+		virtual void reduceMacroscopic(vcp_real_accum& upot6lj, vcp_real_accum& upotXpoles,
+				vcp_real_accum& virial, vcp_real_accum& myRF) = 0;
+
+		//! \brief Start a new traversal, i.e. the copies of the CellDataSoAs in another precision are outdated.
+		void initTraversal() {
+			_traversal = ++_lastTraversal;
+		}
+
+		/**
+		 * \brief Add the forces, which the calling thread calculated on copies of CellDataSoAs in another
+		 * precision during this traversal, to the CellDataSoAs.
+		 */
+		virtual void endTraversal() = 0;
+
+		//! \brief Add the forces calculated on the copy of soa in another precision to soa, if not done yet.
+		virtual void finishCell(CellDataSoA& soa) = 0;
+
+	protected:
+		//! \brief Parameter table of the VectorizedCellProcessor, converted to the precision of the kernel.
+		template<typename T>
+		static std::vector<AlignedArray<T> > convertTable(const std::vector<AlignedArray<double> >& table) {
+			std::vector<AlignedArray<T> > converted;
+			converted.reserve(table.size());
+			for (const AlignedArray<double>& row : table) {
+				const size_t n = row.get_size();
+				converted.push_back(AlignedArray<T>(n));
+				for (size_t i = 0; i < n; ++i) {
+					converted.back()[i] = static_cast<T>(row[i]);
+				}
+			}
+			return converted;
+		}
+
+		template<typename T>
+		std::vector<AlignedArray<T> > getEpsSig() const {
+			return convertTable<T>(_vcp._eps_sig);
+		}
+
+		template<typename T>
+		std::vector<AlignedArray<T> > getShift6() const {
+			return convertTable<T>(_vcp._shift6);
+		}
+
+		template<typename T>
+		std::vector<AlignedArray<T> > getLJCRc2() const {
+			return convertTable<T>(_vcp._ljcRc2);
+		}
+
+		template<typename T>
+		std::vector<AlignedArray<T> > getLJFShiftRs2() const {
+			return convertTable<T>(_vcp._ljFShiftRs2);
+		}
+
+		template<typename T>
+		std::vector<AlignedArray<T> > getLJSwitch() const {
+			return convertTable<T>(_vcp._ljSwitch);
+		}
+
+		template<typename T>
+		std::vector<AlignedArray<T> > getLJCQQ() const {
+			return convertTable<T>(_vcp._ljcQQ);
+		}
+
+		const VectorizedCellProcessor& _vcp;
+		const double _epsRFInvrc3;
+		const bool _singleSiteLJ;
+
+		//! \brief Tabulated potentials of the VectorizedCellProcessor (evaluated in double precision).
+		const std::vector<std::vector<int> >& _ljcTab;
+		const std::vector<TabulatedTable>& _tabTables;
+		const std::vector<double>& _tabCoeffs;
+
+		//! \brief Number of the current traversal, unique among all kernels.
+		unsigned long _traversal;
+
+	private:
+		static unsigned long _lastTraversal;
+	};
+
 
 private:
 	/**
@@ -109,13 +304,64 @@ private:
 	 * \details Each DoubleArray contains parameters for one center combined with all centers.<br>
 	 * Each set of parameters is a pair (epsilon*24.0, sigma^2).
 	 */
-	std::vector<AlignedArray<vcp_real_calc> > _eps_sig;
+	std::vector<AlignedArray<double> > _eps_sig;
 	/**
 	 * \brief Shift for pairs of LJcenters.
 	 * \details Each DoubleArray contains the LJ shift*6.0 for one center combined<br>
 	 * with all centers.
 	 */
-	std::vector<AlignedArray<vcp_real_calc> > _shift6;
+	std::vector<AlignedArray<double> > _shift6;
+	/**
+	 * \brief Squared LJ cutoff radius for pairs of LJcenters, if components have their own LJ cutoff radius.
+	 * \details Same layout as _shift6. Empty, if all components use the global LJ cutoff radius.<br>
+	 * The distance lookup uses the global LJ cutoff radius, pairs beyond their own cutoff radius
+	 * are then excluded in the LJ loop.
+	 */
+	std::vector<AlignedArray<double> > _ljcRc2;
+	/**
+	 * \brief Force shift and inner switching radius for pairs of LJcenters (see LJTruncation).
+	 * \details Same layout as _eps_sig, each pair is (dU/dr(rc), rs^2). dU/dr(rc) is 0 except for force-shifted pairs,
+	 * rs^2 is the largest float except for switched pairs. Empty, if all pairs use the truncated LJ potential.<br>
+	 * The shift6 of force-shifted pairs includes 6 rc dU/dr(rc), switched pairs are not shifted.
+	 */
+	std::vector<AlignedArray<double> > _ljFShiftRs2;
+	/**
+	 * \brief Switching function for pairs of LJcenters.
+	 * \details Same layout as _eps_sig, each pair is (rc^2, 1 / (rc^2 - rs^2)^3), rc^2 is the largest float
+	 * except for switched pairs. Empty together with _ljFShiftRs2.
+	 */
+	std::vector<AlignedArray<double> > _ljSwitch;
+	/**
+	 * \brief Product of the charges at the positions of pairs of LJcenters.
+	 * \details Same layout as _shift6. Only set up, if all charges of all components are at the position
+	 * of an LJ center and the cutoff radius equals the LJ cutoff radius, and empty otherwise.<br>
+	 * The kernels then add the charge-charge interactions in the LJ loop, with the positions, distance lookup
+	 * and force stores of the LJ centers, and skip the charge-charge loop.
+	 */
+	std::vector<AlignedArray<double> > _ljcQQ;
+	/**
+	 * \brief Whether all components consist of one LJ center in the center of mass and nothing else,
+	 * except charges at the LJ center (see _ljcQQ).
+	 * \details Then the kernels calculate the forces directly on the LJ centers, without the distance lookups
+	 * of the molecules (except with Verlet lists).
+	 */
+	bool _singleSiteLJ;
+	/**
+	 * \brief Tabulated potential for pairs of LJcenters, see TabulatedPotential.
+	 * \details One row for each LJ center with the index into _tabTables for each center or -1,
+	 * if the pair interacts by LJ 12-6. A row is empty, if the center has no tabulated potential,
+	 * and the whole vector is empty without tabulated potentials.<br>
+	 * The LJ parameters of tabulated pairs are set to zero in _eps_sig and _shift6.
+	 */
+	std::vector<std::vector<int> > _ljcTab;
+	/**
+	 * \brief Grids of the tabulated potentials, the coefficients are stored in _tabCoeffs.
+	 */
+	std::vector<TabulatedTable> _tabTables;
+	/**
+	 * \brief Spline coefficients (a, b, c, d) of all intervals of all tabulated potentials.
+	 */
+	std::vector<double> _tabCoeffs;
 	/**
 	 * \brief Sum of all LJ potentials.
 	 * \details Multiplied by 6.0 for performance reasons.
@@ -137,186 +383,89 @@ private:
 	 */
 	double _myRF;
 
-	struct VLJCPThreadData {
-	public:
-		VLJCPThreadData(): _ljc_dist_lookup(nullptr), _charges_dist_lookup(nullptr), _dipoles_dist_lookup(nullptr), _quadrupoles_dist_lookup(nullptr){
-			_upot6ljV.resize(_numVectorElements);
-			_upotXpolesV.resize(_numVectorElements);
-			_virialV.resize(_numVectorElements);
-			_myRFV.resize(_numVectorElements);
-
-			for (size_t j = 0; j < _numVectorElements; ++j) {
-				_upot6ljV[j] = 0.0;
-				_upotXpolesV[j] = 0.0;
-				_virialV[j] = 0.0;
-				_myRFV[j] = 0.0;
-			}
-		}
-
-		/**
-		 * \brief array, that stores the dist_lookup.
-		 * For all vectorization methods, that utilize masking, this stores masks.
-		 * To utilize the gather operations of the KNL architecture, the dist_lookup is able to store the indices of the required particles.
-		 */
-		AlignedArray<vcp_lookupOrMask_single> _centers_dist_lookup;
-
-		/**
-		 * \brief pointer to the starting point of the dist_lookup of the lennard jones particles.
-		 */
-		vcp_lookupOrMask_single* _ljc_dist_lookup;
+	//! \brief Thermostat sums of the fused integration, as in Leapfrog::transition2to3().
+	struct ThermostatSums {
+		unsigned long N = 0;
+		unsigned long rotDOF = 0;
+		double summv2 = 0.0;
+		double sumIw2 = 0.0;
+	};
 
-		/**
-		 * \brief pointer to the starting point of the dist_lookup of the charge particles.
-		 */
-		vcp_lookupOrMask_single* _charges_dist_lookup;
+	//! \brief Half time step of the fused integration (0: disabled).
+	double _fusedDtHalf;
 
-		/**
-		 * \brief pointer to the starting point of the dist_lookup of the dipole particles.
-		 */
-		vcp_lookupOrMask_single* _dipoles_dist_lookup;
+	//! \brief Thermostat sums of the fused integration per thread and thermostat.
+	std::vector<std::map<int, ThermostatSums> > _threadThermostatSums;
 
-		/**
-		 * \brief pointer to the starting point of the dist_lookup of the quadrupole particles.
-		 */
-		vcp_lookupOrMask_single* _quadrupoles_dist_lookup;
-
-		AlignedArray<vcp_real_accum> _upot6ljV, _upotXpolesV, _virialV, _myRFV;
-	};
+	//! \brief CellDataSoA of the test molecule of processSingleMolecule() per thread.
+	std::vector<std::unique_ptr<CellDataSoA> > _threadTestMoleculeSoAs;
 
-	std::vector<VLJCPThreadData *> _threadData;
+	//! \brief calcFM() and upd_postF() of the fused integration per thread.
+	std::vector<std::unique_ptr<VectorizedMoleculeUpdate> > _threadMoleculeUpdates;
 
-	static const size_t _numVectorElements = VCP_VEC_SIZE;
 	size_t _numThreads;
 
-	template<bool calculateMacroscopic>
-	inline void _loopBodyLJ(
-			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
-			const MaskCalcVec& forceMask,
-			const RealCalcVec& eps_24, const RealCalcVec& sig2,
-			const RealCalcVec& shift6);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyCharge(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& qii,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& qjj,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyChargeDipole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& q,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& e_x, const RealCalcVec& e_y, const RealCalcVec& e_z,
-		const RealCalcVec& p,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyDipole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
-		const RealCalcVec& pii,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
-		const RealCalcVec& pjj,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
-		RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial, RealAccumVec& sum_myRF,
-		const MaskCalcVec& forceMask,
-		const RealCalcVec& epsRFInvrc3);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyChargeQuadrupole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& q,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
-		const RealCalcVec& m,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyDipoleQuadrupole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
-		const RealCalcVec& p,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
-		const RealCalcVec& m,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
-		RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
-
-	template<bool calculateMacroscopic>
-	inline void _loopBodyQuadrupole(
-		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
-		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
-		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
-		const RealCalcVec& mii,
-		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
-		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
-		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
-		const RealCalcVec& mjj,
-		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
-		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
-		RealAccumVec& Mii_x, RealAccumVec& Mii_y, RealAccumVec& Mii_z,
-		RealAccumVec& Mjj_x, RealAccumVec& Mjj_y, RealAccumVec& Mjj_z,
-		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
-		const MaskCalcVec& forceMask);
+	//! \brief The force kernel selected for the CPU.
+	std::unique_ptr<Kernel> _kernel;
+
+	//! \brief Kernel for the instruction set of the build (VectorizedCellProcessorKernel.cpp).
+	static Kernel* createKernel(const VectorizedCellProcessor& vcp);
+	//! \brief Kernel for the instruction set of the build in the given precision.
+	static Kernel* createKernel(const VectorizedCellProcessor& vcp, int precision);
+#ifdef VCP_DISPATCH_AVX2
+	//! \brief Kernel for AVX2 and FMA (VectorizedCellProcessorKernelAVX2.cpp).
+	static Kernel* createKernelAVX2(const VectorizedCellProcessor& vcp);
+	//! \brief Kernel for AVX2 and FMA in the given precision.
+	static Kernel* createKernelAVX2(const VectorizedCellProcessor& vcp, int precision);
+#endif
+#ifdef VCP_DISPATCH_AVX512F
+	//! \brief Kernel for AVX-512 (VectorizedCellProcessorKernelAVX512F.cpp).
+	static Kernel* createKernelAVX512F(const VectorizedCellProcessor& vcp);
+	//! \brief Kernel for AVX-512 in the given precision.
+	static Kernel* createKernelAVX512F(const VectorizedCellProcessor& vcp, int precision);
+#endif
+#if VCP_PREC != VCP_SPSP
+	//! \brief Kernel in single precision (VectorizedCellProcessorKernelSPSP.cpp).
+	static Kernel* createKernelSPSP(const VectorizedCellProcessor& vcp);
+#endif
+#if defined(VCP_DISPATCH_AVX2) and VCP_PREC != VCP_SPSP
+	//! \brief Kernel for AVX2 and FMA in single precision (VectorizedCellProcessorKernelAVX2SPSP.cpp).
+	static Kernel* createKernelAVX2SPSP(const VectorizedCellProcessor& vcp);
+#endif
+#if defined(VCP_DISPATCH_AVX512F) and VCP_PREC != VCP_SPSP
+	//! \brief Kernel for AVX-512 in single precision (VectorizedCellProcessorKernelAVX512FSPSP.cpp).
+	static Kernel* createKernelAVX512FSPSP(const VectorizedCellProcessor& vcp);
+#endif
+#if VCP_PREC != VCP_SPDP
+	//! \brief Kernel in mixed precision (VectorizedCellProcessorKernelSPDP.cpp).
+	static Kernel* createKernelSPDP(const VectorizedCellProcessor& vcp);
+#endif
+#if defined(VCP_DISPATCH_AVX2) and VCP_PREC != VCP_SPDP
+	//! \brief Kernel for AVX2 and FMA in mixed precision (VectorizedCellProcessorKernelAVX2SPDP.cpp).
+	static Kernel* createKernelAVX2SPDP(const VectorizedCellProcessor& vcp);
+#endif
+#if defined(VCP_DISPATCH_AVX512F) and VCP_PREC != VCP_SPDP
+	//! \brief Kernel for AVX-512 in mixed precision (VectorizedCellProcessorKernelAVX512FSPDP.cpp).
+	static Kernel* createKernelAVX512FSPDP(const VectorizedCellProcessor& vcp);
+#endif
+#if VCP_PREC != VCP_DPDP
+	//! \brief Kernel in double precision (VectorizedCellProcessorKernelDPDP.cpp).
+	static Kernel* createKernelDPDP(const VectorizedCellProcessor& vcp);
+#endif
+#if defined(VCP_DISPATCH_AVX2) and VCP_PREC != VCP_DPDP
+	//! \brief Kernel for AVX2 and FMA in double precision (VectorizedCellProcessorKernelAVX2DPDP.cpp).
+	static Kernel* createKernelAVX2DPDP(const VectorizedCellProcessor& vcp);
+#endif
+#if defined(VCP_DISPATCH_AVX512F) and VCP_PREC != VCP_DPDP
+	//! \brief Kernel for AVX-512 in double precision (VectorizedCellProcessorKernelAVX512FDPDP.cpp).
+	static Kernel* createKernelAVX512FDPDP(const VectorizedCellProcessor& vcp);
+#endif
 
 	/**
-	 * \brief Force calculation with abstraction of cell pairs.
-	 * \details The differences between single cell and cell pair calculation<br>
-	 * have been moved into two policy class templates.<br>
-	 * <br>
-	 * The ForcePolicy class must provide the following methods:<br>
-	 * <br>
-	 * static size_t InitJ(size_t i);<br>
-	 * Returns the value which j is to be initialized as in the inner loop<br>
-	 * depending on the vectorization method.<br>
-	 * <br>
-	 * If the code is to be vectorized:<br>
-	 * static DoubleVec GetForceMask(DoubleVec m_r2, DoubleVec rc2);<br>
-	 * Returns the mask indicating which pairs to calculate in the vectorized code.<br>
-	 * <br>
-	 * The boolean CalculateMacroscopic should specify, whether macroscopic values are to be calculated or not.
-	 * <br>
-	 * The class MaskGatherChooser is a class, that specifies the used loading,storing and masking routines.
+	 * \brief Get the Verlet list for the interaction of the molecules of cell1 with the centers of cell2.
+	 * \return nullptr, if the cells do not use Verlet lists.
 	 */
-	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
-	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2);
+	CellVerletLists::PairList * getVerletPairList(FullParticleCell & cell1, FullParticleCell & cell2);
 
 }; /* end of class VectorizedCellProcessor */
 
@@ -0,0 +1,11 @@
+/**
+ * \file
+ * \brief VectorizedCellProcessorKernel.cpp
+ * \details Force kernel for the instruction set of the build.
+ */
+
+#include "VectorizedCellProcessorKernel.h"
+
+VectorizedCellProcessor::Kernel* VectorizedCellProcessor::createKernel(const VectorizedCellProcessor& vcp) {
+	return new vcp::VectorizedCellProcessorKernel(vcp);
+}
@@ -0,0 +1,3904 @@
+/**
+ * \file
+ * \brief VectorizedCellProcessorKernel.h
+ * \details Force calculation of the VectorizedCellProcessor for one instruction set.
+ * Every translation unit, which includes this file, compiles the kernel for the instruction set
+ * given by SIMD_TYPES.h (VectorizedCellProcessorKernel.cpp) or by VCP_DISPATCH_VEC_TYPE
+ * (VectorizedCellProcessorKernelAVX2.cpp, VectorizedCellProcessorKernelAVX512F.cpp) and for the
+ * precision of the build or the one given by VCP_DISPATCH_PREC (VectorizedCellProcessorKernelSPSP.cpp etc.,
+ * VectorizedCellProcessorKernelAVX2SPSP.cpp etc. for both).
+ * The vector classes and the kernel are put into VCP_NAMESPACE to keep these kernels apart.
+ */
+
+#ifndef VECTORIZEDCELLPROCESSORKERNEL_H_
+#define VECTORIZEDCELLPROCESSORKERNEL_H_
+
+#include "VectorizedCellProcessor.h"
+#include "CellDataSoA.h"
+#include "vectorization/SIMD_TYPES.h"
+#include "vectorization/SIMD_VectorizedCellProcessorHelpers.h"
+#include "vectorization/MaskGatherChooser.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+
+namespace VCP_NAMESPACE {
+
+//! \brief CellDataSoA in the precision of the kernel, ::CellDataSoA is the one of the build.
+typedef CellDataSoAT<vcp_real_calc, vcp_real_accum> CellDataSoA;
+
+/**
+ * \brief Vectorized calculation of the force.
+ * \author Johannes Heckl
+ */
+class VectorizedCellProcessorKernel : public VectorizedCellProcessor::Kernel {
+public:
+	explicit VectorizedCellProcessorKernel(const VectorizedCellProcessor& vcp);
+
+	~VectorizedCellProcessorKernel();
+
+	const char* getInstructionSet() const override;
+
+	int getPrecision() const override {
+		return VCP_PREC;
+	}
+
+	size_t getVectorLength() const override {
+		return VCP_VEC_SIZE;
+	}
+
+	bool usesVerletLists() const override {
+#if VCP_VEC_TYPE != VCP_VEC_KNL_GATHER and VCP_VEC_TYPE != VCP_VEC_AVX512F_GATHER
+		return not _singleSiteLJ;
+#else
+		return true;
+#endif
+	}
+
+	void calculatePairs(::CellDataSoA& soa1, ::CellDataSoA& soa2, CellVerletLists::PairList* verletList,
+			bool singleCell, bool calculateMacroscopic) override;
+
+	double calculateEnergy(::CellDataSoA& soa1, const std::vector< ::CellDataSoA*>& soa2s) override;
+
+	void reduceMacroscopic(::vcp_real_accum& upot6lj, ::vcp_real_accum& upotXpoles,
+			::vcp_real_accum& virial, ::vcp_real_accum& myRF) override;
+
+	void endTraversal() override;
+
+	void finishCell(::CellDataSoA& soa) override;
+
+private:
+	//! \brief The CellDataSoA in the precision of the kernel: soa itself, if the precisions agree.
+	CellDataSoA& kernelSoA(CellDataSoA& soa) {
+		return soa;
+	}
+
+	//! \brief The CellDataSoA in the precision of the kernel: the copy of soa, made at the first call in a traversal.
+	template<class SoA>
+	CellDataSoA& kernelSoA(SoA& soa);
+
+	//! \brief The CellDataSoA in the precision of the kernel for calculateEnergy(): soa itself, if the precisions agree.
+	CellDataSoA& energySoA(CellDataSoA& soa, CellDataSoA& /*copy*/) {
+		return soa;
+	}
+
+	//! \brief The CellDataSoA in the precision of the kernel for calculateEnergy(): soa copied to copy.
+	template<class SoA>
+	CellDataSoA& energySoA(SoA& soa, CellDataSoA& copy) {
+		copy.copyCalcFrom(soa);
+		return copy;
+	}
+
+	//! \brief Parameter tables of the VectorizedCellProcessor in the precision of the kernel.
+	const std::vector<AlignedArray<vcp_real_calc> > _eps_sig;
+	const std::vector<AlignedArray<vcp_real_calc> > _shift6;
+	const std::vector<AlignedArray<vcp_real_calc> > _ljcRc2;
+	const std::vector<AlignedArray<vcp_real_calc> > _ljFShiftRs2;
+	const std::vector<AlignedArray<vcp_real_calc> > _ljSwitch;
+	const std::vector<AlignedArray<vcp_real_calc> > _ljcQQ;
+
+	struct VLJCPThreadData {
+	public:
+		VLJCPThreadData(): _ljc_dist_lookup(nullptr), _charges_dist_lookup(nullptr), _dipoles_dist_lookup(nullptr), _quadrupoles_dist_lookup(nullptr),
+				_energySoA1(0, 0, 0, 0, 0), _energySoA2(0, 0, 0, 0, 0), _energyAccum(0, 0, 0, 0, 0) {
+			_upot6ljV.resize(_numVectorElements);
+			_upotXpolesV.resize(_numVectorElements);
+			_virialV.resize(_numVectorElements);
+			_myRFV.resize(_numVectorElements);
+
+			for (size_t j = 0; j < _numVectorElements; ++j) {
+				_upot6ljV[j] = 0.0;
+				_upotXpolesV[j] = 0.0;
+				_virialV[j] = 0.0;
+				_myRFV[j] = 0.0;
+			}
+		}
+
+		/**
+		 * \brief array, that stores the dist_lookup.
+		 * For all vectorization methods, that utilize masking, this stores masks.
+		 * To utilize the gather operations of the KNL architecture, the dist_lookup is able to store the indices of the required particles.
+		 */
+		AlignedArray<vcp_lookupOrMask_single> _centers_dist_lookup;
+
+		/**
+		 * \brief pointer to the starting point of the dist_lookup of the lennard jones particles.
+		 */
+		vcp_lookupOrMask_single* _ljc_dist_lookup;
+
+		/**
+		 * \brief pointer to the starting point of the dist_lookup of the charge particles.
+		 */
+		vcp_lookupOrMask_single* _charges_dist_lookup;
+
+		/**
+		 * \brief pointer to the starting point of the dist_lookup of the dipole particles.
+		 */
+		vcp_lookupOrMask_single* _dipoles_dist_lookup;
+
+		/**
+		 * \brief pointer to the starting point of the dist_lookup of the quadrupole particles.
+		 */
+		vcp_lookupOrMask_single* _quadrupoles_dist_lookup;
+
+		AlignedArray<vcp_real_accum> _upot6ljV, _upotXpolesV, _virialV, _myRFV;
+
+#if VCP_VEC_TYPE == VCP_VEC_KNL or VCP_VEC_TYPE == VCP_VEC_AVX512F
+		/**
+		 * \brief LJ centers of soa2 within the cutoff radius of the current center of soa1, stored contiguously,
+		 * and the forces and virials on them (see _calculatePairs1CLJPacked).
+		 */
+		AlignedArray<vcp_real_calc> _packed_r_x, _packed_r_y, _packed_r_z;
+		AlignedArray<vcp_ljc_id_t> _packed_id;
+		AlignedArray<vcp_real_accum> _packed_f_x, _packed_f_y, _packed_f_z, _packed_V_x, _packed_V_y, _packed_V_z;
+
+		/**
+		 * \brief masks of the vectors of soa2, from which the centers were packed.
+		 */
+		AlignedArray<vcp_mask_single> _packed_masks;
+#endif
+
+		/**
+		 * \brief Copies of the CellDataSoAs in the precision of the kernel for calculateEnergy() (see energySoA())
+		 * and the forces, torques and virials, which are swapped into the second one meanwhile.
+		 */
+		CellDataSoA _energySoA1, _energySoA2, _energyAccum;
+
+		/**
+		 * \brief CellDataSoAs, which were copied by this thread in the current traversal (see kernelSoA()).
+		 */
+		std::vector< ::CellDataSoA*> _convertedSoAs;
+	};
+
+	std::vector<VLJCPThreadData *> _threadData;
+
+	static const size_t _numVectorElements = VCP_VEC_SIZE;
+
+	/**
+	 * \brief LJ interaction of the LJ center at r1 with the LJ centers at r2.
+	 * \details smoothLJ selects the variant with the force-shifted and switched potentials (see LJTruncation),
+	 * whose parameters fshift, rs2, rc2 and invD are unpacked from _ljFShiftRs2 and _ljSwitch. They are
+	 * ignored by the truncated variant.
+	 */
+	template<bool calculateMacroscopic, bool smoothLJ>
+	inline void _loopBodyLJ(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const RealCalcVec& eps_24, const RealCalcVec& sig2,
+			const RealCalcVec& shift6,
+			const RealCalcVec& fshift, const RealCalcVec& rs2,
+			const RealCalcVec& rc2, const RealCalcVec& invD);
+
+	/**
+	 * \brief Unpack the parameters of the LJ interaction of center id_i with the centers at j (see _loopBodyLJ()).
+	 * \details Without force-shifted and switched potentials, fshift, rs2, rc2 and invD are left untouched.
+	 */
+	template<class MaskGatherChooser>
+	inline void _unpackLJ(RealCalcVec& eps_24, RealCalcVec& sig2, RealCalcVec& shift6,
+			RealCalcVec& fshift, RealCalcVec& rs2, RealCalcVec& rc2, RealCalcVec& invD,
+			vcp_ljc_id_t id_i, const vcp_ljc_id_t* soa2_ljc_id, size_t j, const vcp_lookupOrMask_vec& lookupORforceMask);
+
+	/**
+	 * \brief Add the tabulated potentials of the pairs of the LJ center at r1 with the LJ centers at r2,
+	 * whose table ids are given by tabRow and id_j (see VectorizedCellProcessor::_ljcTab), to the result of _loopBodyLJ.
+	 * \details The coefficients of the intervals are gathered lane by lane, the spline is evaluated in vectors.
+	 */
+	template<bool calculateMacroscopic>
+	inline void _loopBodyTabulated(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const std::vector<int>& tabRow, const vcp_ljc_id_t* id_j);
+
+	/**
+	 * \brief Add the charge-charge interaction of the charges at the LJ center at r1 and the LJ centers at r2
+	 * to the result of _loopBodyLJ.
+	 * \details qq is the product of the charges, unpacked from _ljcQQ. The potential energy is summed up in
+	 * sum_upotXpoles like the one of _loopBodyCharge.
+	 */
+	template<bool calculateMacroscopic>
+	inline void _loopBodyLJCharge(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const RealCalcVec& qq);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyCharge(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& qii,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& qjj,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyChargeDipole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& q,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& e_x, const RealCalcVec& e_y, const RealCalcVec& e_z,
+		const RealCalcVec& p,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyDipole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+		const RealCalcVec& pii,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+		const RealCalcVec& pjj,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
+		RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial, RealAccumVec& sum_myRF,
+		const MaskCalcVec& forceMask,
+		const RealCalcVec& epsRFInvrc3);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyChargeQuadrupole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& q,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+		const RealCalcVec& m,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyDipoleQuadrupole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+		const RealCalcVec& p,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+		const RealCalcVec& m,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
+		RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	template<bool calculateMacroscopic>
+	inline void _loopBodyQuadrupole(
+		const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+		const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+		const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+		const RealCalcVec& mii,
+		const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+		const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+		const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+		const RealCalcVec& mjj,
+		RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+		RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+		RealAccumVec& Mii_x, RealAccumVec& Mii_y, RealAccumVec& Mii_z,
+		RealAccumVec& Mjj_x, RealAccumVec& Mjj_y, RealAccumVec& Mjj_z,
+		RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+		const MaskCalcVec& forceMask);
+
+	/**
+	 * \brief Calculate the forces with _calculatePairs1CLJPacked, _calculatePairs1CLJ or _calculatePairs,
+	 * whichever suits the components, the instruction set and the Verlet lists.
+	 */
+	template<class ForcePolicy, bool CalculateMacroscopic>
+	void _calculatePairsSelect(CellDataSoA& soa1, CellDataSoA& soa2, CellVerletLists::PairList* verletList);
+
+	/**
+	 * \brief Force calculation with abstraction of cell pairs.
+	 * \details The differences between single cell and cell pair calculation<br>
+	 * have been moved into two policy class templates.<br>
+	 * <br>
+	 * The ForcePolicy class must provide the following methods:<br>
+	 * <br>
+	 * static size_t InitJ(size_t i);<br>
+	 * Returns the value which j is to be initialized as in the inner loop<br>
+	 * depending on the vectorization method.<br>
+	 * <br>
+	 * If the code is to be vectorized:<br>
+	 * static DoubleVec GetForceMask(DoubleVec m_r2, DoubleVec rc2);<br>
+	 * Returns the mask indicating which pairs to calculate in the vectorized code.<br>
+	 * <br>
+	 * The boolean CalculateMacroscopic should specify, whether macroscopic values are to be calculated or not.
+	 * <br>
+	 * The class MaskGatherChooser is a class, that specifies the used loading,storing and masking routines.
+	 * <br>
+	 * If verletList is given, only the blocks of centers listed in it are checked against the cutoff radius
+	 * (or the list is rebuilt, if it became invalid).
+	 */
+	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
+	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, CellVerletLists::PairList * verletList);
+
+	/**
+	 * \brief Force calculation, if all components are single LJ centers in their center of mass.
+	 * \details Works directly on the LJ centers like VCP1CLJRMM: the distance of the centers is the distance
+	 * of the molecules, so neither the distance lookups of the molecules nor the per molecule loops over
+	 * the sites are needed. The virial of a pair is the one of its LJ centers.<br>
+	 * Charges at the LJ centers are included by _loopBodyLJCharge (see VectorizedCellProcessor::_ljcQQ).
+	 */
+	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
+	void _calculatePairs1CLJ(CellDataSoA & soa1, CellDataSoA & soa2);
+
+#if VCP_VEC_TYPE == VCP_VEC_KNL or VCP_VEC_TYPE == VCP_VEC_AVX512F
+	/**
+	 * \brief Like _calculatePairs1CLJ, but the potential is only evaluated for packed vectors of pairs.
+	 * \details For each center of soa1, the centers of soa2 within the cutoff radius are first compressed
+	 * (vcompress) into the buffers of the thread, so that the potential is evaluated on full vectors, also
+	 * if only few lanes of a vector of soa2 are within the cutoff radius (e.g. in the corners of the cell
+	 * pairs). Afterwards the forces and virials are expanded (vexpand) back to the lanes of soa2.
+	 */
+	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
+	void _calculatePairs1CLJPacked(CellDataSoA & soa1, CellDataSoA & soa2);
+#endif
+
+}; /* end of class VectorizedCellProcessorKernel */
+
+VectorizedCellProcessorKernel::VectorizedCellProcessorKernel(const VectorizedCellProcessor& vcp) :
+		Kernel(vcp), _eps_sig(getEpsSig<vcp_real_calc>()), _shift6(getShift6<vcp_real_calc>()), _ljcRc2(getLJCRc2<vcp_real_calc>()),
+		_ljFShiftRs2(getLJFShiftRs2<vcp_real_calc>()), _ljSwitch(getLJSwitch<vcp_real_calc>()), _ljcQQ(getLJCQQ<vcp_real_calc>()) {
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	// the tabulated potentials are looked up by the j indices of the lanes
+	if (not _ljcTab.empty()) {
+		Log::global_log->error() << "VectorizedCellProcessor: tabulated potentials are not supported by the gather kernels." << std::endl;
+		mardyn_exit(1);
+	}
+#endif
+	// initialize thread data
+	_threadData.resize(mardyn_get_max_threads());
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		VLJCPThreadData * myown = new VLJCPThreadData();
+		const int myid = mardyn_get_thread_num();
+		_threadData[myid] = myown;
+	} // end pragma omp parallel
+}
+
+VectorizedCellProcessorKernel::~VectorizedCellProcessorKernel() {
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		const int myid = mardyn_get_thread_num();
+		delete _threadData[myid];
+	}
+}
+
+const char* VectorizedCellProcessorKernel::getInstructionSet() const {
+#if VCP_VEC_TYPE==VCP_NOVEC
+	return "no";
+#elif VCP_VEC_TYPE==VCP_VEC_SSE3
+	return "SSE3";
+#elif VCP_VEC_TYPE==VCP_VEC_AVX
+	return "AVX";
+#elif VCP_VEC_TYPE==VCP_VEC_AVX2
+	return "AVX2";
+#elif (VCP_VEC_TYPE==VCP_VEC_KNL) || (VCP_VEC_TYPE==VCP_VEC_KNL_GATHER)
+	return "KNL";
+#elif (VCP_VEC_TYPE==VCP_VEC_AVX512F) || (VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER)
+	return "SKX";
+#endif
+}
+
+void VectorizedCellProcessorKernel::calculatePairs(::CellDataSoA& soa1_arg, ::CellDataSoA& soa2_arg,
+		CellVerletLists::PairList* verletList, bool singleCell, bool calculateMacroscopic) {
+	CellDataSoA& soa1 = kernelSoA(soa1_arg);
+	CellDataSoA& soa2 = kernelSoA(soa2_arg);
+	const bool ApplyCutoff = true;
+	if (singleCell) {
+		mardyn_assert(calculateMacroscopic);
+		_calculatePairsSelect<SingleCellPolicy_<ApplyCutoff>, true>(soa1, soa2, verletList);
+	} else if (calculateMacroscopic) {
+		_calculatePairsSelect<CellPairPolicy_<ApplyCutoff>, true>(soa1, soa2, verletList);
+	} else {
+		_calculatePairsSelect<CellPairPolicy_<ApplyCutoff>, false>(soa1, soa2, verletList);
+	}
+}
+
+double VectorizedCellProcessorKernel::calculateEnergy(::CellDataSoA& soa1_arg, const std::vector< ::CellDataSoA*>& soa2s) {
+	VLJCPThreadData& my_threadData = *_threadData[mardyn_get_thread_num()];
+	CellDataSoA& soa1 = energySoA(soa1_arg, my_threadData._energySoA1);
+
+	// put the macroscopic values of the current traversal aside
+	vcp_real_accum traversalSums[4] = {0.0, 0.0, 0.0, 0.0};
+	load_hSum_Store_Clear(&traversalSums[0], my_threadData._upot6ljV);
+	load_hSum_Store_Clear(&traversalSums[1], my_threadData._upotXpolesV);
+	load_hSum_Store_Clear(&traversalSums[2], my_threadData._virialV);
+	load_hSum_Store_Clear(&traversalSums[3], my_threadData._myRFV);
+
+	for (::CellDataSoA* soa2_arg : soa2s) {
+		CellDataSoA& soa2 = energySoA(*soa2_arg, my_threadData._energySoA2);
+		// the forces on soa2 go to the thread, those on soa1 are not needed either
+		soa2.swapAccum(my_threadData._energyAccum);
+		_calculatePairsSelect<SingleMoleculePolicy_<true>, true>(soa1, soa2, nullptr);
+		soa2.swapAccum(my_threadData._energyAccum);
+	}
+
+	vcp_real_accum sums[4] = {0.0, 0.0, 0.0, 0.0};
+	load_hSum_Store_Clear(&sums[0], my_threadData._upot6ljV);
+	load_hSum_Store_Clear(&sums[1], my_threadData._upotXpolesV);
+	load_hSum_Store_Clear(&sums[2], my_threadData._virialV);
+	load_hSum_Store_Clear(&sums[3], my_threadData._myRFV);
+	my_threadData._upot6ljV[0] = traversalSums[0];
+	my_threadData._upotXpolesV[0] = traversalSums[1];
+	my_threadData._virialV[0] = traversalSums[2];
+	my_threadData._myRFV[0] = traversalSums[3];
+
+	return sums[0] / 6.0 + sums[1] + sums[3];
+}
+
+template<class ForcePolicy, bool CalculateMacroscopic>
+void VectorizedCellProcessorKernel::_calculatePairsSelect(CellDataSoA& soa1, CellDataSoA& soa2, CellVerletLists::PairList* verletList) {
+#if VCP_VEC_TYPE != VCP_VEC_KNL_GATHER and VCP_VEC_TYPE != VCP_VEC_AVX512F_GATHER
+	// the Verlet lists are made of the distance lookups, which the single-site path does not use
+	if (_singleSiteLJ and verletList == nullptr) {
+#if VCP_VEC_TYPE == VCP_VEC_KNL or VCP_VEC_TYPE == VCP_VEC_AVX512F
+		// packing pays off for the tabulated potentials, which are gathered lane by lane,
+		// but not for the LJ potential, which costs less than the packing
+		if (not _ljcTab.empty()) {
+			_calculatePairs1CLJPacked<ForcePolicy, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+			return;
+		}
+#endif
+		_calculatePairs1CLJ<ForcePolicy, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+		return;
+	}
+#endif
+	_calculatePairs<ForcePolicy, CalculateMacroscopic, MaskGatherC>(soa1, soa2, verletList);
+}
+
+void VectorizedCellProcessorKernel::reduceMacroscopic(::vcp_real_accum& upot6lj, ::vcp_real_accum& upotXpoles,
+		::vcp_real_accum& virial, ::vcp_real_accum& myRF) {
+	VLJCPThreadData& my_threadData = *_threadData[mardyn_get_thread_num()];
+
+	// reduce vectors and clear local variable
+	vcp_real_accum sums[4] = {0.0, 0.0, 0.0, 0.0};
+	load_hSum_Store_Clear(&sums[0], my_threadData._upot6ljV);
+	load_hSum_Store_Clear(&sums[1], my_threadData._upotXpolesV);
+	load_hSum_Store_Clear(&sums[2], my_threadData._virialV);
+	load_hSum_Store_Clear(&sums[3], my_threadData._myRFV);
+	upot6lj += sums[0];
+	upotXpoles += sums[1];
+	virial += sums[2];
+	myRF += sums[3];
+}
+
+void VectorizedCellProcessorKernel::endTraversal() {
+	std::vector< ::CellDataSoA*>& convertedSoAs = _threadData[mardyn_get_thread_num()]->_convertedSoAs;
+	for (::CellDataSoA* soa : convertedSoAs) {
+		finishCell(*soa);
+	}
+	convertedSoAs.clear();
+}
+
+void VectorizedCellProcessorKernel::finishCell(::CellDataSoA& soa) {
+	const CellDataSoA* converted = soa._conversion.takePending<CellDataSoA>();
+	if (converted != nullptr) {
+		converted->addAccumTo(soa);
+	}
+}
+
+template<class SoA>
+CellDataSoA& VectorizedCellProcessorKernel::kernelSoA(SoA& soa) {
+	bool outdated = false;
+	CellDataSoA& converted = soa._conversion.template get<CellDataSoA>(_traversal, outdated);
+	if (outdated) {
+		converted.copyCalcFrom(soa);
+		_threadData[mardyn_get_thread_num()]->_convertedSoAs.push_back(&soa);
+	}
+	return converted;
+}
+
+	template<class MaskGatherChooser>
+	vcp_inline void VectorizedCellProcessorKernel::_unpackLJ(RealCalcVec& eps_24, RealCalcVec& sig2, RealCalcVec& shift6,
+			RealCalcVec& fshift, RealCalcVec& rs2, RealCalcVec& rc2, RealCalcVec& invD,
+			vcp_ljc_id_t id_i, const vcp_ljc_id_t* soa2_ljc_id, size_t j, const vcp_lookupOrMask_vec& lookupORforceMask)
+	{
+		unpackEps24Sig2<MaskGatherChooser>(eps_24, sig2, _eps_sig[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+		unpackShift6<MaskGatherChooser>(shift6, _shift6[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+		if (not _ljFShiftRs2.empty()) {
+			unpackEps24Sig2<MaskGatherChooser>(fshift, rs2, _ljFShiftRs2[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+			unpackEps24Sig2<MaskGatherChooser>(rc2, invD, _ljSwitch[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+		}
+	}
+
+	template<bool calculateMacroscopic, bool smoothLJ>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyLJ(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const RealCalcVec& eps_24, const RealCalcVec& sig2,
+			const RealCalcVec& shift6,
+			const RealCalcVec& fshift, const RealCalcVec& rs2,
+			const RealCalcVec& rc2, const RealCalcVec& invD)
+	{
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec r2_inv = RealCalcVec::fastReciprocal_mask(c_r2, forceMask);
+
+		const RealCalcVec lj2 = sig2 * r2_inv;//1FP (scale)
+		const RealCalcVec lj4 = lj2 * lj2;//1FP (scale)
+		const RealCalcVec lj6 = lj4 * lj2;//1FP (scale)
+		const RealCalcVec lj12 = lj6 * lj6;//1FP (scale)
+		const RealCalcVec lj12m6 = lj12 - lj6;//1FP (scale)
+
+		const RealCalcVec eps24r2inv = eps_24 * r2_inv;//1FP (scale)
+		const RealCalcVec lj12lj12m6 = lj12 + lj12m6;//1FP (scale)
+		RealCalcVec scale = eps24r2inv * lj12lj12m6;//1FP (scale)
+
+		// force-shifted and switched pairs
+		RealCalcVec switchS, r_inv;
+		if (smoothLJ) {
+			// switching function S and -2 U dS/d(r^2) between rs and rc, S = 0 beyond rc
+			const MaskCalcVec inside = c_r2 < rc2;
+			const MaskCalcVec inSwitch = (rs2 < c_r2) and inside;
+			const RealCalcVec rc2_r2 = rc2 - c_r2;
+			const RealCalcVec rs2_r2 = rs2 - c_r2;
+			const RealCalcVec one = RealCalcVec::set1(1.0);
+			const RealCalcVec sPoly = rc2_r2 * rc2_r2 * RealCalcVec::fnmadd(RealCalcVec::set1(3.0), rs2_r2, rc2_r2) * invD;
+			switchS = RealCalcVec::apply_mask(one - RealCalcVec::apply_mask(one - sPoly, inSwitch), inside);
+			const RealCalcVec dSterm = RealCalcVec::apply_mask(RealCalcVec::set1(2.0) * eps_24 * lj12m6 * rc2_r2 * rs2_r2 * invD, inSwitch);
+
+			// constant force dU/dr(rc) of force-shifted pairs
+			r_inv = RealCalcVec::fastReciprocSqrt_mask(c_r2, forceMask);
+			scale = RealCalcVec::fmadd(fshift, r_inv, switchS * scale - dSterm);
+		}
+
+		f_x = c_dx * scale;//1FP (apply scale)
+		f_y = c_dy * scale;//1FP (apply scale)
+		f_z = c_dz * scale;//1FP (apply scale)
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;//1FP (virial) (does not count)
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;//1FP (virial) (does not count)
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;//1FP (virial) (does not count)
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);//1FP (virial)
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);//1FP (virial)
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);//1FP (virial)
+
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+
+			RealCalcVec upot_sh = RealCalcVec::fmadd(eps_24, lj12m6, shift6); //2 FP upot				//shift6 is not masked -> we have to mask upot_shifted
+			if (smoothLJ) {
+				// S U - r dU/dr(rc) (the constant part of the force shift is in shift6)
+				const RealCalcVec r = c_r2 * r_inv;
+				upot_sh = RealCalcVec::fmadd(switchS, eps_24 * lj12m6, shift6) - RealCalcVec::set1(6.0) * fshift * r;
+			}
+			const RealCalcVec upot_masked = RealCalcVec::apply_mask(upot_sh, forceMask); //mask it
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot_masked);
+
+			sum_upot6lj = sum_upot6lj + upot_accum;//1FP (sum macro)
+
+			sum_virial = sum_virial + V_x + V_y + V_z;//1 FP (sum macro) + 2 FP (virial)
+		}
+	}
+
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyTabulated(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upot6lj, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const std::vector<int>& tabRow, const vcp_ljc_id_t* id_j)
+	{
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		// interval and coefficients of every lane, lanes without table or beyond the cutoff stay zero
+		alignas(64) vcp_real_calc r2[VCP_VEC_SIZE];
+		alignas(64) vcp_real_calc a[VCP_VEC_SIZE], b[VCP_VEC_SIZE], c[VCP_VEC_SIZE], d[VCP_VEC_SIZE];
+		alignas(64) vcp_real_calc t[VCP_VEC_SIZE], m2invDr2[VCP_VEC_SIZE];
+		c_r2.aligned_store(r2);
+		for (size_t k = 0; k < VCP_VEC_SIZE; ++k) {
+			a[k] = b[k] = c[k] = d[k] = t[k] = m2invDr2[k] = 0.;
+			const size_t id = id_j[k];
+			const int tab = id < tabRow.size() ? tabRow[id] : -1;
+			if (tab < 0) {
+				continue;
+			}
+			const VectorizedCellProcessor::TabulatedTable& table = _tabTables[tab];
+			const double x = (r2[k] - table.r2min) * table.invDr2;
+			if (x >= table.intervals) {
+				continue;
+			}
+			// linear continuation below the first node
+			const size_t interval = x < 0. ? 0 : static_cast<size_t>(x);
+			const double* coeffs = &_tabCoeffs[table.offset + 4 * interval];
+			a[k] = coeffs[0];
+			b[k] = coeffs[1];
+			if (x >= 0.) {
+				c[k] = coeffs[2];
+				d[k] = coeffs[3];
+			}
+			t[k] = x - interval;
+			m2invDr2[k] = -2. * table.invDr2;
+		}
+		const RealCalcVec t_v = RealCalcVec::aligned_load(t);
+		const RealCalcVec a_v = RealCalcVec::aligned_load(a);
+		const RealCalcVec b_v = RealCalcVec::aligned_load(b);
+		const RealCalcVec c_v = RealCalcVec::aligned_load(c);
+		const RealCalcVec d_v = RealCalcVec::aligned_load(d);
+
+		// scale = -2 dU/d(r^2), dU/dt = b + t (2 c + 3 t d)
+		const RealCalcVec three_t = RealCalcVec::set1(3.) * t_v;
+		const RealCalcVec dUdt = RealCalcVec::fmadd(t_v, RealCalcVec::fmadd(three_t, d_v, c_v + c_v), b_v);
+		const RealCalcVec scale = RealCalcVec::apply_mask(dUdt * RealCalcVec::aligned_load(m2invDr2), forceMask);
+
+		const RealCalcVec tab_fx = c_dx * scale;
+		const RealCalcVec tab_fy = c_dy * scale;
+		const RealCalcVec tab_fz = c_dz * scale;
+		f_x = f_x + tab_fx;
+		f_y = f_y + tab_fy;
+		f_z = f_z + tab_fz;
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+		const RealAccumVec tab_Vx = RealAccumVec::convertCalcToAccum(m_dx * tab_fx);
+		const RealAccumVec tab_Vy = RealAccumVec::convertCalcToAccum(m_dy * tab_fy);
+		const RealAccumVec tab_Vz = RealAccumVec::convertCalcToAccum(m_dz * tab_fz);
+		V_x = V_x + tab_Vx;
+		V_y = V_y + tab_Vy;
+		V_z = V_z + tab_Vz;
+
+		if (calculateMacroscopic) {
+			// U = a + t (b + t (c + t d)), summed up multiplied by 6 like the LJ potential
+			const RealCalcVec upot = RealCalcVec::fmadd(t_v, RealCalcVec::fmadd(t_v, RealCalcVec::fmadd(t_v, d_v, c_v), b_v), a_v);
+			const RealCalcVec upot6_masked = RealCalcVec::apply_mask(RealCalcVec::set1(6.) * upot, forceMask);
+			sum_upot6lj = sum_upot6lj + RealAccumVec::convertCalcToAccum(upot6_masked);
+
+			sum_virial = sum_virial + tab_Vx + tab_Vy + tab_Vz;
+		}
+	}
+
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyLJCharge(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask,
+			const RealCalcVec& qq)
+	{
+		// the same distance as in _loopBodyLJ, the compiler evaluates it once
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec c_dr2_inv = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);//masked
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+		const RealCalcVec c_dr_inv = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);//masked
+#else
+		const RealCalcVec c_dr_inv = RealCalcVec::sqrt(c_dr2_inv);//masked
+#endif
+
+		const RealCalcVec upot = qq * c_dr_inv;//masked
+		const RealCalcVec fac = upot * c_dr2_inv;//masked
+
+		const RealCalcVec q_fx = c_dx * fac;
+		const RealCalcVec q_fy = c_dy * fac;
+		const RealCalcVec q_fz = c_dz * fac;
+		f_x = f_x + q_fx;
+		f_y = f_y + q_fy;
+		f_z = f_z + q_fz;
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+		const RealAccumVec q_Vx = RealAccumVec::convertCalcToAccum(m_dx * q_fx);
+		const RealAccumVec q_Vy = RealAccumVec::convertCalcToAccum(m_dy * q_fy);
+		const RealAccumVec q_Vz = RealAccumVec::convertCalcToAccum(m_dz * q_fz);
+		V_x = V_x + q_Vx;
+		V_y = V_y + q_Vy;
+		V_z = V_z + q_Vz;
+
+		if (calculateMacroscopic) {
+			sum_upotXpoles = sum_upotXpoles + RealAccumVec::convertCalcToAccum(upot);
+			sum_virial = sum_virial + q_Vx + q_Vy + q_Vz;
+		}
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyCharge(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& qii,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& qjj,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask)
+	{
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;//fma not possible since they will be reused...
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec c_dr2_inv = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);//masked
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec c_dr_inv = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);//masked
+#else
+	    const RealCalcVec c_dr_inv = RealCalcVec::sqrt(c_dr2_inv);//masked
+#endif
+
+		const RealCalcVec q1q2per4pie0 = qii * qjj;
+		const RealCalcVec upot = q1q2per4pie0 * c_dr_inv;//masked
+		const RealCalcVec fac = upot * c_dr2_inv;//masked
+
+		f_x = c_dx * fac;
+		f_y = c_dy * fac;
+		f_z = c_dz * fac;
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+			RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+			sum_virial = sum_virial + V_x + V_y + V_z;//DoubleVec::scal_prod(m_dx, m_dy, m_dz, f_x, f_y, f_z);
+		}
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyChargeDipole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& q,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& e_x, const RealCalcVec& e_y, const RealCalcVec& e_z,
+			const RealCalcVec& p,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask)
+	{
+		const RealCalcVec three = RealCalcVec::set1(3.0);
+
+		const RealCalcVec dx = r1_x - r2_x;
+		const RealCalcVec dy = r1_y - r2_y;
+		const RealCalcVec dz = r1_z - r2_z;
+
+		const RealCalcVec dr2 = RealCalcVec::scal_prod(dx, dy, dz, dx, dy, dz);
+
+		const RealCalcVec dr2_inv = RealCalcVec::fastReciprocal_mask(dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+		const RealCalcVec dr_inv = RealCalcVec::fastReciprocSqrt_mask(dr2, forceMask);
+#else
+	    const RealCalcVec dr_inv = RealCalcVec::sqrt(dr2_inv);
+#endif
+		const RealCalcVec dr3_inv = dr2_inv * dr_inv;
+
+		const RealCalcVec re = RealCalcVec::scal_prod(dx, dy, dz, e_x, e_y, e_z);
+
+		const RealCalcVec qpper4pie0 = q * p;
+		const RealCalcVec qpper4pie0dr3 = qpper4pie0 * dr3_inv;
+
+		const RealCalcVec fac = dr2_inv * three * re;
+
+		f_x = qpper4pie0dr3 * RealCalcVec::fnmadd(dx, fac, e_x);
+		f_y = qpper4pie0dr3 * RealCalcVec::fnmadd(dy, fac, e_y);
+		f_z = qpper4pie0dr3 * RealCalcVec::fnmadd(dz, fac, e_z);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up.
+		if (calculateMacroscopic)
+		{
+			const RealCalcVec minusUpot =  qpper4pie0dr3 * re;//already masked
+			RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(minusUpot);
+			sum_upotXpoles = sum_upotXpoles - upot_accum;
+			sum_virial = sum_virial + V_x + V_y + V_z; //DoubleVec::scal_prod(m_dx, m_dy, m_dz, f_x, f_y, f_z);//already masked
+		}
+
+		const RealCalcVec e_x_dy_minus_e_y_dx = RealCalcVec::fmsub(e_x, dy, e_y * dx);
+		const RealCalcVec e_y_dz_minus_e_z_dy = RealCalcVec::fmsub(e_y, dz, e_z * dy);
+		const RealCalcVec e_z_dx_minus_e_x_dz = RealCalcVec::fmsub(e_z, dx, e_x * dz);
+
+		M_x = RealAccumVec::convertCalcToAccum(qpper4pie0dr3 * e_y_dz_minus_e_z_dy);
+		M_y = RealAccumVec::convertCalcToAccum(qpper4pie0dr3 * e_z_dx_minus_e_x_dz);
+		M_z = RealAccumVec::convertCalcToAccum(qpper4pie0dr3 * e_x_dy_minus_e_y_dx);
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyDipole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+			const RealCalcVec& pii,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+			const RealCalcVec& pjj,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
+			RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial, RealAccumVec& sum_myRF,
+			const MaskCalcVec& forceMask,
+			const RealCalcVec& epsRFInvrc3)
+	{
+		const RealCalcVec three = RealCalcVec::set1(3.0);
+		const RealCalcVec five = RealCalcVec::set1(5.0);
+
+		const RealCalcVec dx = r1_x - r2_x;
+		const RealCalcVec dy = r1_y - r2_y;
+		const RealCalcVec dz = r1_z - r2_z;
+
+		const RealCalcVec dr2 = RealCalcVec::scal_prod(dx, dy, dz, dx, dy, dz);
+
+		const RealCalcVec dr2_inv = RealCalcVec::fastReciprocal_mask(dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec dr_inv = RealCalcVec::fastReciprocSqrt_mask(dr2, forceMask);
+#else
+	    const RealCalcVec dr_inv = RealCalcVec::sqrt(dr2_inv);
+#endif
+		const RealCalcVec dr2three_inv = three * dr2_inv;
+
+		const RealCalcVec p1p2 = RealCalcVec::apply_mask(pii * pjj, forceMask);
+		const RealCalcVec p1p2per4pie0 = p1p2;
+		const RealCalcVec rffac = p1p2 * epsRFInvrc3;
+
+		const RealCalcVec p1p2per4pie0r3 = p1p2per4pie0 * dr_inv * dr2_inv;
+		const RealCalcVec p1p2threeper4pie0r5 = p1p2per4pie0r3 * dr2three_inv;
+
+		const RealCalcVec e1e2 = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, ejj_x, ejj_y, ejj_z);
+		const RealCalcVec re1 = RealCalcVec::scal_prod(dx, dy, dz, eii_x, eii_y, eii_z);
+		const RealCalcVec re2 = RealCalcVec::scal_prod(dx, dy, dz, ejj_x, ejj_y, ejj_z);
+
+		const RealCalcVec re1threeperr2 = re1 * dr2three_inv;
+		const RealCalcVec re2threeperr2 = re2 * dr2three_inv;
+		const RealCalcVec re1re2perr2 = dr2_inv * re1 * re2;
+
+		const RealCalcVec e1e2minus5re1re2perr2 = RealCalcVec::fnmadd(five, re1re2perr2, e1e2);//-five*re1+e1e2
+
+
+		f_x = p1p2threeper4pie0r5 * RealCalcVec::scal_prod(dx, eii_x, ejj_x, e1e2minus5re1re2perr2, re2, re1);
+		f_y = p1p2threeper4pie0r5 * RealCalcVec::scal_prod(dy, eii_y, ejj_y, e1e2minus5re1re2perr2, re2, re1);
+		f_z = p1p2threeper4pie0r5 * RealCalcVec::scal_prod(dz, eii_z, ejj_z, e1e2minus5re1re2perr2, re2, re1);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+
+			// can we precompute some of this?
+			const RealCalcVec upot = p1p2per4pie0r3 * RealCalcVec::fnmadd(three, re1re2perr2, e1e2);//already masked
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+
+			//const DoubleVec virial = DoubleVec::scal_prod(m_dx, m_dy, m_dz, f_x, f_y, f_z);//already masked
+			sum_virial = sum_virial + V_x + V_y + V_z;
+
+			RealAccumVec rf_accum = RealAccumVec::convertCalcToAccum(rffac * e1e2);
+			sum_myRF = sum_myRF + rf_accum;
+		}
+
+		const RealCalcVec e1_x_e2_y_minus_e1_y_e2_x = RealCalcVec::fmsub(eii_x, ejj_y, eii_y * ejj_x);
+		const RealCalcVec e1_y_e2_z_minus_e1_z_e2_y = RealCalcVec::fmsub(eii_y, ejj_z, eii_z * ejj_y);
+		const RealCalcVec e1_z_e2_x_minus_e1_x_e2_z = RealCalcVec::fmsub(eii_z, ejj_x, eii_x * ejj_z);
+
+		M1_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(p1p2per4pie0r3, RealCalcVec::fmsub(re2threeperr2, RealCalcVec::fmsub(eii_y, dz, eii_z * dy), e1_y_e2_z_minus_e1_z_e2_y), rffac * e1_y_e2_z_minus_e1_z_e2_y));
+		M1_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(p1p2per4pie0r3, RealCalcVec::fmsub(re2threeperr2, RealCalcVec::fmsub(eii_z, dx, eii_x * dz), e1_z_e2_x_minus_e1_x_e2_z), rffac * e1_z_e2_x_minus_e1_x_e2_z));
+		M1_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(p1p2per4pie0r3, RealCalcVec::fmsub(re2threeperr2, RealCalcVec::fmsub(eii_x, dy, eii_y * dx), e1_x_e2_y_minus_e1_y_e2_x), rffac * e1_x_e2_y_minus_e1_y_e2_x));
+
+		M2_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(p1p2per4pie0r3, RealCalcVec::fmadd(re1threeperr2, RealCalcVec::fmsub(ejj_y, dz, ejj_z * dy), e1_y_e2_z_minus_e1_z_e2_y), rffac * e1_y_e2_z_minus_e1_z_e2_y));
+		M2_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(p1p2per4pie0r3, RealCalcVec::fmadd(re1threeperr2, RealCalcVec::fmsub(ejj_z, dx, ejj_x * dz), e1_z_e2_x_minus_e1_x_e2_z), rffac * e1_z_e2_x_minus_e1_x_e2_z));
+		M2_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(p1p2per4pie0r3, RealCalcVec::fmadd(re1threeperr2, RealCalcVec::fmsub(ejj_x, dy, ejj_y * dx), e1_x_e2_y_minus_e1_y_e2_x), rffac * e1_x_e2_y_minus_e1_y_e2_x));
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyChargeQuadrupole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& q,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+			const RealCalcVec& m,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask) {
+		const RealCalcVec one = RealCalcVec::set1(1.0);
+		const RealCalcVec three = RealCalcVec::set1(3.0);
+		const RealCalcVec six = RealCalcVec::set1(6.0);
+		const RealCalcVec _05 = RealCalcVec::set1(0.5);
+
+
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;//fma not possible since they will be reused...
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec invdr2 = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec invdr = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);
+#else
+	    const RealCalcVec invdr = RealCalcVec::sqrt(invdr2);
+#endif
+
+		const RealCalcVec qQ05per4pie0 = _05 * q * m;
+
+		RealCalcVec costj = RealCalcVec::scal_prod(ejj_x, ejj_y, ejj_z, c_dx, c_dy, c_dz);
+		costj = costj * invdr;
+
+		const RealCalcVec qQinv4dr3 = qQ05per4pie0 * invdr * invdr2;
+		const RealCalcVec part1 = three * costj * costj;
+		const RealCalcVec upot = qQinv4dr3 * (part1 - one);
+
+		/**********
+		 * Force
+		 **********/
+		const RealCalcVec minus_partialRijInvdr = three * upot * invdr2;
+		const RealCalcVec partialTjInvdr = six * costj * qQinv4dr3 * invdr;
+
+		const RealCalcVec fac = RealCalcVec::fmadd(costj * partialTjInvdr, invdr, minus_partialRijInvdr);
+
+		f_x = RealCalcVec::fmsub(fac, c_dx, partialTjInvdr * ejj_x);
+		f_y = RealCalcVec::fmsub(fac, c_dy, partialTjInvdr * ejj_y);
+		f_z = RealCalcVec::fmsub(fac, c_dz, partialTjInvdr * ejj_z);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+
+			sum_virial = sum_virial + V_x + V_y + V_z;
+		}
+
+		/**********
+		 * Torque
+		 **********/
+		const RealCalcVec minuseXrij_x = RealCalcVec::fmsub(ejj_z, c_dy, ejj_y * c_dz);
+		const RealCalcVec minuseXrij_y = RealCalcVec::fmsub(ejj_x, c_dz, ejj_z * c_dx);
+		const RealCalcVec minuseXrij_z = RealCalcVec::fmsub(ejj_y, c_dx, ejj_x * c_dy);
+
+		M_x = RealAccumVec::convertCalcToAccum(partialTjInvdr * minuseXrij_x);
+		M_y = RealAccumVec::convertCalcToAccum(partialTjInvdr * minuseXrij_y);
+		M_z = RealAccumVec::convertCalcToAccum(partialTjInvdr * minuseXrij_z);
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyDipoleQuadrupole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+			const RealCalcVec& p,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+			const RealCalcVec& m,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& M1_x, RealAccumVec& M1_y, RealAccumVec& M1_z,
+			RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask) {
+		const RealCalcVec one = RealCalcVec::set1(1.0);
+		const RealCalcVec two = RealCalcVec::set1(2.0);
+		const RealCalcVec four = RealCalcVec::set1(4.0);
+		const RealCalcVec five = RealCalcVec::set1(5.0);
+		const RealCalcVec _1pt5 = RealCalcVec::set1(1.5);
+
+
+
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec invdr2 = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec invdr = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);
+#else
+	    const RealCalcVec invdr = RealCalcVec::sqrt(invdr2);
+#endif
+
+		const RealCalcVec myqfac = _1pt5 * p * m * invdr2 * invdr2;
+
+		RealCalcVec costi = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, c_dx, c_dy, c_dz);
+		costi = costi * invdr;
+
+		RealCalcVec costj = RealCalcVec::scal_prod(ejj_x, ejj_y, ejj_z, c_dx, c_dy, c_dz);
+		costj = costj * invdr;
+
+		const RealCalcVec cos2tj = costj * costj;
+
+		const RealCalcVec cosgij = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, ejj_x, ejj_y, ejj_z);
+
+		/************
+		 * Potential
+		 ************/
+		// TODO: Check if upot has to be multiplied by -1 according to DISS_STOLL S.178.
+		// This affects also the implementation in potforce.h
+		const RealCalcVec _5cos2tjminus1 = RealCalcVec::fmsub(five, cos2tj, one);
+		const RealCalcVec _2costj = two * costj;
+
+		RealCalcVec part1 = costi * _5cos2tjminus1;
+		RealCalcVec part2 = _2costj * cosgij;
+
+		RealCalcVec const upot = myqfac * (part2 - part1);
+
+		const RealCalcVec myqfacXinvdr = myqfac * invdr;
+		const RealCalcVec minus_partialRijInvdr = four * upot * invdr2;
+		const RealCalcVec minus_partialTiInvdr = myqfacXinvdr * _5cos2tjminus1;
+
+		part1 = RealCalcVec::fmsub(five, costi * costj, cosgij); // *-1!
+
+		const RealCalcVec minus_partialTjInvdr = myqfacXinvdr * two * part1;
+		const RealCalcVec partialGij = myqfac * _2costj;
+
+		RealCalcVec part3 = RealCalcVec::fmadd(costi, minus_partialTiInvdr, costj * minus_partialTjInvdr);
+		const RealCalcVec fac = RealCalcVec::fnmadd(part3, invdr, minus_partialRijInvdr);//minus_pRI - part3*infdr
+
+		// Force components
+		f_x = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dx, eii_x, ejj_x);
+
+		f_y = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dy, eii_y, ejj_y);
+
+		f_z = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dz, eii_z, ejj_z);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up
+		if (calculateMacroscopic) {
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+
+			sum_virial = sum_virial + V_x + V_y + V_z;
+		}
+
+		/**********
+		 * Torque
+		 **********/
+		const RealCalcVec eii_x_ejj_y_minus_eii_y_ejj_x = RealCalcVec::fmsub(eii_x, ejj_y, eii_y * ejj_x);
+		const RealCalcVec eii_y_ejj_z_minus_eii_z_ejj_y = RealCalcVec::fmsub(eii_y, ejj_z, eii_z * ejj_y);
+		const RealCalcVec eii_z_ejj_x_minus_eii_x_ejj_z = RealCalcVec::fmsub(eii_z, ejj_x, eii_x * ejj_z);
+
+		const RealCalcVec partialGij_eiXej_x = partialGij * eii_y_ejj_z_minus_eii_z_ejj_y;
+		const RealCalcVec partialGij_eiXej_y = partialGij * eii_z_ejj_x_minus_eii_x_ejj_z;
+		const RealCalcVec partialGij_eiXej_z = partialGij * eii_x_ejj_y_minus_eii_y_ejj_x;
+
+		RealCalcVec eXrij_x = RealCalcVec::fmsub(eii_y, c_dz, eii_z * c_dy);
+		RealCalcVec eXrij_y = RealCalcVec::fmsub(eii_z, c_dx, eii_x * c_dz);
+		RealCalcVec eXrij_z = RealCalcVec::fmsub(eii_x, c_dy, eii_y * c_dx);
+
+		M1_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_x, partialGij_eiXej_x));
+		M1_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_y, partialGij_eiXej_y));
+		M1_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_z, partialGij_eiXej_z));
+
+		eXrij_x = RealCalcVec::fmsub(ejj_y, c_dz, ejj_z * c_dy);
+		eXrij_y = RealCalcVec::fmsub(ejj_z, c_dx, ejj_x * c_dz);
+		eXrij_z = RealCalcVec::fmsub(ejj_x, c_dy, ejj_y * c_dx);
+
+		M2_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_x, partialGij_eiXej_x));
+		M2_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_y, partialGij_eiXej_y));
+		M2_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_z, partialGij_eiXej_z));
+	}
+
+	template<bool calculateMacroscopic>
+	vcp_inline void VectorizedCellProcessorKernel::_loopBodyQuadrupole(
+			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
+			const RealCalcVec& r1_x, const RealCalcVec& r1_y, const RealCalcVec& r1_z,
+			const RealCalcVec& eii_x, const RealCalcVec& eii_y, const RealCalcVec& eii_z,
+			const RealCalcVec& mii,
+			const RealCalcVec& m2_r_x, const RealCalcVec& m2_r_y, const RealCalcVec& m2_r_z,
+			const RealCalcVec& r2_x, const RealCalcVec& r2_y, const RealCalcVec& r2_z,
+			const RealCalcVec& ejj_x, const RealCalcVec& ejj_y, const RealCalcVec& ejj_z,
+			const RealCalcVec& mjj,
+			RealCalcVec& f_x, RealCalcVec& f_y, RealCalcVec& f_z,
+			RealAccumVec& V_x, RealAccumVec& V_y, RealAccumVec& V_z,
+			RealAccumVec& Mii_x, RealAccumVec& Mii_y, RealAccumVec& Mii_z,
+			RealAccumVec& Mjj_x, RealAccumVec& Mjj_y, RealAccumVec& Mjj_z,
+			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
+			const MaskCalcVec& forceMask)
+	{
+		const RealCalcVec one = RealCalcVec::set1(1.0);
+		const RealCalcVec two = RealCalcVec::set1(2.0);
+		const RealCalcVec three = RealCalcVec::set1(3.0);
+		const RealCalcVec four = RealCalcVec::set1(4.0);
+		const RealCalcVec five = RealCalcVec::set1(5.0);
+		const RealCalcVec ten = RealCalcVec::set1(10.0);
+		const RealCalcVec _075 = RealCalcVec::set1(0.75);
+		const RealCalcVec _15 = RealCalcVec::set1(15.0);
+
+		const RealCalcVec c_dx = r1_x - r2_x;
+		const RealCalcVec c_dy = r1_y - r2_y;
+		const RealCalcVec c_dz = r1_z - r2_z;
+
+		const RealCalcVec c_dr2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+		const RealCalcVec invdr2 = RealCalcVec::fastReciprocal_mask(c_dr2, forceMask);
+#if VCP_VEC_TYPE == VCP_VEC_AVX2 or \
+	VCP_VEC_TYPE == VCP_VEC_KNL or \
+	VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F or \
+	VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+	    const RealCalcVec invdr = RealCalcVec::fastReciprocSqrt_mask(c_dr2, forceMask);
+#else
+	    const RealCalcVec invdr = RealCalcVec::sqrt(invdr2);
+#endif
+
+		RealCalcVec qfac = _075 * invdr;
+		qfac = qfac * (mii * mjj);
+		qfac = qfac * (invdr2 * invdr2);
+
+		RealCalcVec costi = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, c_dx, c_dy, c_dz);
+		costi = costi * invdr;
+
+		RealCalcVec costj = RealCalcVec::scal_prod(ejj_x, ejj_y, ejj_z, c_dx, c_dy, c_dz);
+		costj = costj * invdr;
+
+		const RealCalcVec cos2ti = costi * costi;
+		const RealCalcVec cos2tj = costj * costj;
+
+		const RealCalcVec cosgij = RealCalcVec::scal_prod(eii_x, eii_y, eii_z, ejj_x, ejj_y, ejj_z);
+
+		RealCalcVec term = five * (costi * costj);
+		term = cosgij - term;
+
+		/************
+		 * Potential
+		 ************/
+		RealCalcVec part2 = _15 * cos2ti * cos2tj;
+		RealCalcVec part3 = two * term * term;
+		RealCalcVec upot = RealCalcVec::fmadd(five, (cos2ti + cos2tj), part2);
+		upot = (one + part3) - upot;
+		upot = qfac * upot;
+
+		/**********
+		 * Force
+		 **********/
+		const RealCalcVec minus_partialRijInvdr = five * upot * invdr2;
+
+		// partialTiInvdr & partialTjInvdr
+		RealCalcVec part1 = qfac * ten * invdr;
+		part2 = two * term;
+
+		// partialTiInvdr only
+		part3 = three * costi * cos2tj;
+		RealCalcVec part4 = costi + RealCalcVec::fmadd(part2, costj, part3);
+		const RealCalcVec minus_partialTiInvdr = part1 * part4;
+
+		// partialTjInvdr only
+		part3 = three * costj * cos2ti;
+		part4 = costj + RealCalcVec::fmadd(part2, costi, part3);
+		const RealCalcVec minus_partialTjInvdr = part1 * part4;
+
+		const RealCalcVec partialGij = qfac * four * term;
+
+		// fac
+		part1 = minus_partialTiInvdr * costi;
+		part2 = minus_partialTjInvdr * costj;
+		//part3 = (part1 + part2) * invdr;
+		const RealCalcVec fac = RealCalcVec::fnmadd((part1 + part2), invdr, minus_partialRijInvdr); //min - part3 = -part3 + min
+
+		// Force components
+
+
+		f_x = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dx, eii_x, ejj_x);
+
+		f_y = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dy, eii_y, ejj_y);
+
+		f_z = RealCalcVec::scal_prod(fac, minus_partialTiInvdr, minus_partialTjInvdr, c_dz, eii_z, ejj_z);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		V_x = RealAccumVec::convertCalcToAccum(m_dx * f_x);
+		V_y = RealAccumVec::convertCalcToAccum(m_dy * f_y);
+		V_z = RealAccumVec::convertCalcToAccum(m_dz * f_z);
+
+		// Check if we have to add the macroscopic values up for at least one of this pairs
+		if (calculateMacroscopic) {
+			const RealAccumVec upot_accum = RealAccumVec::convertCalcToAccum(upot);
+
+			sum_upotXpoles = sum_upotXpoles + upot_accum;
+
+
+			sum_virial = sum_virial + V_x + V_y + V_z;
+		}
+
+		/**********
+		 * Torque
+		 **********/
+
+		const RealCalcVec eii_x_ejj_y_minus_eii_y_ejj_x = RealCalcVec::fmsub(eii_x, ejj_y, eii_y * ejj_x);
+		const RealCalcVec eii_y_ejj_z_minus_eii_z_ejj_y = RealCalcVec::fmsub(eii_y, ejj_z, eii_z * ejj_y);
+		const RealCalcVec eii_z_ejj_x_minus_eii_x_ejj_z = RealCalcVec::fmsub(eii_z, ejj_x, eii_x * ejj_z);
+
+		const RealCalcVec partialGij_eiXej_x = partialGij * eii_y_ejj_z_minus_eii_z_ejj_y;
+		const RealCalcVec partialGij_eiXej_y = partialGij * eii_z_ejj_x_minus_eii_x_ejj_z;
+		const RealCalcVec partialGij_eiXej_z = partialGij * eii_x_ejj_y_minus_eii_y_ejj_x;
+
+		RealCalcVec eXrij_x = RealCalcVec::fmsub(eii_y, c_dz, eii_z * c_dy);
+		RealCalcVec eXrij_y = RealCalcVec::fmsub(eii_z, c_dx, eii_x * c_dz);
+		RealCalcVec eXrij_z = RealCalcVec::fmsub(eii_x, c_dy, eii_y * c_dx);
+
+		Mii_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_x, partialGij_eiXej_x));
+		Mii_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_y, partialGij_eiXej_y));
+		Mii_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmsub(minus_partialTiInvdr, eXrij_z, partialGij_eiXej_z));
+
+		eXrij_x = RealCalcVec::fmsub(ejj_y, c_dz, ejj_z * c_dy);
+		eXrij_y = RealCalcVec::fmsub(ejj_z, c_dx, ejj_x * c_dz);
+		eXrij_z = RealCalcVec::fmsub(ejj_x, c_dy, ejj_y * c_dx);
+
+		Mjj_x = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_x, partialGij_eiXej_x));
+		Mjj_y = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_y, partialGij_eiXej_y));
+		Mjj_z = RealAccumVec::convertCalcToAccum(RealCalcVec::fmadd(minus_partialTjInvdr, eXrij_z, partialGij_eiXej_z));
+	}
+
+template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
+void VectorizedCellProcessorKernel::_calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, CellVerletLists::PairList * verletList) {
+	// the positions of soa1 in the frame of those of soa2 (see CellDataSoA::_origin)
+	const RealCalcVec shift1_x = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[0] - soa2._origin[0]));
+	const RealCalcVec shift1_y = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[1] - soa2._origin[1]));
+	const RealCalcVec shift1_z = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[2] - soa2._origin[2]));
+
+	const int tid = mardyn_get_thread_num();
+	VLJCPThreadData &my_threadData = *_threadData[tid];
+
+	// initialize dist lookups
+	soa2.initDistLookupPointers<VCP_INDICES_PER_LOOKUP_SINGLE>(my_threadData._centers_dist_lookup,
+			my_threadData._ljc_dist_lookup, my_threadData._charges_dist_lookup,
+			my_threadData._dipoles_dist_lookup,
+			my_threadData._quadrupoles_dist_lookup);
+
+	// Pointer for molecules
+	const vcp_real_calc * const soa1_mol_pos_x = soa1._mol_pos.xBegin();
+	const vcp_real_calc * const soa1_mol_pos_y = soa1._mol_pos.yBegin();
+	const vcp_real_calc * const soa1_mol_pos_z = soa1._mol_pos.zBegin();
+
+	//for better readability:
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	// Pointer for LJ centers
+	const vcp_real_calc * const soa1_ljc_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa1_ljc_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa1_ljc_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa1_ljc_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa1_ljc_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa1_ljc_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa1_ljc_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa1_ljc_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa1_ljc_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const int * const soa1_mol_ljc_num = soa1._mol_ljc_num;
+	const vcp_ljc_id_t * const soa1_ljc_id = soa1._ljc_id;
+
+
+	const vcp_real_calc * const soa2_ljc_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa2_ljc_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa2_ljc_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::LJC, Coordinate::Z);
+	const vcp_real_calc * const soa2_ljc_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa2_ljc_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa2_ljc_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t * const soa2_ljc_id = soa2._ljc_id;
+
+	vcp_lookupOrMask_single* const soa2_ljc_dist_lookup = my_threadData._ljc_dist_lookup;
+
+	// Pointer for charges
+	const vcp_real_calc * const soa1_charges_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::X);
+	const vcp_real_calc * const soa1_charges_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Y);
+	const vcp_real_calc * const soa1_charges_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa1_charges_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa1_charges_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa1_charges_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa1_charges_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa1_charges_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa1_charges_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Z);
+	const vcp_real_calc * const soa1_charges_q = soa1._charges_q;
+	const int * const soa1_mol_charges_num = soa1._mol_charges_num;
+
+	const vcp_real_calc * const soa2_charges_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::CHARGE, Coordinate::X);
+	const vcp_real_calc * const soa2_charges_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::CHARGE, Coordinate::Y);
+	const vcp_real_calc * const soa2_charges_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::CHARGE, Coordinate::Z);
+	const vcp_real_calc * const soa2_charges_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::X);
+	const vcp_real_calc * const soa2_charges_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Y);
+	const vcp_real_calc * const soa2_charges_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa2_charges_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa2_charges_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa2_charges_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa2_charges_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa2_charges_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa2_charges_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Z);
+	const vcp_real_calc * const soa2_charges_q = soa2._charges_q;
+
+	vcp_lookupOrMask_single* const soa2_charges_dist_lookup = my_threadData._charges_dist_lookup;
+
+	// Pointer for dipoles
+	const vcp_real_calc * const soa1_dipoles_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::X);
+	const vcp_real_calc * const soa1_dipoles_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa1_dipoles_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa1_dipoles_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa1_dipoles_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa1_dipoles_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa1_dipoles_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa1_dipoles_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa1_dipoles_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa1_dipoles_p = soa1._dipoles_p;
+	const vcp_real_calc * const soa1_dipoles_e_x = soa1._dipoles_e.xBegin();
+	const vcp_real_calc * const soa1_dipoles_e_y = soa1._dipoles_e.yBegin();
+	const vcp_real_calc * const soa1_dipoles_e_z = soa1._dipoles_e.zBegin();
+	vcp_real_accum * const soa1_dipoles_M_x = soa1._dipoles_M.xBegin();
+	vcp_real_accum * const soa1_dipoles_M_y = soa1._dipoles_M.yBegin();
+	vcp_real_accum * const soa1_dipoles_M_z = soa1._dipoles_M.zBegin();
+	const int * const soa1_mol_dipoles_num = soa1._mol_dipoles_num;
+
+	const vcp_real_calc * const soa2_dipoles_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::DIPOLE, Coordinate::X);
+	const vcp_real_calc * const soa2_dipoles_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::DIPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa2_dipoles_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::DIPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa2_dipoles_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::X);
+	const vcp_real_calc * const soa2_dipoles_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa2_dipoles_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_dipoles_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_dipoles_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_dipoles_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_dipoles_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_dipoles_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_dipoles_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa2_dipoles_p = soa2._dipoles_p;
+	const vcp_real_calc * const soa2_dipoles_e_x = soa2._dipoles_e.xBegin();
+	const vcp_real_calc * const soa2_dipoles_e_y = soa2._dipoles_e.yBegin();
+	const vcp_real_calc * const soa2_dipoles_e_z = soa2._dipoles_e.zBegin();
+	vcp_real_accum * const soa2_dipoles_M_x = soa2._dipoles_M.xBegin();
+	vcp_real_accum * const soa2_dipoles_M_y = soa2._dipoles_M.yBegin();
+	vcp_real_accum * const soa2_dipoles_M_z = soa2._dipoles_M.zBegin();
+
+	vcp_lookupOrMask_single* const soa2_dipoles_dist_lookup = my_threadData._dipoles_dist_lookup;
+
+	// Pointer for quadrupoles
+	const vcp_real_calc * const soa1_quadrupoles_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::X);
+	const vcp_real_calc * const soa1_quadrupoles_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa1_quadrupoles_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa1_quadrupoles_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa1_quadrupoles_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa1_quadrupoles_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa1_quadrupoles_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa1_quadrupoles_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa1_quadrupoles_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa1_quadrupoles_m = soa1._quadrupoles_m;
+	const vcp_real_calc * const soa1_quadrupoles_e_x = soa1._quadrupoles_e.xBegin();
+	const vcp_real_calc * const soa1_quadrupoles_e_y = soa1._quadrupoles_e.yBegin();
+	const vcp_real_calc * const soa1_quadrupoles_e_z = soa1._quadrupoles_e.zBegin();
+	     vcp_real_accum * const soa1_quadrupoles_M_x = soa1._quadrupoles_M.xBegin();
+	     vcp_real_accum * const soa1_quadrupoles_M_y = soa1._quadrupoles_M.yBegin();
+	     vcp_real_accum * const soa1_quadrupoles_M_z = soa1._quadrupoles_M.zBegin();
+	const int * const soa1_mol_quadrupoles_num = soa1._mol_quadrupoles_num;
+
+
+	const vcp_real_calc * const soa2_quadrupoles_m_r_x = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::QUADRUPOLE, Coordinate::X);
+	const vcp_real_calc * const soa2_quadrupoles_m_r_y = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::QUADRUPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa2_quadrupoles_m_r_z = soa2.getBeginCalc(QuantityType::MOL_POSITION, SiteType::QUADRUPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa2_quadrupoles_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::X);
+	const vcp_real_calc * const soa2_quadrupoles_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Y);
+	const vcp_real_calc * const soa2_quadrupoles_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_quadrupoles_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_quadrupoles_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_quadrupoles_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_quadrupoles_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_quadrupoles_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_quadrupoles_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Z);
+	const vcp_real_calc * const soa2_quadrupoles_m = soa2._quadrupoles_m;
+	const vcp_real_calc * const soa2_quadrupoles_e_x = soa2._quadrupoles_e.xBegin();
+	const vcp_real_calc * const soa2_quadrupoles_e_y = soa2._quadrupoles_e.yBegin();
+	const vcp_real_calc * const soa2_quadrupoles_e_z = soa2._quadrupoles_e.zBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_x = soa2._quadrupoles_M.xBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_y = soa2._quadrupoles_M.yBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_z = soa2._quadrupoles_M.zBegin();
+
+	vcp_lookupOrMask_single* const soa2_quadrupoles_dist_lookup = my_threadData._quadrupoles_dist_lookup;
+
+
+
+
+	RealAccumVec sum_upot6lj = RealAccumVec::zero();
+	RealAccumVec sum_upotXpoles = RealAccumVec::zero();
+	RealAccumVec sum_virial = RealAccumVec::zero();
+	RealAccumVec sum_myRF = RealAccumVec::zero();
+
+	const RealCalcVec ljrc2 = RealCalcVec::set1(static_cast<vcp_real_calc>(_vcp.getLJCutoffRadiusSquare()));
+	const RealCalcVec cutoffRadiusSquare = RealCalcVec::set1(static_cast<vcp_real_calc>(_vcp.getCutoffRadiusSquare()));
+	const RealCalcVec epsRFInvrc3 = RealCalcVec::set1(static_cast<vcp_real_calc>(_epsRFInvrc3));
+
+	// list radii of the Verlet list (if any): cutoff radii plus the margins of both cells
+	const bool rebuildVerletList = verletList != nullptr and verletList->needsRebuild();
+	const double verletMargin = verletList != nullptr ? verletList->getMargin() : 0.0;
+	const RealCalcVec verletLjrc2 = RealCalcVec::set1(static_cast<vcp_real_calc>(
+			(_vcp.getLJCutoffRadius() + verletMargin) * (_vcp.getLJCutoffRadius() + verletMargin)));
+	const RealCalcVec verletCutoffRadiusSquare = RealCalcVec::set1(static_cast<vcp_real_calc>(
+			(_vcp.getCutoffRadius() + verletMargin) * (_vcp.getCutoffRadius() + verletMargin)));
+
+	/*
+	 *  Here different end values for the loops are defined. For loops, which do not vectorize over the last (possibly "uneven") amount of indices, the normal values are computed. These mark the end of the vectorized part.
+	 *  The longloop values mark the end of the vectorized part, if vectorization is performed for all elements. For these, various conditions have to be fulfilled, to be sure, that no NaN values are stored and no segfaults arise:
+	 *  * arrays have to be long enough
+	 *  * arrays have to be filled with something
+	 *  * _ljc_id has to be set to existing values for each index
+	 *  All of these conditions are fulfilled by setting the non existing values within CellDataSoA.h and AlignedArray.h to zero.
+	 */
+	const size_t end_ljc_j = vcp_floor_to_vec_size(soa2._ljc_num);
+	const size_t end_ljc_j_longloop = vcp_ceil_to_vec_size(soa2._ljc_num);//this is ceil _ljc_num, VCP_VEC_SIZE
+
+	const size_t end_charges_j = vcp_floor_to_vec_size(soa2._charges_num);
+	const size_t end_charges_j_longloop = vcp_ceil_to_vec_size(soa2._charges_num);//this is ceil _charges_num, VCP_VEC_SIZE
+
+	const size_t end_dipoles_j = vcp_floor_to_vec_size(soa2._dipoles_num);
+	const size_t end_dipoles_j_longloop = vcp_ceil_to_vec_size(soa2._dipoles_num);//this is ceil _dipoles_num, VCP_VEC_SIZE
+
+	const size_t end_quadrupoles_j = vcp_floor_to_vec_size(soa2._quadrupoles_num);
+	const size_t end_quadrupoles_j_longloop = vcp_ceil_to_vec_size(soa2._quadrupoles_num);//this is ceil _quadrupoles_num, VCP_VEC_SIZE
+
+	size_t i_ljc_idx = 0;
+	size_t i_charge_idx = 0;
+	size_t i_charge_dipole_idx = 0;
+	size_t i_charge_quadrupole_idx = 0;
+	size_t i_dipole_charge_idx = 0;
+	size_t i_dipole_idx = 0;
+	size_t i_dipole_quadrupole_idx = 0;
+	size_t i_quadrupole_charge_idx = 0;
+	size_t i_quadrupole_dipole_idx = 0;
+	size_t i_quadrupole_idx = 0;
+
+	//if(soa1.getMolNum() < 8){
+	//	printf("less than 8\n");
+	//}
+
+	// Iterate over each center in the first cell.
+	const size_t soa1_mol_num = soa1.getMolNum();
+	for (size_t i = 0; i < soa1_mol_num; ++i) {//over the molecules
+		const RealCalcVec m1_r_x = (RealCalcVec::broadcast(soa1_mol_pos_x + i) + shift1_x);
+		const RealCalcVec m1_r_y = (RealCalcVec::broadcast(soa1_mol_pos_y + i) + shift1_y);
+		const RealCalcVec m1_r_z = (RealCalcVec::broadcast(soa1_mol_pos_z + i) + shift1_z);
+		// Iterate over centers of second cell
+		countertype32 compute_molecule_ljc, compute_molecule_charges, compute_molecule_dipoles, compute_molecule_quadrupoles;
+		// with the charge-charge interactions in the LJ loop, the charges of soa2 only interact with dipoles and quadrupoles
+		const bool lookupCharges = _ljcQQ.empty() or soa1_mol_dipoles_num[i] > 0 or soa1_mol_quadrupoles_num[i] > 0;
+		if (verletList == nullptr) {
+			compute_molecule_ljc = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
+					soa2_ljc_dist_lookup, soa2_ljc_m_r_x, soa2_ljc_m_r_y, soa2_ljc_m_r_z,
+					ljrc2, end_ljc_j, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_charges = not lookupCharges ? 0 : calcDistLookup<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
+					soa2_charges_dist_lookup, soa2_charges_m_r_x, soa2_charges_m_r_y, soa2_charges_m_r_z,
+					cutoffRadiusSquare,	end_charges_j, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_dipoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
+					soa2_dipoles_dist_lookup, soa2_dipoles_m_r_x, soa2_dipoles_m_r_y, soa2_dipoles_m_r_z,
+					cutoffRadiusSquare,	end_dipoles_j, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_quadrupoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
+					soa2_quadrupoles_dist_lookup, soa2_quadrupoles_m_r_x, soa2_quadrupoles_m_r_y, soa2_quadrupoles_m_r_z,
+					cutoffRadiusSquare, end_quadrupoles_j, m1_r_x, m1_r_y, m1_r_z);
+		} else if (rebuildVerletList) {
+			compute_molecule_ljc = calcDistLookupBuildVerlet<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
+					soa2_ljc_dist_lookup, soa2_ljc_m_r_x, soa2_ljc_m_r_y, soa2_ljc_m_r_z,
+					ljrc2, end_ljc_j, m1_r_x, m1_r_y, m1_r_z,
+					verletList->getBlocks(SiteType::LJC, i), verletLjrc2);
+			compute_molecule_charges = not lookupCharges ? 0 : calcDistLookupBuildVerlet<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
+					soa2_charges_dist_lookup, soa2_charges_m_r_x, soa2_charges_m_r_y, soa2_charges_m_r_z,
+					cutoffRadiusSquare,	end_charges_j, m1_r_x, m1_r_y, m1_r_z,
+					verletList->getBlocks(SiteType::CHARGE, i), verletCutoffRadiusSquare);
+			compute_molecule_dipoles = calcDistLookupBuildVerlet<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
+					soa2_dipoles_dist_lookup, soa2_dipoles_m_r_x, soa2_dipoles_m_r_y, soa2_dipoles_m_r_z,
+					cutoffRadiusSquare,	end_dipoles_j, m1_r_x, m1_r_y, m1_r_z,
+					verletList->getBlocks(SiteType::DIPOLE, i), verletCutoffRadiusSquare);
+			compute_molecule_quadrupoles = calcDistLookupBuildVerlet<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
+					soa2_quadrupoles_dist_lookup, soa2_quadrupoles_m_r_x, soa2_quadrupoles_m_r_y, soa2_quadrupoles_m_r_z,
+					cutoffRadiusSquare, end_quadrupoles_j, m1_r_x, m1_r_y, m1_r_z,
+					verletList->getBlocks(SiteType::QUADRUPOLE, i), verletCutoffRadiusSquare);
+		} else {
+			compute_molecule_ljc = calcDistLookupVerlet<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
+					soa2_ljc_dist_lookup, soa2_ljc_m_r_x, soa2_ljc_m_r_y, soa2_ljc_m_r_z,
+					ljrc2, end_ljc_j, m1_r_x, m1_r_y, m1_r_z,
+					verletList->getBlocks(SiteType::LJC, i));
+			compute_molecule_charges = not lookupCharges ? 0 : calcDistLookupVerlet<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
+					soa2_charges_dist_lookup, soa2_charges_m_r_x, soa2_charges_m_r_y, soa2_charges_m_r_z,
+					cutoffRadiusSquare,	end_charges_j, m1_r_x, m1_r_y, m1_r_z,
+					verletList->getBlocks(SiteType::CHARGE, i));
+			compute_molecule_dipoles = calcDistLookupVerlet<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
+					soa2_dipoles_dist_lookup, soa2_dipoles_m_r_x, soa2_dipoles_m_r_y, soa2_dipoles_m_r_z,
+					cutoffRadiusSquare,	end_dipoles_j, m1_r_x, m1_r_y, m1_r_z,
+					verletList->getBlocks(SiteType::DIPOLE, i));
+			compute_molecule_quadrupoles = calcDistLookupVerlet<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
+					soa2_quadrupoles_dist_lookup, soa2_quadrupoles_m_r_x, soa2_quadrupoles_m_r_y, soa2_quadrupoles_m_r_z,
+					cutoffRadiusSquare, end_quadrupoles_j, m1_r_x, m1_r_y, m1_r_z,
+					verletList->getBlocks(SiteType::QUADRUPOLE, i));
+		}
+
+		size_t end_ljc_loop = MaskGatherChooser::getEndloop(end_ljc_j_longloop, compute_molecule_ljc);
+		size_t end_charges_loop = MaskGatherChooser::getEndloop(end_charges_j_longloop, compute_molecule_charges);
+		size_t end_dipoles_loop = MaskGatherChooser::getEndloop(end_dipoles_j_longloop, compute_molecule_dipoles);
+		size_t end_quadrupoles_loop = MaskGatherChooser::getEndloop(end_quadrupoles_j_longloop, compute_molecule_quadrupoles);
+
+		if (compute_molecule_ljc==0) {
+			i_ljc_idx += soa1_mol_ljc_num[i];
+		}
+		else {
+			// LJ force computation
+			for (int local_i = 0; local_i < soa1_mol_ljc_num[i]; local_i++) {//over the number of lj-centers in the molecule i
+				RealAccumVec sum_fx1 = RealAccumVec::zero();
+				RealAccumVec sum_fy1 = RealAccumVec::zero();
+				RealAccumVec sum_fz1 = RealAccumVec::zero();
+
+				RealAccumVec sum_Vx1 = RealAccumVec::zero();
+				RealAccumVec sum_Vy1 = RealAccumVec::zero();
+				RealAccumVec sum_Vz1 = RealAccumVec::zero();
+
+				const RealCalcVec c_r_x1 = (RealCalcVec::broadcast(soa1_ljc_r_x + i_ljc_idx) + shift1_x);
+				const RealCalcVec c_r_y1 = (RealCalcVec::broadcast(soa1_ljc_r_y + i_ljc_idx) + shift1_y);
+				const RealCalcVec c_r_z1 = (RealCalcVec::broadcast(soa1_ljc_r_z + i_ljc_idx) + shift1_z);
+
+				// Iterate over each pair of centers in the second cell.
+				size_t j = ForcePolicy::InitJ2(i_ljc_idx);
+				for (; j < end_ljc_loop; j += VCP_VEC_SIZE) {//over (all/some) lj-centers -- amount depends on ForcePolicy::InitJ (two cells: all, within one cell: only do i,j not j,i)
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_ljc_dist_lookup, j);
+					// Only go on if at least 1 of the forces has to be calculated.
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+						const RealCalcVec c_r_x2 = MaskGatherChooser::load(soa2_ljc_r_x, j, lookupORforceMask);
+						const RealCalcVec c_r_y2 = MaskGatherChooser::load(soa2_ljc_r_y, j, lookupORforceMask);
+						const RealCalcVec c_r_z2 = MaskGatherChooser::load(soa2_ljc_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m_r_x2 = MaskGatherChooser::load(soa2_ljc_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m_r_y2 = MaskGatherChooser::load(soa2_ljc_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m_r_z2 = MaskGatherChooser::load(soa2_ljc_m_r_z, j, lookupORforceMask);
+
+						const vcp_ljc_id_t id_i = soa1_ljc_id[i_ljc_idx];
+						RealCalcVec fx, fy, fz;
+						RealAccumVec Vx, Vy, Vz;
+
+						RealCalcVec eps_24, sig2, shift6;
+						RealCalcVec fshift = RealCalcVec::zero(), rs2 = RealCalcVec::zero(), rc2 = RealCalcVec::zero(), invD = RealCalcVec::zero();
+						_unpackLJ<MaskGatherChooser>(eps_24, sig2, shift6, fshift, rs2, rc2, invD, id_i, soa2_ljc_id, j, lookupORforceMask);
+
+						if (not _ljcRc2.empty()) {
+							// component dependent cutoff: no contribution of the pairs beyond their cutoff radius
+							RealCalcVec ljcRc2;
+							unpackShift6<MaskGatherChooser>(ljcRc2, _ljcRc2[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+							const RealCalcVec m_dx = m1_r_x - m_r_x2;
+							const RealCalcVec m_dy = m1_r_y - m_r_y2;
+							const RealCalcVec m_dz = m1_r_z - m_r_z2;
+							const MaskCalcVec inside = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz) < ljcRc2;
+							eps_24 = RealCalcVec::apply_mask(eps_24, inside);
+							shift6 = RealCalcVec::apply_mask(shift6, inside);
+							fshift = RealCalcVec::apply_mask(fshift, inside);
+						}
+
+						if (_ljFShiftRs2.empty()) {
+							_loopBodyLJ<CalculateMacroscopic, false>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask),
+								eps_24, sig2,
+								shift6,
+								fshift, rs2, rc2, invD);
+						} else {
+							_loopBodyLJ<CalculateMacroscopic, true>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask),
+								eps_24, sig2,
+								shift6,
+								fshift, rs2, rc2, invD);
+						}
+
+						if (not _ljcTab.empty() and not _ljcTab[id_i].empty()) {
+							_loopBodyTabulated<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask),
+								_ljcTab[id_i], soa2_ljc_id + j);
+						}
+
+						if (not _ljcQQ.empty()) {
+							RealCalcVec qq;
+							unpackShift6<MaskGatherChooser>(qq, _ljcQQ[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+							_loopBodyLJCharge<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask),
+								qq);
+						}
+
+						RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
+						RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
+						RealAccumVec a_fz = RealAccumVec::convertCalcToAccum(fz);
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_x, j, a_fx, lookupORforceMask);
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_y, j, a_fy, lookupORforceMask);
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_z, j, a_fz, lookupORforceMask);
+
+						sum_fx1 = sum_fx1 + a_fx;
+						sum_fy1 = sum_fy1 + a_fy;
+						sum_fz1 = sum_fz1 + a_fz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, lookupORforceMask);
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, lookupORforceMask);
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, lookupORforceMask);
+
+						sum_Vx1 = sum_Vx1 + Vx;
+						sum_Vy1 = sum_Vy1 + Vy;
+						sum_Vz1 = sum_Vz1 + Vz;
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_ljc);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_ljc);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_ljc_dist_lookup, j, remainderM);
+
+						const RealCalcVec c_r_x2 = MaskGatherChooser::load(soa2_ljc_r_x, j, lookupORforceMask);
+						const RealCalcVec c_r_y2 = MaskGatherChooser::load(soa2_ljc_r_y, j, lookupORforceMask);
+						const RealCalcVec c_r_z2 = MaskGatherChooser::load(soa2_ljc_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m_r_x2 = MaskGatherChooser::load(soa2_ljc_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m_r_y2 = MaskGatherChooser::load(soa2_ljc_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m_r_z2 = MaskGatherChooser::load(soa2_ljc_m_r_z, j, lookupORforceMask);
+
+						const size_t id_i = soa1_ljc_id[i_ljc_idx];
+						RealCalcVec fx, fy, fz;
+						RealAccumVec Vx, Vy, Vz;
+
+						RealCalcVec eps_24, sig2, shift6;
+						RealCalcVec fshift = RealCalcVec::zero(), rs2 = RealCalcVec::zero(), rc2 = RealCalcVec::zero(), invD = RealCalcVec::zero();
+						_unpackLJ<MaskGatherChooser>(eps_24, sig2, shift6, fshift, rs2, rc2, invD, id_i, soa2_ljc_id, j, lookupORforceMask);
+
+						if (not _ljcRc2.empty()) {
+							// component dependent cutoff: no contribution of the pairs beyond their cutoff radius
+							RealCalcVec ljcRc2;
+							unpackShift6<MaskGatherChooser>(ljcRc2, _ljcRc2[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+							const RealCalcVec m_dx = m1_r_x - m_r_x2;
+							const RealCalcVec m_dy = m1_r_y - m_r_y2;
+							const RealCalcVec m_dz = m1_r_z - m_r_z2;
+							const MaskCalcVec inside = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz) < ljcRc2;
+							eps_24 = RealCalcVec::apply_mask(eps_24, inside);
+							shift6 = RealCalcVec::apply_mask(shift6, inside);
+							fshift = RealCalcVec::apply_mask(fshift, inside);
+						}
+
+						if (_ljFShiftRs2.empty()) {
+							_loopBodyLJ<CalculateMacroscopic, false>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								remainderM,//use remainder mask as forcemask
+								eps_24, sig2,
+								shift6,
+								fshift, rs2, rc2, invD);
+						} else {
+							_loopBodyLJ<CalculateMacroscopic, true>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upot6lj, sum_virial,
+								remainderM,//use remainder mask as forcemask
+								eps_24, sig2,
+								shift6,
+								fshift, rs2, rc2, invD);
+						}
+
+						if (not _ljcQQ.empty()) {
+							RealCalcVec qq;
+							unpackShift6<MaskGatherChooser>(qq, _ljcQQ[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, lookupORforceMask);
+							_loopBodyLJCharge<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, c_r_x1, c_r_y1, c_r_z1,
+								m_r_x2, m_r_y2, m_r_z2, c_r_x2, c_r_y2, c_r_z2,
+								fx, fy, fz,
+								Vx, Vy, Vz,
+								sum_upotXpoles, sum_virial,
+								remainderM,
+								qq);
+						}
+
+						RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
+						RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
+						RealAccumVec a_fz = RealAccumVec::convertCalcToAccum(fz);
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_ljc_f_x, j, a_fx, lookupORforceMask, remainderM);
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_ljc_f_y, j, a_fy, lookupORforceMask, remainderM);
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_ljc_f_z, j, a_fz, lookupORforceMask, remainderM);
+
+						sum_fx1 = sum_fx1 + a_fx;
+						sum_fy1 = sum_fy1 + a_fy;
+						sum_fz1 = sum_fz1 + a_fz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, lookupORforceMask, remainderM);
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, lookupORforceMask, remainderM);
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, lookupORforceMask, remainderM);
+
+
+						sum_Vx1 = sum_Vx1 + Vx;
+						sum_Vy1 = sum_Vy1 + Vy;
+						sum_Vz1 = sum_Vz1 + Vz;
+
+					}
+				}
+#endif
+
+				hSum_Add_Store(soa1_ljc_f_x + i_ljc_idx, sum_fx1);
+				hSum_Add_Store(soa1_ljc_f_y + i_ljc_idx, sum_fy1);
+				hSum_Add_Store(soa1_ljc_f_z + i_ljc_idx, sum_fz1);
+
+				hSum_Add_Store(soa1_ljc_V_x + i_ljc_idx, sum_Vx1);
+				hSum_Add_Store(soa1_ljc_V_y + i_ljc_idx, sum_Vy1);
+				hSum_Add_Store(soa1_ljc_V_z + i_ljc_idx, sum_Vz1);
+
+				i_ljc_idx++;
+			}
+		}
+		// Computation of site interactions with charges
+
+		if (compute_molecule_charges == 0) {
+			i_charge_idx += soa1_mol_charges_num[i];
+			i_dipole_charge_idx += soa1_mol_dipoles_num[i];
+			i_quadrupole_charge_idx += soa1_mol_quadrupoles_num[i];
+		}
+		else {
+			// Computation of charge-charge interactions, unless they are part of the LJ loop (see _ljcQQ)
+			const int charges_num_i = _ljcQQ.empty() ? soa1_mol_charges_num[i] : 0;
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < charges_num_i; local_i++) {
+
+				const RealCalcVec q1 = RealCalcVec::broadcast(soa1_charges_q + i_charge_idx + local_i);
+				const RealCalcVec r1_x = (RealCalcVec::broadcast(soa1_charges_r_x + i_charge_idx + local_i) + shift1_x);
+				const RealCalcVec r1_y = (RealCalcVec::broadcast(soa1_charges_r_y + i_charge_idx + local_i) + shift1_y);
+				const RealCalcVec r1_z = (RealCalcVec::broadcast(soa1_charges_r_z + i_charge_idx + local_i) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_charge_idx + local_i);
+
+				for (; j < end_charges_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_charges_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+						const RealCalcVec q2 = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyCharge<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, q1,
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q2,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask);
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask);
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask);
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_charges_dist_lookup, j, remainderM);
+
+						const RealCalcVec q2 = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyCharge<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, q1,
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q2,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask, remainderM);
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask, remainderM);
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask, remainderM);
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);
+					}
+				}
+#endif
+
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_charges_f_x + i_charge_idx + local_i, sum_f1_x);
+				hSum_Add_Store(soa1_charges_f_y + i_charge_idx + local_i, sum_f1_y);
+				hSum_Add_Store(soa1_charges_f_z + i_charge_idx + local_i, sum_f1_z);
+				// Add old virial and summed calculated virials for center 1
+				hSum_Add_Store(soa1_charges_V_x + i_charge_idx + local_i, sum_V1_x);
+				hSum_Add_Store(soa1_charges_V_y + i_charge_idx + local_i, sum_V1_y);
+				hSum_Add_Store(soa1_charges_V_z + i_charge_idx + local_i, sum_V1_z);
+
+			}
+
+			// Computation of dipole-charge interactions
+
+			for (int local_i = 0; local_i < soa1_mol_dipoles_num[i]; local_i++)
+			{
+				const RealCalcVec p = RealCalcVec::broadcast(soa1_dipoles_p + i_dipole_charge_idx);
+				const RealCalcVec e_x = RealCalcVec::broadcast(soa1_dipoles_e_x + i_dipole_charge_idx);
+				const RealCalcVec e_y = RealCalcVec::broadcast(soa1_dipoles_e_y + i_dipole_charge_idx);
+				const RealCalcVec e_z = RealCalcVec::broadcast(soa1_dipoles_e_z + i_dipole_charge_idx);
+				const RealCalcVec r1_x = (RealCalcVec::broadcast(soa1_dipoles_r_x + i_dipole_charge_idx) + shift1_x);
+				const RealCalcVec r1_y = (RealCalcVec::broadcast(soa1_dipoles_r_y + i_dipole_charge_idx) + shift1_y);
+				const RealCalcVec r1_z = (RealCalcVec::broadcast(soa1_dipoles_r_z + i_dipole_charge_idx) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M_x = RealAccumVec::zero();
+				RealAccumVec sum_M_y = RealAccumVec::zero();
+				RealAccumVec sum_M_z = RealAccumVec::zero();
+
+				size_t j = ForcePolicy::InitJ2(i_charge_idx);
+				for (; j < end_charges_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_charges_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec q = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeDipole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e_x, e_y, e_z, p,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;//negative, since dipole-charge, not charge-dipole -> direction inversed
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						//store virials
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);//newton 3
+
+						// Store torque
+
+						sum_M_x = sum_M_x + M_x;
+						sum_M_y = sum_M_y + M_y;
+						sum_M_z = sum_M_z + M_z;
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_charges_dist_lookup, j, remainderM);
+						const RealCalcVec q = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeDipole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e_x, e_y, e_z, p,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+						// Store torque
+
+						sum_M_x = sum_M_x + M_x;
+						sum_M_y = sum_M_y + M_y;
+						sum_M_z = sum_M_z + M_z;
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_dipoles_f_x + i_dipole_charge_idx, sum_f1_x);
+				hSum_Add_Store(soa1_dipoles_f_y + i_dipole_charge_idx, sum_f1_y);
+				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_charge_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_charge_idx, sum_V1_x);
+				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_charge_idx, sum_V1_y);
+				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_charge_idx, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_charge_idx, sum_M_x);
+				hSum_Add_Store(soa1_dipoles_M_y + i_dipole_charge_idx, sum_M_y);
+				hSum_Add_Store(soa1_dipoles_M_z + i_dipole_charge_idx, sum_M_z);
+
+				i_dipole_charge_idx++;
+			}
+
+			// Computation of quadrupole-charge interactions
+
+			for (int local_i = 0; local_i < soa1_mol_quadrupoles_num[i]; local_i++)
+			{
+				const RealCalcVec m = RealCalcVec::broadcast(soa1_quadrupoles_m + i_quadrupole_charge_idx);
+				const RealCalcVec e_x = RealCalcVec::broadcast(soa1_quadrupoles_e_x + i_quadrupole_charge_idx);
+				const RealCalcVec e_y = RealCalcVec::broadcast(soa1_quadrupoles_e_y + i_quadrupole_charge_idx);
+				const RealCalcVec e_z = RealCalcVec::broadcast(soa1_quadrupoles_e_z + i_quadrupole_charge_idx);
+				const RealCalcVec r1_x = (RealCalcVec::broadcast(soa1_quadrupoles_r_x + i_quadrupole_charge_idx) + shift1_x);
+				const RealCalcVec r1_y = (RealCalcVec::broadcast(soa1_quadrupoles_r_y + i_quadrupole_charge_idx) + shift1_y);
+				const RealCalcVec r1_z = (RealCalcVec::broadcast(soa1_quadrupoles_r_z + i_quadrupole_charge_idx) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				size_t j = ForcePolicy::InitJ2(i_charge_idx);
+				for (; j < end_charges_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_charges_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec q = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeQuadrupole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e_x, e_y, e_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M_x;
+						sum_M1_y = sum_M1_y + M_y;
+						sum_M1_z = sum_M1_z + M_z;
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_charges);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_charges_dist_lookup, j, remainderM);
+						const RealCalcVec q = MaskGatherChooser::load(soa2_charges_q, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_charges_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_charges_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_charges_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_charges_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_charges_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_charges_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeQuadrupole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, q,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e_x, e_y, e_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_charges_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M_x;
+						sum_M1_y = sum_M1_y + M_y;
+						sum_M1_z = sum_M1_z + M_z;
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_quadrupoles_f_x + i_quadrupole_charge_idx, sum_f1_x);
+				hSum_Add_Store(soa1_quadrupoles_f_y + i_quadrupole_charge_idx, sum_f1_y);
+				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_charge_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_charge_idx, sum_V1_x);
+				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_charge_idx, sum_V1_y);
+				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_charge_idx, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_charge_idx, sum_M1_x);
+				hSum_Add_Store(soa1_quadrupoles_M_y + i_quadrupole_charge_idx, sum_M1_y);
+				hSum_Add_Store(soa1_quadrupoles_M_z + i_quadrupole_charge_idx, sum_M1_z);
+
+				i_quadrupole_charge_idx++;
+			}
+
+			i_charge_idx += soa1_mol_charges_num[i];
+		}
+
+		// Computation of site interactions with dipoles
+
+		// Continue with next molecule if no force has to be calculated
+		if (compute_molecule_dipoles==0) {
+			i_dipole_idx += soa1_mol_dipoles_num[i];
+			i_charge_dipole_idx += soa1_mol_charges_num[i];
+			i_quadrupole_dipole_idx += soa1_mol_quadrupoles_num[i];
+		}
+		else {
+			// Computation of dipole-dipole interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_dipoles_num[i]; local_i++) {
+
+				const RealCalcVec p1 = RealCalcVec::broadcast(soa1_dipoles_p + i_dipole_idx + local_i);
+				const RealCalcVec e1_x = RealCalcVec::broadcast(soa1_dipoles_e_x + i_dipole_idx + local_i);
+				const RealCalcVec e1_y = RealCalcVec::broadcast(soa1_dipoles_e_y + i_dipole_idx + local_i);
+				const RealCalcVec e1_z = RealCalcVec::broadcast(soa1_dipoles_e_z + i_dipole_idx + local_i);
+				const RealCalcVec r1_x = (RealCalcVec::broadcast(soa1_dipoles_r_x + i_dipole_idx + local_i) + shift1_x);
+				const RealCalcVec r1_y = (RealCalcVec::broadcast(soa1_dipoles_r_y + i_dipole_idx + local_i) + shift1_y);
+				const RealCalcVec r1_z = (RealCalcVec::broadcast(soa1_dipoles_r_z + i_dipole_idx + local_i) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_dipole_idx + local_i);
+				for (; j < end_dipoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_dipoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+						const RealCalcVec p2 = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+						const RealCalcVec e2_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e2_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e2_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipole<CalculateMacroscopic>(
+							m1_r_x, m1_r_y, m1_r_z, r1_x, r1_y, r1_z, e1_x, e1_y, e1_z, p1,
+							m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, e2_x, e2_y, e2_z, p2,
+							f_x, f_y, f_z,
+							Vx, Vy, Vz,
+							M1_x, M1_y, M1_z,
+							M2_x, M2_y, M2_z,
+							sum_upotXpoles, sum_virial, sum_myRF,
+							MaskGatherChooser::getForceMask(lookupORforceMask),
+							epsRFInvrc3);
+
+					RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+					RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+					RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_x, j, M2_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_y, j, M2_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_z, j, M2_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_dipoles_dist_lookup, j, remainderM);
+						const RealCalcVec p2 = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+						const RealCalcVec e2_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e2_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e2_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipole<CalculateMacroscopic>(
+							m1_r_x, m1_r_y, m1_r_z, r1_x, r1_y, r1_z, e1_x, e1_y, e1_z, p1,
+							m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, e2_x, e2_y, e2_z, p2,
+							f_x, f_y, f_z,
+							Vx, Vy, Vz,
+							M1_x, M1_y, M1_z,
+							M2_x, M2_y, M2_z,
+							sum_upotXpoles, sum_virial, sum_myRF,
+							remainderM,
+							epsRFInvrc3);
+
+					RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+					RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+					RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_x, j, M2_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_y, j, M2_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_z, j, M2_z, lookupORforceMask, remainderM);//newton 3
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_dipoles_f_x + i_dipole_idx + local_i, sum_f1_x);
+				hSum_Add_Store(soa1_dipoles_f_y + i_dipole_idx + local_i, sum_f1_y);
+				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_idx + local_i, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_idx + local_i, sum_V1_x);
+				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_idx + local_i, sum_V1_y);
+				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_idx + local_i, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_idx + local_i, sum_M1_x);
+				hSum_Add_Store(soa1_dipoles_M_y + i_dipole_idx + local_i, sum_M1_y);
+				hSum_Add_Store(soa1_dipoles_M_z + i_dipole_idx + local_i, sum_M1_z);
+
+			}
+
+			// Computation of charge-dipole interactions
+
+			for (int local_i = 0; local_i < soa1_mol_charges_num[i]; local_i++)
+			{
+
+				const RealCalcVec q = RealCalcVec::broadcast(soa1_charges_q + i_charge_dipole_idx);
+				const RealCalcVec r1_x = (RealCalcVec::broadcast(soa1_charges_r_x + i_charge_dipole_idx) + shift1_x);
+				const RealCalcVec r1_y = (RealCalcVec::broadcast(soa1_charges_r_y + i_charge_dipole_idx) + shift1_y);
+				const RealCalcVec r1_z = (RealCalcVec::broadcast(soa1_charges_r_z + i_charge_dipole_idx) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				size_t j = ForcePolicy::InitJ2(i_dipole_idx);
+				for (; j < end_dipoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_dipoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec p = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+
+						const RealCalcVec e_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeDipole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, r1_x, r1_y, r1_z, q,
+								m2_r_x, m2_r_y, m2_r_z,	r2_x, r2_y, r2_z, e_x, e_y, e_z, p,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+						// Store torque
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_x, j, M_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_y, j, M_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_z, j, M_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_dipoles_dist_lookup, j, remainderM);
+						const RealCalcVec p = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+
+						const RealCalcVec e_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeDipole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, r1_x, r1_y, r1_z, q,
+								m2_r_x, m2_r_y, m2_r_z,	r2_x, r2_y, r2_z, e_x, e_y, e_z, p,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+						// Store torque
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_x, j, M_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_y, j, M_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_z, j, M_z, lookupORforceMask, remainderM);//newton 3
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_charges_f_x + i_charge_dipole_idx, sum_f1_x);
+				hSum_Add_Store(soa1_charges_f_y + i_charge_dipole_idx, sum_f1_y);
+				hSum_Add_Store(soa1_charges_f_z + i_charge_dipole_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_charges_V_x + i_charge_dipole_idx, sum_V1_x);
+				hSum_Add_Store(soa1_charges_V_y + i_charge_dipole_idx, sum_V1_y);
+				hSum_Add_Store(soa1_charges_V_z + i_charge_dipole_idx, sum_V1_z);
+
+				i_charge_dipole_idx++;
+			}
+
+			// Computation of quadrupole-dipole interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_quadrupoles_num[i]; local_i++) {
+
+				const RealCalcVec m = RealCalcVec::broadcast(soa1_quadrupoles_m + i_quadrupole_dipole_idx);
+				const RealCalcVec e1_x = RealCalcVec::broadcast(soa1_quadrupoles_e_x + i_quadrupole_dipole_idx);
+				const RealCalcVec e1_y = RealCalcVec::broadcast(soa1_quadrupoles_e_y + i_quadrupole_dipole_idx);
+				const RealCalcVec e1_z = RealCalcVec::broadcast(soa1_quadrupoles_e_z + i_quadrupole_dipole_idx);
+				const RealCalcVec r1_x = (RealCalcVec::broadcast(soa1_quadrupoles_r_x + i_quadrupole_dipole_idx) + shift1_x);
+				const RealCalcVec r1_y = (RealCalcVec::broadcast(soa1_quadrupoles_r_y + i_quadrupole_dipole_idx) + shift1_y);
+				const RealCalcVec r1_z = (RealCalcVec::broadcast(soa1_quadrupoles_r_z + i_quadrupole_dipole_idx) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_dipole_idx);
+				for (; j < end_dipoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_dipoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+						const RealCalcVec p = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+						const RealCalcVec e2_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e2_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e2_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipoleQuadrupole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z,	r2_x, r2_y, r2_z, e2_x, e2_y, e2_z, p,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e1_x, e1_y, e1_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M2_x, M2_y, M2_z, M1_x, M1_y, M1_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_x, j, M2_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_y, j, M2_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_dipoles_M_z, j, M2_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_dipoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_dipoles_dist_lookup, j, remainderM);
+						const RealCalcVec p = MaskGatherChooser::load(soa2_dipoles_p, j, lookupORforceMask);
+						const RealCalcVec e2_x = MaskGatherChooser::load(soa2_dipoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e2_y = MaskGatherChooser::load(soa2_dipoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e2_z = MaskGatherChooser::load(soa2_dipoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_dipoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_dipoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_dipoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_dipoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_dipoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_dipoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipoleQuadrupole<CalculateMacroscopic>(
+								m2_r_x, m2_r_y, m2_r_z,	r2_x, r2_y, r2_z, e2_x, e2_y, e2_z, p,
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, e1_x, e1_y, e1_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M2_x, M2_y, M2_z, M1_x, M1_y, M1_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x - a_f_x;
+						sum_f1_y = sum_f1_y - a_f_y;
+						sum_f1_z = sum_f1_z - a_f_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_x, j, M2_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_y, j, M2_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_dipoles_M_z, j, M2_z, lookupORforceMask, remainderM);//newton 3
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_quadrupoles_f_x + i_quadrupole_dipole_idx, sum_f1_x);
+				hSum_Add_Store(soa1_quadrupoles_f_y + i_quadrupole_dipole_idx, sum_f1_y);
+				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_dipole_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_dipole_idx, sum_V1_x);
+				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_dipole_idx, sum_V1_y);
+				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_dipole_idx, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_dipole_idx, sum_M1_x);
+				hSum_Add_Store(soa1_quadrupoles_M_y + i_quadrupole_dipole_idx, sum_M1_y);
+				hSum_Add_Store(soa1_quadrupoles_M_z + i_quadrupole_dipole_idx, sum_M1_z);
+
+				i_quadrupole_dipole_idx++;
+
+			}
+
+			i_dipole_idx += soa1_mol_dipoles_num[i];
+		}
+
+		// Computation of site interactions with quadrupoles
+
+		if (compute_molecule_quadrupoles==0) {
+			i_quadrupole_idx += soa1_mol_quadrupoles_num[i];
+			i_charge_quadrupole_idx += soa1_mol_charges_num[i];
+			i_dipole_quadrupole_idx += soa1_mol_dipoles_num[i];
+		}
+		else {
+			// Computation of quadrupole-quadrupole interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_quadrupoles_num[i]; local_i++)
+			{
+				const RealCalcVec mii = RealCalcVec::broadcast(soa1_quadrupoles_m + i_quadrupole_idx + local_i);
+				const RealCalcVec eii_x = RealCalcVec::broadcast(soa1_quadrupoles_e_x + i_quadrupole_idx + local_i);
+				const RealCalcVec eii_y = RealCalcVec::broadcast(soa1_quadrupoles_e_y + i_quadrupole_idx + local_i);
+				const RealCalcVec eii_z = RealCalcVec::broadcast(soa1_quadrupoles_e_z + i_quadrupole_idx + local_i);
+				const RealCalcVec rii_x = (RealCalcVec::broadcast(soa1_quadrupoles_r_x + i_quadrupole_idx + local_i) + shift1_x);
+				const RealCalcVec rii_y = (RealCalcVec::broadcast(soa1_quadrupoles_r_y + i_quadrupole_idx + local_i) + shift1_y);
+				const RealCalcVec rii_z = (RealCalcVec::broadcast(soa1_quadrupoles_r_z + i_quadrupole_idx + local_i) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_quadrupole_idx + local_i);
+				for (; j < end_quadrupoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_quadrupoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec mjj = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec ejj_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec ejj_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec ejj_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec rjj_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec rjj_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec rjj_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, rii_x, rii_y, rii_z, eii_x, eii_y, eii_z, mii,
+								m2_r_x, m2_r_y, m2_r_z,	rjj_x, rjj_y, rjj_z, ejj_x, ejj_y, ejj_z, mjj,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M1_x, M1_y, M1_z, M2_x, M2_y, M2_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M2_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M2_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M2_z, lookupORforceMask);//newton 3
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_quadrupoles_dist_lookup, j, remainderM);
+						const RealCalcVec mjj = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec ejj_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec ejj_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec ejj_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec rjj_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec rjj_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec rjj_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, rii_x, rii_y, rii_z, eii_x, eii_y, eii_z, mii,
+								m2_r_x, m2_r_y, m2_r_z,	rjj_x, rjj_y, rjj_z, ejj_x, ejj_y, ejj_z, mjj,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M1_x, M1_y, M1_z, M2_x, M2_y, M2_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M2_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M2_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M2_z, lookupORforceMask, remainderM);//newton 3
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_quadrupoles_f_x + i_quadrupole_idx + local_i, sum_f1_x);
+				hSum_Add_Store(soa1_quadrupoles_f_y + i_quadrupole_idx + local_i, sum_f1_y);
+				hSum_Add_Store(soa1_quadrupoles_f_z + i_quadrupole_idx + local_i, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_quadrupoles_V_x + i_quadrupole_idx + local_i, sum_V1_x);
+				hSum_Add_Store(soa1_quadrupoles_V_y + i_quadrupole_idx + local_i, sum_V1_y);
+				hSum_Add_Store(soa1_quadrupoles_V_z + i_quadrupole_idx + local_i, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_quadrupoles_M_x + i_quadrupole_idx + local_i, sum_M1_x);
+				hSum_Add_Store(soa1_quadrupoles_M_y + i_quadrupole_idx + local_i, sum_M1_y);
+				hSum_Add_Store(soa1_quadrupoles_M_z + i_quadrupole_idx + local_i, sum_M1_z);
+
+			}
+
+			// Computation of charge-quadrupole interactions
+
+			for (int local_i = 0; local_i < soa1_mol_charges_num[i]; local_i++)
+			{
+				const RealCalcVec q = RealCalcVec::broadcast(soa1_charges_q + i_charge_quadrupole_idx);
+				const RealCalcVec r1_x = (RealCalcVec::broadcast(soa1_charges_r_x + i_charge_quadrupole_idx) + shift1_x);
+				const RealCalcVec r1_y = (RealCalcVec::broadcast(soa1_charges_r_y + i_charge_quadrupole_idx) + shift1_y);
+				const RealCalcVec r1_z = (RealCalcVec::broadcast(soa1_charges_r_z + i_charge_quadrupole_idx) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				size_t j = ForcePolicy::InitJ2(i_quadrupole_idx);
+				for (; j < end_quadrupoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_quadrupoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec m = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec e_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, q,
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, e_x, e_y, e_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store forces
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+
+						// Store torque
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_quadrupoles_dist_lookup, j, remainderM);
+						const RealCalcVec m = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec e_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec e_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec e_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec r2_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec r2_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec r2_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M_x, M_y, M_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyChargeQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z,	r1_x, r1_y, r1_z, q,
+								m2_r_x, m2_r_y, m2_r_z, r2_x, r2_y, r2_z, e_x, e_y, e_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M_x, M_y, M_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M_z, lookupORforceMask, remainderM);//newton 3
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_charges_f_x + i_charge_quadrupole_idx, sum_f1_x);
+				hSum_Add_Store(soa1_charges_f_y + i_charge_quadrupole_idx, sum_f1_y);
+				hSum_Add_Store(soa1_charges_f_z + i_charge_quadrupole_idx, sum_f1_z);
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_charges_V_x + i_charge_quadrupole_idx, sum_V1_x);
+				hSum_Add_Store(soa1_charges_V_y + i_charge_quadrupole_idx, sum_V1_y);
+				hSum_Add_Store(soa1_charges_V_z + i_charge_quadrupole_idx, sum_V1_z);
+
+				i_charge_quadrupole_idx++;
+			}
+
+			// Computation of dipole-quadrupole interactions
+
+			// Iterate over centers of actual molecule
+			for (int local_i = 0; local_i < soa1_mol_dipoles_num[i]; local_i++)
+			{
+				const RealCalcVec p = RealCalcVec::broadcast(soa1_dipoles_p + i_dipole_quadrupole_idx);
+				const RealCalcVec eii_x = RealCalcVec::broadcast(soa1_dipoles_e_x + i_dipole_quadrupole_idx);
+				const RealCalcVec eii_y = RealCalcVec::broadcast(soa1_dipoles_e_y + i_dipole_quadrupole_idx);
+				const RealCalcVec eii_z = RealCalcVec::broadcast(soa1_dipoles_e_z + i_dipole_quadrupole_idx);
+				const RealCalcVec rii_x = (RealCalcVec::broadcast(soa1_dipoles_r_x + i_dipole_quadrupole_idx) + shift1_x);
+				const RealCalcVec rii_y = (RealCalcVec::broadcast(soa1_dipoles_r_y + i_dipole_quadrupole_idx) + shift1_y);
+				const RealCalcVec rii_z = (RealCalcVec::broadcast(soa1_dipoles_r_z + i_dipole_quadrupole_idx) + shift1_z);
+
+				RealAccumVec sum_f1_x = RealAccumVec::zero();
+				RealAccumVec sum_f1_y = RealAccumVec::zero();
+				RealAccumVec sum_f1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_V1_x = RealAccumVec::zero();
+				RealAccumVec sum_V1_y = RealAccumVec::zero();
+				RealAccumVec sum_V1_z = RealAccumVec::zero();
+
+				RealAccumVec sum_M1_x = RealAccumVec::zero();
+				RealAccumVec sum_M1_y = RealAccumVec::zero();
+				RealAccumVec sum_M1_z = RealAccumVec::zero();
+
+				// Iterate over centers of second cell
+				size_t j = ForcePolicy::InitJ2(i_quadrupole_idx);
+				for (; j < end_quadrupoles_loop; j += VCP_VEC_SIZE) {
+					const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMask(soa2_quadrupoles_dist_lookup, j);
+					// Check if we have to calculate anything for at least one of the pairs
+					if (MaskGatherChooser::computeLoop(lookupORforceMask)) {
+
+						const RealCalcVec m = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec ejj_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec ejj_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec ejj_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec rjj_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec rjj_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec rjj_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipoleQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, rii_x, rii_y, rii_z, eii_x, eii_y, eii_z, p,
+								m2_r_x, m2_r_y, m2_r_z,	rjj_x, rjj_y, rjj_z, ejj_x, ejj_y, ejj_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M1_x, M1_y, M1_z, M2_x, M2_y, M2_z,
+								sum_upotXpoles, sum_virial,
+								MaskGatherChooser::getForceMask(lookupORforceMask));
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask);//newton 3
+						vcp_simd_load_sub_store<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M2_x, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M2_y, lookupORforceMask);//newton 3
+						vcp_simd_load_add_store<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M2_z, lookupORforceMask);//newton 3
+
+					}
+				}
+#if VCP_VEC_TYPE == VCP_VEC_KNL_GATHER or VCP_VEC_TYPE == VCP_VEC_AVX512F_GATHER
+				if(MaskGatherChooser::hasRemainder()){//remainder computations, that's not an if, but a constant branch... compiler is wise.
+			#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+					const __mmask16 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x0000){
+			#else /*VCP_DPDP */
+					const __mmask8 remainderM = MaskGatherChooser::getRemainder(compute_molecule_quadrupoles);
+					if(remainderM != 0x00){
+			#endif
+						const vcp_lookupOrMask_vec lookupORforceMask = MaskGatherChooser::loadLookupOrForceMaskRemainder(soa2_quadrupoles_dist_lookup, j, remainderM);
+						const RealCalcVec m = MaskGatherChooser::load(soa2_quadrupoles_m, j, lookupORforceMask);
+						const RealCalcVec ejj_x = MaskGatherChooser::load(soa2_quadrupoles_e_x, j, lookupORforceMask);
+						const RealCalcVec ejj_y = MaskGatherChooser::load(soa2_quadrupoles_e_y, j, lookupORforceMask);
+						const RealCalcVec ejj_z = MaskGatherChooser::load(soa2_quadrupoles_e_z, j, lookupORforceMask);
+						const RealCalcVec rjj_x = MaskGatherChooser::load(soa2_quadrupoles_r_x, j, lookupORforceMask);
+						const RealCalcVec rjj_y = MaskGatherChooser::load(soa2_quadrupoles_r_y, j, lookupORforceMask);
+						const RealCalcVec rjj_z = MaskGatherChooser::load(soa2_quadrupoles_r_z, j, lookupORforceMask);
+
+						const RealCalcVec m2_r_x = MaskGatherChooser::load(soa2_quadrupoles_m_r_x, j, lookupORforceMask);
+						const RealCalcVec m2_r_y = MaskGatherChooser::load(soa2_quadrupoles_m_r_y, j, lookupORforceMask);
+						const RealCalcVec m2_r_z = MaskGatherChooser::load(soa2_quadrupoles_m_r_z, j, lookupORforceMask);
+
+						RealCalcVec f_x, f_y, f_z;
+						RealAccumVec M1_x, M1_y, M1_z, M2_x, M2_y, M2_z;
+						RealAccumVec Vx, Vy, Vz;
+
+						_loopBodyDipoleQuadrupole<CalculateMacroscopic>(
+								m1_r_x, m1_r_y, m1_r_z, rii_x, rii_y, rii_z, eii_x, eii_y, eii_z, p,
+								m2_r_x, m2_r_y, m2_r_z,	rjj_x, rjj_y, rjj_z, ejj_x, ejj_y, ejj_z, m,
+								f_x, f_y, f_z,
+								Vx, Vy, Vz,
+								M1_x, M1_y, M1_z, M2_x, M2_y, M2_z,
+								sum_upotXpoles, sum_virial,
+								remainderM);
+
+						RealAccumVec a_f_x = RealAccumVec::convertCalcToAccum(f_x);
+						RealAccumVec a_f_y = RealAccumVec::convertCalcToAccum(f_y);
+						RealAccumVec a_f_z = RealAccumVec::convertCalcToAccum(f_z);
+
+						sum_f1_x = sum_f1_x + a_f_x;
+						sum_f1_y = sum_f1_y + a_f_y;
+						sum_f1_z = sum_f1_z + a_f_z;
+
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_x, j, a_f_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_y, j, a_f_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_sub_store_masked<MaskGatherChooser>(soa2_quadrupoles_f_z, j, a_f_z, lookupORforceMask, remainderM);//newton 3
+
+						// Store virials
+
+						sum_V1_x = sum_V1_x + Vx;
+						sum_V1_y = sum_V1_y + Vy;
+						sum_V1_z = sum_V1_z + Vz;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_x, j, Vx, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_y, j, Vy, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_V_z, j, Vz, lookupORforceMask, remainderM);//newton 3
+
+
+						// Store torque
+
+						sum_M1_x = sum_M1_x + M1_x;
+						sum_M1_y = sum_M1_y + M1_y;
+						sum_M1_z = sum_M1_z + M1_z;
+
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_x, j, M2_x, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_y, j, M2_y, lookupORforceMask, remainderM);//newton 3
+						vcp_simd_load_add_store_masked<MaskGatherChooser>(soa2_quadrupoles_M_z, j, M2_z, lookupORforceMask, remainderM);//newton 3
+
+					}
+				}
+#endif
+				// Add old force and summed calculated forces for center 1
+				hSum_Add_Store(soa1_dipoles_f_x + i_dipole_quadrupole_idx, sum_f1_x);
+				hSum_Add_Store(soa1_dipoles_f_y + i_dipole_quadrupole_idx, sum_f1_y);
+				hSum_Add_Store(soa1_dipoles_f_z + i_dipole_quadrupole_idx, sum_f1_z);
+
+				// Add old virials and summed calculated virials for center 1
+				hSum_Add_Store(soa1_dipoles_V_x + i_dipole_quadrupole_idx, sum_V1_x);
+				hSum_Add_Store(soa1_dipoles_V_y + i_dipole_quadrupole_idx, sum_V1_y);
+				hSum_Add_Store(soa1_dipoles_V_z + i_dipole_quadrupole_idx, sum_V1_z);
+
+				// Add old torques and summed calculated torques for center 1
+				hSum_Add_Store(soa1_dipoles_M_x + i_dipole_quadrupole_idx, sum_M1_x);
+				hSum_Add_Store(soa1_dipoles_M_y + i_dipole_quadrupole_idx, sum_M1_y);
+				hSum_Add_Store(soa1_dipoles_M_z + i_dipole_quadrupole_idx, sum_M1_z);
+
+				i_dipole_quadrupole_idx++;
+
+			}
+
+			i_quadrupole_idx += soa1_mol_quadrupoles_num[i];
+		}
+	}
+
+	sum_upot6lj.aligned_load_add_store(&my_threadData._upot6ljV[0]);
+	sum_upotXpoles.aligned_load_add_store(&my_threadData._upotXpolesV[0]);
+	sum_virial.aligned_load_add_store(&my_threadData._virialV[0]);
+	const RealAccumVec negative_sum_myRF = RealAccumVec::zero() - sum_myRF;
+	negative_sum_myRF.aligned_load_add_store(&my_threadData._myRFV[0]);
+
+} // void LennardJonesCellHandler::CalculatePairs_(LJSoA & soa1, LJSoA & soa2)
+
+template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
+void VectorizedCellProcessorKernel::_calculatePairs1CLJ(CellDataSoA & soa1, CellDataSoA & soa2) {
+	// the positions of soa1 in the frame of those of soa2 (see CellDataSoA::_origin)
+	const RealCalcVec shift1_x = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[0] - soa2._origin[0]));
+	const RealCalcVec shift1_y = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[1] - soa2._origin[1]));
+	const RealCalcVec shift1_z = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[2] - soa2._origin[2]));
+
+	const int tid = mardyn_get_thread_num();
+	VLJCPThreadData &my_threadData = *_threadData[tid];
+
+	//for better readability:
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	// Pointer for LJ centers
+	const vcp_real_calc * const soa1_ljc_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa1_ljc_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa1_ljc_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa1_ljc_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa1_ljc_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa1_ljc_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa1_ljc_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa1_ljc_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa1_ljc_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t * const soa1_ljc_id = soa1._ljc_id;
+
+	const vcp_real_calc * const soa2_ljc_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa2_ljc_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa2_ljc_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t * const soa2_ljc_id = soa2._ljc_id;
+
+	RealAccumVec sum_upot6lj = RealAccumVec::zero();
+	RealAccumVec sum_upotXpoles = RealAccumVec::zero();
+	RealAccumVec sum_virial = RealAccumVec::zero();
+
+	const RealCalcVec ljrc2 = RealCalcVec::set1(static_cast<vcp_real_calc>(_vcp.getLJCutoffRadiusSquare()));
+
+	/*
+	 * The loop runs over whole vectors up to end_ljc_j_longloop, as the arrays are padded with zeros
+	 * (see _calculatePairs). The padding of the last vector is masked out by the remainder mask.
+	 */
+	const size_t end_ljc_j = vcp_floor_to_vec_size(soa2._ljc_num);
+	const size_t end_ljc_j_longloop = vcp_ceil_to_vec_size(soa2._ljc_num);
+	const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(soa2._ljc_num);
+
+	const size_t soa1_ljc_num = soa1._ljc_num;
+	for (size_t i = 0; i < soa1_ljc_num; ++i) {
+		RealAccumVec sum_fx1 = RealAccumVec::zero();
+		RealAccumVec sum_fy1 = RealAccumVec::zero();
+		RealAccumVec sum_fz1 = RealAccumVec::zero();
+
+		RealAccumVec sum_Vx1 = RealAccumVec::zero();
+		RealAccumVec sum_Vy1 = RealAccumVec::zero();
+		RealAccumVec sum_Vz1 = RealAccumVec::zero();
+
+		const RealCalcVec c_r_x1 = (RealCalcVec::broadcast(soa1_ljc_r_x + i) + shift1_x);
+		const RealCalcVec c_r_y1 = (RealCalcVec::broadcast(soa1_ljc_r_y + i) + shift1_y);
+		const RealCalcVec c_r_z1 = (RealCalcVec::broadcast(soa1_ljc_r_z + i) + shift1_z);
+		const vcp_ljc_id_t id_i = soa1_ljc_id[i];
+
+		size_t j = ForcePolicy::InitJ(i);
+		MaskCalcVec initJ_mask = ForcePolicy::InitJ_Mask(i);
+		for (; j < end_ljc_j_longloop; j += VCP_VEC_SIZE) {
+			const RealCalcVec c_r_x2 = RealCalcVec::aligned_load(soa2_ljc_r_x + j);
+			const RealCalcVec c_r_y2 = RealCalcVec::aligned_load(soa2_ljc_r_y + j);
+			const RealCalcVec c_r_z2 = RealCalcVec::aligned_load(soa2_ljc_r_z + j);
+
+			const RealCalcVec c_dx = c_r_x1 - c_r_x2;
+			const RealCalcVec c_dy = c_r_y1 - c_r_y2;
+			const RealCalcVec c_dz = c_r_z1 - c_r_z2;
+			const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+			MaskCalcVec forceMask = ForcePolicy::GetForceMask(c_r2, ljrc2, initJ_mask);
+			if (j == end_ljc_j) {
+				forceMask = forceMask and remainderMask;
+			}
+
+			if (MaskGatherChooser::computeLoop(forceMask)) {
+				RealCalcVec eps_24, sig2, shift6;
+				RealCalcVec fshift = RealCalcVec::zero(), rs2 = RealCalcVec::zero(), rc2 = RealCalcVec::zero(), invD = RealCalcVec::zero();
+				_unpackLJ<MaskGatherChooser>(eps_24, sig2, shift6, fshift, rs2, rc2, invD, id_i, soa2_ljc_id, j, forceMask);
+
+				if (not _ljcRc2.empty()) {
+					// component dependent cutoff: no contribution of the pairs beyond their cutoff radius
+					RealCalcVec ljcRc2;
+					unpackShift6<MaskGatherChooser>(ljcRc2, _ljcRc2[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, forceMask);
+					if (_ljcQQ.empty()) {
+						forceMask = forceMask and c_r2 < ljcRc2;
+					} else {
+						// the charges at the LJ centers interact up to the cutoff radius
+						const MaskCalcVec inside = c_r2 < ljcRc2;
+						eps_24 = RealCalcVec::apply_mask(eps_24, inside);
+						shift6 = RealCalcVec::apply_mask(shift6, inside);
+						fshift = RealCalcVec::apply_mask(fshift, inside);
+					}
+				}
+
+				RealCalcVec fx, fy, fz;
+				RealAccumVec Vx, Vy, Vz;
+				if (_ljFShiftRs2.empty()) {
+					_loopBodyLJ<CalculateMacroscopic, false>(
+						c_r_x1, c_r_y1, c_r_z1, c_r_x1, c_r_y1, c_r_z1,
+						c_r_x2, c_r_y2, c_r_z2, c_r_x2, c_r_y2, c_r_z2,
+						fx, fy, fz,
+						Vx, Vy, Vz,
+						sum_upot6lj, sum_virial,
+						forceMask,
+						eps_24, sig2,
+						shift6,
+						fshift, rs2, rc2, invD);
+				} else {
+					_loopBodyLJ<CalculateMacroscopic, true>(
+						c_r_x1, c_r_y1, c_r_z1, c_r_x1, c_r_y1, c_r_z1,
+						c_r_x2, c_r_y2, c_r_z2, c_r_x2, c_r_y2, c_r_z2,
+						fx, fy, fz,
+						Vx, Vy, Vz,
+						sum_upot6lj, sum_virial,
+						forceMask,
+						eps_24, sig2,
+						shift6,
+						fshift, rs2, rc2, invD);
+				}
+
+				if (not _ljcTab.empty() and not _ljcTab[id_i].empty()) {
+					_loopBodyTabulated<CalculateMacroscopic>(
+						c_r_x1, c_r_y1, c_r_z1, c_r_x1, c_r_y1, c_r_z1,
+						c_r_x2, c_r_y2, c_r_z2, c_r_x2, c_r_y2, c_r_z2,
+						fx, fy, fz,
+						Vx, Vy, Vz,
+						sum_upot6lj, sum_virial,
+						forceMask,
+						_ljcTab[id_i], soa2_ljc_id + j);
+				}
+
+				if (not _ljcQQ.empty()) {
+					RealCalcVec qq;
+					unpackShift6<MaskGatherChooser>(qq, _ljcQQ[id_i], soa2_ljc_id, (vcp_ljc_id_t)j, forceMask);
+					_loopBodyLJCharge<CalculateMacroscopic>(
+						c_r_x1, c_r_y1, c_r_z1, c_r_x1, c_r_y1, c_r_z1,
+						c_r_x2, c_r_y2, c_r_z2, c_r_x2, c_r_y2, c_r_z2,
+						fx, fy, fz,
+						Vx, Vy, Vz,
+						sum_upotXpoles, sum_virial,
+						forceMask,
+						qq);
+				}
+
+				RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
+				RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
+				RealAccumVec a_fz = RealAccumVec::convertCalcToAccum(fz);
+
+				vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_x, j, a_fx, forceMask);
+				vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_y, j, a_fy, forceMask);
+				vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_z, j, a_fz, forceMask);
+
+				sum_fx1 = sum_fx1 + a_fx;
+				sum_fy1 = sum_fy1 + a_fy;
+				sum_fz1 = sum_fz1 + a_fz;
+
+				vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_x, j, Vx, forceMask);
+				vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_y, j, Vy, forceMask);
+				vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_z, j, Vz, forceMask);
+
+				sum_Vx1 = sum_Vx1 + Vx;
+				sum_Vy1 = sum_Vy1 + Vy;
+				sum_Vz1 = sum_Vz1 + Vz;
+			}
+		}
+
+		hSum_Add_Store(soa1_ljc_f_x + i, sum_fx1);
+		hSum_Add_Store(soa1_ljc_f_y + i, sum_fy1);
+		hSum_Add_Store(soa1_ljc_f_z + i, sum_fz1);
+
+		hSum_Add_Store(soa1_ljc_V_x + i, sum_Vx1);
+		hSum_Add_Store(soa1_ljc_V_y + i, sum_Vy1);
+		hSum_Add_Store(soa1_ljc_V_z + i, sum_Vz1);
+	}
+
+	sum_upot6lj.aligned_load_add_store(&my_threadData._upot6ljV[0]);
+	sum_upotXpoles.aligned_load_add_store(&my_threadData._upotXpolesV[0]);
+	sum_virial.aligned_load_add_store(&my_threadData._virialV[0]);
+}
+
+#if VCP_VEC_TYPE == VCP_VEC_KNL or VCP_VEC_TYPE == VCP_VEC_AVX512F
+template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
+void VectorizedCellProcessorKernel::_calculatePairs1CLJPacked(CellDataSoA & soa1, CellDataSoA & soa2) {
+	// the positions of soa1 in the frame of those of soa2 (see CellDataSoA::_origin)
+	const RealCalcVec shift1_x = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[0] - soa2._origin[0]));
+	const RealCalcVec shift1_y = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[1] - soa2._origin[1]));
+	const RealCalcVec shift1_z = RealCalcVec::set1(static_cast<vcp_real_calc>(soa1._origin[2] - soa2._origin[2]));
+
+	const int tid = mardyn_get_thread_num();
+	VLJCPThreadData &my_threadData = *_threadData[tid];
+
+	//for better readability:
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	// Pointer for LJ centers
+	const vcp_real_calc * const soa1_ljc_r_x = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa1_ljc_r_y = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa1_ljc_r_z = soa1.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa1_ljc_f_x = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa1_ljc_f_y = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa1_ljc_f_z = soa1.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa1_ljc_V_x = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa1_ljc_V_y = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa1_ljc_V_z = soa1.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t * const soa1_ljc_id = soa1._ljc_id;
+
+	const vcp_real_calc * const soa2_ljc_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
+	const vcp_real_calc * const soa2_ljc_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
+	const vcp_real_calc * const soa2_ljc_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+	const vcp_ljc_id_t * const soa2_ljc_id = soa2._ljc_id;
+
+	const size_t end_ljc_j = vcp_floor_to_vec_size(soa2._ljc_num);
+	const size_t end_ljc_j_longloop = vcp_ceil_to_vec_size(soa2._ljc_num);
+	const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(soa2._ljc_num);
+
+	// the buffers hold all centers of soa2 and one vector of padding (see vcp_simd_compress_store)
+	const size_t packed_size = end_ljc_j_longloop + VCP_VEC_SIZE;
+
+	my_threadData._packed_r_x.resize_zero_shrink(packed_size);
+	my_threadData._packed_r_y.resize_zero_shrink(packed_size);
+	my_threadData._packed_r_z.resize_zero_shrink(packed_size);
+	my_threadData._packed_id.resize_zero_shrink(packed_size);
+	my_threadData._packed_f_x.resize_zero_shrink(packed_size);
+	my_threadData._packed_f_y.resize_zero_shrink(packed_size);
+	my_threadData._packed_f_z.resize_zero_shrink(packed_size);
+	my_threadData._packed_V_x.resize_zero_shrink(packed_size);
+	my_threadData._packed_V_y.resize_zero_shrink(packed_size);
+	my_threadData._packed_V_z.resize_zero_shrink(packed_size);
+	my_threadData._packed_masks.resize_zero_shrink(end_ljc_j_longloop / VCP_VEC_SIZE);
+
+	vcp_real_calc * const packed_r_x = my_threadData._packed_r_x;
+	vcp_real_calc * const packed_r_y = my_threadData._packed_r_y;
+	vcp_real_calc * const packed_r_z = my_threadData._packed_r_z;
+	vcp_ljc_id_t * const packed_id = my_threadData._packed_id;
+	vcp_real_accum * const packed_f_x = my_threadData._packed_f_x;
+	vcp_real_accum * const packed_f_y = my_threadData._packed_f_y;
+	vcp_real_accum * const packed_f_z = my_threadData._packed_f_z;
+	vcp_real_accum * const packed_V_x = my_threadData._packed_V_x;
+	vcp_real_accum * const packed_V_y = my_threadData._packed_V_y;
+	vcp_real_accum * const packed_V_z = my_threadData._packed_V_z;
+	vcp_mask_single * const packed_masks = my_threadData._packed_masks;
+
+	RealAccumVec sum_upot6lj = RealAccumVec::zero();
+	RealAccumVec sum_upotXpoles = RealAccumVec::zero();
+	RealAccumVec sum_virial = RealAccumVec::zero();
+
+	const RealCalcVec ljrc2 = RealCalcVec::set1(static_cast<vcp_real_calc>(_vcp.getLJCutoffRadiusSquare()));
+
+	const size_t soa1_ljc_num = soa1._ljc_num;
+	for (size_t i = 0; i < soa1_ljc_num; ++i) {
+		const RealCalcVec c_r_x1 = (RealCalcVec::broadcast(soa1_ljc_r_x + i) + shift1_x);
+		const RealCalcVec c_r_y1 = (RealCalcVec::broadcast(soa1_ljc_r_y + i) + shift1_y);
+		const RealCalcVec c_r_z1 = (RealCalcVec::broadcast(soa1_ljc_r_z + i) + shift1_z);
+		const vcp_ljc_id_t id_i = soa1_ljc_id[i];
+
+		// 1. pack the centers within the cutoff radius
+		size_t numPacked = 0;
+		size_t j = ForcePolicy::InitJ(i);
+		MaskCalcVec initJ_mask = ForcePolicy::InitJ_Mask(i);
+		for (; j < end_ljc_j_longloop; j += VCP_VEC_SIZE) {
+			const RealCalcVec c_r_x2 = RealCalcVec::aligned_load(soa2_ljc_r_x + j);
+			const RealCalcVec c_r_y2 = RealCalcVec::aligned_load(soa2_ljc_r_y + j);
+			const RealCalcVec c_r_z2 = RealCalcVec::aligned_load(soa2_ljc_r_z + j);
+
+			const RealCalcVec c_dx = c_r_x1 - c_r_x2;
+			const RealCalcVec c_dy = c_r_y1 - c_r_y2;
+			const RealCalcVec c_dz = c_r_z1 - c_r_z2;
+			const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+
+			MaskCalcVec forceMask = ForcePolicy::GetForceMask(c_r2, ljrc2, initJ_mask);
+			if (j == end_ljc_j) {
+				forceMask = forceMask and remainderMask;
+			}
+			forceMask.aligned_store(packed_masks + j / VCP_VEC_SIZE);
+
+			vcp_simd_compress_store(packed_r_x + numPacked, c_r_x2, forceMask);
+			vcp_simd_compress_store(packed_r_y + numPacked, c_r_y2, forceMask);
+			vcp_simd_compress_store(packed_r_z + numPacked, c_r_z2, forceMask);
+			vcp_simd_compress_store(packed_id + numPacked, soa2_ljc_id + j, forceMask);
+			numPacked += forceMask.countUnmasked();
+		}
+
+		if (numPacked == 0) {
+			continue;
+		}
+
+		// 2. evaluate the potential on the packed centers
+		RealAccumVec sum_fx1 = RealAccumVec::zero();
+		RealAccumVec sum_fy1 = RealAccumVec::zero();
+		RealAccumVec sum_fz1 = RealAccumVec::zero();
+
+		RealAccumVec sum_Vx1 = RealAccumVec::zero();
+		RealAccumVec sum_Vy1 = RealAccumVec::zero();
+		RealAccumVec sum_Vz1 = RealAccumVec::zero();
+
+		const size_t end_packed = vcp_ceil_to_vec_size(numPacked);
+		for (size_t k = 0; k < end_packed; k += VCP_VEC_SIZE) {
+			const RealCalcVec c_r_x2 = RealCalcVec::aligned_load(packed_r_x + k);
+			const RealCalcVec c_r_y2 = RealCalcVec::aligned_load(packed_r_y + k);
+			const RealCalcVec c_r_z2 = RealCalcVec::aligned_load(packed_r_z + k);
+
+			// only the last vector is partially filled
+			MaskCalcVec forceMask = k + VCP_VEC_SIZE <= numPacked ? MaskCalcVec::ones() : vcp_simd_getRemainderMask(numPacked);
+
+			RealCalcVec eps_24, sig2, shift6;
+			RealCalcVec fshift = RealCalcVec::zero(), rs2 = RealCalcVec::zero(), rc2 = RealCalcVec::zero(), invD = RealCalcVec::zero();
+			_unpackLJ<MaskGatherChooser>(eps_24, sig2, shift6, fshift, rs2, rc2, invD, id_i, packed_id, k, forceMask);
+
+			if (not _ljcRc2.empty()) {
+				// component dependent cutoff: no contribution of the pairs beyond their cutoff radius
+				const RealCalcVec c_dx = c_r_x1 - c_r_x2;
+				const RealCalcVec c_dy = c_r_y1 - c_r_y2;
+				const RealCalcVec c_dz = c_r_z1 - c_r_z2;
+				const RealCalcVec c_r2 = RealCalcVec::scal_prod(c_dx, c_dy, c_dz, c_dx, c_dy, c_dz);
+				RealCalcVec ljcRc2;
+				unpackShift6<MaskGatherChooser>(ljcRc2, _ljcRc2[id_i], packed_id, (vcp_ljc_id_t)k, forceMask);
+				if (_ljcQQ.empty()) {
+					forceMask = forceMask and c_r2 < ljcRc2;
+				} else {
+					// the charges at the LJ centers interact up to the cutoff radius
+					const MaskCalcVec inside = c_r2 < ljcRc2;
+					eps_24 = RealCalcVec::apply_mask(eps_24, inside);
+					shift6 = RealCalcVec::apply_mask(shift6, inside);
+					fshift = RealCalcVec::apply_mask(fshift, inside);
+				}
+			}
+
+			RealCalcVec fx, fy, fz;
+			RealAccumVec Vx, Vy, Vz;
+			if (_ljFShiftRs2.empty()) {
+				_loopBodyLJ<CalculateMacroscopic, false>(
+					c_r_x1, c_r_y1, c_r_z1, c_r_x1, c_r_y1, c_r_z1,
+					c_r_x2, c_r_y2, c_r_z2, c_r_x2, c_r_y2, c_r_z2,
+					fx, fy, fz,
+					Vx, Vy, Vz,
+					sum_upot6lj, sum_virial,
+					forceMask,
+					eps_24, sig2,
+					shift6,
+					fshift, rs2, rc2, invD);
+			} else {
+				_loopBodyLJ<CalculateMacroscopic, true>(
+					c_r_x1, c_r_y1, c_r_z1, c_r_x1, c_r_y1, c_r_z1,
+					c_r_x2, c_r_y2, c_r_z2, c_r_x2, c_r_y2, c_r_z2,
+					fx, fy, fz,
+					Vx, Vy, Vz,
+					sum_upot6lj, sum_virial,
+					forceMask,
+					eps_24, sig2,
+					shift6,
+					fshift, rs2, rc2, invD);
+			}
+
+			if (not _ljcTab.empty() and not _ljcTab[id_i].empty()) {
+				_loopBodyTabulated<CalculateMacroscopic>(
+					c_r_x1, c_r_y1, c_r_z1, c_r_x1, c_r_y1, c_r_z1,
+					c_r_x2, c_r_y2, c_r_z2, c_r_x2, c_r_y2, c_r_z2,
+					fx, fy, fz,
+					Vx, Vy, Vz,
+					sum_upot6lj, sum_virial,
+					forceMask,
+					_ljcTab[id_i], packed_id + k);
+			}
+
+			if (not _ljcQQ.empty()) {
+				RealCalcVec qq;
+				unpackShift6<MaskGatherChooser>(qq, _ljcQQ[id_i], packed_id, (vcp_ljc_id_t)k, forceMask);
+				_loopBodyLJCharge<CalculateMacroscopic>(
+					c_r_x1, c_r_y1, c_r_z1, c_r_x1, c_r_y1, c_r_z1,
+					c_r_x2, c_r_y2, c_r_z2, c_r_x2, c_r_y2, c_r_z2,
+					fx, fy, fz,
+					Vx, Vy, Vz,
+					sum_upotXpoles, sum_virial,
+					forceMask,
+					qq);
+			}
+
+			RealAccumVec a_fx = RealAccumVec::convertCalcToAccum(fx);
+			RealAccumVec a_fy = RealAccumVec::convertCalcToAccum(fy);
+			RealAccumVec a_fz = RealAccumVec::convertCalcToAccum(fz);
+
+			a_fx.aligned_store(packed_f_x + k);
+			a_fy.aligned_store(packed_f_y + k);
+			a_fz.aligned_store(packed_f_z + k);
+
+			sum_fx1 = sum_fx1 + a_fx;
+			sum_fy1 = sum_fy1 + a_fy;
+			sum_fz1 = sum_fz1 + a_fz;
+
+			Vx.aligned_store(packed_V_x + k);
+			Vy.aligned_store(packed_V_y + k);
+			Vz.aligned_store(packed_V_z + k);
+
+			sum_Vx1 = sum_Vx1 + Vx;
+			sum_Vy1 = sum_Vy1 + Vy;
+			sum_Vz1 = sum_Vz1 + Vz;
+		}
+
+		hSum_Add_Store(soa1_ljc_f_x + i, sum_fx1);
+		hSum_Add_Store(soa1_ljc_f_y + i, sum_fy1);
+		hSum_Add_Store(soa1_ljc_f_z + i, sum_fz1);
+
+		hSum_Add_Store(soa1_ljc_V_x + i, sum_Vx1);
+		hSum_Add_Store(soa1_ljc_V_y + i, sum_Vy1);
+		hSum_Add_Store(soa1_ljc_V_z + i, sum_Vz1);
+
+		// 3. expand the forces and virials back to the centers of soa2
+		size_t offset = 0;
+		for (j = ForcePolicy::InitJ(i); j < end_ljc_j_longloop; j += VCP_VEC_SIZE) {
+			const MaskCalcVec forceMask = MaskCalcVec::aligned_load(packed_masks + j / VCP_VEC_SIZE);
+			if (not forceMask.movemask()) {
+				continue;
+			}
+			vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_x, j, vcp_simd_expand_load(packed_f_x + offset, forceMask), forceMask);
+			vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_y, j, vcp_simd_expand_load(packed_f_y + offset, forceMask), forceMask);
+			vcp_simd_load_sub_store<MaskGatherChooser>(soa2_ljc_f_z, j, vcp_simd_expand_load(packed_f_z + offset, forceMask), forceMask);
+
+			vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_x, j, vcp_simd_expand_load(packed_V_x + offset, forceMask), forceMask);
+			vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_y, j, vcp_simd_expand_load(packed_V_y + offset, forceMask), forceMask);
+			vcp_simd_load_add_store<MaskGatherChooser>(soa2_ljc_V_z, j, vcp_simd_expand_load(packed_V_z + offset, forceMask), forceMask);
+			offset += forceMask.countUnmasked();
+		}
+	}
+
+	sum_upot6lj.aligned_load_add_store(&my_threadData._upot6ljV[0]);
+	sum_upotXpoles.aligned_load_add_store(&my_threadData._upotXpolesV[0]);
+	sum_virial.aligned_load_add_store(&my_threadData._virialV[0]);
+}
+#endif
+
+} /* namespace VCP_NAMESPACE */
+
+#endif /* VECTORIZEDCELLPROCESSORKERNEL_H_ */
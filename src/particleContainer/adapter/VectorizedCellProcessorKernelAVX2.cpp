@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief VectorizedCellProcessorKernelAVX2.cpp
+ * \details Force kernel for AVX2 and FMA, if it is selected at run time (see VCP_DISPATCH in VectorizedCellProcessor.h).
+ */
+
+#include "VectorizedCellProcessor.h"
+
+#ifdef VCP_DISPATCH_AVX2
+
+/*
+ * Everything, which is shared with the code for the instruction set of the build, has to be included
+ * before the target options are changed. Otherwise, the linker could pick the AVX2 version of an
+ * inline function for the whole program.
+ */
+#include "CellDataSoA.h"
+#include "utils/AlignedArray.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include <cmath>
+#include <fstream>
+#include <immintrin.h>
+
+#ifdef SIMD_TYPES_H
+	#error "SIMD_TYPES.h must be included only after the target options are set."
+#endif
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+#define VCP_DISPATCH_VEC_TYPE VCP_VEC_AVX2
+#define VCP_NAMESPACE vcp_avx2
+#include "VectorizedCellProcessorKernel.h"
+
+VectorizedCellProcessor::Kernel* VectorizedCellProcessor::createKernelAVX2(const VectorizedCellProcessor& vcp) {
+	return new vcp_avx2::VectorizedCellProcessorKernel(vcp);
+}
+
+#pragma GCC pop_options
+
+#endif /* VCP_DISPATCH_AVX2 */
@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief VectorizedCellProcessorKernelAVX512F.cpp
+ * \details Force kernel for AVX-512 (F, CD, BW, DQ, VL), if it is selected at run time (see VCP_DISPATCH in VectorizedCellProcessor.h).
+ */
+
+#include "VectorizedCellProcessor.h"
+
+#ifdef VCP_DISPATCH_AVX512F
+
+/*
+ * Everything, which is shared with the code for the instruction set of the build, has to be included
+ * before the target options are changed. Otherwise, the linker could pick the AVX512F version of an
+ * inline function for the whole program.
+ */
+#include "CellDataSoA.h"
+#include "utils/AlignedArray.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include <cmath>
+#include <fstream>
+#include <immintrin.h>
+
+#ifdef SIMD_TYPES_H
+	#error "SIMD_TYPES.h must be included only after the target options are set."
+#endif
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")
+
+#define VCP_DISPATCH_VEC_TYPE VCP_VEC_AVX512F
+#define VCP_NAMESPACE vcp_avx512f
+#include "VectorizedCellProcessorKernel.h"
+
+VectorizedCellProcessor::Kernel* VectorizedCellProcessor::createKernelAVX512F(const VectorizedCellProcessor& vcp) {
+	return new vcp_avx512f::VectorizedCellProcessorKernel(vcp);
+}
+
+#pragma GCC pop_options
+
+#endif /* VCP_DISPATCH_AVX512F */
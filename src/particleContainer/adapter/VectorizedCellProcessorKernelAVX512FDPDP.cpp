@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \brief VectorizedCellProcessorKernelAVX512FDPDP.cpp
+ * \details Force kernel for AVX-512 (F, CD, BW, DQ, VL) in the precision DPDP, if both are selected at run time
+ * (see VCP_DISPATCH in VectorizedCellProcessor.h and VectorizedCellProcessor::Kernel).
+ */
+
+#include "VectorizedCellProcessor.h"
+
+#if defined(VCP_DISPATCH_AVX512F) and VCP_PREC != VCP_DPDP
+
+/*
+ * Everything, which is shared with the code for the instruction set and the precision of the build, has to be
+ * included before the target options and the precision are changed
+ * (see VectorizedCellProcessorKernelAVX512F.cpp and VectorizedCellProcessorKernelDPDP.cpp).
+ */
+#include "CellDataSoA.h"
+#include "utils/AlignedArray.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include <cmath>
+#include <fstream>
+#include <immintrin.h>
+
+#ifdef SIMD_TYPES_H
+	#error "SIMD_TYPES.h must be included only after the target options and the precision are set."
+#endif
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512cd,avx512bw,avx512dq,avx512vl")
+
+#define VCP_DISPATCH_VEC_TYPE VCP_VEC_AVX512F
+#define VCP_DISPATCH_PREC VCP_DPDP
+#define VCP_NAMESPACE vcp_avx512f_dpdp
+#include "VectorizedCellProcessorKernel.h"
+
+VectorizedCellProcessor::Kernel* VectorizedCellProcessor::createKernelAVX512FDPDP(const VectorizedCellProcessor& vcp) {
+	return new vcp_avx512f_dpdp::VectorizedCellProcessorKernel(vcp);
+}
+
+#pragma GCC pop_options
+
+#endif /* defined(VCP_DISPATCH_AVX512F) and VCP_PREC != VCP_DPDP */
@@ -0,0 +1,34 @@
+/**
+ * \file
+ * \brief VectorizedCellProcessorKernelSPDP.cpp
+ * \details Force kernel for the precision SPDP, if it differs from the one of the build (see VectorizedCellProcessor::Kernel).
+ */
+
+#include "VectorizedCellProcessor.h"
+
+#if VCP_PREC != VCP_SPDP
+
+/*
+ * Everything, which is shared with the code for the precision of the build, has to be included
+ * before the precision is changed (see VCP_DISPATCH_PREC in SIMD_TYPES.h).
+ */
+#include "CellDataSoA.h"
+#include "utils/AlignedArray.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include <cmath>
+#include <fstream>
+
+#ifdef SIMD_TYPES_H
+	#error "SIMD_TYPES.h must be included only after the precision is set."
+#endif
+
+#define VCP_DISPATCH_PREC VCP_SPDP
+#define VCP_NAMESPACE vcp_spdp
+#include "VectorizedCellProcessorKernel.h"
+
+VectorizedCellProcessor::Kernel* VectorizedCellProcessor::createKernelSPDP(const VectorizedCellProcessor& vcp) {
+	return new vcp_spdp::VectorizedCellProcessorKernel(vcp);
+}
+
+#endif /* VCP_PREC != VCP_SPDP */
@@ -0,0 +1,261 @@
+/**
+ * \file
+ * \brief VectorizedMoleculeUpdate.cpp
+ */
+
+#include "VectorizedMoleculeUpdate.h"
+#include "CellDataSoA.h"
+#include "molecules/Component.h"
+#include "molecules/Molecule.h"
+#include "particleContainer/FullParticleCell.h"
+#include "utils/mardyn_assert.h"
+#include "vectorization/SIMD_VectorizedCellProcessorHelpers.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+typedef RealVec<double> DoubleVec;
+
+//! \brief Number of molecules, which upd_postF() handles at once.
+constexpr size_t VCP_DOUBLE_VEC_SIZE = sizeof(DoubleVec) / sizeof(double);
+
+static_assert(CACHE_LINE_SIZE % sizeof(DoubleVec) == 0, "the molecule arrays have to be padded to whole vectors");
+
+//! \brief Torque d x f of VCP_VEC_SIZE sites with arm d = r - m_r.
+vcp_inline
+void storeSiteTorque(const RealCalcVec& r_x, const RealCalcVec& r_y, const RealCalcVec& r_z,
+		const RealCalcVec& m_r_x, const RealCalcVec& m_r_y, const RealCalcVec& m_r_z,
+		const RealAccumVec& f_x, const RealAccumVec& f_y, const RealAccumVec& f_z,
+		vcp_real_accum* const M_x, vcp_real_accum* const M_y, vcp_real_accum* const M_z) {
+	const RealAccumVec d_x = RealAccumVec::convertCalcToAccum(r_x - m_r_x);
+	const RealAccumVec d_y = RealAccumVec::convertCalcToAccum(r_y - m_r_y);
+	const RealAccumVec d_z = RealAccumVec::convertCalcToAccum(r_z - m_r_z);
+
+	(d_y * f_z - d_z * f_y).aligned_store(M_x);
+	(d_z * f_x - d_x * f_z).aligned_store(M_y);
+	(d_x * f_y - d_y * f_x).aligned_store(M_z);
+}
+
+} /* namespace */
+
+VectorizedMoleculeUpdate::VectorizedMoleculeUpdate(const std::vector<Component>& components) {
+	size_t maxID = 0;
+	for (const Component& c : components) {
+		maxID = std::max(maxID, static_cast<size_t>(c.ID()));
+	}
+	_mass.resize(maxID + 1, 0.0);
+	for (int d = 0; d < 3; ++d) {
+		_I[d].resize(maxID + 1, 0.0);
+		_invI[d].resize(maxID + 1, 0.0);
+	}
+	for (const Component& c : components) {
+		const double I[3] = { c.I11(), c.I22(), c.I33() };
+		_mass[c.ID()] = c.m();
+		for (int d = 0; d < 3; ++d) {
+			_I[d][c.ID()] = I[d];
+			_invI[d][c.ID()] = I[d] != 0. ? 1. / I[d] : 0.;
+		}
+	}
+}
+
+void VectorizedMoleculeUpdate::calcFM(FullParticleCell& cell) {
+	typedef CellDataSoA::QuantityType QuantityType;
+	typedef ConcSites::SiteType SiteType;
+	typedef ConcSites::CoordinateType Coordinate;
+
+	mardyn_assert(cell.getCompactHaloMoleculeCount() == 0);
+	CellDataSoA& soa = cell.getCellDataSoA();
+
+	const SiteType siteTypes[4] = { SiteType::LJC, SiteType::CHARGE, SiteType::DIPOLE, SiteType::QUADRUPOLE };
+	const size_t numSites[4] = { soa._ljc_num, soa._charges_num, soa._dipoles_num, soa._quadrupoles_num };
+	const int* const molSites[4] = { soa._mol_ljc_num, soa._mol_charges_num, soa._mol_dipoles_num, soa._mol_quadrupoles_num };
+
+	// torques of all sites, the sites of each type start at a whole vector
+	size_t offset[4];
+	size_t numSitesPadded = 0;
+	for (int t = 0; t < 4; ++t) {
+		offset[t] = numSitesPadded;
+		numSitesPadded += vcp_ceil_to_vec_size(numSites[t]);
+	}
+	for (int d = 0; d < 3; ++d) {
+		_siteM[d].resize_zero_shrink(numSitesPadded);
+	}
+
+	for (int t = 0; t < 4; ++t) {
+		const SiteType st = siteTypes[t];
+		const vcp_real_calc* const r_x = soa.getBeginCalc(QuantityType::CENTER_POSITION, st, Coordinate::X);
+		const vcp_real_calc* const r_y = soa.getBeginCalc(QuantityType::CENTER_POSITION, st, Coordinate::Y);
+		const vcp_real_calc* const r_z = soa.getBeginCalc(QuantityType::CENTER_POSITION, st, Coordinate::Z);
+		const vcp_real_calc* const m_r_x = soa.getBeginCalc(QuantityType::MOL_POSITION, st, Coordinate::X);
+		const vcp_real_calc* const m_r_y = soa.getBeginCalc(QuantityType::MOL_POSITION, st, Coordinate::Y);
+		const vcp_real_calc* const m_r_z = soa.getBeginCalc(QuantityType::MOL_POSITION, st, Coordinate::Z);
+		const vcp_real_accum* const f_x = soa.getBeginAccum(QuantityType::FORCE, st, Coordinate::X);
+		const vcp_real_accum* const f_y = soa.getBeginAccum(QuantityType::FORCE, st, Coordinate::Y);
+		const vcp_real_accum* const f_z = soa.getBeginAccum(QuantityType::FORCE, st, Coordinate::Z);
+		vcp_real_accum* const M_x = _siteM[0] + offset[t];
+		vcp_real_accum* const M_y = _siteM[1] + offset[t];
+		vcp_real_accum* const M_z = _siteM[2] + offset[t];
+
+		const size_t end_i = vcp_floor_to_vec_size(numSites[t]);
+		size_t i = 0;
+		for (; i < end_i; i += VCP_VEC_SIZE) {
+			storeSiteTorque(
+					RealCalcVec::aligned_load(r_x + i), RealCalcVec::aligned_load(r_y + i), RealCalcVec::aligned_load(r_z + i),
+					RealCalcVec::aligned_load(m_r_x + i), RealCalcVec::aligned_load(m_r_y + i), RealCalcVec::aligned_load(m_r_z + i),
+					RealAccumVec::aligned_load(f_x + i), RealAccumVec::aligned_load(f_y + i), RealAccumVec::aligned_load(f_z + i),
+					M_x + i, M_y + i, M_z + i);
+		}
+		const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(numSites[t]);
+		if (remainderMask.movemask()) {
+			storeSiteTorque(
+					RealCalcVec::aligned_load_mask(r_x + i, remainderMask),
+					RealCalcVec::aligned_load_mask(r_y + i, remainderMask),
+					RealCalcVec::aligned_load_mask(r_z + i, remainderMask),
+					RealCalcVec::aligned_load_mask(m_r_x + i, remainderMask),
+					RealCalcVec::aligned_load_mask(m_r_y + i, remainderMask),
+					RealCalcVec::aligned_load_mask(m_r_z + i, remainderMask),
+					RealAccumVec::aligned_load_mask(f_x + i, remainderMask),
+					RealAccumVec::aligned_load_mask(f_y + i, remainderMask),
+					RealAccumVec::aligned_load_mask(f_z + i, remainderMask),
+					M_x + i, M_y + i, M_z + i);
+		}
+	}
+
+	// sums per molecule: the sites of a molecule are contiguous (see FullParticleCell::buildSoACaches())
+	const vcp_real_accum* f[4][3];
+	const vcp_real_accum* V[4][3];
+	const Coordinate coords[3] = { Coordinate::X, Coordinate::Y, Coordinate::Z };
+	for (int t = 0; t < 4; ++t) {
+		for (int d = 0; d < 3; ++d) {
+			f[t][d] = soa.getBeginAccum(QuantityType::FORCE, siteTypes[t], coords[d]);
+			V[t][d] = soa.getBeginAccum(QuantityType::VIRIAL, siteTypes[t], coords[d]);
+		}
+	}
+	const vcp_real_accum* const orientedM[4][3] = {
+		{ nullptr, nullptr, nullptr },
+		{ nullptr, nullptr, nullptr },
+		{ soa._dipoles_M.xBegin(), soa._dipoles_M.yBegin(), soa._dipoles_M.zBegin() },
+		{ soa._quadrupoles_M.xBegin(), soa._quadrupoles_M.yBegin(), soa._quadrupoles_M.zBegin() }
+	};
+	size_t site[4] = { 0, 0, 0, 0 };
+	size_t mol = 0;
+	for (auto it = cell.iterator(); it.isValid(); ++it, ++mol) {
+		double F[3] = { 0., 0., 0. };
+		double M[3] = { 0., 0., 0. };
+		double Vi[3] = { 0., 0., 0. };
+		for (int t = 0; t < 4; ++t) {
+			const size_t end = site[t] + molSites[t][mol];
+			for (size_t i = site[t]; i < end; ++i) {
+				for (int d = 0; d < 3; ++d) {
+					F[d] += f[t][d][i];
+					M[d] += _siteM[d][offset[t] + i];
+					Vi[d] += V[t][d][i];
+				}
+			}
+			if (orientedM[t][0] != nullptr) {
+				for (size_t i = site[t]; i < end; ++i) {
+					for (int d = 0; d < 3; ++d) {
+						M[d] += orientedM[t][d][i];
+					}
+				}
+			}
+			site[t] = end;
+		}
+		for (int d = 0; d < 3; ++d) {
+			Vi[d] *= 0.5;
+			mardyn_assert(!std::isnan(F[d]) and !std::isnan(M[d]) and !std::isnan(Vi[d]));
+		}
+		it->Fadd(F);
+		it->Madd(M);
+		it->Viadd(Vi);
+	}
+}
+
+void VectorizedMoleculeUpdate::upd_postF(FullParticleCell& cell, double dt_halve) {
+	const size_t numMolecules = cell.getMoleculeCount();
+	for (AlignedArray<double>* a : { _v, _F, _L, _M, _Imol, _invImol }) {
+		for (int d = 0; d < 3; ++d) {
+			a[d].resize_zero_shrink(numMolecules);
+		}
+	}
+	for (int d = 0; d < 4; ++d) {
+		_q[d].resize_zero_shrink(numMolecules);
+	}
+	_m.resize_zero_shrink(numMolecules);
+	_mv2.resize_zero_shrink(numMolecules);
+	_Iw2.resize_zero_shrink(numMolecules);
+
+	size_t i = 0;
+	for (auto it = cell.iterator(); it.isValid(); ++it, ++i) {
+		const unsigned cid = it->componentid();
+		for (unsigned short d = 0; d < 3; ++d) {
+			_v[d][i] = it->v(d);
+			_F[d][i] = it->F(d);
+			_L[d][i] = it->D(d);
+			_M[d][i] = it->M(d);
+			_Imol[d][i] = _I[d][cid];
+			_invImol[d][i] = _invI[d][cid];
+		}
+		const Quaternion& q = it->q();
+		_q[0][i] = q.qw();
+		_q[1][i] = q.qx();
+		_q[2][i] = q.qy();
+		_q[3][i] = q.qz();
+		_m[i] = _mass[cid];
+	}
+
+	// the padding of the arrays is processed as well, the results are not used
+	const DoubleVec dt = DoubleVec::set1(dt_halve);
+	const DoubleVec two = DoubleVec::set1(2.0);
+	for (i = 0; i < numMolecules; i += VCP_DOUBLE_VEC_SIZE) {
+		const DoubleVec m = DoubleVec::aligned_load(_m + i);
+		const DoubleVec dtInv2m = dt / m;
+
+		DoubleVec v[3], L[3];
+		for (int d = 0; d < 3; ++d) {
+			v[d] = DoubleVec::fmadd(dtInv2m, DoubleVec::aligned_load(_F[d] + i), DoubleVec::aligned_load(_v[d] + i));
+			L[d] = DoubleVec::fmadd(dt, DoubleVec::aligned_load(_M[d] + i), DoubleVec::aligned_load(_L[d] + i));
+			v[d].aligned_store(_v[d] + i);
+			L[d].aligned_store(_L[d] + i);
+		}
+		(m * DoubleVec::scal_prod(v[0], v[1], v[2], v[0], v[1], v[2])).aligned_store(_mv2 + i);
+
+		// w = q.rotateinv(L) * invI, see Quaternion::rotateinv()
+		const DoubleVec qw = DoubleVec::aligned_load(_q[0] + i);
+		const DoubleVec qx = DoubleVec::aligned_load(_q[1] + i);
+		const DoubleVec qy = DoubleVec::aligned_load(_q[2] + i);
+		const DoubleVec qz = DoubleVec::aligned_load(_q[3] + i);
+		const DoubleVec ww = qw * qw;
+		const DoubleVec xx = qx * qx;
+		const DoubleVec yy = qy * qy;
+		const DoubleVec zz = qz * qz;
+		const DoubleVec wx = qw * qx;
+		const DoubleVec wy = qw * qy;
+		const DoubleVec wz = qw * qz;
+		const DoubleVec xy = qx * qy;
+		const DoubleVec xz = qx * qz;
+		const DoubleVec yz = qy * qz;
+
+		DoubleVec w[3];
+		w[0] = (ww + xx - yy - zz) * L[0] + two * (xy + wz) * L[1] + two * (xz - wy) * L[2];
+		w[1] = two * (xy - wz) * L[0] + (ww - xx + yy - zz) * L[1] + two * (yz + wx) * L[2];
+		w[2] = two * (xz + wy) * L[0] + two * (yz - wx) * L[1] + (ww - xx - yy + zz) * L[2];
+
+		DoubleVec Iw2 = DoubleVec::zero();
+		for (int d = 0; d < 3; ++d) {
+			w[d] = w[d] * DoubleVec::aligned_load(_invImol[d] + i);
+			Iw2 = DoubleVec::fmadd(DoubleVec::aligned_load(_Imol[d] + i) * w[d], w[d], Iw2);
+		}
+		Iw2.aligned_store(_Iw2 + i);
+	}
+
+	i = 0;
+	for (auto it = cell.iterator(); it.isValid(); ++it, ++i) {
+		for (unsigned short d = 0; d < 3; ++d) {
+			it->setv(d, _v[d][i]);
+			it->setD(d, _L[d][i]);
+		}
+		mardyn_assert(!std::isnan(_mv2[i]) and !std::isnan(_Iw2[i]));
+	}
+}
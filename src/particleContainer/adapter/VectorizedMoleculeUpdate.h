@@ -0,0 +1,80 @@
+/**
+ * \file
+ * \brief VectorizedMoleculeUpdate.h
+ */
+
+#ifndef VECTORIZEDMOLECULEUPDATE_H_
+#define VECTORIZEDMOLECULEUPDATE_H_
+
+#include "utils/AlignedArray.h"
+#include "utils/ConcatenatedSites.h"
+#include "vectorization/SIMD_PRECISION.h"
+#include <cstddef>
+#include <vector>
+
+class Component;
+class FullParticleCell;
+
+/**
+ * \brief Molecule::calcFM() and Molecule::upd_postF() for all molecules of a cell, vectorized on its CellDataSoA.
+ * \details calcFM() computes the torques of all sites of the cell at once from the site positions and forces
+ * in the SoA and adds the sums per molecule to force, torque and virial of the molecules. upd_postF()
+ * gathers the molecules of the cell into arrays and does the half-kick of momentum and angular momentum
+ * and the rotation of the angular momentum into the body frame for the rotational energy for
+ * several molecules at once, always in double precision.
+ *
+ * The arm of a site is its position minus the centre of mass of its molecule, both from the SoA.
+ * In builds with single precision positions, the torque is therefore only as precise as the site forces.
+ *
+ * Each thread needs its own instance.
+ */
+class VectorizedMoleculeUpdate {
+public:
+	explicit VectorizedMoleculeUpdate(const std::vector<Component>& components);
+
+	/**
+	 * \brief Molecule::calcFM() for all molecules of a cell without compact halo copies, after its forces are final.
+	 */
+	void calcFM(FullParticleCell& cell);
+
+	/**
+	 * \brief Molecule::upd_postF() for all molecules of the cell.
+	 * \details The contributions of the i-th molecule of the cell to the thermostat sums are
+	 * mv2(i) and Iw2(i) afterwards.
+	 */
+	void upd_postF(FullParticleCell& cell, double dt_halve);
+
+	double mv2(size_t i) const {
+		return _mv2[i];
+	}
+
+	double Iw2(size_t i) const {
+		return _Iw2[i];
+	}
+
+private:
+	//! \brief Add torque, force and virial of the sites of one type in the SoA to the molecules of the cell.
+	void reduceSites(FullParticleCell& cell, ConcSites::SiteType siteType);
+
+	// mass, moments of inertia and their inverses per component ID, as in Molecule::updateMassInertia()
+	std::vector<double> _mass;
+	std::vector<double> _I[3];
+	std::vector<double> _invI[3];
+
+	// site torques of one site type
+	AlignedArray<vcp_real_accum> _siteM[3];
+
+	// molecule data for upd_postF()
+	AlignedArray<double> _v[3];
+	AlignedArray<double> _F[3];
+	AlignedArray<double> _L[3];
+	AlignedArray<double> _M[3];
+	AlignedArray<double> _q[4];
+	AlignedArray<double> _m;
+	AlignedArray<double> _Imol[3];
+	AlignedArray<double> _invImol[3];
+	AlignedArray<double> _mv2;
+	AlignedArray<double> _Iw2;
+};
+
+#endif /* VECTORIZEDMOLECULEUPDATE_H_ */
@@ -248,8 +248,7 @@ void VCP1CLJRMMTest::testProcessCell() {
 
 	vcp_full.initTraversal();
 	const bool CalculateMacroscopic = true;
-	const bool ApplyCutoff = true;
-	vcp_full._calculatePairs<SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(full_SoA, full_SoA);
+	vcp_full._kernel->calculatePairs(full_SoA, full_SoA, nullptr, true, CalculateMacroscopic);
 	vcp_full.endTraversal();
 
 	double full_Upot = _domain->getLocalUpot();
@@ -326,8 +325,7 @@ void VCP1CLJRMMTest::testProcessCellPair() {
 
 	vcp_full.initTraversal();
 	const bool CalculateMacroscopic = true;
-	const bool ApplyCutoff = true;
-	vcp_full._calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(full_SoA2, full_SoA1);
+	vcp_full._kernel->calculatePairs(full_SoA2, full_SoA1, nullptr, false, CalculateMacroscopic);
 	vcp_full.endTraversal();
 
 	double full_Upot = _domain->getLocalUpot();
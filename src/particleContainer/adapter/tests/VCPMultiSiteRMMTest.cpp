@@ -0,0 +1,206 @@
+#include "VCPMultiSiteRMMTest.h"
+#include "Domain.h"
+#include "molecules/Component.h"
+#include "molecules/FullMolecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/LinkedCells.h"
+#include "particleContainer/ParticleCellRMM.h"
+#include "particleContainer/adapter/VCPMultiSiteRMM.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+TEST_SUITE_REGISTRATION(VCPMultiSiteRMMTest);
+#else
+#pragma message "Compilation info: The unit test for the RMM multi-site force calculation is not executed in non-RMM mode."
+#endif
+
+
+VCPMultiSiteRMMTest::VCPMultiSiteRMMTest() {
+}
+
+VCPMultiSiteRMMTest::~VCPMultiSiteRMMTest() {
+}
+
+void VCPMultiSiteRMMTest::testProcessCell2CLJ() {
+	compareToVectorizedCellProcessor("VectorizationLennardJones.inp", false);
+}
+
+void VCPMultiSiteRMMTest::testProcessCellPair2CLJ() {
+	compareToVectorizedCellProcessor("VectorizationLennardJones.inp", true);
+}
+
+void VCPMultiSiteRMMTest::testProcessCellLJCharge() {
+	compareToVectorizedCellProcessor("VectorizationLennardJonesCharge.inp", false);
+}
+
+void VCPMultiSiteRMMTest::testProcessCellPairLJCharge() {
+	compareToVectorizedCellProcessor("VectorizationLennardJonesCharge.inp", true);
+}
+
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+// free function
+void VCPMultiSiteRMMTest__initFullCellSoA(ParticleCellRMM & cell_RMM, CellDataSoA& fullSoA) {
+	typedef ConcSites::SiteType SiteType;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	const Component& component = *MoleculeRMM::getStaticRMMComponent();
+	const size_t numMolecules = cell_RMM.getMoleculeCount();
+	const unsigned numLJcenters = component.numLJcenters();
+	const unsigned numCharges = component.numCharges();
+
+	fullSoA.resize(numMolecules, numMolecules * numLJcenters, numMolecules * numCharges, 0, 0);
+
+	size_t i = 0;
+	for (auto it = cell_RMM.iterator(); it.isValid(); ++it, ++i) {
+		fullSoA._mol_ljc_num[i] = numLJcenters;
+		fullSoA._mol_charges_num[i] = numCharges;
+		fullSoA._mol_dipoles_num[i] = 0;
+		fullSoA._mol_quadrupoles_num[i] = 0;
+
+		const std::array<double, 3> r = {{it->r(0), it->r(1), it->r(2)}};
+		fullSoA._mol_pos.x(i) = r[0];
+		fullSoA._mol_pos.y(i) = r[1];
+		fullSoA._mol_pos.z(i) = r[2];
+
+		FullMolecule::setupSoACacheSites(fullSoA, component, r, it->q(), i * numLJcenters, i * numCharges, 0, 0);
+	}
+
+	const std::array<vcp_real_accum, 3> clearance = {{0., 0., 0.}};
+	for (size_t s = 0; s < fullSoA._ljc_num; ++s) {
+		fullSoA.setTripletAccum(clearance, QuantityType::FORCE, SiteType::LJC, s);
+		fullSoA.setTripletAccum(clearance, QuantityType::VIRIAL, SiteType::LJC, s);
+	}
+	for (size_t s = 0; s < fullSoA._charges_num; ++s) {
+		fullSoA.setTripletAccum(clearance, QuantityType::FORCE, SiteType::CHARGE, s);
+		fullSoA.setTripletAccum(clearance, QuantityType::VIRIAL, SiteType::CHARGE, s);
+	}
+}
+
+// free function: velocities (= forces) and angular momenta (= mass times torques) after the kick with dtInvm = 1
+void VCPMultiSiteRMMTest__compareCell(ParticleCellRMM & cell_RMM, const CellDataSoA& fullSoA) {
+	typedef ConcSites::SiteType SiteType;
+	typedef CellDataSoA::QuantityType QuantityType;
+
+	const Component& component = *MoleculeRMM::getStaticRMMComponent();
+	const double mass = component.m();
+	const size_t numMolecules = cell_RMM.getMoleculeCount();
+	const SiteType siteTypes[2] = {SiteType::LJC, SiteType::CHARGE};
+	const unsigned numSites[2] = {component.numLJcenters(), component.numCharges()};
+
+	// forces and torques of the molecules, summed up from the sites of the full SoA
+	std::vector<std::array<double, 6> > full_FM(numMolecules);
+	double scaleF = 0.0, scaleM = 0.0;
+	for (size_t i = 0; i < numMolecules; ++i) {
+		std::array<double, 6>& FM = full_FM[i];
+		FM.fill(0.0);
+		const std::array<double, 3> r = {{fullSoA._mol_pos.x(i), fullSoA._mol_pos.y(i), fullSoA._mol_pos.z(i)}};
+		for (int t = 0; t < 2; ++t) {
+			for (unsigned s = i * numSites[t]; s < (i + 1) * numSites[t]; ++s) {
+				const std::array<vcp_real_calc, 3> c = fullSoA.getTripletCalc(QuantityType::CENTER_POSITION, siteTypes[t], s);
+				const std::array<vcp_real_accum, 3> f = fullSoA.getTripletAccum(QuantityType::FORCE, siteTypes[t], s);
+				const double d[3] = {c[0] - r[0], c[1] - r[1], c[2] - r[2]};
+				for (int k = 0; k < 3; ++k) {
+					FM[k] += f[k];
+				}
+				FM[3] += d[1] * f[2] - d[2] * f[1];
+				FM[4] += d[2] * f[0] - d[0] * f[2];
+				FM[5] += d[0] * f[1] - d[1] * f[0];
+			}
+		}
+		for (int k = 0; k < 3; ++k) {
+			scaleF = std::max(scaleF, std::abs(FM[k]));
+			scaleM = std::max(scaleM, std::abs(FM[3 + k]));
+		}
+	}
+	ASSERT_TRUE(scaleF > 0.0);
+	ASSERT_TRUE(scaleM > 0.0);
+
+	size_t i = 0;
+	for (auto it = cell_RMM.iterator(); it.isValid(); ++it, ++i) {
+		for (int k = 0; k < 3; ++k) {
+			std::stringstream str;
+			str << "Molecule id=" << it->getID() << " index k=" << k << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG("force: " + str.str(), full_FM[i][k], it->v(k), 1.0e-5 * scaleF);
+			ASSERT_DOUBLES_EQUAL_MSG("torque: " + str.str(), full_FM[i][3 + k], it->D(k) / mass, 1.0e-5 * scaleM);
+		}
+	}
+}
+#endif /* ENABLE_REDUCED_MEMORY_MODE */
+
+void VCPMultiSiteRMMTest::compareToVectorizedCellProcessor(const char* filename, bool pair) {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VCPMultiSiteRMMTest::compareToVectorizedCellProcessor()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	double ScenarioCutoff = 35.0;
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	ASSERT_TRUE(MoleculeRMM::isMultiSite());
+	for (auto m = container->iterator(); m.isValid(); ++m) {
+		for (int d = 0; d < 3; ++d) {
+			m->setv(d, 0.0);
+			m->setD(d, 0.0);
+		}
+	}
+
+	LinkedCells * linkedCells = dynamic_cast<LinkedCells*>(container);
+
+	VCPMultiSiteRMM vcp_RMM(*_domain, ScenarioCutoff, ScenarioCutoff);
+	vcp_RMM.setDtInvm(1.0);
+	VectorizedCellProcessor vcp_full(*_domain, ScenarioCutoff, ScenarioCutoff);
+
+	// get an inner cell and its neighbour
+	double innerPoint[3] = {0.1, 0.1, 0.1};
+	unsigned long firstCellIndex = linkedCells->getCellIndexOfPoint(innerPoint);
+	ParticleCellRMM& cell_RMM1 = linkedCells->getCellReference(firstCellIndex);
+	ParticleCellRMM& cell_RMM2 = linkedCells->getCellReference(firstCellIndex + 1);
+	ASSERT_TRUE(cell_RMM1.getCellDataSoA().isRotational());
+	ASSERT_TRUE(cell_RMM1.getMoleculeCount() > 1);
+	ASSERT_TRUE(not pair or cell_RMM2.getMoleculeCount() > 0);
+
+	CellDataSoA full_SoA1(0,0,0,0,0);
+	CellDataSoA full_SoA2(0,0,0,0,0);
+	VCPMultiSiteRMMTest__initFullCellSoA(cell_RMM1, full_SoA1);
+	VCPMultiSiteRMMTest__initFullCellSoA(cell_RMM2, full_SoA2);
+
+	vcp_RMM.initTraversal();
+	if (pair) {
+		vcp_RMM.processCellPair(cell_RMM1, cell_RMM2);
+	} else {
+		vcp_RMM.processCell(cell_RMM1);
+	}
+	vcp_RMM.endTraversal();
+
+	double RMM_Upot = _domain->getLocalUpot();
+	double RMM_Virial = _domain->getLocalVirial();
+
+	vcp_full.initTraversal();
+	const bool CalculateMacroscopic = true;
+	if (pair) {
+		vcp_full._kernel->calculatePairs(full_SoA2, full_SoA1, nullptr, false, CalculateMacroscopic);
+	} else {
+		vcp_full._kernel->calculatePairs(full_SoA1, full_SoA1, nullptr, true, CalculateMacroscopic);
+	}
+	vcp_full.endTraversal();
+
+	double full_Upot = _domain->getLocalUpot();
+	double full_Virial = _domain->getLocalVirial();
+
+	ASSERT_TRUE(full_Upot != 0.0);
+	ASSERT_DOUBLES_EQUAL(full_Upot, RMM_Upot, fabs(1.0e-5*full_Upot));
+	ASSERT_DOUBLES_EQUAL(full_Virial, RMM_Virial, fabs(1.0e-5*full_Virial));
+
+	VCPMultiSiteRMMTest__compareCell(cell_RMM1, full_SoA1);
+	if (pair) {
+		VCPMultiSiteRMMTest__compareCell(cell_RMM2, full_SoA2);
+	}
+
+	delete container;
+#endif /* ENABLE_REDUCED_MEMORY_MODE */
+}
@@ -0,0 +1,56 @@
+#ifndef SRC_PARTICLECONTAINER_ADAPTER_TESTS_VCPMULTISITERMMTEST_H_
+#define SRC_PARTICLECONTAINER_ADAPTER_TESTS_VCPMULTISITERMMTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+class VCPMultiSiteRMMTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(VCPMultiSiteRMMTest);
+
+	TEST_METHOD(testProcessCell2CLJ);
+	TEST_METHOD(testProcessCellPair2CLJ);
+	TEST_METHOD(testProcessCellLJCharge);
+	TEST_METHOD(testProcessCellPairLJCharge);
+
+	TEST_SUITE_END();
+
+
+public:
+	VCPMultiSiteRMMTest();
+	virtual ~VCPMultiSiteRMMTest();
+
+	/**
+	 * Two LJ centers of different parameters per molecule.
+	 *
+	 * @see compareToVectorizedCellProcessor
+	 */
+	void testProcessCell2CLJ();
+
+	/**
+	 * @see testProcessCell2CLJ
+	 */
+	void testProcessCellPair2CLJ();
+
+	/**
+	 * Two LJ centers and two charges per molecule.
+	 *
+	 * @see compareToVectorizedCellProcessor
+	 */
+	void testProcessCellLJCharge();
+
+	/**
+	 * @see testProcessCellLJCharge
+	 */
+	void testProcessCellPairLJCharge();
+
+	/**
+	 * Run the VCPMultiSiteRMM on an inner cell (and its neighbour, if pair is true) with dtInvm = 1 and
+	 * the molecules at rest, so that the velocities are the forces and the angular momenta are the torques
+	 * times the mass afterwards. Compare them, the potential and the virial to the VectorizedCellProcessor
+	 * on full SoAs of the same molecules.
+	 */
+	void compareToVectorizedCellProcessor(const char* filename, bool pair);
+
+};
+
+#endif /* SRC_PARTICLECONTAINER_ADAPTER_TESTS_VCPMULTISITERMMTEST_H_ */
@@ -6,12 +6,23 @@
  */
 
 #include "VectorizedCellProcessorTest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include "Domain.h"
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "molecules/TabulatedPotential.h"
 #include "parallel/DomainDecompBase.h"
 #include "particleContainer/ParticleContainer.h"
+#include "particleContainer/LinkedCells.h"
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
 #include "particleContainer/adapter/LegacyCellProcessor.h"
 #include "particleContainer/adapter/VectorizedCellProcessor.h"
+#include "particleContainer/adapter/CellDataSoA.h"
+#include "particleContainer/adapter/vectorization/SIMD_TYPES.h"
 
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 TEST_SUITE_REGISTRATION(VectorizedCellProcessorTest);
@@ -377,6 +388,21 @@ void VectorizedCellProcessorTest::testQuadrupoleQuadrupoleVectorization() {
 	testElectrostaticVectorization(filename, 35.0);
 }
 
+void VectorizedCellProcessorTest::testLennardJones1CLJVectorization() {
+	const char* filename = "VectorizationLennardJones1CLJ.inp";
+	testElectrostaticVectorization(filename, 35.0);
+}
+
+void VectorizedCellProcessorTest::testLennardJonesChargeVectorization() {
+	const char* filename = "VectorizationLennardJonesCharge.inp";
+	testElectrostaticVectorization(filename, 35.0);
+}
+
+void VectorizedCellProcessorTest::testLennardJonesCharge1CLJVectorization() {
+	const char* filename = "VectorizationLennardJonesCharge1CLJ.inp";
+	testElectrostaticVectorization(filename, 35.0);
+}
+
 void VectorizedCellProcessorTest::testWaterVectorization() {
 	const char* filename = "VectorizationWater.inp";
 	testElectrostaticVectorization(filename, 6.16);
@@ -386,3 +412,719 @@ void VectorizedCellProcessorTest::testMultiComponentMultiPotentials() {
 	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
 	testElectrostaticVectorization(filename, 35.0);
 }
+
+void VectorizedCellProcessorTest::testVerletLists() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testVerletLists()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	double Tolerance = 1e-12;
+#else
+	double Tolerance = 1e-06;
+#endif
+
+	const double ScenarioCutoff = 6.16;
+	const double skin = 1.0;
+	const char filename[] = {"VectorizationWater.inp"};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	LinkedCells* linkedCells = dynamic_cast<LinkedCells*>(container);
+	if (linkedCells == nullptr) {
+		test_log->info() << "VectorizedCellProcessorTest::testVerletLists()"
+				<< " not executed (no LinkedCells container)" << std::endl;
+		delete container;
+		return;
+	}
+
+	VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff);
+
+	// build the lists
+	linkedCells->setVerletSkin(skin);
+	container->updateMoleculeCaches();
+	container->traverseCells(vectorized_cell_proc);
+
+	// move the molecules by less than half the skin, so that the lists of unchanged cells are reused
+	for (auto m = container->iterator(); m.isValid(); ++m) {
+		const double shift = 0.4 * skin * ((m->getID() % 7) / 6.0 - 0.5);
+		for (int d = 0; d < 3; ++d) {
+			m->setr(d, m->r(d) + shift * (d + 1) / 3.0);
+		}
+	}
+	container->update();
+	container->updateMoleculeCaches();
+	container->traverseCells(vectorized_cell_proc);
+
+	std::vector<double> verletValues;
+	for (auto m = container->iterator(); m.isValid(); ++m) {
+		m->calcFM();
+		for (int i = 0; i < 3; i++) {
+			verletValues.push_back(m->F(i));
+			verletValues.push_back(m->M(i));
+			verletValues.push_back(m->Vi(i));
+		}
+	}
+	const double verlet_u_pot = _domain->getLocalUpot();
+	const double verlet_virial = _domain->getLocalVirial();
+
+	// same configuration without Verlet lists
+	linkedCells->setVerletSkin(0.0);
+	container->updateMoleculeCaches();
+	container->traverseCells(vectorized_cell_proc);
+
+	size_t index = 0;
+	for (auto m = container->iterator(); m.isValid(); ++m) {
+		m->calcFM();
+		for (int i = 0; i < 3; i++) {
+			std::stringstream str;
+			str << "Molecule id=" << m->getID() << " index i="<< i << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), m->F(i), verletValues[index++], Tolerance);
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), m->M(i), verletValues[index++], Tolerance);
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), m->Vi(i), verletValues[index++], Tolerance);
+		}
+	}
+	ASSERT_EQUAL(verletValues.size(), index);
+
+	ASSERT_DOUBLES_EQUAL(_domain->getLocalUpot(), verlet_u_pot, Tolerance);
+	ASSERT_DOUBLES_EQUAL(_domain->getLocalVirial(), verlet_virial, Tolerance);
+
+	delete container;
+}
+
+void VectorizedCellProcessorTest::testFusedHalfKick() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testFusedHalfKick()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	double Tolerance = 1e-12;
+#else
+	double Tolerance = 1e-06;
+#endif
+
+	const double ScenarioCutoff = 6.16;
+	const double dtHalf = 0.005;
+	const char filename[] = {"VectorizationWater.inp"};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff);
+
+	std::vector<double> initialValues;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		for (int i = 0; i < 3; i++) {
+			initialValues.push_back(m->v(i));
+			initialValues.push_back(m->D(i));
+		}
+	}
+
+	// separate sweeps (halo molecules are not integrated), as in Simulation::updateForces() and Leapfrog::transition2to3()
+	container->traverseCells(vectorized_cell_proc);
+	std::vector<double> separateValues;
+	double summv2 = 0.0, sumIw2 = 0.0;
+	size_t index = 0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		m->upd_postF(dtHalf, summv2, sumIw2);
+		for (int i = 0; i < 3; i++) {
+			separateValues.push_back(m->v(i));
+			separateValues.push_back(m->D(i));
+			m->setv(i, initialValues[index++]);
+			m->setD(i, initialValues[index++]);
+		}
+	}
+
+	// fused into the traversal
+	vectorized_cell_proc.setFusedHalfKick(dtHalf);
+	ASSERT_TRUE(vectorized_cell_proc.requiresPostprocessing());
+	container->traverseCells(vectorized_cell_proc);
+
+	index = 0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		for (int i = 0; i < 3; i++) {
+			std::stringstream str;
+			str << "Molecule id=" << m->getID() << " index i="<< i << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), separateValues[index++], m->v(i), Tolerance);
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), separateValues[index++], m->D(i), Tolerance);
+		}
+	}
+	ASSERT_EQUAL(separateValues.size(), index);
+
+	delete container;
+}
+
+void VectorizedCellProcessorTest::testCompactHaloCells() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testCompactHaloCells()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	double Tolerance = 1e-12;
+#else
+	double Tolerance = 1e-06;
+#endif
+
+	const double ScenarioCutoff = 6.16;
+	const char filename[] = {"VectorizationWater.inp"};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	LinkedCells* linkedCells = dynamic_cast<LinkedCells*>(container);
+	if (linkedCells == nullptr) {
+		test_log->info() << "VectorizedCellProcessorTest::testCompactHaloCells()"
+				<< " not executed (no LinkedCells container)" << std::endl;
+		delete container;
+		return;
+	}
+
+	VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff);
+
+	// full halo molecules
+	_domainDecomposition->exchangeMolecules(container, _domain);
+	container->updateMoleculeCaches();
+	container->traverseCells(vectorized_cell_proc);
+
+	std::vector<double> fullValues;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		for (int i = 0; i < 3; i++) {
+			fullValues.push_back(m->F(i));
+			fullValues.push_back(m->M(i));
+			fullValues.push_back(m->Vi(i));
+		}
+	}
+	const double full_u_pot = _domain->getLocalUpot();
+	const double full_virial = _domain->getLocalVirial();
+	const unsigned long numInner = fullValues.size() / 9;
+	ASSERT_TRUE(container->getNumberOfParticles() > numInner);
+
+	// compact halo copies, which the iterators do not visit
+	container->deleteOuterParticles();
+	linkedCells->setCompactHaloCells(true);
+	ASSERT_TRUE(linkedCells->hasCompactHaloCells());
+	_domainDecomposition->exchangeMolecules(container, _domain);
+	ASSERT_EQUAL(numInner, container->getNumberOfParticles());
+	container->updateMoleculeCaches();
+	container->traverseCells(vectorized_cell_proc);
+
+	size_t index = 0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		for (int i = 0; i < 3; i++) {
+			std::stringstream str;
+			str << "Molecule id=" << m->getID() << " index i="<< i << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), fullValues[index++], m->F(i), Tolerance);
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), fullValues[index++], m->M(i), Tolerance);
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), fullValues[index++], m->Vi(i), Tolerance);
+		}
+	}
+	ASSERT_EQUAL(fullValues.size(), index);
+	ASSERT_DOUBLES_EQUAL(full_u_pot, _domain->getLocalUpot(), Tolerance);
+	ASSERT_DOUBLES_EQUAL(full_virial, _domain->getLocalVirial(), Tolerance);
+
+	delete container;
+}
+
+void VectorizedCellProcessorTest::testPrecisions() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testPrecisions()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	const double ScenarioCutoff = 6.16;
+	const char filename[] = {"VectorizationWater.inp"};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+
+	// precision of the build
+	VectorizedCellProcessor build_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff);
+	container->updateMoleculeCaches();
+	container->traverseCells(build_cell_proc);
+
+	std::vector<double> buildValues;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		for (int i = 0; i < 3; i++) {
+			buildValues.push_back(m->F(i));
+			buildValues.push_back(m->M(i));
+			buildValues.push_back(m->Vi(i));
+		}
+	}
+	const double build_u_pot = _domain->getLocalUpot();
+	const double build_virial = _domain->getLocalVirial();
+
+	const int precisions[] = {VCP_SPSP, VCP_SPDP, VCP_DPDP};
+	for (int precision : precisions) {
+		// relative tolerance
+		const double Tolerance = (precision == VCP_DPDP and VCP_PREC == VCP_DPDP) ? 1e-12 : 1e-4;
+		VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff, precision);
+
+		// the second traversal has to refresh the converted copies of the first one
+		for (int traversal = 0; traversal < 2; traversal++) {
+			container->updateMoleculeCaches();
+			container->traverseCells(vectorized_cell_proc);
+
+			size_t index = 0;
+			for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+				m->calcFM();
+				for (int i = 0; i < 3; i++) {
+					std::stringstream str;
+					str << VectorizedCellProcessor::precisionToString(precision) << " traversal " << traversal
+							<< " Molecule id=" << m->getID() << " index i="<< i << std::endl;
+					const double F = buildValues[index++], M = buildValues[index++], Vi = buildValues[index++];
+					ASSERT_DOUBLES_EQUAL_MSG(str.str(), F, m->F(i), Tolerance * std::max(1.0, std::abs(F)));
+					ASSERT_DOUBLES_EQUAL_MSG(str.str(), M, m->M(i), Tolerance * std::max(1.0, std::abs(M)));
+					ASSERT_DOUBLES_EQUAL_MSG(str.str(), Vi, m->Vi(i), Tolerance * std::max(1.0, std::abs(Vi)));
+				}
+			}
+			ASSERT_EQUAL(buildValues.size(), index);
+			ASSERT_DOUBLES_EQUAL(build_u_pot, _domain->getLocalUpot(), Tolerance * std::max(1.0, std::abs(build_u_pot)));
+			ASSERT_DOUBLES_EQUAL(build_virial, _domain->getLocalVirial(), Tolerance * std::max(1.0, std::abs(build_virial)));
+		}
+	}
+
+	delete container;
+}
+
+void VectorizedCellProcessorTest::testRelativePositions() {
+	typedef CellDataSoAT<float, double> SingleSoA;
+	typedef SingleSoA::QuantityType QuantityType;
+	typedef ConcSites::SiteType SiteType;
+
+	const std::array<double, 3> boxMin = {{1000., 2000., -3000.}};
+	const std::array<vcp_real_calc, 3> molPos = {{1000.123456789, 2000.987654321, -2999.5}};
+	const std::array<vcp_real_calc, 3> ljcPos = {{1000.623456789, 2001.187654321, -2999.25}};
+	CellDataSoA soa(1, 1, 0, 0, 0);
+	soa._cellBoxMin = boxMin;
+	soa._mol_pos.x(0) = molPos[0];
+	soa._mol_pos.y(0) = molPos[1];
+	soa._mol_pos.z(0) = molPos[2];
+	soa.pushBackLJC(0, molPos, ljcPos, 0);
+
+	SingleSoA single(0, 0, 0, 0, 0);
+	single.copyCalcFrom(soa);
+
+	// positions, which are stored in single precision anyway, stay absolute
+	const bool relative = sizeof(vcp_real_calc) > sizeof(float);
+	const double tolerance = relative ? 1e-6 : 0.;
+	for (int d = 0; d < 3; ++d) {
+		ASSERT_DOUBLES_EQUAL(relative ? boxMin[d] : 0., single._origin[d], 0.);
+		const double m = single._origin[d] + single.getTripletCalc(QuantityType::MOL_POSITION, SiteType::LJC, 0)[d];
+		const double r = single._origin[d] + single.getTripletCalc(QuantityType::CENTER_POSITION, SiteType::LJC, 0)[d];
+		ASSERT_DOUBLES_EQUAL(molPos[d], m, tolerance);
+		ASSERT_DOUBLES_EQUAL(ljcPos[d], r, tolerance);
+	}
+}
+
+void VectorizedCellProcessorTest::testSinglePrecisionFootprint() {
+	typedef CellDataSoAT<float, double> MixedSoA;
+
+	const size_t numCenters = 64;
+	CellDataSoA soa(numCenters, numCenters, 0, 0, 0);
+	for (size_t i = 0; i < numCenters; ++i) {
+		const std::array<vcp_real_calc, 3> pos = {{0.01 * i, 0.02 * i, 0.03 * i}};
+		soa._mol_pos.x(i) = pos[0];
+		soa._mol_pos.y(i) = pos[1];
+		soa._mol_pos.z(i) = pos[2];
+		soa.pushBackLJC(i, pos, pos, 0);
+	}
+
+	MixedSoA mixed(0, 0, 0, 0, 0);
+	mixed.copyCalcFrom(soa);
+
+	const double calcRatio = static_cast<double>(sizeof(float)) / sizeof(vcp_real_calc);
+	const double accumRatio = static_cast<double>(sizeof(double)) / sizeof(vcp_real_accum);
+	ASSERT_TRUE(soa._mol_pos.get_dynamic_memory() > 0);
+	ASSERT_TRUE(soa._centers_f.get_dynamic_memory() > 0);
+	ASSERT_DOUBLES_EQUAL(calcRatio * soa._mol_pos.get_dynamic_memory(), mixed._mol_pos.get_dynamic_memory(), 0.);
+	ASSERT_DOUBLES_EQUAL(calcRatio * soa._centers_m_r.get_dynamic_memory(), mixed._centers_m_r.get_dynamic_memory(), 0.);
+	ASSERT_DOUBLES_EQUAL(calcRatio * soa._centers_r.get_dynamic_memory(), mixed._centers_r.get_dynamic_memory(), 0.);
+	ASSERT_DOUBLES_EQUAL(accumRatio * soa._centers_f.get_dynamic_memory(), mixed._centers_f.get_dynamic_memory(), 0.);
+	ASSERT_DOUBLES_EQUAL(accumRatio * soa._centers_V.get_dynamic_memory(), mixed._centers_V.get_dynamic_memory(), 0.);
+}
+
+void VectorizedCellProcessorTest::testSingleMolecule() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testSingleMolecule()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	// relative tolerance
+#if defined(MARDYN_DPDP)
+	double Tolerance = 1e-10;
+#else
+	double Tolerance = 1e-04;
+#endif
+
+	const double ScenarioCutoff = 6.16;
+	const char filename[] = {"VectorizationWater.inp"};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	_domainDecomposition->exchangeMolecules(container, _domain);
+	container->updateMoleculeCaches();
+
+	ParticlePairs2PotForceAdapter forceAdapter(*_domain);
+	LegacyCellProcessor legacy_cell_proc(ScenarioCutoff, ScenarioCutoff, &forceAdapter);
+	VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff);
+
+	// test deletions of all molecules and test insertions next to them
+	std::vector<Molecule> testMolecules;
+	unsigned long nextID = 1000000;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		testMolecules.push_back(*m);
+		Molecule inserted(*m);
+		for (int d = 0; d < 3; d++) {
+			const double min = container->getBoundingBoxMin(d);
+			const double length = container->getBoundingBoxMax(d) - min;
+			inserted.setr(d, min + std::fmod(m->r(d) - min + (d + 1) * 0.3, length));
+		}
+		inserted.setid(nextID++);
+		testMolecules.push_back(inserted);
+	}
+
+	container->traverseCells(vectorized_cell_proc);
+	const double u_pot = _domain->getLocalUpot();
+	const double virial = _domain->getLocalVirial();
+
+	std::vector<double> vectorizedEnergies;
+	for (Molecule& m : testMolecules) {
+		vectorizedEnergies.push_back(container->getEnergy(&forceAdapter, &m, vectorized_cell_proc));
+	}
+	ASSERT_DOUBLES_EQUAL(u_pot, _domain->getLocalUpot(), 0.0);
+	ASSERT_DOUBLES_EQUAL(virial, _domain->getLocalVirial(), 0.0);
+
+	std::vector<double> forces;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		for (int i = 0; i < 3; i++) {
+			forces.push_back(m->F(i));
+			forces.push_back(m->M(i));
+		}
+	}
+
+	for (size_t i = 0; i < testMolecules.size(); i++) {
+		const double legacyEnergy = container->getEnergy(&forceAdapter, &testMolecules[i], legacy_cell_proc);
+		std::stringstream str;
+		str << "Test molecule id=" << testMolecules[i].getID() << std::endl;
+		ASSERT_DOUBLES_EQUAL_MSG(str.str(), legacyEnergy, vectorizedEnergies[i], Tolerance * std::max(1.0, std::abs(legacyEnergy)));
+	}
+
+	// the forces of a traversal without test molecules
+	container->updateMoleculeCaches();
+	container->traverseCells(vectorized_cell_proc);
+	size_t index = 0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		for (int i = 0; i < 3; i++) {
+			std::stringstream str;
+			str << "Molecule id=" << m->getID() << " index i="<< i << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), m->F(i), forces[index++], 0.0);
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), m->M(i), forces[index++], 0.0);
+		}
+	}
+	ASSERT_EQUAL(forces.size(), index);
+
+	delete container;
+}
+
+/**
+ * Analytic LJ potential u and scalar force f = -dU/dr of a pair at the distance r, truncated at rc as given
+ * by truncation, or truncated and shifted for nullptr.
+ */
+static void VectorizedCellProcessorTest__truncatedLJ(double eps, double sigma, double rc, const LJTruncation* truncation,
+		double r, double& u, double& f) {
+	u = f = 0.0;
+	if (r >= rc) {
+		return;
+	}
+	const double s6 = std::pow(sigma / r, 6), sc6 = std::pow(sigma / rc, 6);
+	u = 4.0 * eps * (s6 * s6 - s6);
+	f = 24.0 * eps / r * (2.0 * s6 * s6 - s6);
+	const double u_rc = 4.0 * eps * (sc6 * sc6 - sc6);
+	const double f_rc = 24.0 * eps / rc * (2.0 * sc6 * sc6 - sc6);
+	if (truncation == nullptr) {
+		u -= u_rc;
+	} else if (truncation->type == LJTruncation::FORCE_SHIFTED) {
+		u += (r - rc) * f_rc - u_rc;
+		f -= f_rc;
+	} else if (r > truncation->radiusSwitch) {
+		const double r2 = r * r, rc2 = rc * rc, rs2 = truncation->radiusSwitch * truncation->radiusSwitch;
+		const double d3 = (rc2 - rs2) * (rc2 - rs2) * (rc2 - rs2);
+		const double S = (rc2 - r2) * (rc2 - r2) * (rc2 + 2.0 * r2 - 3.0 * rs2) / d3;
+		const double dSdr = 12.0 * r * (rc2 - r2) * (rs2 - r2) / d3;
+		f = S * f - dSdr * u;
+		u = S * u;
+	}
+}
+
+void VectorizedCellProcessorTest::testLJTruncations() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testLJTruncations()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	const double ScenarioCutoff = 1.4;
+	const double RadiusSwitch = 1.1;
+	const char filename[] = {"VectorizationLJTruncations.inp"};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	std::vector<Component>& components = *(global_simulation->getEnsemble()->getComponents());
+
+	LJTruncation forceShifted;
+	forceShifted.type = LJTruncation::FORCE_SHIFTED;
+	forceShifted.allPairs = true;
+	forceShifted.cid1 = forceShifted.cid2 = 0;
+	forceShifted.radiusSwitch = 0.0;
+	LJTruncation switched = forceShifted;
+	switched.type = LJTruncation::SWITCHED;
+	switched.radiusSwitch = RadiusSwitch;
+	// mixed: force-shifted within the first component, switched between the components,
+	// truncated and shifted within the second one (no force shift and no switching in the tables)
+	LJTruncation forceShifted11 = forceShifted;
+	forceShifted11.allPairs = false;
+	LJTruncation switched12 = switched;
+	switched12.allPairs = false;
+	switched12.cid2 = 1;
+	const std::vector<std::vector<LJTruncation> > scenarios = {{forceShifted}, {switched}, {forceShifted11, switched12}};
+
+	std::vector<unsigned long> ids;
+	std::vector<std::array<double, 3> > positions;
+	std::vector<unsigned> cids;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		ids.push_back(m->getID());
+		positions.push_back({{m->r(0), m->r(1), m->r(2)}});
+		cids.push_back(m->componentid());
+	}
+	const size_t numMolecules = ids.size();
+
+	for (const std::vector<LJTruncation>& truncations : scenarios) {
+		global_simulation->setLJTruncations(truncations);
+
+		// analytic pair sum, the scales sum up the magnitudes of the pair contributions
+		std::vector<std::array<double, 3> > forces(numMolecules, {{0.0, 0.0, 0.0}});
+		std::vector<double> forceScales(numMolecules, 0.0);
+		double u_pot = 0.0, u_potScale = 0.0, virial = 0.0, virialScale = 0.0;
+		for (size_t i = 0; i < numMolecules; ++i) {
+			for (size_t j = i + 1; j < numMolecules; ++j) {
+				const LJcenter& ljc_i = components[cids[i]].ljcenter(0);
+				const LJcenter& ljc_j = components[cids[j]].ljcenter(0);
+				const LJTruncation* truncation = nullptr;
+				for (const LJTruncation& t : truncations) {
+					if (t.appliesTo(cids[i], cids[j])) {
+						truncation = &t;
+					}
+				}
+				double d[3], r2 = 0.0;
+				for (int k = 0; k < 3; ++k) {
+					d[k] = positions[i][k] - positions[j][k];
+					r2 += d[k] * d[k];
+				}
+				const double r = std::sqrt(r2);
+				double u, f;
+				VectorizedCellProcessorTest__truncatedLJ(std::sqrt(ljc_i.eps() * ljc_j.eps()), 0.5 * (ljc_i.sigma() + ljc_j.sigma()),
+						ScenarioCutoff, truncation, r, u, f);
+				for (int k = 0; k < 3; ++k) {
+					forces[i][k] += f * d[k] / r;
+					forces[j][k] -= f * d[k] / r;
+				}
+				forceScales[i] += std::abs(f);
+				forceScales[j] += std::abs(f);
+				u_pot += u;
+				u_potScale += std::abs(u);
+				virial += r * f;
+				virialScale += std::abs(r * f);
+			}
+		}
+
+		const int precisions[] = {VCP_SPSP, VCP_SPDP, VCP_DPDP};
+		for (int precision : precisions) {
+			// relative tolerance
+			const double Tolerance = (precision == VCP_DPDP and VCP_PREC == VCP_DPDP) ? 1e-10 : 1e-5;
+			VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff, precision);
+			container->updateMoleculeCaches();
+			container->traverseCells(vectorized_cell_proc);
+
+			size_t index = 0;
+			for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m, ++index) {
+				ASSERT_EQUAL(ids[index], m->getID());
+				m->calcFM();
+				for (int k = 0; k < 3; k++) {
+					std::stringstream str;
+					str << VectorizedCellProcessor::precisionToString(precision) << " truncations " << truncations.size()
+							<< " type " << truncations[0].type << " Molecule id=" << m->getID() << " index k=" << k << std::endl;
+					ASSERT_DOUBLES_EQUAL_MSG(str.str(), forces[index][k], m->F(k), Tolerance * std::max(1.0, forceScales[index]));
+				}
+			}
+			ASSERT_EQUAL(numMolecules, index);
+			ASSERT_DOUBLES_EQUAL(u_pot, _domain->getLocalUpot(), Tolerance * std::max(1.0, u_potScale));
+			ASSERT_DOUBLES_EQUAL(virial, _domain->getLocalVirial(), Tolerance * std::max(1.0, virialScale));
+		}
+	}
+
+#if defined(MARDYN_DPDP)
+	// a single pair of the first component along a skewed direction, the second molecule gets the force f * direction;
+	// the distances next to the cutoff radius need the positions in double precision
+	const double direction[3] = {2.0 / 3.0, 1.0 / 3.0, 2.0 / 3.0};
+	auto calculatePair = [&](double r, double& u, double& f) {
+		container->clear();
+		Molecule m1(1, &components[0], 1.0, 1.0, 1.0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+		Molecule m2(2, &components[0], 1.0 + r * direction[0], 1.0 + r * direction[1], 1.0 + r * direction[2],
+				0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+		container->addParticle(m1);
+		container->addParticle(m2);
+		container->update();
+		container->updateMoleculeCaches();
+		VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff, VCP_DPDP);
+		container->traverseCells(vectorized_cell_proc);
+		f = 0.0;
+		for (auto m = container->iterator(); m.isValid(); ++m) {
+			m->calcFM();
+			if (m->getID() == 2) {
+				for (int k = 0; k < 3; k++) {
+					f += m->F(k) * direction[k];
+				}
+			}
+		}
+		u = _domain->getLocalUpot();
+	};
+
+	const double sigma = components[0].ljcenter(0).sigma();
+	const double eps = components[0].ljcenter(0).eps();
+	const double inside = ScenarioCutoff * (1.0 - 1e-8), outside = ScenarioCutoff * (1.0 + 1e-8);
+	double u, f, u_ref, f_ref;
+
+	// the truncated and shifted potential is continuous, but not its force,
+	// so u only vanishes to first order in the distance to the cutoff radius
+	global_simulation->setLJTruncations(std::vector<LJTruncation>());
+	calculatePair(inside, u, f);
+	VectorizedCellProcessorTest__truncatedLJ(eps, sigma, ScenarioCutoff, nullptr, inside, u_ref, f_ref);
+	ASSERT_DOUBLES_EQUAL(u_ref, u, 1e-10);
+	ASSERT_TRUE(std::abs(u) < 1e-6);
+	ASSERT_DOUBLES_EQUAL(f_ref, f, 1e-10);
+	ASSERT_TRUE(std::abs(f) > 1e-3);
+
+	for (const LJTruncation& truncation : {forceShifted, switched}) {
+		global_simulation->setLJTruncations(std::vector<LJTruncation>(1, truncation));
+		calculatePair(inside, u, f);
+		ASSERT_DOUBLES_EQUAL(0.0, u, 1e-8);
+		ASSERT_DOUBLES_EQUAL(0.0, f, 1e-6);
+		calculatePair(outside, u, f);
+		ASSERT_DOUBLES_EQUAL(0.0, u, 0.0);
+		ASSERT_DOUBLES_EQUAL(0.0, f, 0.0);
+	}
+
+	// S = 1 below radiusSwitch: the plain LJ potential without shift
+	global_simulation->setLJTruncations(std::vector<LJTruncation>(1, switched));
+	for (double r : {0.95, 1.05, RadiusSwitch * (1.0 - 1e-8)}) {
+		calculatePair(r, u, f);
+		const double s6 = std::pow(sigma / r, 6);
+		u_ref = 4.0 * eps * (s6 * s6 - s6);
+		f_ref = 24.0 * eps / r * (2.0 * s6 * s6 - s6);
+		ASSERT_DOUBLES_EQUAL(u_ref, u, 1e-10 * std::max(1.0, std::abs(u_ref)));
+		ASSERT_DOUBLES_EQUAL(f_ref, f, 1e-10 * std::max(1.0, std::abs(f_ref)));
+	}
+#endif
+
+	global_simulation->setLJTruncations(std::vector<LJTruncation>());
+	delete container;
+}
+
+void VectorizedCellProcessorTest::testTabulatedMieLennardJones() {
+	testTabulatedMie("VectorizationLennardJonesEqualCenters.inp", 35.0);
+}
+
+void VectorizedCellProcessorTest::testTabulatedMie1CLJ() {
+	testTabulatedMie("VectorizationLennardJones1CLJ.inp", 35.0);
+}
+
+void VectorizedCellProcessorTest::testTabulatedMie(const char* filename, double ScenarioCutoff) {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testTabulatedMie()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	// the table is interpolated with cubic Hermite splines in r^2, fine enough that the rounding errors dominate
+	const unsigned Nodes = 20000;
+	// on AVX-512, the single-site input runs the packed kernel with the table (vcompress/vexpand, in mixed
+	// precision split into two halves of the mask) and the masked kernel with LJ, so all precisions are compared
+	const int precisions[] = {VCP_SPSP, VCP_SPDP, VCP_DPDP};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+
+	// reference: plain LJ kernel in every precision
+	std::vector<std::vector<std::array<double, 9> > > ljFMVi;
+	std::vector<double> ljUpot, ljVirial, scales;
+	for (int precision : precisions) {
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->clearFM();
+		}
+		{
+			VectorizedCellProcessor ljCellProc(*_domain, ScenarioCutoff, ScenarioCutoff, precision);
+			container->updateMoleculeCaches();
+			container->traverseCells(ljCellProc);
+		}
+		ljFMVi.push_back(std::vector<std::array<double, 9> >());
+		for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+			m->calcFM();
+			ljFMVi.back().push_back({m->F(0), m->F(1), m->F(2), m->M(0), m->M(1), m->M(2), m->Vi(0), m->Vi(1), m->Vi(2)});
+		}
+		ljUpot.push_back(_domain->getLocalUpot());
+		ljVirial.push_back(_domain->getLocalVirial());
+
+		// the largest absolute value of a force, torque or virial component serves as scale of the tolerance,
+		// as small components of a molecule are sums of large, cancelling pair contributions
+		double scale = 0.0;
+		for (const std::array<double, 9>& fmvi : ljFMVi.back()) {
+			for (double x : fmvi) {
+				scale = std::max(scale, std::abs(x));
+			}
+		}
+		ASSERT_TRUE(scale > 0.0);
+		scales.push_back(scale);
+	}
+
+	const LJcenter& ljCenter = global_simulation->getEnsemble()->getComponent(0)->ljcenter(0);
+	TabulatedPotential mie;
+	mie.setMie(0, 0, ljCenter.eps(), ljCenter.sigma(), 12.0, 6.0);
+	mie.setShifted(false);
+	mie.setNodes(Nodes);
+	global_simulation->getEnsemble()->addTabulatedPotential(mie);
+
+	for (size_t p = 0; p < ljFMVi.size(); ++p) {
+		const double Tolerance = (precisions[p] == VCP_DPDP and VCP_PREC == VCP_DPDP) ? 1e-6 : 1e-4;
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->clearFM();
+		}
+		{
+			VectorizedCellProcessor mieCellProc(*_domain, ScenarioCutoff, ScenarioCutoff, precisions[p]);
+			container->updateMoleculeCaches();
+			container->traverseCells(mieCellProc);
+		}
+		size_t i = 0;
+		for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m, ++i) {
+			m->calcFM();
+			const std::array<double, 9> mieFMVi = {m->F(0), m->F(1), m->F(2), m->M(0), m->M(1), m->M(2),
+					m->Vi(0), m->Vi(1), m->Vi(2)};
+			for (int d = 0; d < 9; ++d) {
+				std::stringstream str;
+				str << VectorizedCellProcessor::precisionToString(precisions[p]) << " Molecule id=" << m->getID()
+						<< " F, M, Vi index=" << d << std::endl;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), ljFMVi[p][i][d], mieFMVi[d], Tolerance * scales[p]);
+			}
+		}
+		ASSERT_EQUAL(ljFMVi[p].size(), i);
+
+		ASSERT_DOUBLES_EQUAL(ljUpot[p], _domain->getLocalUpot(), Tolerance * std::abs(ljUpot[p]));
+		ASSERT_DOUBLES_EQUAL(ljVirial[p], _domain->getLocalVirial(), Tolerance * std::abs(ljVirial[p]));
+	}
+
+	delete container;
+}
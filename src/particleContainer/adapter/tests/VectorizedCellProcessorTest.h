@@ -22,6 +22,9 @@ class VectorizedCellProcessorTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testForcePotentialCalculationF0);
 
 	TEST_METHOD(testLennardJonesVectorization);
+	TEST_METHOD(testLennardJones1CLJVectorization);
+	TEST_METHOD(testLennardJonesChargeVectorization);
+	TEST_METHOD(testLennardJonesCharge1CLJVectorization);
 
 	TEST_METHOD(testChargeChargeVectorization);
 	TEST_METHOD(testChargeDipoleVectorization);
@@ -36,6 +39,26 @@ class VectorizedCellProcessorTest : public utils::TestWithSimulationSetup {
 
 	TEST_METHOD(testMultiComponentMultiPotentials);
 
+	TEST_METHOD(testVerletLists);
+
+	TEST_METHOD(testFusedHalfKick);
+
+	TEST_METHOD(testCompactHaloCells);
+
+	TEST_METHOD(testPrecisions);
+
+	TEST_METHOD(testRelativePositions);
+
+	TEST_METHOD(testSinglePrecisionFootprint);
+
+	TEST_METHOD(testSingleMolecule);
+
+	TEST_METHOD(testLJTruncations);
+
+	TEST_METHOD(testTabulatedMieLennardJones);
+
+	TEST_METHOD(testTabulatedMie1CLJ);
+
 	TEST_SUITE_END();
 
 public:
@@ -73,6 +96,24 @@ public:
 	 */
 	void testLennardJonesVectorization();
 
+	/**
+	 * Same as testLennardJonesVectorization, but for a single-site LJ component,
+	 * for which the VectorizedCellProcessor uses its single-site LJ kernel.
+	 */
+	void testLennardJones1CLJVectorization();
+
+	/**
+	 * Components with charges at all of their LJ centers,
+	 * which the VectorizedCellProcessor calculates in the LJ loop.
+	 */
+	void testLennardJonesChargeVectorization();
+
+	/**
+	 * Same as testLennardJonesChargeVectorization, but for single-site LJ components
+	 * with a charge at the center, i.e. for the single-site LJ kernel.
+	 */
+	void testLennardJonesCharge1CLJVectorization();
+
 	/**
 	 * Generic test routine for all electrostatic interactions.
 	 * Which test is run is dependent on filename,
@@ -120,5 +161,79 @@ public:
 	 */
 	void testMultiComponentMultiPotentials();
 
+	/**
+	 * Computes the forces with Verlet lists, moves the molecules by less than half the skin,
+	 * so that some of the lists are reused, and compares the resulting forces to a computation
+	 * without Verlet lists.
+	 */
+	void testVerletLists();
+
+	/**
+	 * Applies the second half step of the leapfrog integrator once after the force calculation
+	 * and once fused into the traversal (VectorizedCellProcessor::setFusedHalfKick()) and
+	 * compares the resulting velocities and angular momenta.
+	 */
+	void testFusedHalfKick();
+
+	/**
+	 * Populates the halo once with full molecules and once with compact halo copies
+	 * (LinkedCells::setCompactHaloCells()) and compares the forces, torques and virials
+	 * of the inner molecules as well as the potential and virial.
+	 */
+	void testCompactHaloCells();
+
+	/**
+	 * Computes the forces, torques and virials once in the precision of the build and twice
+	 * in each of the precisions SINGLE, MIXED and DOUBLE, which may compute on converted copies
+	 * of the SoA caches, and compares them within the accuracy of the precision.
+	 */
+	void testPrecisions();
+
+	/**
+	 * Converts a SoA cache with positions far from the origin into single precision and checks that the
+	 * positions of the copy are relative to the cell and keep the precision of the original.
+	 */
+	void testRelativePositions();
+
+	/**
+	 * Converts a SoA cache of LJ centers into a MIXED copy and checks that its positions take
+	 * sizeof(float) and its forces and virials sizeof(double) bytes per coordinate.
+	 */
+	void testSinglePrecisionFootprint();
+
+	/**
+	 * Computes the energies of test deletions and insertions (LinkedCells::getEnergy()) once with the
+	 * Legacy- and once with the VectorizedCellProcessor and compares them. Checks that the test molecules
+	 * change neither the forces nor the potential and virial of the preceding force calculation.
+	 */
+	void testSingleMolecule();
+
+	/**
+	 * Computes the forces, the potential and the virial of two LJ components with force-shifted, switched
+	 * and per pair of components mixed (force-shifted, switched, truncated and shifted) LJ potentials in all
+	 * precisions and compares them to an analytic pair sum. For a single pair, checks that the potential and
+	 * the force are continuous at the cutoff radius and that the switching function is 1 below radiusSwitch.
+	 */
+	void testLJTruncations();
+
+	/**
+	 * Replaces the LJ potential of the two component 0 centers of a 2CLJ input by a tabulated Mie 12-6
+	 * potential with the same parameters and compares the forces, torques, the potential and the virial
+	 * to those of the plain LJ kernel. LJ centers further apart than the cutoff radius of a pair of
+	 * molecules within the cutoff radius must be covered by the table, too.
+	 */
+	void testTabulatedMieLennardJones();
+
+	/**
+	 * As testTabulatedMieLennardJones, but for a single-site LJ input.
+	 */
+	void testTabulatedMie1CLJ();
+
+	/**
+	 * Compares the plain LJ kernel to a tabulated Mie 12-6 potential with the parameters of the first
+	 * LJ center of component 0 in all precisions. All LJ centers of the input must have these parameters and no shift.
+	 */
+	void testTabulatedMie(const char* filename, double ScenarioCutoff);
+
 };
 #endif /* VECTORIZEDCELLPROCESSORTEST_H_ */
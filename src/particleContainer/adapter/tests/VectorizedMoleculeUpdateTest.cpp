@@ -0,0 +1,132 @@
+/**
+ * \file
+ * \brief VectorizedMoleculeUpdateTest.cpp
+ */
+
+#include "VectorizedMoleculeUpdateTest.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <set>
+#include <sstream>
+
+#include "Domain.h"
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/LinkedCells.h"
+#include "particleContainer/ParticleCell.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
+#include "particleContainer/adapter/VectorizedMoleculeUpdate.h"
+
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+TEST_SUITE_REGISTRATION(VectorizedMoleculeUpdateTest);
+#else
+#pragma message "Compilation info: VectorizedMoleculeUpdateTest disabled in reduced memory mode"
+#endif
+
+VectorizedMoleculeUpdateTest::VectorizedMoleculeUpdateTest() {
+}
+
+VectorizedMoleculeUpdateTest::~VectorizedMoleculeUpdateTest() {
+}
+
+void VectorizedMoleculeUpdateTest::testMultiComponentMultiPotentials() {
+	testCalcFMUpdPostF("VectorizationMultiComponentMultiPotentials_50_molecules.inp", 35.0);
+}
+
+void VectorizedMoleculeUpdateTest::testWater() {
+	testCalcFMUpdPostF("VectorizationWater.inp", 6.16);
+}
+
+void VectorizedMoleculeUpdateTest::testCalcFMUpdPostF(const char* filename, double ScenarioCutoff) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedMoleculeUpdateTest::testCalcFMUpdPostF()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	const double Tolerance = 1e-12;
+#else
+	// the arms of the sites are differences of single precision positions
+	const double Tolerance = 1e-5;
+#endif
+	const double dtHalf = 0.005;
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, ScenarioCutoff);
+	LinkedCells* linkedCells = dynamic_cast<LinkedCells*>(container);
+	ASSERT_TRUE(linkedCells != nullptr);
+	VectorizedCellProcessor vectorized_cell_proc(*_domain, ScenarioCutoff, ScenarioCutoff);
+
+	// per molecule ID: F, M, Vi, v, D, mv2 and Iw2
+	typedef std::array<double, 17> Values;
+	std::map<unsigned long, Values> initialValues, expectedValues;
+	std::set<unsigned long> cellIndices;
+
+	container->updateMoleculeCaches();
+	container->traverseCells(vectorized_cell_proc);
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		Values& initial = initialValues[m->getID()];
+		for (int d = 0; d < 3; ++d) {
+			initial[9 + d] = m->v(d);
+			initial[12 + d] = m->D(d);
+		}
+		cellIndices.insert(linkedCells->getCellIndexOfMolecule(&(*m)));
+
+		double mv2 = 0.0, Iw2 = 0.0;
+		m->calcFM();
+		m->upd_postF(dtHalf, mv2, Iw2);
+		Values& expected = expectedValues[m->getID()];
+		for (int d = 0; d < 3; ++d) {
+			expected[d] = m->F(d);
+			expected[3 + d] = m->M(d);
+			expected[6 + d] = m->Vi(d);
+			expected[9 + d] = m->v(d);
+			expected[12 + d] = m->D(d);
+		}
+		expected[15] = mv2;
+		expected[16] = Iw2;
+	}
+
+	// restore the molecules and calculate the same site forces again
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		const Values& initial = initialValues[m->getID()];
+		for (int d = 0; d < 3; ++d) {
+			m->setv(d, initial[9 + d]);
+			m->setD(d, initial[12 + d]);
+		}
+		m->clearFM();
+	}
+	container->updateMoleculeCaches();
+	container->traverseCells(vectorized_cell_proc);
+
+	VectorizedMoleculeUpdate update(*(global_simulation->getEnsemble()->getComponents()));
+	size_t numMolecules = 0;
+	for (unsigned long cellIndex : cellIndices) {
+		FullParticleCell& cell = downcastCellReferenceFull(linkedCells->getCellReference(cellIndex));
+		ASSERT_TRUE(not cell.isHaloCell());
+		update.calcFM(cell);
+		update.upd_postF(cell, dtHalf);
+
+		size_t i = 0;
+		for (auto m = cell.iterator(); m.isValid(); ++m, ++i) {
+			const Values actual = {m->F(0), m->F(1), m->F(2), m->M(0), m->M(1), m->M(2), m->Vi(0), m->Vi(1), m->Vi(2),
+					m->v(0), m->v(1), m->v(2), m->D(0), m->D(1), m->D(2), update.mv2(i), update.Iw2(i)};
+			const Values& expected = expectedValues[m->getID()];
+			for (size_t k = 0; k < actual.size(); ++k) {
+				std::stringstream str;
+				str << "Molecule id=" << m->getID() << " F, M, Vi, v, D, mv2, Iw2 index=" << k << std::endl;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), expected[k], actual[k], Tolerance * std::max(1.0, std::abs(expected[k])));
+			}
+		}
+		numMolecules += i;
+	}
+	ASSERT_EQUAL(expectedValues.size(), numMolecules);
+
+	delete container;
+#endif /* ENABLE_REDUCED_MEMORY_MODE */
+}
@@ -0,0 +1,51 @@
+/**
+ * \file
+ * \brief VectorizedMoleculeUpdateTest.h
+ */
+
+#ifndef SRC_PARTICLECONTAINER_ADAPTER_TESTS_VECTORIZEDMOLECULEUPDATETEST_H_
+#define SRC_PARTICLECONTAINER_ADAPTER_TESTS_VECTORIZEDMOLECULEUPDATETEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+class VectorizedMoleculeUpdateTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(VectorizedMoleculeUpdateTest);
+
+	TEST_METHOD(testMultiComponentMultiPotentials);
+
+	TEST_METHOD(testWater);
+
+	TEST_SUITE_END();
+
+public:
+	VectorizedMoleculeUpdateTest();
+
+	virtual ~VectorizedMoleculeUpdateTest();
+
+	/**
+	 * Two components, one with LJ center, charge, dipole and quadrupole and a moment of inertia of zero
+	 * about its axis, the other one a water model.
+	 *
+	 * @see testCalcFMUpdPostF
+	 */
+	void testMultiComponentMultiPotentials();
+
+	/**
+	 * A water model with LJ center and three charges.
+	 *
+	 * @see testCalcFMUpdPostF
+	 */
+	void testWater();
+
+	/**
+	 * Calculates the site forces with the VectorizedCellProcessor and compares force, torque, virial,
+	 * velocity and angular momentum of each molecule and the contributions to summv2 and sumIw2 after
+	 * VectorizedMoleculeUpdate::calcFM() and upd_postF() for each cell to those after Molecule::calcFM()
+	 * and Molecule::upd_postF() for each molecule.
+	 */
+	void testCalcFMUpdPostF(const char* filename, double ScenarioCutoff);
+
+};
+
+#endif /* SRC_PARTICLECONTAINER_ADAPTER_TESTS_VECTORIZEDMOLECULEUPDATETEST_H_ */
@@ -1,5 +1,8 @@
 #include "SIMD_TYPES.h"
 
+// in the namespace of the vector classes, since they differ between the instruction sets and precisions (see VCP_NAMESPACE)
+namespace VCP_NAMESPACE {
+
 class MaskingChooser {
 private:
 	MaskCalcVec compute_molecule=MaskCalcVec::zero();
@@ -18,6 +21,14 @@ public:
 		compute_molecule = compute_molecule or forceMask;
 	}
 
+	//! mark the centers [j_begin, j_end) as not to be computed
+	inline void storeEmptyCalcDistLookups(size_t j_begin, size_t j_end){
+		const MaskCalcVec zero = MaskCalcVec::zero();
+		for (size_t j = j_begin; j < j_end; j += VCP_VEC_SIZE) {
+			zero.aligned_store(storeCalcDistLookupLocation + j/VCP_INDICES_PER_LOOKUP_SINGLE);
+		}
+	}
+
 	inline static size_t getEndloop(const size_t& long_loop, const countertype32& /*number_calculate*/ /* number of interactions, that are calculated*/) {
 		return long_loop;
 	}
@@ -101,6 +112,18 @@ public:
 		indices = _mm512_add_epi32(indices, advance);
 		counter += __builtin_popcount(forceMask);
 	}
+
+	//! skip the centers [j_begin, j_end), i.e. only advance the indices
+	inline void storeEmptyCalcDistLookups(size_t j_begin, size_t j_end){
+		if (j_end <= j_begin) {
+			return;
+		}
+		#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+			indices = _mm512_add_epi32(indices, _mm512_set1_epi32(j_end - j_begin));
+		#else /* VCP_DPDP */
+			indices = _mm512_mask_add_epi32(indices, static_cast<__mmask16>(0x00FF), indices, _mm512_set1_epi32(j_end - j_begin));
+		#endif
+	}
 	inline int getCount(){
 		return counter;
 	}
@@ -214,4 +237,8 @@ public:
 	vcp_inline void storeCalcDistLookup(size_t j, MaskCalcVec forceMask) {
 		_numUnmasked += forceMask.countUnmasked();
 	}
+
+	vcp_inline void storeEmptyCalcDistLookups(size_t /*j_begin*/, size_t /*j_end*/) {}
 };
+
+} /* namespace VCP_NAMESPACE */
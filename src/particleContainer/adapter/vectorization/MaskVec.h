@@ -10,13 +10,13 @@
 
 #include "./SIMD_TYPES.h"
 
-namespace vcp {
+namespace VCP_NAMESPACE {
 
 template<typename FloatOrDouble>
 class MaskVec {
 };
 
-} /* namespace vcp */
+} /* namespace VCP_NAMESPACE */
 
 // SPECIALIZATIONS: suggested to view via vimdiff
 #include "MaskVecFloat.h"
@@ -12,7 +12,7 @@
 
 // keep this file and MaskVecFloat as close as possible, so that they can be examined via diff!
 
-namespace vcp {
+namespace VCP_NAMESPACE {
 
 template<>
 class MaskVec<double> {
@@ -179,6 +179,6 @@ public:
 	}
 };
 
-} /* namespace vcp */
+} /* namespace VCP_NAMESPACE */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_MASKVECDOUBLE_H_ */
@@ -12,7 +12,7 @@
 
 // keep this file and MaskVecDouble as close as possible, so that they can be examined via diff!
 
-namespace vcp {
+namespace VCP_NAMESPACE {
 
 template<>
 class MaskVec<float> {
@@ -179,6 +179,6 @@ public:
 	}
 };
 
-} /* namespace vcp */
+} /* namespace VCP_NAMESPACE */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_MASKVECFLOAT_H_ */
@@ -10,7 +10,7 @@
 
 #include "RealVec.h"
 
-namespace vcp {
+namespace VCP_NAMESPACE {
 
 #if VCP_VEC_WIDTH != VCP_VEC_W__64
 // the novec case is handled differently, as it requires only one RealVec<double> to store its results.
@@ -322,6 +322,6 @@ public:
 
 #endif /* VCP_VEC_WIDTH */
 
-} /* namespace vcp */
+} /* namespace VCP_NAMESPACE */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_REALACCUMVECSPDP_H_ */
@@ -16,13 +16,13 @@
 
 #include "utils/Logger.h"
 
-namespace vcp {
+namespace VCP_NAMESPACE {
 
 template<typename FloatOrDouble>
 class RealVec {
 }; /* class RealVec */
 
-} /* namespace vcp */
+} /* namespace VCP_NAMESPACE */
 
 // SPECIALIZATIONS: suggested to view via vimdiff
 #include "RealVecFloat.h"
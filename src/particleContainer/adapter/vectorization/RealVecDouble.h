@@ -12,7 +12,7 @@
 
 // keep this file and RealVecFloat as close as possible, so that they can be examined via diff!
 
-namespace vcp {
+namespace VCP_NAMESPACE {
 
 template<>
 class RealVec<double> {
@@ -542,6 +542,6 @@ public:
 
 }; /* class RealCalcVec */
 
-} /* namespace vcp */
+} /* namespace VCP_NAMESPACE */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_REALVECDOUBLE_H_ */
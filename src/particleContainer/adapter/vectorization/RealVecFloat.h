@@ -12,7 +12,7 @@
 
 // keep this file and RealVecDouble as close as possible, so that they can be examined via diff!
 
-namespace vcp {
+namespace VCP_NAMESPACE {
 
 template<>
 class RealVec<float> {
@@ -554,6 +554,6 @@ public:
 
 }; /* class RealCalcVec */
 
-} /* namespace vcp */
+} /* namespace VCP_NAMESPACE */
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_REALVECFLOAT_H_ */
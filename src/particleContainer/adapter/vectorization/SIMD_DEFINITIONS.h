@@ -12,49 +12,47 @@
 #ifndef  SIMD_DEFINITIONS_H
 #define  SIMD_DEFINITIONS_H
 
-#if defined(__GNUC__)
-#define vcp_inline inline __attribute__((always_inline))
-#else
-#define vcp_inline inline
-#endif
-
 #ifdef IN_IDE_PARSER //just for the ide parser include the simd_types.h -- normally this is not done.
     #include "./SIMD_TYPES.h"
 #endif
 
 #include "RealVec.h"
 
-namespace vcp {
+namespace VCP_NAMESPACE {
 	typedef MaskVec<vcp_real_calc> MaskCalcVec;
 	typedef RealVec<vcp_real_calc> RealCalcVec;
 }
 
 #if VCP_PREC == VCP_SPDP
 #include "RealAccumVecSPDP.h"
-namespace vcp {
+namespace VCP_NAMESPACE {
 	typedef RealAccumVecSPDP RealAccumVec;
 }
 #else
-namespace vcp {
+namespace VCP_NAMESPACE {
 	typedef RealCalcVec RealAccumVec;
 }
 #endif
 
 // use constexpr instead of conditional compilation to death:
 
-constexpr size_t VCP_VEC_SIZE = sizeof(vcp::RealCalcVec) / sizeof(vcp_real_calc);
+namespace VCP_NAMESPACE {
+
+constexpr size_t VCP_VEC_SIZE = sizeof(VCP_NAMESPACE::RealCalcVec) / sizeof(vcp_real_calc);
 constexpr size_t VCP_VEC_SIZE_M1 = VCP_VEC_SIZE - 1u;
 
 constexpr size_t VCP_INDICES_PER_LOOKUP_SINGLE    = (VCP_VEC_TYPE != VCP_VEC_KNL) and (VCP_VEC_TYPE != VCP_VEC_AVX512F) ? 1u : VCP_VEC_SIZE;
 constexpr size_t VCP_INDICES_PER_LOOKUP_SINGLE_M1 = (VCP_VEC_TYPE != VCP_VEC_KNL) and (VCP_VEC_TYPE != VCP_VEC_AVX512F) ? 0u : VCP_VEC_SIZE_M1;
 
-constexpr size_t VCP_ALIGNMENT = (VCP_VEC_TYPE != VCP_NOVEC) ? sizeof(vcp::RealCalcVec) : 8u;
+constexpr size_t VCP_ALIGNMENT = (VCP_VEC_TYPE != VCP_NOVEC) ? sizeof(VCP_NAMESPACE::RealCalcVec) : 8u;
+
+} /* namespace VCP_NAMESPACE */
 
 #include <cmath>
 #include "sys/types.h"
 
 
-using namespace vcp;
+using namespace VCP_NAMESPACE;
 
 /*
  * Check whether the file SIMD_TYPES.hpp has been included.
@@ -64,6 +62,8 @@ using namespace vcp;
     #error "SIMD_DEFINITIONS included without SIMD_TYPES! Never include this file directly! Include it only via SIMD_TYPES!"
 #endif /* defined SIMD_TYPES_H */
 
+namespace VCP_NAMESPACE {
+
 #if VCP_VEC_TYPE==VCP_NOVEC
 	static vcp_inline MaskCalcVec vcp_simd_getInitMask(const size_t& /*i*/){
 		return true;
@@ -195,4 +195,6 @@ static vcp_inline T vcp_floor_to_vec_size(const T& num){
 	return num & (~static_cast<T>(VCP_VEC_SIZE_M1));
 }
 
+} /* namespace VCP_NAMESPACE */
+
 #endif /* SIMD_DEFINITIONS_H */
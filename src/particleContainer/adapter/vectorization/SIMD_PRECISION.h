@@ -0,0 +1,54 @@
+/***********************************************************************************//**
+ *
+ * \file SIMD_PRECISION.h
+ *
+ * \brief Defines the precision of the vectorized force calculation
+ *
+ * \details Everything in here is independent of the instruction set, so that headers
+ * that only need the floating point types (e.g. CellDataSoA.h) can be shared by
+ * kernels compiled for different instruction sets (see VCP_DISPATCH).
+ *
+ **************************************************************************************/
+#pragma once
+#ifndef  SIMD_PRECISION_H
+#define  SIMD_PRECISION_H
+
+#include <type_traits>
+#include <cstdint>
+
+// definitions for precision:
+#if defined(VCP_SPSP) or \
+	defined(VCP_SPDP) or \
+	defined(VCP_DPDP)
+	#error conflicting precision definitions
+#endif
+
+#define VCP_SPSP 0
+#define VCP_SPDP 1
+#define VCP_DPDP 2
+
+#if defined(MARDYN_SPSP)
+	#define VCP_PREC VCP_SPSP
+#elif defined(MARDYN_SPDP)
+	#define VCP_PREC VCP_SPDP
+#elif defined(MARDYN_DPDP)
+	#define VCP_PREC VCP_DPDP
+#else
+	#error Precision macro not defined.
+#endif
+
+#if defined(__GNUC__)
+#define vcp_inline inline __attribute__((always_inline))
+#else
+#define vcp_inline inline
+#endif
+
+// define necessary types
+
+typedef std::conditional<VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP, float, double>::type vcp_real_calc;
+typedef std::conditional<VCP_PREC == VCP_SPSP                        , float, double>::type vcp_real_accum;
+typedef std::conditional<VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP, uint32_t, uint64_t>::type vcp_ljc_id_t;
+
+typedef int countertype32;//int is 4Byte almost everywhere... replace with __int32 if problems occur
+
+#endif /* SIMD_PRECISION_H */
@@ -11,28 +11,13 @@
 #ifndef  SIMD_TYPES_H
 #define  SIMD_TYPES_H
 
-#include <type_traits>
-#include <cstdint>
-
-// definitions for precision:
-#if defined(VCP_SPSP) or \
-	defined(VCP_SPDP) or \
-	defined(VCP_DPDP)
-	#error conflicting precision definitions
-#endif
-
-#define VCP_SPSP 0
-#define VCP_SPDP 1
-#define VCP_DPDP 2
+#include "SIMD_PRECISION.h"
 
-#if defined(MARDYN_SPSP)
-	#define VCP_PREC VCP_SPSP
-#elif defined(MARDYN_SPDP)
-	#define VCP_PREC VCP_SPDP
-#elif defined(MARDYN_DPDP)
-	#define VCP_PREC VCP_DPDP
-#else
-	#error Precision macro not defined.
+#if defined(VCP_DISPATCH_PREC)
+	// kernel compiled for a precision selected at run time (see VectorizedCellProcessor.h).
+	// The floating point types of this precision are defined in VCP_NAMESPACE below.
+	#undef VCP_PREC
+	#define VCP_PREC VCP_DISPATCH_PREC
 #endif
 
 // The following error should NEVER occur, since it signalizes, that the macros, used by THIS translation unit are defined anywhere else in the program.
@@ -61,7 +46,11 @@
 #endif
 
 // define symbols for vectorization
-#if defined(__AVX512F__) && defined(__AVX512ER__)
+#if defined(VCP_DISPATCH_VEC_TYPE)
+	// kernel compiled for an instruction set selected at run time (see VCP_DISPATCH in VectorizedCellProcessor.h).
+	// The target options of such a translation unit are not visible to the preprocessor.
+	#define VCP_VEC_TYPE VCP_DISPATCH_VEC_TYPE
+#elif defined(__AVX512F__) && defined(__AVX512ER__)
 	#if defined(__VCP_GATHER__)
 		#define VCP_VEC_TYPE VCP_VEC_KNL_GATHER
 	#else
@@ -85,7 +74,7 @@
 	#define VCP_VEC_TYPE VCP_NOVEC
 #endif
 
-#ifdef NOVEC
+#if defined(NOVEC) and not defined(VCP_DISPATCH_VEC_TYPE)
 	#ifdef VCP_VEC_TYPE
 		#warn Multiple vectorization methods specified. Will not use vectorization at all!
 		#undef VCP_VEC_TYPE
@@ -105,12 +94,6 @@
 
 // define necessary types
 
-typedef std::conditional<VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP, float, double>::type vcp_real_calc;
-typedef std::conditional<VCP_PREC == VCP_SPSP                        , float, double>::type vcp_real_accum;
-typedef std::conditional<VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP, uint32_t, uint64_t>::type vcp_ljc_id_t;
-
-typedef int countertype32;//int is 4Byte almost everywhere... replace with __int32 if problems occur
-
 #if VCP_VEC_TYPE==VCP_NOVEC //novec comes first. For NOVEC no specific types are specified -- use build in ones.
 
 	#define VCP_VEC_WIDTH VCP_VEC_W__64
@@ -167,6 +150,20 @@ typedef int countertype32;//int is 4Byte almost everywhere... replace with __int
 
 #endif
 
+// namespace of the vector classes. Kernels for other instruction sets or precisions put them into their own namespace.
+#ifndef VCP_NAMESPACE
+	#define VCP_NAMESPACE vcp
+#endif
+
+#if defined(VCP_DISPATCH_PREC)
+	// these hide the types of the precision of the build (SIMD_PRECISION.h) inside the namespace
+	namespace VCP_NAMESPACE {
+		typedef std::conditional<VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP, float, double>::type vcp_real_calc;
+		typedef std::conditional<VCP_PREC == VCP_SPSP                        , float, double>::type vcp_real_accum;
+		typedef std::conditional<VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP, uint32_t, uint64_t>::type vcp_ljc_id_t;
+	}
+#endif
+
 /*
  * Control macros are set
  *
@@ -14,6 +14,9 @@
 #include "SIMD_TYPES.h"
 #include "utils/AlignedArray.h"
 
+// in the namespace of the vector classes, since they differ between the instruction sets and precisions (see VCP_NAMESPACE)
+namespace VCP_NAMESPACE {
+
 /**
  * unpacks eps_24 and sig2 from the eps_sigI array according to the index array id_j (for mic+avx2: use gather)
  * @param eps_24 vector in which eps_24 is saved
@@ -337,6 +340,57 @@ void vcp_simd_load_sub_store_masked(vcp_real_accum * const addr, size_t offset,
 	MaskGatherChooser::storeMasked(addr, offset, sum, lookupORforceMask, mask);
 }
 
+#if VCP_VEC_TYPE==VCP_VEC_KNL or VCP_VEC_TYPE==VCP_VEC_AVX512F
+/*
+ * The packing helpers compress and expand in the registers and store or load a whole vector at the (unaligned)
+ * address, which is faster than vcompress/vexpand with a memory operand. So the buffers need one vector of
+ * padding behind the packed values.
+ */
+
+/**
+ * stores the elements of value, which are selected by mask, contiguously at addr (vcompress)
+ */
+static vcp_inline
+void vcp_simd_compress_store(vcp_real_calc * const addr, const RealCalcVec& value, const MaskCalcVec& mask) {
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		_mm512_storeu_ps(addr, _mm512_maskz_compress_ps(mask, value));
+	#else /* VCP_DPDP */
+		_mm512_storeu_pd(addr, _mm512_maskz_compress_pd(mask, value));
+	#endif
+}
+
+/**
+ * stores the ids at src (aligned), which are selected by mask, contiguously at addr (vcompress)
+ */
+static vcp_inline
+void vcp_simd_compress_store(vcp_ljc_id_t * const addr, const vcp_ljc_id_t * const src, const MaskCalcVec& mask) {
+	#if VCP_PREC == VCP_SPSP or VCP_PREC == VCP_SPDP
+		_mm512_storeu_si512(addr, _mm512_maskz_compress_epi32(mask, _mm512_load_epi32(src)));
+	#else /* VCP_DPDP */
+		_mm512_storeu_si512(addr, _mm512_maskz_compress_epi64(mask, _mm512_load_epi64(src)));
+	#endif
+}
+
+/**
+ * loads contiguous values from addr into the elements selected by mask, the others are zero (vexpand)
+ */
+static vcp_inline
+RealAccumVec vcp_simd_expand_load(const vcp_real_accum * const addr, const MaskCalcVec& mask) {
+	#if VCP_PREC == VCP_SPSP
+		return _mm512_maskz_expand_ps(mask, _mm512_loadu_ps(addr));
+	#elif VCP_PREC == VCP_SPDP
+		const __mmask8 mask_lo = static_cast<__mmask8>(mask);
+		const __mmask8 mask_hi = static_cast<__mmask8>(static_cast<__mmask16>(mask) >> 8);
+		const RealVec<double> first(_mm512_maskz_expand_pd(mask_lo, _mm512_loadu_pd(addr)));
+		const RealVec<double> second(_mm512_maskz_expand_pd(mask_hi, _mm512_loadu_pd(addr + __builtin_popcount(mask_lo))));
+		return RealAccumVec(first, second);
+	#else /* VCP_DPDP */
+		return _mm512_maskz_expand_pd(mask, _mm512_loadu_pd(addr));
+	#endif
+}
+#endif
+
+
 
 /**
  * \brief Policy class for single cell force calculation.
@@ -421,6 +475,21 @@ public:
 	}
 }; /* end of class CellPairPolicy_ */
 
+/**
+ * \brief Policy class for the energy of a test molecule with a cell (see VectorizedCellProcessor::processSingleMolecule()).
+ * \details Like CellPairPolicy_, but molecules at the position of the test molecule are skipped:
+ * the test molecule of a deletion is a copy of a molecule of the cell.
+ */
+template<bool ApplyCutoff>
+class SingleMoleculePolicy_ : public CellPairPolicy_<ApplyCutoff> {
+public:
+	vcp_inline static MaskCalcVec GetForceMask (const RealCalcVec& m_r2, const RealCalcVec& rc2, MaskCalcVec& j_mask)
+	{
+		return CellPairPolicy_<ApplyCutoff>::GetForceMask(m_r2, rc2, j_mask) and (m_r2 != RealCalcVec::zero());
+	}
+}; /* end of class SingleMoleculePolicy_ */
+
+
 /**
  * \brief The dist lookup for a molecule and all centers of a type
  */
@@ -472,4 +541,136 @@ static vcp_inline calcDistLookup (const size_t & i_center_idx, const size_t & so
 }
 
 
+/**
+ * \brief Like calcDistLookup, but additionally sets the bits of the Verlet list verletBlocks
+ * for all blocks of VCP_VEC_SIZE centers with at least one center closer than the list radius.
+ */
+template<class ForcePolicy, class MaskGatherChooser>
+countertype32
+static vcp_inline calcDistLookupBuildVerlet (const size_t & i_center_idx, const size_t & soa2_num_centers,
+		vcp_lookupOrMask_single* const soa2_center_dist_lookup, const vcp_real_calc* const soa2_m_r_x, const vcp_real_calc* const soa2_m_r_y, const vcp_real_calc* const soa2_m_r_z,
+		const RealCalcVec & cutoffRadiusSquareD, size_t end_j, const RealCalcVec m1_r_x, const RealCalcVec m1_r_y, const RealCalcVec m1_r_z,
+		uint64_t* const verletBlocks, const RealCalcVec & listRadiusSquareD) {
+
+	size_t j = ForcePolicy :: InitJ(i_center_idx);
+	MaskCalcVec initJ_mask = ForcePolicy :: InitJ_Mask(i_center_idx);
+
+	MaskGatherChooser mgc(soa2_center_dist_lookup, j);
+
+	for (; j < end_j; j += VCP_VEC_SIZE) {
+		const RealCalcVec m2_r_x = RealCalcVec::aligned_load(soa2_m_r_x + j);
+		const RealCalcVec m2_r_y = RealCalcVec::aligned_load(soa2_m_r_y + j);
+		const RealCalcVec m2_r_z = RealCalcVec::aligned_load(soa2_m_r_z + j);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		const RealCalcVec m_r2 = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz);
+
+		const size_t block = j / VCP_VEC_SIZE;
+		const uint64_t inList = (m_r2 < listRadiusSquareD).movemask() ? 1 : 0;
+		verletBlocks[block / 64] |= inList << (block % 64);
+
+		const MaskCalcVec forceMask = ForcePolicy::GetForceMask(m_r2, cutoffRadiusSquareD, initJ_mask);
+
+		mgc.storeCalcDistLookup(j, forceMask);
+
+	}
+	const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(soa2_num_centers);
+	if (remainderMask.movemask()) {
+		const RealCalcVec m2_r_x = RealCalcVec::aligned_load_mask(soa2_m_r_x + j, remainderMask);
+		const RealCalcVec m2_r_y = RealCalcVec::aligned_load_mask(soa2_m_r_y + j, remainderMask);
+		const RealCalcVec m2_r_z = RealCalcVec::aligned_load_mask(soa2_m_r_z + j, remainderMask);
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		const RealCalcVec m_r2 = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz);
+
+		const size_t block = j / VCP_VEC_SIZE;
+		const uint64_t inList = (remainderMask and (m_r2 < listRadiusSquareD)).movemask() ? 1 : 0;
+		verletBlocks[block / 64] |= inList << (block % 64);
+
+		const MaskCalcVec forceMask = remainderMask and ForcePolicy::GetForceMask(m_r2, cutoffRadiusSquareD, initJ_mask);//AND remainderMask -> set unimportant ones to zero.
+		mgc.storeCalcDistLookup(j, forceMask);
+	}
+
+	return mgc.getCount();	//do not compute stuff if nothing needs to be computed.
+
+}
+
+/**
+ * \brief The dist lookup for a molecule and all centers of a type, restricted to the blocks of a Verlet list
+ * \details Only the blocks of VCP_VEC_SIZE centers, whose bit is set in verletBlocks, are checked against
+ * the cutoff radius. All other blocks get an empty lookup.
+ */
+template<class ForcePolicy, class MaskGatherChooser>
+countertype32
+static vcp_inline calcDistLookupVerlet (const size_t & i_center_idx, const size_t & soa2_num_centers,
+		vcp_lookupOrMask_single* const soa2_center_dist_lookup, const vcp_real_calc* const soa2_m_r_x, const vcp_real_calc* const soa2_m_r_y, const vcp_real_calc* const soa2_m_r_z,
+		const RealCalcVec & cutoffRadiusSquareD, size_t end_j, const RealCalcVec m1_r_x, const RealCalcVec m1_r_y, const RealCalcVec m1_r_z,
+		const uint64_t* const verletBlocks) {
+
+	const size_t begin_j = ForcePolicy :: InitJ(i_center_idx);
+	const MaskCalcVec initJ_mask = ForcePolicy :: InitJ_Mask(i_center_idx);
+	const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(soa2_num_centers);
+	const size_t end_j_longloop = vcp_ceil_to_vec_size(soa2_num_centers);
+	const size_t num_words = (end_j_longloop / VCP_VEC_SIZE + 63) / 64;
+
+	MaskGatherChooser mgc(soa2_center_dist_lookup, begin_j);
+
+	// iterate only over the set bits, the blocks in between get empty lookups
+	size_t next_j = begin_j;
+	for (size_t w = begin_j / VCP_VEC_SIZE / 64; w < num_words; ++w) {
+		for (uint64_t word = verletBlocks[w]; word != 0; word &= word - 1) {
+			const size_t j = (w * 64 + __builtin_ctzll(word)) * VCP_VEC_SIZE;
+			if (j < begin_j) {
+				continue;
+			}
+			mgc.storeEmptyCalcDistLookups(next_j, j);
+			next_j = j + VCP_VEC_SIZE;
+
+			MaskCalcVec j_mask = (j == begin_j) ? initJ_mask : MaskCalcVec::ones();
+			if (j < end_j) {
+				const RealCalcVec m2_r_x = RealCalcVec::aligned_load(soa2_m_r_x + j);
+				const RealCalcVec m2_r_y = RealCalcVec::aligned_load(soa2_m_r_y + j);
+				const RealCalcVec m2_r_z = RealCalcVec::aligned_load(soa2_m_r_z + j);
+
+				const RealCalcVec m_dx = m1_r_x - m2_r_x;
+				const RealCalcVec m_dy = m1_r_y - m2_r_y;
+				const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+				const RealCalcVec m_r2 = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz);
+
+				const MaskCalcVec forceMask = ForcePolicy::GetForceMask(m_r2, cutoffRadiusSquareD, j_mask);
+				mgc.storeCalcDistLookup(j, forceMask);
+			} else {
+				const RealCalcVec m2_r_x = RealCalcVec::aligned_load_mask(soa2_m_r_x + j, remainderMask);
+				const RealCalcVec m2_r_y = RealCalcVec::aligned_load_mask(soa2_m_r_y + j, remainderMask);
+				const RealCalcVec m2_r_z = RealCalcVec::aligned_load_mask(soa2_m_r_z + j, remainderMask);
+
+				const RealCalcVec m_dx = m1_r_x - m2_r_x;
+				const RealCalcVec m_dy = m1_r_y - m2_r_y;
+				const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+				const RealCalcVec m_r2 = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz);
+
+				const MaskCalcVec forceMask = remainderMask and ForcePolicy::GetForceMask(m_r2, cutoffRadiusSquareD, j_mask);
+				mgc.storeCalcDistLookup(j, forceMask);
+			}
+		}
+	}
+	if (next_j == begin_j) {
+		return 0;	// nothing in the list, the lookup is not used
+	}
+	mgc.storeEmptyCalcDistLookups(next_j, end_j_longloop);
+
+	return mgc.getCount();	//do not compute stuff if nothing needs to be computed.
+
+}
+
+} /* namespace VCP_NAMESPACE */
+
 #endif /* SIMD_VECTORIZEDCELLPROCESSORHELPERS_H */
@@ -13,6 +13,11 @@ class LinkedCellsTest;
 #include "parallel/DomainDecomposition.h"
 #endif
 #include "particleContainer/adapter/CellProcessor.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <sstream>
 #include <vector>
 
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
@@ -20,6 +25,12 @@ class LinkedCellsTest;
 #include "particleContainer/adapter/VectorizedCellProcessor.h"
 #include "particleContainer/LinkedCellTraversals/HalfShellTraversal.h"
 #include "particleContainer/TraversalTuner.h"
+#include "ensemble/EnsembleBase.h"
+#include "Simulation.h"
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+#include "integrators/PositionCellProcessorRMM.h"
+#include "particleContainer/adapter/vectorization/SIMD_TYPES.h"
+#endif
 
 TEST_SUITE_REGISTRATION(LinkedCellsTest);
 
@@ -121,6 +132,81 @@ void LinkedCellsTest::testMoleculeBeginNextEndDeleteCurrent() {
 	ASSERT_TRUE_MSG("delete() last", not molIt.isValid()); // cell 4 became empty, we arrived at end()
 }
 
+void LinkedCellsTest::testSortMolecules() {
+	double bBoxMin[3] = {0.0, 0.0, 0.0};
+	double bBoxMax[3] = {2.0, 2.0, 2.0};
+	double cutoffRadius = 1.0;
+	LinkedCells LC(bBoxMin, bBoxMax, cutoffRadius);
+	LC._sortMolecules = true;
+
+	// all molecules in the same cell [0,1)^3, sub-cells of width 0.25
+	const double positions[5][3] = {
+		{0.9, 0.9, 0.9},   // sub-cell (3,3,3)
+		{0.15, 0.12, 0.1}, // sub-cell (0,0,0)
+		{0.1, 0.6, 0.1},   // sub-cell (0,2,0)
+		{0.6, 0.1, 0.1},   // sub-cell (2,0,0)
+		{0.1, 0.1, 0.1}    // sub-cell (0,0,0)
+	};
+	for (unsigned long i = 0; i < 5; ++i) {
+		Molecule m(i + 1, &_components[0], positions[i][0], positions[i][1], positions[i][2], 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+		LC.addParticle(m);
+	}
+
+	LC.updateMoleculeCaches();
+
+	// Morton order of the sub-cells, molecules 2 and 5 share a sub-cell and keep their order
+	const unsigned long expectedIDs[5] = {2, 5, 4, 3, 1};
+	auto molIt = LC.iterator();
+	for (int i = 0; i < 5; ++i) {
+		ASSERT_TRUE(molIt.isValid());
+		ASSERT_EQUAL(expectedIDs[i], molIt->getID());
+		++molIt;
+	}
+	ASSERT_TRUE(not molIt.isValid());
+}
+
+void LinkedCellsTest::testUpdateViaThreadBuffers() {
+	double bBoxMin[3] = {0.0, 0.0, 0.0};
+	double bBoxMax[3] = {3.0, 3.0, 3.0};
+	double cutoffRadius = 1.0;
+	LinkedCells LC(bBoxMin, bBoxMax, cutoffRadius);
+
+	// molecules on a grid through the halo and the inner cells
+	const int numPerDim = 8;
+	const double spacing = 4.0 / numPerDim;
+	unsigned long id = 0;
+	for (int z = 0; z < numPerDim; ++z) {
+		for (int y = 0; y < numPerDim; ++y) {
+			for (int x = 0; x < numPerDim; ++x) {
+				Molecule m(++id, &_components[0], -0.5 + (x + 0.5) * spacing, -0.5 + (y + 0.5) * spacing,
+						-0.5 + (z + 0.5) * spacing, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+				LC.addParticle(m);
+			}
+		}
+	}
+	const unsigned long numMolecules = id;
+
+	// move every molecule by up to one cell length, staying inside the halo box
+	for (auto it = LC.iterator(); it.isValid(); ++it) {
+		for (int d = 0; d < 3; ++d) {
+			const double shift = 0.25 * static_cast<double>((it->getID() + d) % 7) - 0.75;
+			const double r = std::min(std::max(it->r(d) + shift, -0.99), 3.99);
+			it->setr(d, r);
+		}
+	}
+	LC.update();
+
+	std::vector<bool> found(numMolecules + 1, false);
+	unsigned long count = 0;
+	for (auto it = LC.iterator(); it.isValid(); ++it) {
+		ASSERT_TRUE_MSG("molecule in wrong cell", LC._cells[it.getCellIndex()].testInBox(*it));
+		ASSERT_TRUE_MSG("molecule duplicated", not found[it->getID()]);
+		found[it->getID()] = true;
+		++count;
+	}
+	ASSERT_EQUAL(numMolecules, count);
+}
+
 #if 0
 void LinkedCellsTest::testGetHaloBoundaryParticlesDirection() {
 #if 0
@@ -279,6 +365,234 @@ void LinkedCellsTest::testTraversalMethods() {
 	delete container;
 }
 
+void LinkedCellsTest::testTraversalCellsInCutoff() {
+	double bBoxMin[3] = {0.0, 0.0, 0.0};
+	double bBoxMax[3] = {10.0, 10.0, 10.0};
+	const double cutoff = 2.5;
+
+	for (unsigned k = 2; k <= 3; ++k) {
+		LinkedCells LC(bBoxMin, bBoxMax, cutoff);
+		LC._cellsInCutoff = k;
+		LC.rebuild(bBoxMin, bBoxMax);
+
+		const long dims[3] = {LC._cellsPerDimension[0], LC._cellsPerDimension[1], LC._cellsPerDimension[2]};
+		CellProcessorStub cpStub(LC._cells.size());
+
+		for (auto name : {TraversalTuner<ParticleCell>::C08, TraversalTuner<ParticleCell>::C04,
+				TraversalTuner<ParticleCell>::SLICED, TraversalTuner<ParticleCell>::C08WS}) {
+			LC._traversalTuner->_traversals[name].first->traverseCellPairs(cpStub);
+			cpStub.inverseSign();
+
+			// reference: every cell and every pair of cells within the cutoff radius, unless both are halo
+			for (long z = 0; z < dims[2]; ++z) {
+				for (long y = 0; y < dims[1]; ++y) {
+					for (long x = 0; x < dims[0]; ++x) {
+						ParticleCell& cell1 = LC._cells[LC.cellIndexOf3DIndex(x, y, z)];
+						if (not cell1.isHaloCell()) {
+							cpStub.processCell(cell1);
+						}
+						for (long dz = -(long) k; dz <= (long) k; ++dz) {
+							for (long dy = -(long) k; dy <= (long) k; ++dy) {
+								for (long dx = -(long) k; dx <= (long) k; ++dx) {
+									const long n[3] = {x + dx, y + dy, z + dz};
+									const long delta[3] = {dx, dy, dz};
+									bool inside = true;
+									double distanceSquare = 0.0;
+									for (int d = 0; d < 3; ++d) {
+										inside = inside and n[d] >= 0 and n[d] < dims[d];
+										const double gap = std::max(std::abs(delta[d]) - 1l, 0l) * LC._cellLength[d];
+										distanceSquare += gap * gap;
+									}
+									if (not inside or distanceSquare > cutoff * cutoff) {
+										continue;
+									}
+									ParticleCell& cell2 = LC._cells[LC.cellIndexOf3DIndex(n[0], n[1], n[2])];
+									if (cell2.getCellIndex() <= cell1.getCellIndex() or (cell1.isHaloCell() and cell2.isHaloCell())) {
+										continue;
+									}
+									cpStub.processCellPair(cell1, cell2);
+								}
+							}
+						}
+					}
+				}
+			}
+			cpStub.checkZero();
+			cpStub.inverseSign();
+		}
+	}
+}
+
+void LinkedCellsTest::testSlicedTraversalWeighted() {
+	// elongated box, so the slices are perpendicular to z
+	double bBoxMin[3] = {0.0, 0.0, 0.0};
+	double bBoxMax[3] = {6.0, 6.0, 30.0};
+	LinkedCells LC(bBoxMin, bBoxMax, 1.0);
+
+	// dense layer at the bottom, the rest is empty
+	unsigned long id = 0;
+	for (int z = 0; z < 6; ++z) {
+		for (int y = 0; y < 6; ++y) {
+			for (int x = 0; x < 6; ++x) {
+				for (int i = 0; i < 3; ++i) {
+					Molecule m(++id, &_components[0], x + 0.2 + 0.3 * i, y + 0.5, z + 0.5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+					LC.addParticle(m);
+				}
+			}
+		}
+	}
+
+	SlicedCellPairTraversal<ParticleCell>* sliced = dynamic_cast<SlicedCellPairTraversal<ParticleCell>*>(
+			LC._traversalTuner->_traversals[TraversalTuner<ParticleCell>::SLICED].first);
+	ASSERT_TRUE(sliced != nullptr);
+
+	const std::array<unsigned long, 3> start = {{0, 0, 0}};
+	const std::array<unsigned long, 3> end = {{7, 7, 31}};
+	const int numThreads = 4;
+	sliced->computeSliceBounds(start, end, numThreads);
+
+	const std::vector<unsigned long>& bounds = sliced->_sliceBounds;
+	ASSERT_EQUAL(static_cast<size_t>(numThreads + 1), bounds.size());
+	ASSERT_EQUAL(0ul, bounds.front());
+	ASSERT_EQUAL(31ul, bounds.back());
+	for (int t = 0; t < numThreads; ++t) {
+		// the locking scheme requires two slices per thread
+		ASSERT_TRUE(bounds[t + 1] >= bounds[t] + 2);
+	}
+	// the threads in the dense layer get thinner slabs than the ones in the empty part
+	ASSERT_TRUE(bounds[1] - bounds[0] < bounds[4] - bounds[3]);
+	ASSERT_TRUE(bounds[2] - bounds[1] < bounds[4] - bounds[3]);
+}
+
+void LinkedCellsTest::testComponentCutoffRadii() {
+	// regular lattice, so all cells are populated and many cell pairs lie beyond the LJ radius
+	const char* filename = "1clj-regular-12x12x12.inp";
+	const double cutoff = 3.5;
+	const double rcLJ = 2.0;
+
+	// the cells share the static CellBorderAndFlagManager, so the reference is evaluated
+	// and deleted before the container with a different cell size is built
+	bool forceRebalancing = false;
+#ifdef MARDYN_SPSP
+	const double delta = 1e-5;
+#else
+	const double delta = 1e-9;
+#endif
+
+	// reference: global LJ cutoff radius rcLJ, no pruning
+	LinkedCells* reference = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell,
+			filename, cutoff));
+	_domainDecomposition->balanceAndExchange(0., forceRebalancing, reference, _domain);
+	_domain->initParameterStreams(cutoff, rcLJ);
+	reference->updateMoleculeCaches();
+	VectorizedCellProcessor referenceProcessor(*_domain, cutoff, rcLJ);
+	reference->traverseCells(referenceProcessor);
+	const double referenceUpot = _domain->getLocalUpot();
+
+	// the cells are traversed in a different order, so match the molecules by ID
+	reference->deleteOuterParticles();
+	const unsigned long referenceNumParticles = reference->getNumberOfParticles();
+	std::map<unsigned long, std::array<double, 3> > referenceForces;
+	for (auto i = reference->iterator(); i.isValid(); ++i) {
+		i->calcFM();
+		referenceForces[i->getID()] = {{i->F(0), i->F(1), i->F(2)}};
+	}
+	delete reference;
+	// the reader appends the sites to the components which are already present
+	global_simulation->getEnsemble()->getComponents()->clear();
+
+	// test: the component has the LJ radius rcLJ, the global LJ cutoff is the full cutoff radius
+	LinkedCells* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell,
+			filename, cutoff));
+	double bBoxMin[3], bBoxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		bBoxMin[d] = container->getBoundingBoxMin(d);
+		bBoxMax[d] = container->getBoundingBoxMax(d);
+	}
+	container->_cellsInCutoff = 3;
+	container->rebuild(bBoxMin, bBoxMax);
+	container->update();
+	_domainDecomposition->balanceAndExchange(0., forceRebalancing, container, _domain);
+
+	Component* component = global_simulation->getEnsemble()->getComponent(0);
+	component->setLJCutoffRadius(rcLJ);
+	_domain->initParameterStreams(cutoff, cutoff);
+	container->setComponentCutoffRadii(std::vector<double>(1, rcLJ));
+	container->updateMoleculeCaches();
+	const long inner = container->cellIndexOf3DIndex(container->_cellsPerDimension[0] / 2,
+			container->_cellsPerDimension[1] / 2, container->_cellsPerDimension[2] / 2);
+	ASSERT_DOUBLES_EQUAL(rcLJ, container->_cells[inner].getInteractionRadius(), 0.0);
+	VectorizedCellProcessor processor(*_domain, cutoff, cutoff);
+	container->traverseCells(processor);
+	const double upot = _domain->getLocalUpot();
+
+	component->setLJCutoffRadius(0.0);
+	_domain->initParameterStreams(cutoff, cutoff);
+
+	container->deleteOuterParticles();
+	ASSERT_EQUAL(referenceNumParticles, container->getNumberOfParticles());
+	ASSERT_DOUBLES_EQUAL(referenceUpot, upot, 1e-9 * fabs(referenceUpot));
+
+	for (auto i = container->iterator(); i.isValid(); ++i) {
+		i->calcFM();
+		const std::array<double, 3>& F = referenceForces[i->getID()];
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(F[d], i->F(d), delta * (fabs(F[d]) + 1.0));
+		}
+	}
+
+	delete container;
+}
+
+void LinkedCellsTest::testTraversalAutotuning() {
+	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, filename, 5.);
+	LinkedCells* linkedCells = dynamic_cast<LinkedCells*>(container);
+	int* boxWidthInNumCells = linkedCells->getBoxWidthInNumCells();
+	int haloWidthInNumCells = container->getHaloWidthNumCells();
+	size_t numCells = (boxWidthInNumCells[0] + 2 * haloWidthInNumCells)
+			* (boxWidthInNumCells[1] + 2 * haloWidthInNumCells) * (boxWidthInNumCells[2] + 2 * haloWidthInNumCells);
+	CellProcessorStub cpStub(numCells);
+
+	TraversalTuner<ParticleCell>* tuner = linkedCells->_traversalTuner.get();
+	tuner->_autotune = true;
+	tuner->_tuningSamples = 1;
+
+	// every candidate has to process exactly the same cell pairs as the reference traversal
+	std::array<unsigned long, 3> dims;
+	for (int d = 0; d < 3; ++d) {
+		dims[d] = linkedCells->_cellsPerDimension[d];
+	}
+	C08CellPairTraversal<ParticleCell> reference(linkedCells->_cells, dims);
+
+	size_t numCandidates = 0;
+	size_t numTraversals = 0;
+	do {
+		container->traverseCells(cpStub);
+		++numTraversals;
+		if (numTraversals == 1) {
+			// the first traversal starts the sampling phase
+			numCandidates = tuner->_tuningCandidates.size();
+			ASSERT_TRUE(numCandidates >= 2);
+			ASSERT_TRUE(tuner->_tuningActive);
+		}
+		cpStub.inverseSign();
+		reference.traverseCellPairs(cpStub);
+		cpStub.checkZero();
+		cpStub.inverseSign();
+	} while (tuner->_tuningActive);
+
+	ASSERT_EQUAL(numCandidates, numTraversals);
+	ASSERT_TRUE(std::find(tuner->_tuningCandidates.begin(), tuner->_tuningCandidates.end(),
+			tuner->getSelectedTraversal()) != tuner->_tuningCandidates.end());
+
+	// a changed cell grid triggers a new sampling phase
+	linkedCells->initializeTraversal();
+	container->traverseCells(cpStub);
+	ASSERT_TRUE(tuner->_tuningActive);
+	delete container;
+}
+
 //void LinkedCellsTest::testHalfShell() {
 //	//TODO: ___Extract to separate test class
 //	//------------------------------------------------------------
@@ -413,6 +727,91 @@ void LinkedCellsTest::testEighthShellMPIDirectPP() {
 	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::C08ES, 2, "direct-pp", "es");
 }
 
+void LinkedCellsTest::testLeavingMolecules() {
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	const double bBoxMin[3] = {0.0, 0.0, 0.0};
+	const double bBoxMax[3] = {6.0, 6.0, 6.0};
+	const double cutoffRadius = 1.0;
+	const double dt = 1.0;
+	// the molecules start in the cell [2, 3)^3
+	const double start = 2.5;
+
+	std::vector<std::array<double, 3> > velocities;
+	velocities.push_back({{0.4, -0.4, 0.3}});
+	for (int d = 0; d < 3; ++d) {
+		for (double v : {-0.75, 0.75, 0.5}) {
+			std::array<double, 3> velocity = {{0.0, 0.0, 0.0}};
+			velocity[d] = v;
+			velocities.push_back(velocity);
+		}
+	}
+
+	const unsigned numMolecules = VCP_VEC_SIZE + 1;
+	for (const std::array<double, 3>& v : velocities) {
+		for (unsigned moved : {0u, numMolecules - 1}) {
+			LinkedCells LC(bBoxMin, bBoxMax, cutoffRadius);
+			for (unsigned i = 0; i < numMolecules; ++i) {
+				const double offset = i == moved ? 0.0 : 0.01 * (i + 1);
+				const std::array<double, 3> velocity = i == moved ? v : std::array<double, 3>{{0.0, 0.0, 0.0}};
+				Molecule molecule(i, &_components[0], start + offset, start - offset, start + offset,
+						velocity[0], velocity[1], velocity[2], 1, 0, 0, 0, 0, 0, 0);
+				LC.addParticle(molecule);
+			}
+			// far from the moved molecule, so that its cell is resorted by the full update() only
+			const double sentinelPosition[3] = {5.5, 5.5, 5.5};
+			Molecule sentinel(numMolecules, &_components[0], sentinelPosition[0], sentinelPosition[1], sentinelPosition[2],
+					0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+			LC.addParticle(sentinel);
+			LC.update();
+			ParticleCell& sentinelCell = LC.getCellReference(LC.getCellIndexOfPoint(sentinelPosition));
+
+			const double oldPosition[3] = {start, start, start};
+			const double newPosition[3] = {start + dt * v[0], start + dt * v[1], start + dt * v[2]};
+			const unsigned long oldCellIndex = LC.getCellIndexOfPoint(oldPosition);
+			const unsigned long newCellIndex = LC.getCellIndexOfPoint(newPosition);
+			const bool leaves = newCellIndex != oldCellIndex;
+			ParticleCell& oldCell = LC.getCellReference(oldCellIndex);
+			ParticleCell& newCell = LC.getCellReference(newCellIndex);
+			ASSERT_EQUAL(static_cast<int>(numMolecules), oldCell.getMoleculeCount());
+
+			std::stringstream str;
+			str << "velocity (" << v[0] << ", " << v[1] << ", " << v[2] << "), moved molecule " << moved << std::endl;
+
+			PositionCellProcessorRMM cellProc(dt, true);
+			LC.traverseCellsIndependently(cellProc);
+			ASSERT_EQUAL_MSG(str.str(), leaves, oldCell.hasLeavingMolecules());
+			ASSERT_TRUE_MSG(str.str(), not newCell.hasLeavingMolecules());
+
+			// moved without flagging its cell, so the update() of the detected leaving molecules skips it
+			const double sentinelMoved = 4.5;
+			for (auto m = sentinelCell.iterator(); m.isValid(); ++m) {
+				m->setr(2, sentinelMoved);
+			}
+			ASSERT_TRUE_MSG(str.str(), not sentinelCell.hasLeavingMolecules());
+
+			LC.setLeavingMoleculesDetected();
+			LC.update();
+			ASSERT_EQUAL_MSG(str.str(), 1, sentinelCell.getMoleculeCount());
+			ASSERT_EQUAL_MSG(str.str(), static_cast<int>(leaves ? numMolecules - 1 : numMolecules), oldCell.getMoleculeCount());
+			ASSERT_EQUAL_MSG(str.str(), static_cast<int>(leaves ? 1 : numMolecules), newCell.getMoleculeCount());
+			for (auto m = newCell.iterator(); m.isValid(); ++m) {
+				if (m->getID() == moved) {
+					for (int d = 0; d < 3; ++d) {
+						ASSERT_DOUBLES_EQUAL_MSG(str.str(), newPosition[d], m->r(d), 1e-6);
+					}
+				}
+			}
+			ASSERT_EQUAL(static_cast<unsigned long>(numMolecules + 1), LC.getNumberOfParticles());
+
+			LC.update();
+			ASSERT_EQUAL_MSG(str.str(), 0, sentinelCell.getMoleculeCount());
+			const double sentinelNewPosition[3] = {sentinelPosition[0], sentinelPosition[1], sentinelMoved};
+			ASSERT_EQUAL_MSG(str.str(), 1, LC.getCellReference(LC.getCellIndexOfPoint(sentinelNewPosition)).getMoleculeCount());
+		}
+	}
+#endif
+}
+
 void LinkedCellsTest::testCellBorderAndFlagManager() {
 	long int cellIndex;
 	double cellBoxMin[3], cellBoxMax[3];
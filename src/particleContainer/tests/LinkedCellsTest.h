@@ -23,10 +23,17 @@ class LinkedCellsTest: public ParticleContainerTest {
 	TEST_METHOD(testUpdateAndDeleteOuterParticles8Particles);
 	TEST_METHOD(testMoleculeBeginNextEndDeleteCurrent);
 	TEST_METHOD(testTraversalMethods);
+	TEST_METHOD(testTraversalAutotuning);
+	TEST_METHOD(testTraversalCellsInCutoff);
+	TEST_METHOD(testSlicedTraversalWeighted);
+	TEST_METHOD(testComponentCutoffRadii);
 
 	TEST_METHOD(testCellBorderAndFlagManager);
 
 #ifndef ENABLE_REDUCED_MEMORY_MODE
+	TEST_METHOD(testSortMolecules);
+	TEST_METHOD(testUpdateViaThreadBuffers);
+
 	TEST_METHOD(testFullShellMPIDirectPP);
 	TEST_METHOD(testFullShellMPIDirect);
 
@@ -41,6 +48,7 @@ class LinkedCellsTest: public ParticleContainerTest {
 	TEST_METHOD(testEighthShellMPIDirectPP);
 #else
 #pragma message "half and midpoint tests disabled for RMM"
+	TEST_METHOD(testLeavingMolecules);
 #endif
 
 	TEST_SUITE_END();
@@ -76,7 +84,17 @@ public:
 	void testUpdateAndDeleteOuterParticlesH2O();
 	void testUpdateAndDeleteOuterParticles8Particles();
 	void testMoleculeBeginNextEndDeleteCurrent();
+	void testSortMolecules();
+	void testUpdateViaThreadBuffers();
 	void testTraversalMethods();
+	void testTraversalAutotuning();
+	void testTraversalCellsInCutoff();
+	void testSlicedTraversalWeighted();
+	/**
+	 * Checks that a component LJ cutoff radius below the cutoff radius yields the same forces as the same global LJ
+	 * cutoff radius, with the cell pairs beyond the radius pruned from the traversal.
+	 */
+	void testComponentCutoffRadii();
 	void testGetHaloBoundaryParticlesDirection();
 
 	void testHalfShell();
@@ -97,6 +115,15 @@ public:
 
 	void testCellBorderAndFlagManager();
 
+	/**
+	 * Moves one of several molecules of a cell with PositionCellProcessorRMM within the cell, across each of
+	 * its faces and exactly onto its upper corner, which belongs to the next cell, and checks that only the
+	 * moves out of the cell flag it (ParticleCellRMM::hasLeavingMolecules()) and that the update() after
+	 * setLeavingMoleculesDetected() sorts the molecule into its new cell, but skips the cells without the flag.
+	 * The moved molecule is both in the first vector and in the remainder of the cell.
+	 */
+	void testLeavingMolecules();
+
 private:
 
 	void doForceComparisonTest(std::string inputFile, TraversalTuner<ParticleCell>::traversalNames traversal, unsigned cellsInCutoff, std::string neighbourCommScheme, std::string commScheme);
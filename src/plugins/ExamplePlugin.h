@@ -51,6 +51,8 @@ public:
             unsigned long simstep
     );
 
+    bool requiresForcesBeforeIntegration() const override { return true; }
+
     void endStep(
             ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
             Domain* domain, unsigned long simstep);
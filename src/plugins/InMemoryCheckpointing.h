@@ -11,6 +11,7 @@
 #include "PluginBase.h"
 #include "molecules/MoleculeForwardDeclaration.h"
 
+#include <array>
 #include <vector>
 
 class Snapshot;
@@ -38,14 +39,6 @@ public:
             unsigned long simstep
     ){}
 
-    /**
-     * @brief writing takes place here
-     */
-    void afterForces(
-            ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
-            unsigned long simstep
-    ) {}
-
     void endStep(
             ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
             Domain* domain, unsigned long simstep);
@@ -76,6 +76,8 @@ public:
 			unsigned long simstep
 	) override;
 
+	bool requiresForcesBeforeIntegration() const override { return true; }
+
 	void endStep(
 			ParticleContainer *particleContainer,
 			DomainDecompBase *domainDecomp, Domain *domain,
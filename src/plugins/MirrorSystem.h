@@ -5,6 +5,7 @@
 
 #include "PluginBase.h"
 
+#include <array>
 #include <string>
 #include <map>
 #include <list>
@@ -64,6 +65,8 @@ public:
             unsigned long simstep
     ) override;
 
+    bool requiresForcesBeforeIntegration() const override { return true; }
+
 	void endStep(
 			ParticleContainer *particleContainer,
 			DomainDecompBase *domainDecomp, Domain *domain,
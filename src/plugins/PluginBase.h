@@ -113,6 +113,21 @@ public:
             unsigned long simstep
     ) {};
 
+    /** @brief Whether the plugin needs the forces between the force calculation and the integration
+     *
+     * Plugins overriding siteWiseForces() or afterForces() have to return true (checked by REGISTER_PLUGIN).
+     * The second half step of the integration is only fused with the force calculation
+     * (Leapfrog option fuseWithForceCalculation), if no plugin does.
+     */
+    virtual bool requiresForcesBeforeIntegration() const { return false; }
+
+    /** @brief Whether the plugin needs the halo molecules, e.g. to iterate over them or to traverse halo cells
+     *
+     * Compact halo copies (LinkedCells option compactHaloCells) are not visited by the iterators and by cell
+     * processors other than the vectorized one, so they are only used, if no plugin returns true.
+     */
+    virtual bool requiresHaloMolecules() const { return false; }
+
 
     // make pure virtual?
     /** @brief Method endStep will be called at the end of each time step.
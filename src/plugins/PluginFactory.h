@@ -3,11 +3,13 @@
 
 #include <map>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "../Simulation.h"
 
 #include "../utils/Logger.h"
 #include "../utils/String_utils.h"
+#include "../utils/mardyn_assert.h"
 
 #include "PluginBase.h"
 
@@ -16,7 +18,32 @@
 /** @brief macro used to simplify the registration of plugins in the constructor.
  * @param NAME class name of the plugin
  */
-#define REGISTER_PLUGIN(NAME) registerPlugin(&(NAME::createInstance));
+#define REGISTER_PLUGIN(NAME) checkForceCallbacks<NAME>(); registerPlugin(&(NAME::createInstance));
+
+/** @brief Check that a plugin overriding PluginBase::siteWiseForces() or PluginBase::afterForces()
+ * declares it in PluginBase::requiresForcesBeforeIntegration().
+ */
+template <class P>
+typename std::enable_if<std::is_base_of<PluginBase, P>::value>::type checkForceCallbacks() {
+	const bool overridesForceCallbacks =
+			not std::is_same<decltype(&P::siteWiseForces), decltype(&PluginBase::siteWiseForces)>::value
+			or not std::is_same<decltype(&P::afterForces), decltype(&PluginBase::afterForces)>::value;
+	if (overridesForceCallbacks) {
+		PluginBase* plugin = P::createInstance();
+		const bool requiresForces = plugin->requiresForcesBeforeIntegration();
+		const std::string pluginname = plugin->getPluginName();
+		delete plugin;
+		if (not requiresForces) {
+			Log::global_log->error() << "Plugin " << pluginname << " overrides siteWiseForces() or afterForces(), "
+					<< "but requiresForcesBeforeIntegration() returns false." << std::endl;
+			mardyn_exit(1);
+		}
+	}
+}
+
+//! @brief Other plugin types do not have the force callbacks.
+template <class P>
+typename std::enable_if<not std::is_base_of<PluginBase, P>::value>::type checkForceCallbacks() {}
 
 
 /** @brief Plugin Factory
@@ -60,6 +60,8 @@ public:
         global_log->debug()  << "[TESTPLUGIN] TESTPLUGIN AFTER FORCES" << endl;
     }
 
+    bool requiresForcesBeforeIntegration() const override { return true; }
+
     /** @brief Method endStep will be called at the end of each time step.
      *
      * This method will be called every time step passing the simstep as an additional parameter.
@@ -123,6 +123,8 @@ public:
 
     void siteWiseForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
                    unsigned long simstep);
+
+    bool requiresForcesBeforeIntegration() const override { return true; }
 };
 
 
@@ -103,6 +103,13 @@ public:
 		return *this;
 	}
 
+	/**
+	 * \brief Exchange the content with another AlignedArray without copying it.
+	 */
+	void swap(AlignedArray & a) {
+		_vec.swap(a._vec);
+	}
+
 	/**
 	 * \brief Free the array.
 	 */
@@ -10,6 +10,7 @@
 
 #include "AlignedArray.h"
 #include "utils/mardyn_assert.h"
+#include <utility>
 
 template <class T>
 class AlignedArrayTriplet : public AlignedArray<T> {
@@ -112,6 +113,11 @@ public:
 		}
 	}
 
+	void swap(AlignedArrayTriplet<T>& a) {
+		AlignedArray<T>::swap(a);
+		std::swap(_numEntriesPerArray, a._numEntriesPerArray);
+	}
+
 	/**
 	 * \brief Reallocate the array. All content may be lost.
 	 */
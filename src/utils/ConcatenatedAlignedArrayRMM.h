@@ -11,13 +11,23 @@
 #include <utils/AlignedArray.h>
 #include <particleContainer/adapter/vectorization/SIMD_TYPES.h>
 #include <array>
+#include <cstdint>
+#include <limits>
 
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 class ConcatenatedAlignedArrayRMM {
 public:
-	enum class Quantity_t { RX = 0, RY = 1, RZ = 2, VX = 3, VY = 4, VZ = 5, UID = 6};
+	/**
+	 * Q0..Q3 (quaternion) and DX..DZ (angular momentum) are accumulation-type
+	 * quantities, which are only allocated for rotational storage, see setRotational().
+	 * UID holds either uid_t or, for compact storage, 32-bit values, see setCompactUID().
+	 */
+	enum class Quantity_t { RX = 0, RY = 1, RZ = 2, VX = 3, VY = 4, VZ = 5, UID = 6,
+		Q0 = 7, Q1 = 8, Q2 = 9, Q3 = 10, DX = 11, DY = 12, DZ = 13};
 
-	ConcatenatedAlignedArrayRMM(size_t initialSize = 0) : _byteBuffer(0), _numEntriesPerArray(0) {
+	typedef uint32_t compact_uid_t;
+
+	ConcatenatedAlignedArrayRMM(size_t initialSize = 0) : _byteBuffer(0), _numEntriesPerArray(0), _rotational(false), _compactUID(false) {
 		mardyn_assert(sizeof(real_calc_t) <= sizeof(uid_t));
 		ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::resize(initialSize);
 	}
@@ -30,6 +40,9 @@ public:
 	real_calc_t& get_calc(Quantity_t coord, size_t i);
 	real_accum_t& get_accum(Quantity_t coord, size_t i);
 	uid_t& get_uid(Quantity_t coord, size_t i);
+	compact_uid_t* begin_compact_uid();
+	compact_uid_t& get_compact_uid(size_t i);
+	uid_t& compact_uid_base();
 
 	const real_calc_t* begin_calc(Quantity_t coord) const;
 	const real_accum_t* begin_accum(Quantity_t coord) const;
@@ -37,6 +50,9 @@ public:
 	const real_calc_t& get_calc(Quantity_t coord, size_t i) const;
 	const real_accum_t& get_accum(Quantity_t coord, size_t i) const;
 	const uid_t& get_uid(Quantity_t coord, size_t i) const;
+	const compact_uid_t* begin_compact_uid() const;
+	const compact_uid_t& get_compact_uid(size_t i) const;
+	const uid_t& compact_uid_base() const;
 
 	void zero(size_t start_idx = 0);
 
@@ -47,47 +63,105 @@ public:
 
 	void increaseStorage(size_t oldNumElements, size_t additionalElements);
 
+	/**
+	 * \brief Append one entry. For compact storage, uid has to fit into compact_uid_t.
+	 */
 	void appendValues(std::array<real_calc_t, 3> calcs, std::array<real_accum_t, 3> accums, uid_t uid, size_t oldNumElements);
 
 	size_t get_dynamic_memory() const {
 		return _byteBuffer.get_dynamic_memory();
 	}
 
+	/**
+	 * \brief Enable storage for the quaternion and angular momentum (Q0..DZ).
+	 * Can only be changed while no storage is allocated.
+	 */
+	void setRotational(bool rotational) {
+		mardyn_assert(_numEntriesPerArray == 0 or rotational == _rotational);
+		if (_numEntriesPerArray == 0) {
+			_rotational = rotational;
+		}
+	}
+
+	bool isRotational() const {
+		return _rotational;
+	}
+
+	/**
+	 * \brief Store the UIDs as compact_uid_t instead of uid_t, accessed via get_compact_uid().
+	 * One uid_t behind the arrays is left to the user as the base of the compact UIDs, see compact_uid_base().
+	 * Can only be changed while no storage is allocated.
+	 */
+	void setCompactUID(bool compactUID) {
+		mardyn_assert(_numEntriesPerArray == 0 or compactUID == _compactUID);
+		if (_numEntriesPerArray == 0) {
+			_compactUID = compactUID;
+		}
+	}
+
+	bool isCompactUID() const {
+		return _compactUID;
+	}
+
 private:
 	typedef unsigned char byte_t;
 	byte_t* begin(Quantity_t coord);
 	const byte_t* begin(Quantity_t coord) const;
 
+	static bool isAccum(Quantity_t coord) {
+		return (coord >= Quantity_t::VX and coord < Quantity_t::UID) or coord > Quantity_t::UID;
+	}
+	size_t sizeOf(Quantity_t coord) const {
+		if (coord == Quantity_t::UID) {
+			return _compactUID ? sizeof(compact_uid_t) : sizeof(uid_t);
+		}
+		return coord < Quantity_t::VX ? sizeof(real_calc_t) : sizeof(real_accum_t);
+	}
+	size_t numQuantities() const {
+		return _rotational ? 14 : 7;
+	}
+	/**
+	 * \brief Byte offset of the array of a quantity, if numEntriesPerArray entries are allocated per array.
+	 * \details The arrays are padded to VCP_ALIGNMENT, which only matters for the compact UIDs.
+	 */
+	size_t offset(Quantity_t coord, size_t numEntriesPerArray) const {
+		size_t ret = 0;
+		for (int i = 0; i < static_cast<int>(coord); ++i) {
+			ret += AlignedArray<byte_t, VCP_ALIGNMENT>::_round_up(numEntriesPerArray * sizeOf(static_cast<Quantity_t>(i)));
+		}
+		return ret;
+	}
+	//! the arrays, followed by the base of the compact UIDs
+	size_t totalNumBytes(size_t numEntriesPerArray) const {
+		const size_t arrays = offset(static_cast<Quantity_t>(numQuantities()), numEntriesPerArray);
+		return _compactUID ? arrays + sizeof(uid_t) : arrays;
+	}
+
 	AlignedArray<byte_t, CACHE_LINE_SIZE> _byteBuffer;
 
 	//! how many entries are allocated per real array. The number may be smaller for UID.
-	size_t _numEntriesPerArray;
+	//! 32 bits, so that the flags below fit into the same word (see ParticleCellRMMTest::testSizeOfIs64()).
+	uint32_t _numEntriesPerArray;
+
+	//! whether Q0..DZ are allocated
+	bool _rotational;
+
+	//! whether the UIDs are stored as compact_uid_t
+	bool _compactUID;
 };
 
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline typename ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::byte_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::begin(Quantity_t coord) {
-	byte_t * rx = _byteBuffer;
-	byte_t * ry = rx + _numEntriesPerArray * sizeof(real_calc_t);
-	byte_t * rz = ry + _numEntriesPerArray * sizeof(real_calc_t);
-	byte_t * vx = rz + _numEntriesPerArray * sizeof(real_calc_t);
-	byte_t * vy = vx + _numEntriesPerArray * sizeof(real_accum_t);
-	byte_t * vz = vy + _numEntriesPerArray * sizeof(real_accum_t);
-	byte_t * uid = vz + _numEntriesPerArray * sizeof(real_accum_t);
-	byte_t * starts[7] = {rx, ry, rz, vx, vy, vz, uid};
-	return _numEntriesPerArray > 0 ? starts[size_t(coord)] : nullptr;
+	mardyn_assert(size_t(coord) < numQuantities());
+	byte_t * start = _byteBuffer;
+	return _numEntriesPerArray > 0 ? start + offset(coord, _numEntriesPerArray) : nullptr;
 }
 
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline const typename ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::byte_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::begin(Quantity_t coord) const {
-	const byte_t * rx = _byteBuffer;
-	const byte_t * ry = rx + _numEntriesPerArray * sizeof(real_calc_t);
-	const byte_t * rz = ry + _numEntriesPerArray * sizeof(real_calc_t);
-	const byte_t * vx = rz + _numEntriesPerArray * sizeof(real_calc_t);
-	const byte_t * vy = vx + _numEntriesPerArray * sizeof(real_accum_t);
-	const byte_t * vz = vy + _numEntriesPerArray * sizeof(real_accum_t);
-	const byte_t * uid = vz + _numEntriesPerArray * sizeof(real_accum_t);
-	const byte_t * starts[7] = {rx, ry, rz, vx, vy, vz, uid};
-	return _numEntriesPerArray > 0 ? starts[size_t(coord)] : nullptr;
+	mardyn_assert(size_t(coord) < numQuantities());
+	const byte_t * start = _byteBuffer;
+	return _numEntriesPerArray > 0 ? start + offset(coord, _numEntriesPerArray) : nullptr;
 }
 
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
@@ -99,7 +173,7 @@ inline real_calc_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t
 
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline real_accum_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::begin_accum(Quantity_t coord) {
-	mardyn_assert(coord >= Quantity_t::VX and coord < Quantity_t::UID);
+	mardyn_assert(isAccum(coord));
 	byte_t * ret = begin(coord);
 	return reinterpret_cast<real_accum_t*>(ret);
 }
@@ -107,6 +181,7 @@ inline real_accum_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline uid_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::begin_uid(Quantity_t coord) {
 	mardyn_assert(coord == Quantity_t::UID);
+	mardyn_assert(not _compactUID);
 	byte_t * ret = begin(coord);
 	return reinterpret_cast<uid_t*>(ret);
 }
@@ -123,7 +198,7 @@ inline real_calc_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t
 
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline real_accum_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::get_accum(Quantity_t coord, size_t i) {
-	mardyn_assert(coord >= Quantity_t::VX and coord < Quantity_t::UID);
+	mardyn_assert(isAccum(coord));
 	mardyn_assert(i < _numEntriesPerArray);
 	byte_t * startByte = begin(coord);
 	real_accum_t * startReal = reinterpret_cast<real_accum_t*>(startByte);
@@ -134,6 +209,7 @@ inline real_accum_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline uid_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::get_uid(Quantity_t coord, size_t i) {
 	mardyn_assert(coord == Quantity_t::UID);
+	mardyn_assert(not _compactUID);
 	mardyn_assert(i < _numEntriesPerArray);
 	byte_t * startByte = begin(coord);
 	uid_t * startUID = reinterpret_cast<uid_t*>(startByte);
@@ -150,7 +226,7 @@ inline const real_calc_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t,
 
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline const real_accum_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::begin_accum(Quantity_t coord) const {
-	mardyn_assert(coord >= Quantity_t::VX and coord < Quantity_t::UID);
+	mardyn_assert(isAccum(coord));
 	const byte_t * ret = begin(coord);
 	return reinterpret_cast<const real_accum_t*>(ret);
 }
@@ -158,6 +234,7 @@ inline const real_accum_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline const uid_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::begin_uid(Quantity_t coord) const {
 	mardyn_assert(coord == Quantity_t::UID);
+	mardyn_assert(not _compactUID);
 	const byte_t * ret = begin(coord);
 	return reinterpret_cast<const uid_t*>(ret);
 }
@@ -174,7 +251,7 @@ inline const real_calc_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t,
 
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline const real_accum_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::get_accum(Quantity_t coord, size_t i) const {
-	mardyn_assert(coord >= Quantity_t::VX and coord < Quantity_t::UID);
+	mardyn_assert(isAccum(coord));
 	mardyn_assert(i < _numEntriesPerArray);
 	const byte_t * startByte = begin(coord);
 	const real_accum_t * startReal = reinterpret_cast<const real_accum_t*>(startByte);
@@ -185,6 +262,7 @@ inline const real_accum_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline const uid_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::get_uid(Quantity_t coord, size_t i) const {
 	mardyn_assert(coord == Quantity_t::UID);
+	mardyn_assert(not _compactUID);
 	mardyn_assert(i < _numEntriesPerArray);
 	const byte_t * startByte = begin(coord);
 	const uid_t * startUID = reinterpret_cast<const uid_t*>(startByte);
@@ -192,18 +270,58 @@ inline const uid_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t
 	return ret;
 }
 
+template <typename real_calc_t, typename real_accum_t, typename uid_t>
+inline typename ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::compact_uid_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::begin_compact_uid() {
+	mardyn_assert(_compactUID);
+	byte_t * ret = begin(Quantity_t::UID);
+	return reinterpret_cast<compact_uid_t*>(ret);
+}
+
+template <typename real_calc_t, typename real_accum_t, typename uid_t>
+inline const typename ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::compact_uid_t* ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::begin_compact_uid() const {
+	mardyn_assert(_compactUID);
+	const byte_t * ret = begin(Quantity_t::UID);
+	return reinterpret_cast<const compact_uid_t*>(ret);
+}
+
+template <typename real_calc_t, typename real_accum_t, typename uid_t>
+inline typename ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::compact_uid_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::get_compact_uid(size_t i) {
+	mardyn_assert(i < _numEntriesPerArray);
+	return begin_compact_uid()[i];
+}
+
+template <typename real_calc_t, typename real_accum_t, typename uid_t>
+inline const typename ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::compact_uid_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::get_compact_uid(size_t i) const {
+	mardyn_assert(i < _numEntriesPerArray);
+	return begin_compact_uid()[i];
+}
+
+template <typename real_calc_t, typename real_accum_t, typename uid_t>
+inline uid_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::compact_uid_base() {
+	mardyn_assert(_compactUID);
+	mardyn_assert(_numEntriesPerArray > 0);
+	byte_t * start = _byteBuffer;
+	return *reinterpret_cast<uid_t*>(start + offset(static_cast<Quantity_t>(numQuantities()), _numEntriesPerArray));
+}
+
+template <typename real_calc_t, typename real_accum_t, typename uid_t>
+inline const uid_t& ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::compact_uid_base() const {
+	mardyn_assert(_compactUID);
+	mardyn_assert(_numEntriesPerArray > 0);
+	const byte_t * start = _byteBuffer;
+	return *reinterpret_cast<const uid_t*>(start + offset(static_cast<Quantity_t>(numQuantities()), _numEntriesPerArray));
+}
+
 template <typename real_calc_t, typename real_accum_t, typename uid_t>
 inline void ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::resize(size_t nEntriesPerArray) {
 
 	if (nEntriesPerArray == 0 and _numEntriesPerArray == 0)
 		return;
 
-	_numEntriesPerArray = AlignedArray<real_calc_t, VCP_ALIGNMENT>::_round_up(nEntriesPerArray);
-	size_t numBytesForReals = 3 * _numEntriesPerArray * (sizeof(real_calc_t) + sizeof(real_accum_t));
-	size_t numBytesForUID = _numEntriesPerArray * sizeof(uid_t);
-	size_t totalNumBytes = numBytesForReals + numBytesForUID;
-
-	_byteBuffer.resize(totalNumBytes);
+	const size_t roundedUp = AlignedArray<real_calc_t, VCP_ALIGNMENT>::_round_up(nEntriesPerArray);
+	mardyn_assert(roundedUp <= std::numeric_limits<uint32_t>::max());
+	_numEntriesPerArray = static_cast<uint32_t>(roundedUp);
+	_byteBuffer.resize(totalNumBytes(_numEntriesPerArray));
 
 	if (_numEntriesPerArray > nEntriesPerArray) {
 		zero(nEntriesPerArray);
@@ -218,20 +336,11 @@ inline void ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::zero(
 	}
 	size_t num_to_zero = _numEntriesPerArray - start_idx;
 	if (_numEntriesPerArray > 0 and num_to_zero > 0) {
-		const int qbegin = static_cast<int>(Quantity_t::RX);
-		const int qmid = static_cast<int>(Quantity_t::VX);
-		const int qend = static_cast<int>(Quantity_t::UID);
-		for (int i = qbegin; i < qmid; ++i) {
-			Quantity_t q = static_cast<Quantity_t>(i);
-			std::memset(&(get_calc(q,start_idx)), 0, num_to_zero * sizeof(real_calc_t));
-		}
-		for (int i = qmid; i < qend; ++i) {
+		const int qend = static_cast<int>(numQuantities());
+		for (int i = 0; i < qend; ++i) {
 			Quantity_t q = static_cast<Quantity_t>(i);
-			std::memset(&(get_accum(q,start_idx)), 0, num_to_zero * sizeof(real_accum_t));
+			std::memset(begin(q) + start_idx * sizeOf(q), 0, num_to_zero * sizeOf(q));
 		}
-
-		size_t startIndex = begin(Quantity_t::UID) - begin(Quantity_t::RX) + start_idx * sizeof(uid_t);
-		_byteBuffer.zero(startIndex);
 	}
 }
 
@@ -254,13 +363,15 @@ inline void ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::incre
 		size_t oldNumEntriesPerArray = _numEntriesPerArray;
 		resize(newNumElements);
 
-		const int qbegin = static_cast<int>(Quantity_t::RX);
-		const int qend = static_cast<int>(Quantity_t::UID);
-		for (int i = qbegin; i < qend; ++i) {
+		const int qend = static_cast<int>(numQuantities());
+		for (int i = 0; i < qend; ++i) {
 			Quantity_t q = static_cast<Quantity_t>(i);
-			std::memcpy(begin(q), &(backupCopy[i*oldNumEntriesPerArray*sizeof(real_calc_t)]), oldNumElements * sizeof(real_calc_t));
+			std::memcpy(begin(q), &(backupCopy[offset(q, oldNumEntriesPerArray)]), oldNumElements * sizeOf(q));
+		}
+		if (_compactUID) {
+			const Quantity_t end = static_cast<Quantity_t>(numQuantities());
+			std::memcpy(&compact_uid_base(), &(backupCopy[offset(end, oldNumEntriesPerArray)]), sizeof(uid_t));
 		}
-		std::memcpy(begin(Quantity_t::UID), &(backupCopy[6*oldNumEntriesPerArray*sizeof(real_calc_t)]), oldNumElements * sizeof(uid_t));
 	} else {
 		// no
 		resize(newNumElements);
@@ -282,7 +393,12 @@ inline void ConcatenatedAlignedArrayRMM<real_calc_t, real_accum_t, uid_t>::appen
 	get_accum(Quantity_t::VX, oldNumElements) = accums[0];
 	get_accum(Quantity_t::VY, oldNumElements) = accums[1];
 	get_accum(Quantity_t::VZ, oldNumElements) = accums[2];
-	get_uid(Quantity_t::UID, oldNumElements) = uid;
+	if (_compactUID) {
+		mardyn_assert(uid <= std::numeric_limits<compact_uid_t>::max());
+		get_compact_uid(oldNumElements) = static_cast<compact_uid_t>(uid);
+	} else {
+		get_uid(Quantity_t::UID, oldNumElements) = uid;
+	}
 }
 
 template<typename real_calc_t, typename real_accum_t, typename uid_t>
@@ -8,8 +8,9 @@
 
 #include "AlignedArrayTriplet.h"
 #include "utils/mardyn_assert.h"
-#include "../particleContainer/adapter/vectorization/SIMD_TYPES.h"
+#include "../particleContainer/adapter/vectorization/SIMD_PRECISION.h"
 #include <array>
+#include <utility>
 
 namespace ConcSites {
 	/**
@@ -164,6 +165,17 @@ public:
 		setPaddingToZero(_data);
 	}
 
+	/**
+	 * \brief	Exchange the sites with those of another ConcatenatedSites without copying them
+	 */
+	void swap(ConcatenatedSites<T>& c) {
+		_data.swap(c._data);
+		std::swap(_ljc_num, c._ljc_num);
+		std::swap(_charges_num, c._charges_num);
+		std::swap(_dipoles_num, c._dipoles_num);
+		std::swap(_quadrupoles_num, c._quadrupoles_num);
+	}
+
 	/**
 	 * \brief	Get the size of currently occupied memory
 	 * \return	Number of allocated bytes
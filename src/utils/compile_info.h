@@ -3,9 +3,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <time.h>
 
+#include "particleContainer/adapter/vectorization/SIMD_TYPES.h"
+
 #define MAX_INFO_STRING_LENGTH 1024
 
 
@@ -154,6 +157,9 @@ void get_intrinsics_info(char *info_str) {
 #elif VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER
 	sprintf(info_str, "%s", "SKX gather/scatter");
 #endif
+#if defined(VCP_DISPATCH)
+	strcat(info_str, " (kernel of the VectorizedCellProcessor selected at run time)");
+#endif
 }
 
 void get_rmm_normal_info(char *info_str) {
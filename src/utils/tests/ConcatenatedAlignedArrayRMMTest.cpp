@@ -277,3 +277,99 @@ void ConcatenatedAlignedArrayRMMTest::testIncreasingStorage() {
 	check(x, y, z, A, 111);
 }
 
+
+void ConcatenatedAlignedArrayRMMTest::testRotational() {
+	// mixed types, so that the offsets of calc and accum quantities differ
+	typedef ConcatenatedAlignedArrayRMM<float, double, uint64_t> Array_t;
+	typedef Array_t::Quantity_t Q_t;
+
+	Array_t A;
+	A.setRotational(true);
+	ASSERT_TRUE(A.isRotational());
+
+	for(int i = 0; i < 37; ++i) {
+		if (i == 11 or i == 22) {
+			A.increaseStorage(i, 5);
+		}
+		std::array<float, 3> val = {
+			static_cast<float>(i),
+			static_cast<float>(-i-1),
+			static_cast<float>(i+2)
+		};
+		std::array<double, 3> val2 = {
+			static_cast<double>(i),
+			static_cast<double>(-i-1),
+			static_cast<double>(i+2)
+		};
+		A.appendValues(val, val2, i, i);
+		for (int q = static_cast<int>(Q_t::Q0); q <= static_cast<int>(Q_t::DZ); ++q) {
+			A.get_accum(static_cast<Q_t>(q), i) = 100.0 * q + i;
+		}
+	}
+
+	for (int q = static_cast<int>(Q_t::Q0); q <= static_cast<int>(Q_t::DZ); ++q) {
+		const double * begin = A.begin_accum(static_cast<Q_t>(q));
+		ASSERT_EQUAL(static_cast<int>(reinterpret_cast<intptr_t>(begin) % VCP_ALIGNMENT), 0);
+	}
+
+	for(int i = 0; i < 37; ++i) {
+		ASSERT_DOUBLES_EQUAL(static_cast<double>(i), A.get_calc(Q_t::RX, i), 0.0);
+		ASSERT_DOUBLES_EQUAL(static_cast<double>(-i-1), A.get_calc(Q_t::RY, i), 0.0);
+		ASSERT_DOUBLES_EQUAL(static_cast<double>(i+2), A.get_calc(Q_t::RZ, i), 0.0);
+		ASSERT_DOUBLES_EQUAL(static_cast<double>(i), A.get_accum(Q_t::VX, i), 0.0);
+		ASSERT_DOUBLES_EQUAL(static_cast<double>(-i-1), A.get_accum(Q_t::VY, i), 0.0);
+		ASSERT_DOUBLES_EQUAL(static_cast<double>(i+2), A.get_accum(Q_t::VZ, i), 0.0);
+		ASSERT_EQUAL(static_cast<uint64_t>(i), A.get_uid(Q_t::UID, i));
+		for (int q = static_cast<int>(Q_t::Q0); q <= static_cast<int>(Q_t::DZ); ++q) {
+			ASSERT_DOUBLES_EQUAL(100.0 * q + i, A.get_accum(static_cast<Q_t>(q), i), 0.0);
+		}
+	}
+}
+
+void ConcatenatedAlignedArrayRMMTest::testCompactUID() {
+	// double precision, so that the compact UID array alone would break the alignment of the following arrays
+	typedef ConcatenatedAlignedArrayRMM<double, double, uint64_t> Array_t;
+	typedef Array_t::Quantity_t Q_t;
+
+	Array_t A;
+	A.setRotational(true);
+	A.setCompactUID(true);
+	ASSERT_TRUE(A.isCompactUID());
+
+	for(int i = 0; i < 37; ++i) {
+		if (i == 11 or i == 22) {
+			A.increaseStorage(i, 5);
+		}
+		std::array<double, 3> val = {
+			static_cast<double>(i),
+			static_cast<double>(-i-1),
+			static_cast<double>(i+2)
+		};
+		A.appendValues(val, val, 3 * i, i);
+		for (int q = static_cast<int>(Q_t::Q0); q <= static_cast<int>(Q_t::DZ); ++q) {
+			A.get_accum(static_cast<Q_t>(q), i) = 100.0 * q + i;
+		}
+		if (i == 0) {
+			A.compact_uid_base() = 5000000000ul;
+		}
+	}
+
+	// the base is kept when the storage grows
+	ASSERT_EQUAL(static_cast<uint64_t>(5000000000ul), A.compact_uid_base());
+
+	const uint32_t * uid = A.begin_compact_uid();
+	ASSERT_EQUAL(static_cast<int>(reinterpret_cast<intptr_t>(uid) % VCP_ALIGNMENT), 0);
+	for (int q = static_cast<int>(Q_t::Q0); q <= static_cast<int>(Q_t::DZ); ++q) {
+		const double * begin = A.begin_accum(static_cast<Q_t>(q));
+		ASSERT_EQUAL(static_cast<int>(reinterpret_cast<intptr_t>(begin) % VCP_ALIGNMENT), 0);
+	}
+
+	for(int i = 0; i < 37; ++i) {
+		ASSERT_DOUBLES_EQUAL(static_cast<double>(i), A.get_calc(Q_t::RX, i), 0.0);
+		ASSERT_DOUBLES_EQUAL(static_cast<double>(i+2), A.get_accum(Q_t::VZ, i), 0.0);
+		ASSERT_EQUAL(static_cast<uint32_t>(3 * i), A.get_compact_uid(i));
+		for (int q = static_cast<int>(Q_t::Q0); q <= static_cast<int>(Q_t::DZ); ++q) {
+			ASSERT_DOUBLES_EQUAL(100.0 * q + i, A.get_accum(static_cast<Q_t>(q), i), 0.0);
+		}
+	}
+}
@@ -17,6 +17,8 @@ class ConcatenatedAlignedArrayRMMTest: public utils::Test {
 	TEST_METHOD(testZero);
 	TEST_METHOD(testAppending);
 	TEST_METHOD(testIncreasingStorage);
+	TEST_METHOD(testRotational);
+	TEST_METHOD(testCompactUID);
 	TEST_SUITE_END();
 
 public:
@@ -33,6 +35,10 @@ public:
 	void testAppending();
 
 	void testIncreasingStorage();
+
+	void testRotational();
+
+	void testCompactUID();
 };
 
 #endif /* SRC_UTILS_TESTS_CONCATENATEDALIGNEDARRAYRMMTEST_H_ */
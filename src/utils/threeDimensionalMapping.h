@@ -9,6 +9,7 @@
 #define SRC_UTILS_THREEDIMENSIONALMAPPING_H_
 
 #include <array>
+#include <cstdint>
 
 namespace threeDimensionalMapping {
 
@@ -31,6 +32,27 @@ std::array<T, 3> oneToThreeD(T ind, const std::array<T, 3> dims) {
 	return pos;
 }
 
+/**
+ * \brief Spread the lowest 21 bits of x, such that two zero bits follow each bit.
+ */
+inline uint64_t spreadBitsBy3(uint64_t x) {
+	x &= 0x1fffff;
+	x = (x | x << 32) & 0x001f00000000ffffull;
+	x = (x | x << 16) & 0x001f0000ff0000ffull;
+	x = (x | x << 8) & 0x100f00f00f00f00full;
+	x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+	x = (x | x << 2) & 0x1249249249249249ull;
+	return x;
+}
+
+/**
+ * \brief Position of the 3D index (x, y, z) along the Morton (Z-order) curve.
+ * Each coordinate must fit into 21 bits.
+ */
+inline uint64_t threeToMorton(uint64_t x, uint64_t y, uint64_t z) {
+	return spreadBitsBy3(x) | spreadBitsBy3(y) << 1 | spreadBitsBy3(z) << 2;
+}
+
 } /* namespace threeDimensionalMapping */
 
 